@@ -32,6 +32,8 @@
 #include <libxfdashboard/application.h>
 #include <libxfdashboard/stylable.h>
 #include <libxfdashboard/focusable.h>
+#include <libxfdashboard/instrumentation.h>
+#include <libxfdashboard/transition-manager.h>
 #include <libxfdashboard/utils.h>
 #include <libxfdashboard/compat.h>
 
@@ -52,6 +54,7 @@ struct _XfdashboardActorPrivate
 	/* Properties related */
 	gboolean		canFocus;
 	gchar			*effects;
+	gchar			*transition;
 
 	gchar			*styleClasses;
 	gchar			*stylePseudoClasses;
@@ -60,6 +63,10 @@ struct _XfdashboardActorPrivate
 	GHashTable		*lastThemeStyleSet;
 	gboolean		forceStyleRevalidation;
 	gboolean		isFirstParent;
+
+	guint			restyleLevel;
+	gboolean		restyleNeedsRelayout;
+	GSList			*restyleInvalidContents;
 };
 
 /* Properties */
@@ -69,6 +76,7 @@ enum
 
 	PROP_CAN_FOCUS,
 	PROP_EFFECTS,
+	PROP_TRANSITION,
 
 	/* Overriden properties of interface: XfdashboardStylable */
 	PROP_STYLE_CLASSES,
@@ -458,6 +466,23 @@ static void _xfdashboard_actor_stylable_set_pseudo_classes(XfdashboardStylable *
 	}
 }
 
+/* Set value of stylable property either immediately or animated by transition manager */
+static void _xfdashboard_actor_set_stylable_property(XfdashboardActor *self,
+														XfdashboardTransitionManager *inTransitionManager,
+														const gchar *inPropertyName,
+														const GValue *inValue)
+{
+	if(inTransitionManager)
+	{
+		xfdashboard_transition_manager_set_property(inTransitionManager,
+													CLUTTER_ACTOR(self),
+													self->priv->transition,
+													inPropertyName,
+													inValue);
+	}
+		else g_object_set_property(G_OBJECT(self), inPropertyName, inValue);
+}
+
 /* Invalidate style to recompute styles */
 static void _xfdashboard_actor_stylable_invalidate(XfdashboardStylable *inStylable)
 {
@@ -472,6 +497,7 @@ static void _xfdashboard_actor_stylable_invalidate(XfdashboardStylable *inStylab
 	GHashTable					*themeStyleSet;
 	gchar						*styleName;
 	XfdashboardThemeCSSValue	*styleValue;
+	XfdashboardTransitionManager	*transitionManager;
 	gboolean					didChange;
 #ifdef DEBUG
 	gboolean					doDebug=FALSE;
@@ -487,6 +513,8 @@ static void _xfdashboard_actor_stylable_invalidate(XfdashboardStylable *inStylab
 	/* Only recompute style for mapped actors or if revalidation was forced */
 	if(!priv->forceStyleRevalidation && !clutter_actor_is_mapped(CLUTTER_ACTOR(self))) return;
 
+	xfdashboard_instrumentation_add(XFDASHBOARD_INSTRUMENTATION_COUNTER_RESTYLES, 1);
+
 	/* Get theme CSS */
 	theme=xfdashboard_application_get_theme(NULL);
 	themeCSS=xfdashboard_theme_get_css(theme);
@@ -548,8 +576,24 @@ static void _xfdashboard_actor_stylable_invalidate(XfdashboardStylable *inStylab
 
 	/* The 'property-changed' notification will be freezed and thawed
 	 * (fired at once) after all stylable properties of this instance are set.
+	 * Also defer relayout and content invalidation requested by property
+	 * setters until all stylable properties are set.
 	 */
 	g_object_freeze_notify(G_OBJECT(self));
+	xfdashboard_actor_begin_restyle(self);
+
+	/* Set transitions first as they apply to all other stylable properties
+	 * set now. Properties are only animated if this actor was styled before
+	 * so it does not animate from default values when styled the first time.
+	 * Once styled, all properties are set through transition manager even if
+	 * the new style has no transitions anymore, so it can stop transitions
+	 * still running from the previous style before value is set.
+	 */
+	styleValue=(XfdashboardThemeCSSValue*)g_hash_table_lookup(themeStyleSet, "transition");
+	xfdashboard_actor_set_transition(self, styleValue ? styleValue->string : NULL);
+
+	transitionManager=NULL;
+	if(priv->lastThemeStyleSet) transitionManager=xfdashboard_transition_manager_get_default();
 
 	/* Iterate through style information retrieved from theme and
 	 * set the corresponding property in object instance if key
@@ -581,7 +625,7 @@ static void _xfdashboard_actor_stylable_invalidate(XfdashboardStylable *inStylab
 
 		if(g_param_value_convert(realParamSpec, &cssValue, &propertyValue, FALSE))
 		{
-			g_object_set_property(G_OBJECT(self), styleName, &propertyValue);
+			_xfdashboard_actor_set_stylable_property(self, transitionManager, styleName, &propertyValue);
 			didChange=TRUE;
 #ifdef DEBUG
 			if(doDebug)
@@ -637,7 +681,7 @@ static void _xfdashboard_actor_stylable_invalidate(XfdashboardStylable *inStylab
 			g_param_value_set_default(realParamSpec, &propertyValue);
 
 			/* Set value at object property */
-			g_object_set_property(G_OBJECT(self), styleName, &propertyValue);
+			_xfdashboard_actor_set_stylable_property(self, transitionManager, styleName, &propertyValue);
 			didChange=TRUE;
 #ifdef DEBUG
 			if(doDebug)
@@ -667,6 +711,7 @@ static void _xfdashboard_actor_stylable_invalidate(XfdashboardStylable *inStylab
 	priv->lastThemeStyleSet=themeStyleSet;
 
 	/* Release allocated resources */
+	if(transitionManager) g_object_unref(transitionManager);
 	g_hash_table_destroy(possibleStyleSet);
 
 	/* Force a redraw if any change was made at this actor */
@@ -675,9 +720,11 @@ static void _xfdashboard_actor_stylable_invalidate(XfdashboardStylable *inStylab
 	/* Reset force style revalidation flag because it's done now */
 	priv->forceStyleRevalidation=FALSE;
 
-	/* All stylable properties are set now. So thaw 'property-changed'
-	 * notification now and fire all notifications at once.
+	/* All stylable properties are set now. So process deferred relayout and
+	 * content invalidation once and thaw 'property-changed' notification now
+	 * and fire all notifications at once.
 	 */
+	xfdashboard_actor_end_restyle(self);
 	g_object_thaw_notify(G_OBJECT(self));
 }
 
@@ -854,6 +901,12 @@ static void _xfdashboard_actor_dispose(GObject *inObject)
 		priv->effects=NULL;
 	}
 
+	if(priv->transition)
+	{
+		g_free(priv->transition);
+		priv->transition=NULL;
+	}
+
 	if(priv->styleClasses)
 	{
 		g_free(priv->styleClasses);
@@ -872,6 +925,12 @@ static void _xfdashboard_actor_dispose(GObject *inObject)
 		priv->lastThemeStyleSet=NULL;
 	}
 
+	if(priv->restyleInvalidContents)
+	{
+		g_slist_free_full(priv->restyleInvalidContents, g_object_unref);
+		priv->restyleInvalidContents=NULL;
+	}
+
 	/* Call parent's class dispose method */
 	G_OBJECT_CLASS(xfdashboard_actor_parent_class)->dispose(inObject);
 }
@@ -894,6 +953,10 @@ static void _xfdashboard_actor_set_property(GObject *inObject,
 			xfdashboard_actor_set_effects(self, g_value_get_string(inValue));
 			break;
 
+		case PROP_TRANSITION:
+			xfdashboard_actor_set_transition(self, g_value_get_string(inValue));
+			break;
+
 		case PROP_STYLE_CLASSES:
 			_xfdashboard_actor_stylable_set_classes(XFDASHBOARD_STYLABLE(self),
 													g_value_get_string(inValue));
@@ -928,6 +991,10 @@ static void _xfdashboard_actor_get_property(GObject *inObject,
 			g_value_set_string(outValue, priv->effects);
 			break;
 
+		case PROP_TRANSITION:
+			g_value_set_string(outValue, priv->transition);
+			break;
+
 		case PROP_STYLE_CLASSES:
 			g_value_set_string(outValue, priv->styleClasses);
 			break;
@@ -989,11 +1056,23 @@ void xfdashboard_actor_class_init(XfdashboardActorClass *klass)
 								G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
 	g_object_class_install_property(G_OBJECT_CLASS(klass), PROP_EFFECTS, XfdashboardActorProperties[PROP_EFFECTS]);
 
+	XfdashboardActorProperties[PROP_TRANSITION]=
+		g_param_spec_string("transition",
+								_("Transition"),
+								_("List of comma-separated transitions of properties, each consisting of property name, duration and optional easing mode"),
+								NULL,
+								G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+	g_object_class_install_property(G_OBJECT_CLASS(klass), PROP_TRANSITION, XfdashboardActorProperties[PROP_TRANSITION]);
+
 	g_object_class_override_property(gobjectClass, PROP_STYLE_CLASSES, "style-classes");
 	g_object_class_override_property(gobjectClass, PROP_STYLE_PSEUDO_CLASSES, "style-pseudo-classes");
 
 	/* Define stylable properties */
 	xfdashboard_actor_install_stylable_property_by_name(klass, "effects");
+	xfdashboard_actor_install_stylable_property_by_name(klass, "transition");
+	xfdashboard_actor_install_stylable_property_by_name(klass, "opacity");
+	xfdashboard_actor_install_stylable_property_by_name(klass, "translation-x");
+	xfdashboard_actor_install_stylable_property_by_name(klass, "translation-y");
 	xfdashboard_actor_install_stylable_property_by_name(klass, "x-expand");
 	xfdashboard_actor_install_stylable_property_by_name(klass, "y-expand");
 	xfdashboard_actor_install_stylable_property_by_name(klass, "x-align");
@@ -1016,10 +1095,14 @@ void xfdashboard_actor_init(XfdashboardActor *self)
 	/* Set up default values */
 	priv->canFocus=FALSE;
 	priv->effects=NULL;
+	priv->transition=NULL;
 	priv->styleClasses=NULL;
 	priv->stylePseudoClasses=NULL;
 	priv->lastThemeStyleSet=NULL;
 	priv->isFirstParent=TRUE;
+	priv->restyleLevel=0;
+	priv->restyleNeedsRelayout=FALSE;
+	priv->restyleInvalidContents=NULL;
 
 	/* Connect signals */
 	g_signal_connect(self, "notify::mapped", G_CALLBACK(_xfdashboard_actor_on_mapped_changed), NULL);
@@ -1172,6 +1255,36 @@ void xfdashboard_actor_set_effects(XfdashboardActor *self, const gchar *inEffect
 	}
 }
 
+/* Get/set comma-separated list of transitions used when stylable properties
+ * of this actor change, e.g. "opacity 200ms ease-out-quad, translation-x 150ms".
+ */
+const gchar* xfdashboard_actor_get_transition(XfdashboardActor *self)
+{
+	g_return_val_if_fail(XFDASHBOARD_IS_ACTOR(self), NULL);
+
+	return(self->priv->transition);
+}
+
+void xfdashboard_actor_set_transition(XfdashboardActor *self, const gchar *inTransition)
+{
+	XfdashboardActorPrivate		*priv;
+
+	g_return_if_fail(XFDASHBOARD_IS_ACTOR(self));
+
+	priv=self->priv;
+
+	/* Set value if changed */
+	if(g_strcmp0(priv->transition, inTransition)!=0)
+	{
+		/* Set value */
+		if(priv->transition) g_free(priv->transition);
+		priv->transition=g_strdup(inTransition);
+
+		/* Notify about property change */
+		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardActorProperties[PROP_TRANSITION]);
+	}
+}
+
 /* Register stylable property of a class */
 void xfdashboard_actor_install_stylable_property(XfdashboardActorClass *klass, GParamSpec *inParamSpec)
 {
@@ -1267,3 +1380,95 @@ void xfdashboard_actor_invalidate(XfdashboardActor *self)
 
 	self->priv->forceStyleRevalidation=TRUE;
 }
+
+/* Begin a restyle transaction. Until the transaction ends relayout requests
+ * and content invalidations requested via xfdashboard_actor_queue_relayout()
+ * and xfdashboard_actor_invalidate_content() are only remembered and processed
+ * once at xfdashboard_actor_end_restyle(). Transactions can be nested.
+ */
+void xfdashboard_actor_begin_restyle(XfdashboardActor *self)
+{
+	g_return_if_fail(XFDASHBOARD_IS_ACTOR(self));
+
+	self->priv->restyleLevel++;
+}
+
+/* End a restyle transaction and process deferred requests if it was the
+ * outermost one.
+ */
+void xfdashboard_actor_end_restyle(XfdashboardActor *self)
+{
+	XfdashboardActorPrivate		*priv;
+	GSList						*contents;
+	GSList						*iter;
+
+	g_return_if_fail(XFDASHBOARD_IS_ACTOR(self));
+
+	priv=self->priv;
+
+	g_return_if_fail(priv->restyleLevel>0);
+
+	/* Do nothing if this is not the outermost transaction */
+	priv->restyleLevel--;
+	if(priv->restyleLevel>0) return;
+
+	/* Invalidate each content only once */
+	contents=g_slist_reverse(priv->restyleInvalidContents);
+	priv->restyleInvalidContents=NULL;
+
+	for(iter=contents; iter; iter=g_slist_next(iter))
+	{
+		clutter_content_invalidate(CLUTTER_CONTENT(iter->data));
+	}
+	g_slist_free_full(contents, g_object_unref);
+
+	/* Queue relayout only once */
+	if(priv->restyleNeedsRelayout)
+	{
+		priv->restyleNeedsRelayout=FALSE;
+		clutter_actor_queue_relayout(CLUTTER_ACTOR(self));
+	}
+}
+
+/* Determine if actor is in a restyle transaction */
+gboolean xfdashboard_actor_is_restyling(XfdashboardActor *self)
+{
+	g_return_val_if_fail(XFDASHBOARD_IS_ACTOR(self), FALSE);
+
+	return(self->priv->restyleLevel>0 ? TRUE : FALSE);
+}
+
+/* Queue relayout of actor or defer it to end of restyle transaction */
+void xfdashboard_actor_queue_relayout(XfdashboardActor *self)
+{
+	XfdashboardActorPrivate		*priv;
+
+	g_return_if_fail(XFDASHBOARD_IS_ACTOR(self));
+
+	priv=self->priv;
+
+	if(priv->restyleLevel>0) priv->restyleNeedsRelayout=TRUE;
+		else clutter_actor_queue_relayout(CLUTTER_ACTOR(self));
+}
+
+/* Invalidate content used by actor or defer it to end of restyle transaction */
+void xfdashboard_actor_invalidate_content(XfdashboardActor *self, ClutterContent *inContent)
+{
+	XfdashboardActorPrivate		*priv;
+
+	g_return_if_fail(XFDASHBOARD_IS_ACTOR(self));
+	g_return_if_fail(CLUTTER_IS_CONTENT(inContent));
+
+	priv=self->priv;
+
+	if(priv->restyleLevel==0)
+	{
+		clutter_content_invalidate(inContent);
+		return;
+	}
+
+	if(!g_slist_find(priv->restyleInvalidContents, inContent))
+	{
+		priv->restyleInvalidContents=g_slist_prepend(priv->restyleInvalidContents, g_object_ref(inContent));
+	}
+}
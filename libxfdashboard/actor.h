@@ -74,6 +74,9 @@ void xfdashboard_actor_set_can_focus(XfdashboardActor *self, gboolean inCanFous)
 const gchar* xfdashboard_actor_get_effects(XfdashboardActor *self);
 void xfdashboard_actor_set_effects(XfdashboardActor *self, const gchar *inEffects);
 
+const gchar* xfdashboard_actor_get_transition(XfdashboardActor *self);
+void xfdashboard_actor_set_transition(XfdashboardActor *self, const gchar *inTransition);
+
 void xfdashboard_actor_install_stylable_property(XfdashboardActorClass *klass, GParamSpec *inParamSpec);
 void xfdashboard_actor_install_stylable_property_by_name(XfdashboardActorClass *klass, const gchar *inParamName);
 GHashTable* xfdashboard_actor_get_stylable_properties(XfdashboardActorClass *klass);
@@ -81,6 +84,13 @@ GHashTable* xfdashboard_actor_get_stylable_properties_full(XfdashboardActorClass
 
 void xfdashboard_actor_invalidate(XfdashboardActor *self);
 
+void xfdashboard_actor_begin_restyle(XfdashboardActor *self);
+void xfdashboard_actor_end_restyle(XfdashboardActor *self);
+gboolean xfdashboard_actor_is_restyling(XfdashboardActor *self);
+
+void xfdashboard_actor_queue_relayout(XfdashboardActor *self);
+void xfdashboard_actor_invalidate_content(XfdashboardActor *self, ClutterContent *inContent);
+
 G_END_DECLS
 
 #endif
@@ -1068,3 +1068,22 @@ const GList*  xfdashboard_application_tracker_get_window_list_by_app_info(Xfdash
 	/* Return list of windows for found application tracker item */
 	return(item->windows);
 }
+
+/* Get desktop application information of application a window belongs to.
+ * The returned object must be freed with g_object_unref() if not needed anymore.
+ */
+GAppInfo* xfdashboard_application_tracker_get_app_info_by_window(XfdashboardApplicationTracker *self,
+																	XfdashboardWindowTrackerWindow *inWindow)
+{
+	XfdashboardApplicationTrackerItem	*item;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_APPLICATION_TRACKER(self), NULL);
+	g_return_val_if_fail(XFDASHBOARD_IS_WINDOW_TRACKER_WINDOW(inWindow), NULL);
+
+	/* Get application tracker item owning requested window */
+	item=_xfdashboard_application_tracker_find_item_by_window(self, inWindow);
+	if(!item || !item->appInfo) return(NULL);
+
+	/* Return desktop application information of found application tracker item */
+	return(G_APP_INFO(g_object_ref(item->appInfo)));
+}
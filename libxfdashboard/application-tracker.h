@@ -31,6 +31,8 @@
 #include <glib-object.h>
 #include <gio/gio.h>
 
+#include <libxfdashboard/window-tracker.h>
+
 G_BEGIN_DECLS
 
 #define XFDASHBOARD_TYPE_APPLICATION_TRACKER				(xfdashboard_application_tracker_get_type())
@@ -80,6 +82,9 @@ const GList* xfdashboard_application_tracker_get_window_list_by_desktop_id(Xfdas
 const GList*  xfdashboard_application_tracker_get_window_list_by_app_info(XfdashboardApplicationTracker *self,
 																			GAppInfo *inAppInfo);
 
+GAppInfo* xfdashboard_application_tracker_get_app_info_by_window(XfdashboardApplicationTracker *self,
+																	XfdashboardWindowTrackerWindow *inWindow);
+
 G_END_DECLS
 
 #endif	/* __LIBXFDASHBOARD_APPLICATION_TRACKER__ */
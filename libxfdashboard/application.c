@@ -43,6 +43,10 @@
 #include <gtk/gtk.h>
 #include <garcon/garcon.h>
 #include <libxfce4ui/libxfce4ui.h>
+#include <unistd.h>
+#ifdef HAVE_MALLOC_H
+#include <malloc.h>
+#endif
 
 #include <libxfdashboard/stage.h>
 #include <libxfdashboard/types.h>
@@ -52,14 +56,17 @@
 #include <libxfdashboard/search-view.h>
 #include <libxfdashboard/search-manager.h>
 #include <libxfdashboard/applications-search-provider.h>
+#include <libxfdashboard/windows-search-provider.h>
 #include <libxfdashboard/utils.h>
 #include <libxfdashboard/theme.h>
 #include <libxfdashboard/focus-manager.h>
+#include <libxfdashboard/transition-manager.h>
 #include <libxfdashboard/bindings-pool.h>
 #include <libxfdashboard/application-database.h>
 #include <libxfdashboard/application-tracker.h>
 #include <libxfdashboard/plugins-manager.h>
 #include <libxfdashboard/marshal.h>
+#include <libxfdashboard/enums.h>
 #include <libxfdashboard/compat.h>
 
 
@@ -88,6 +95,8 @@ struct _XfdashboardApplicationPrivate
 	XfdashboardViewManager			*viewManager;
 	XfdashboardSearchManager		*searchManager;
 	XfdashboardFocusManager			*focusManager;
+	XfdashboardTransitionManager	*transitionManager;
+	gulong							xfconfReducedMotionBindingID;
 
 	XfdashboardTheme				*theme;
 	gulong							xfconfThemeChangedSignalID;
@@ -149,12 +158,69 @@ static guint XfdashboardApplicationSignals[SIGNAL_LAST]={ 0, };
 #define THEME_NAME_XFCONF_PROP				"/theme"
 #define DEFAULT_THEME_NAME					"xfdashboard"
 
+#define SUSPEND_MEMORY_POLICY_XFCONF_PROP	"/suspend-memory-policy"
+#define DEFAULT_SUSPEND_MEMORY_POLICY		XFDASHBOARD_SUSPEND_MEMORY_POLICY_NONE
+
+#define REDUCED_MOTION_XFCONF_PROP			"/reduced-motion"
+
 /* Single instance of application */
 static XfdashboardApplication*		_xfdashboard_application=NULL;
 
 /* Forward declarations */
 static void _xfdashboard_application_activate(GApplication *inApplication);
 
+/* Get resident set size of this process in bytes or 0 if it cannot be determined */
+static guint64 _xfdashboard_application_get_resident_size(void)
+{
+	gchar							*contents;
+	gchar							*residentField;
+	guint64							residentPages;
+	glong							pageSize;
+
+	/* Read process statistics provided by kernel */
+	contents=NULL;
+	if(!g_file_get_contents("/proc/self/statm", &contents, NULL, NULL)) return(0);
+
+	/* Skip first field (total pages) as second field is number of resident pages */
+	residentField=NULL;
+	g_ascii_strtoull(contents, &residentField, 10);
+	residentPages=g_ascii_strtoull(residentField, NULL, 10);
+	g_free(contents);
+
+	/* Convert pages to bytes */
+	pageSize=sysconf(_SC_PAGESIZE);
+	if(pageSize<=0) return(0);
+
+	return(residentPages*pageSize);
+}
+
+/* Release memory according to suspend memory policy after application was suspended */
+static void _xfdashboard_application_shed_memory(XfdashboardApplication *self, guint64 inResidentSizeBefore)
+{
+	XfdashboardSuspendMemoryPolicy	policy;
+	guint64							residentSizeAfter;
+
+	g_return_if_fail(XFDASHBOARD_IS_APPLICATION(self));
+
+	/* Do nothing if memory should be kept */
+	policy=xfdashboard_application_get_suspend_memory_policy(self);
+	if(policy==XFDASHBOARD_SUSPEND_MEMORY_POLICY_NONE) return;
+
+	/* All objects have released their caches and actors as requested by
+	 * policy when handling "suspend" signal. Return freed memory to system.
+	 */
+#ifdef HAVE_MALLOC_TRIM
+	malloc_trim(0);
+#endif
+
+	/* Report memory usage before and after suspension */
+	residentSizeAfter=_xfdashboard_application_get_resident_size();
+	g_debug("Suspended with memory policy %d: resident size changed from %" G_GUINT64_FORMAT " KiB to %" G_GUINT64_FORMAT " KiB",
+				policy,
+				inResidentSizeBefore/1024,
+				residentSizeAfter/1024);
+}
+
 /* Quit application depending on daemon mode and force parameter */
 static void _xfdashboard_application_quit(XfdashboardApplication *self, gboolean inForceQuit)
 {
@@ -218,12 +284,20 @@ static void _xfdashboard_application_quit(XfdashboardApplication *self, gboolean
 			/* Only send signal if not suspended already */
 			if(!priv->isSuspended)
 			{
+				guint64				residentSize;
+
+				/* Remember memory usage before suspension */
+				residentSize=_xfdashboard_application_get_resident_size();
+
 				/* Send signal */
 				g_signal_emit(self, XfdashboardApplicationSignals[SIGNAL_SUSPEND], 0);
 
 				/* Set flag for suspension */
 				priv->isSuspended=TRUE;
 				g_object_notify_by_pspec(G_OBJECT(self), XfdashboardApplicationProperties[PROP_SUSPENDED]);
+
+				/* Release memory as configured */
+				_xfdashboard_application_shed_memory(self, residentSize);
 			}
 		}
 }
@@ -447,12 +521,23 @@ static gboolean _xfdashboard_application_initialize_full(XfdashboardApplication
 	priv->searchManager=xfdashboard_search_manager_get_default();
 
 	xfdashboard_search_manager_register(priv->searchManager, "builtin.applications", XFDASHBOARD_TYPE_APPLICATIONS_SEARCH_PROVIDER);
+	xfdashboard_search_manager_register(priv->searchManager, "builtin.windows", XFDASHBOARD_TYPE_WINDOWS_SEARCH_PROVIDER);
 
 	/* Create single-instance of focus manager to keep it alive while
 	 * application is running.
 	 */
 	priv->focusManager=xfdashboard_focus_manager_get_default();
 
+	/* Create single-instance of transition manager to keep it alive while
+	 * application is running and let it follow reduced motion setting.
+	 */
+	priv->transitionManager=xfdashboard_transition_manager_get_default();
+	priv->xfconfReducedMotionBindingID=xfconf_g_property_bind(priv->xfconfChannel,
+																REDUCED_MOTION_XFCONF_PROP,
+																G_TYPE_BOOLEAN,
+																priv->transitionManager,
+																"reduced-motion");
+
 	/* Create single-instance of plugin manager to keep it alive while
 	 * application is running.
 	 */
@@ -580,11 +665,21 @@ static gint _xfdashboard_application_handle_command_line_arguments(XfdashboardAp
 
 	/* Setup command-line options */
 	context=g_option_context_new(N_("- A Gnome Shell like dashboard for Xfce4"));
-	g_option_context_add_group(context, gtk_get_option_group(TRUE));
-	g_option_context_add_group(context, clutter_get_option_group_without_init());
 	g_option_context_add_group(context, xfce_sm_client_get_option_group(inArgc, inArgv));
 	g_option_context_add_main_entries(context, entries, GETTEXT_PACKAGE);
 
+	/* A remote instance does not initialize GTK+ and Clutter as it only sends
+	 * its command-line to primary instance. Adding their option groups would
+	 * initialize them when parsing command-line, so do not add them but keep
+	 * their options untouched for primary instance which handles them.
+	 */
+	if(!g_application_get_is_remote(G_APPLICATION(self)))
+	{
+		g_option_context_add_group(context, gtk_get_option_group(TRUE));
+		g_option_context_add_group(context, clutter_get_option_group_without_init());
+	}
+		else g_option_context_set_ignore_unknown_options(context, TRUE);
+
 #ifdef DEBUG
 	/* I always forget the name of the environment variable to get the debug
 	 * message display which are emitted with g_debug(). So display a hint
@@ -826,6 +921,54 @@ static int _xfdashboard_application_command_line(GApplication *inApplication, GA
 	return(exitStatus);
 }
 
+/* Add data about this instance to platform data sent to primary instance */
+static void _xfdashboard_application_add_platform_data(GApplication *inApplication,
+														GVariantBuilder *inBuilder)
+{
+	const gchar						*startupID;
+
+	g_return_if_fail(XFDASHBOARD_IS_APPLICATION(inApplication));
+
+	/* Call parent's class method */
+	G_APPLICATION_CLASS(xfdashboard_application_parent_class)->add_platform_data(inApplication, inBuilder);
+
+	/* A remote instance does not connect to display so it cannot complete its
+	 * startup notification. Send the startup notification ID to primary
+	 * instance which will complete it. GTK+ removes the ID from environment
+	 * when it completes the startup notification of this instance itself.
+	 */
+	startupID=g_getenv("DESKTOP_STARTUP_ID");
+	if(startupID && g_utf8_validate(startupID, -1, NULL))
+	{
+		g_variant_builder_add(inBuilder, "{sv}", "desktop-startup-id", g_variant_new_string(startupID));
+	}
+}
+
+/* Received platform data from an instance before its request is handled */
+static void _xfdashboard_application_before_emit(GApplication *inApplication,
+													GVariant *inPlatformData)
+{
+	GVariantIter					iter;
+	const gchar						*key;
+	GVariant						*value;
+
+	g_return_if_fail(XFDASHBOARD_IS_APPLICATION(inApplication));
+
+	/* Call parent's class method */
+	G_APPLICATION_CLASS(xfdashboard_application_parent_class)->before_emit(inApplication, inPlatformData);
+
+	/* Complete startup notification of instance which sent its request */
+	g_variant_iter_init(&iter, inPlatformData);
+	while(g_variant_iter_loop(&iter, "{&sv}", &key, &value))
+	{
+		if(g_strcmp0(key, "desktop-startup-id")==0 &&
+			g_variant_is_of_type(value, G_VARIANT_TYPE_STRING))
+		{
+			gdk_notify_startup_complete_with_id(g_variant_get_string(value, NULL));
+		}
+	}
+}
+
 /* Check and handle command-line on local instance regardless if this one
  * is the primary instance or a remote one. This functions checks for arguments
  * which can be handled locally, e.g. '--help'. Otherwise they will be send to
@@ -949,6 +1092,18 @@ static void _xfdashboard_application_dispose(GObject *inObject)
 		priv->searchManager=NULL;
 	}
 
+	if(priv->xfconfReducedMotionBindingID)
+	{
+		xfconf_g_property_unbind(priv->xfconfReducedMotionBindingID);
+		priv->xfconfReducedMotionBindingID=0L;
+	}
+
+	if(priv->transitionManager)
+	{
+		g_object_unref(priv->transitionManager);
+		priv->transitionManager=NULL;
+	}
+
 	if(priv->focusManager)
 	{
 		/* Unregisters all remaining registered focusable actors.
@@ -1086,6 +1241,8 @@ static void xfdashboard_application_class_init(XfdashboardApplicationClass *klas
 	appClass->activate=_xfdashboard_application_activate;
 	appClass->command_line=_xfdashboard_application_command_line;
 	appClass->local_command_line=_xfdashboard_application_local_command_line;
+	appClass->add_platform_data=_xfdashboard_application_add_platform_data;
+	appClass->before_emit=_xfdashboard_application_before_emit;
 
 	gobjectClass->dispose=_xfdashboard_application_dispose;
 	gobjectClass->set_property=_xfdashboard_application_set_property;
@@ -1388,6 +1545,8 @@ static void xfdashboard_application_init(XfdashboardApplication *self)
 	priv->viewManager=NULL;
 	priv->searchManager=NULL;
 	priv->focusManager=NULL;
+	priv->transitionManager=NULL;
+	priv->xfconfReducedMotionBindingID=0L;
 	priv->theme=NULL;
 	priv->xfconfThemeChangedSignalID=0L;
 	priv->isQuitting=FALSE;
@@ -1653,3 +1812,50 @@ XfconfChannel* xfdashboard_application_get_xfconf_channel(XfdashboardApplication
 
 	return(channel);
 }
+
+/**
+ * xfdashboard_application_get_suspend_memory_policy:
+ * @self: A #XfdashboardApplication or %NULL
+ *
+ * Retrieve the policy configured in Xfconf which determines how much memory
+ * objects should release when @self is suspended.
+ *
+ * If @self is %NULL the default singleton is used if it was created.
+ *
+ * Return value: The #XfdashboardSuspendMemoryPolicy to apply at suspension
+ */
+XfdashboardSuspendMemoryPolicy xfdashboard_application_get_suspend_memory_policy(XfdashboardApplication *self)
+{
+	XfdashboardSuspendMemoryPolicy	policy;
+	gchar							*policyName;
+	GEnumClass						*enumClass;
+	GEnumValue						*enumValue;
+
+	g_return_val_if_fail(self==NULL || XFDASHBOARD_IS_APPLICATION(self), DEFAULT_SUSPEND_MEMORY_POLICY);
+
+	policy=DEFAULT_SUSPEND_MEMORY_POLICY;
+
+	/* Get default single instance if NULL is requested */
+	if(!self) self=_xfdashboard_application;
+
+	/* Only an application running in daemon mode can be suspended */
+	if(G_UNLIKELY(!self) || !self->priv->isDaemon) return(policy);
+
+	/* Get configured policy by its nick name */
+	policyName=xfconf_channel_get_string(self->priv->xfconfChannel,
+											SUSPEND_MEMORY_POLICY_XFCONF_PROP,
+											NULL);
+	if(policyName)
+	{
+		enumClass=g_type_class_ref(XFDASHBOARD_TYPE_SUSPEND_MEMORY_POLICY);
+
+		enumValue=g_enum_get_value_by_nick(enumClass, policyName);
+		if(enumValue) policy=enumValue->value;
+			else g_warning(_("Unknown suspend memory policy '%s'"), policyName);
+
+		g_type_class_unref(enumClass);
+		g_free(policyName);
+	}
+
+	return(policy);
+}
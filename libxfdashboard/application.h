@@ -33,6 +33,7 @@
 #include <xfconf/xfconf.h>
 
 #include <libxfdashboard/theme.h>
+#include <libxfdashboard/types.h>
 #include <libxfdashboard/focusable.h>
 #include <libxfdashboard/stage.h>
 
@@ -146,6 +147,8 @@ XfdashboardTheme* xfdashboard_application_get_theme(XfdashboardApplication *self
 
 XfconfChannel* xfdashboard_application_get_xfconf_channel(XfdashboardApplication *self);
 
+XfdashboardSuspendMemoryPolicy xfdashboard_application_get_suspend_memory_policy(XfdashboardApplication *self);
+
 G_END_DECLS
 
 #endif	/* __LIBXFDASHBOARD_APPLICATION__ */
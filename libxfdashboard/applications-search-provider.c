@@ -31,6 +31,7 @@
 #include <glib/gi18n-lib.h>
 #include <gtk/gtk.h>
 #include <errno.h>
+#include <string.h>
 
 #include <libxfdashboard/application-database.h>
 #include <libxfdashboard/application-button.h>
@@ -38,6 +39,8 @@
 #include <libxfdashboard/drag-action.h>
 #include <libxfdashboard/utils.h>
 #include <libxfdashboard/enums.h>
+#include <libxfdashboard/search-query.h>
+#include <libxfdashboard/search-match.h>
 #include <libxfdashboard/compat.h>
 
 
@@ -54,6 +57,7 @@ struct _XfdashboardApplicationsSearchProviderPrivate
 {
 	/* Properties related */
 	XfdashboardApplicationsSearchProviderSortMode	nextSortMode;
+	guint											fuzzyMaxErrors;
 
 	/* Instance related */
 	XfdashboardApplicationDatabase					*appDB;
@@ -62,8 +66,13 @@ struct _XfdashboardApplicationsSearchProviderPrivate
 
 	GList											*allApps;
 
+	gchar											*searchIndexStrings;
+	GArray											*searchIndex;
+	guint											searchIndexStamp;
+
 	XfconfChannel									*xfconfChannel;
 	guint											xfconfSortModeBindingID;
+	guint											xfconfFuzzyMaxErrorsBindingID;
 	XfdashboardApplicationsSearchProviderSortMode	currentSortMode;
 };
 
@@ -73,6 +82,7 @@ enum
 	PROP_0,
 
 	PROP_SORT_MODE,
+	PROP_FUZZY_MAX_ERRORS,
 
 	PROP_LAST
 };
@@ -81,6 +91,12 @@ static GParamSpec* XfdashboardApplicationsSearchProviderProperties[PROP_LAST]={
 
 /* IMPLEMENTATION: Private variables and methods */
 #define SORT_MODE_XFCONF_PROP													"/components/applications-search-provider/sort-mode"
+#define FUZZY_MAX_ERRORS_XFCONF_PROP											"/components/applications-search-provider/fuzzy-max-errors"
+
+#define FUZZY_MAX_ERRORS														XFDASHBOARD_SEARCH_MATCH_FUZZY_MAX_ERRORS
+#define FUZZY_MAX_PATTERN_LENGTH												XFDASHBOARD_SEARCH_QUERY_MAX_MASK_LENGTH
+
+#define SEARCH_JOB_DEADLINE_CHECK_INTERVAL										32
 
 #define DEFAULT_DELIMITERS														"\t\n\r "
 
@@ -113,6 +129,33 @@ struct _XfdashboardApplicationsSearchProviderStatistics
 	guint								usedCounter;
 };
 
+typedef struct _XfdashboardApplicationsSearchProviderIndexEntry		XfdashboardApplicationsSearchProviderIndexEntry;
+struct _XfdashboardApplicationsSearchProviderIndexEntry
+{
+	XfdashboardDesktopAppInfo			*appInfo;
+
+	gssize								titleOffset;
+	gsize								titleLength;
+
+	gssize								descriptionOffset;
+	gsize								descriptionLength;
+
+	gssize								commandOffset;
+	gsize								commandLength;
+};
+
+typedef struct _XfdashboardApplicationsSearchProviderJob			XfdashboardApplicationsSearchProviderJob;
+struct _XfdashboardApplicationsSearchProviderJob
+{
+	XfdashboardSearchQuery				*query;
+
+	XfdashboardSearchResultSet			*previousResultSet;
+	XfdashboardSearchResultSet			*resultSet;
+
+	guint								position;
+	guint								searchIndexStamp;
+};
+
 /* Create, destroy, ref and unref statistics data */
 static XfdashboardApplicationsSearchProviderStatistics* _xfdashboard_applications_search_provider_statistics_new(void)
 {
@@ -660,10 +703,8 @@ static void _xfdashboard_applications_search_provider_create_statistics(Xfdashbo
 	G_UNLOCK(_xfdashboard_applications_search_provider_statistics_lock);
 }
 
-/* An application was added to database */
-static void _xfdashboard_applications_search_provider_on_application_added(XfdashboardApplicationsSearchProvider *self,
-																			GAppInfo *inAppInfo,
-																			gpointer inUserData)
+/* Release search index of all installed applications */
+static void _xfdashboard_applications_search_provider_release_search_index(XfdashboardApplicationsSearchProvider *self)
 {
 	XfdashboardApplicationsSearchProviderPrivate	*priv;
 
@@ -671,37 +712,199 @@ static void _xfdashboard_applications_search_provider_on_application_added(Xfdas
 
 	priv=self->priv;
 
-	/* Release current list of all installed applications */
-	if(priv->allApps)
+	if(priv->searchIndex)
 	{
-		g_list_free_full(priv->allApps, g_object_unref);
-		priv->allApps=NULL;
+		g_array_free(priv->searchIndex, TRUE);
+		priv->searchIndex=NULL;
 	}
 
-	/* Get new list of all installed applications */
-	priv->allApps=xfdashboard_application_database_get_all_applications(priv->appDB);
+	if(priv->searchIndexStrings)
+	{
+		g_free(priv->searchIndexStrings);
+		priv->searchIndexStrings=NULL;
+	}
+
+	/* Tell running search jobs that their position in search index is invalid */
+	priv->searchIndexStamp++;
 }
 
-/* An application was removed to database */
-static void _xfdashboard_applications_search_provider_on_application_removed(XfdashboardApplicationsSearchProvider *self,
-																				GAppInfo *inAppInfo,
+/* An application has changed so search index is outdated */
+static void _xfdashboard_applications_search_provider_on_application_changed(XfdashboardApplicationsSearchProvider *self,
 																				gpointer inUserData)
+{
+	g_return_if_fail(XFDASHBOARD_IS_APPLICATIONS_SEARCH_PROVIDER(self));
+
+	_xfdashboard_applications_search_provider_release_search_index(self);
+}
+
+/* Release list of all installed applications and its search index */
+static void _xfdashboard_applications_search_provider_release_applications(XfdashboardApplicationsSearchProvider *self)
 {
 	XfdashboardApplicationsSearchProviderPrivate	*priv;
+	GList											*iter;
 
 	g_return_if_fail(XFDASHBOARD_IS_APPLICATIONS_SEARCH_PROVIDER(self));
 
 	priv=self->priv;
 
-	/* Release current list of all installed applications */
+	_xfdashboard_applications_search_provider_release_search_index(self);
+
 	if(priv->allApps)
 	{
+		for(iter=priv->allApps; iter; iter=g_list_next(iter))
+		{
+			g_signal_handlers_disconnect_by_func(iter->data,
+													G_CALLBACK(_xfdashboard_applications_search_provider_on_application_changed),
+													self);
+		}
+
 		g_list_free_full(priv->allApps, g_object_unref);
 		priv->allApps=NULL;
 	}
+}
+
+/* Get number of errors allowed for fuzzy matching of search term. Short search
+ * terms allow fewer errors as they would match nearly everything otherwise.
+ */
+static guint _xfdashboard_applications_search_provider_get_fuzzy_errors(XfdashboardApplicationsSearchProvider *self,
+																			gsize inSearchTermLength)
+{
+	XfdashboardApplicationsSearchProviderPrivate	*priv;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_APPLICATIONS_SEARCH_PROVIDER(self), 0);
+
+	priv=self->priv;
+
+	if(inSearchTermLength>FUZZY_MAX_PATTERN_LENGTH) return(0);
+	return(MIN(priv->fuzzyMaxErrors, inSearchTermLength/3));
+}
+
+/* Get list of all installed applications and get notified about changes */
+static void _xfdashboard_applications_search_provider_load_applications(XfdashboardApplicationsSearchProvider *self)
+{
+	XfdashboardApplicationsSearchProviderPrivate	*priv;
+	GList											*iter;
+
+	g_return_if_fail(XFDASHBOARD_IS_APPLICATIONS_SEARCH_PROVIDER(self));
+
+	priv=self->priv;
 
-	/* Get new list of all installed applications */
 	priv->allApps=xfdashboard_application_database_get_all_applications(priv->appDB);
+	for(iter=priv->allApps; iter; iter=g_list_next(iter))
+	{
+		g_signal_connect_swapped(iter->data,
+									"changed",
+									G_CALLBACK(_xfdashboard_applications_search_provider_on_application_changed),
+									self);
+	}
+}
+
+/* Append string to search index string buffer and remember its position */
+static void _xfdashboard_applications_search_provider_add_search_index_string(GString *ioStrings,
+																				const gchar *inValue,
+																				gssize *outOffset,
+																				gsize *outLength)
+{
+	g_return_if_fail(ioStrings);
+	g_return_if_fail(outOffset);
+	g_return_if_fail(outLength);
+
+	if(!inValue)
+	{
+		*outOffset=-1;
+		*outLength=0;
+		return;
+	}
+
+	*outOffset=ioStrings->len;
+	*outLength=strlen(inValue);
+	g_string_append_len(ioStrings, inValue, *outLength+1);
+}
+
+/* Build search index of all installed applications. All searchable strings
+ * (title and description normalized like search terms of a query and the
+ * command) are packed into one contiguous string buffer referenced by offsets
+ * so matching all applications can be done in one pass without calling any
+ * getter of app infos or normalizing strings again.
+ */
+static void _xfdashboard_applications_search_provider_create_search_index(XfdashboardApplicationsSearchProvider *self)
+{
+	XfdashboardApplicationsSearchProviderPrivate	*priv;
+	GString											*strings;
+	GList											*iter;
+	XfdashboardApplicationsSearchProviderIndexEntry	entry;
+	const gchar										*value;
+	gchar											*lowerValue;
+
+	g_return_if_fail(XFDASHBOARD_IS_APPLICATIONS_SEARCH_PROVIDER(self));
+
+	priv=self->priv;
+
+	/* Do nothing if search index is still valid */
+	if(priv->searchIndex) return;
+
+	strings=g_string_new(NULL);
+	priv->searchIndex=g_array_sized_new(FALSE, FALSE, sizeof(XfdashboardApplicationsSearchProviderIndexEntry), g_list_length(priv->allApps));
+
+	for(iter=priv->allApps; iter; iter=g_list_next(iter))
+	{
+		entry.appInfo=XFDASHBOARD_DESKTOP_APP_INFO(iter->data);
+
+		/* Skip hidden desktop app infos */
+		if(xfdashboard_desktop_app_info_get_hidden(entry.appInfo) ||
+			xfdashboard_desktop_app_info_get_nodisplay(entry.appInfo))
+		{
+			continue;
+		}
+
+		value=g_app_info_get_display_name(G_APP_INFO(entry.appInfo));
+		lowerValue=(value ? xfdashboard_search_query_normalize_string(value) : NULL);
+		_xfdashboard_applications_search_provider_add_search_index_string(strings, lowerValue, &entry.titleOffset, &entry.titleLength);
+		g_free(lowerValue);
+
+		value=g_app_info_get_description(G_APP_INFO(entry.appInfo));
+		lowerValue=(value ? xfdashboard_search_query_normalize_string(value) : NULL);
+		_xfdashboard_applications_search_provider_add_search_index_string(strings, lowerValue, &entry.descriptionOffset, &entry.descriptionLength);
+		g_free(lowerValue);
+
+		value=g_app_info_get_executable(G_APP_INFO(entry.appInfo));
+		_xfdashboard_applications_search_provider_add_search_index_string(strings, value, &entry.commandOffset, &entry.commandLength);
+
+		g_array_append_val(priv->searchIndex, entry);
+	}
+
+	/* Take string buffer */
+	priv->searchIndexStrings=g_string_free(strings, FALSE);
+
+	g_debug("Created search index for %u applications", priv->searchIndex->len);
+}
+
+/* An application was added to database */
+static void _xfdashboard_applications_search_provider_on_application_added(XfdashboardApplicationsSearchProvider *self,
+																			GAppInfo *inAppInfo,
+																			gpointer inUserData)
+{
+	g_return_if_fail(XFDASHBOARD_IS_APPLICATIONS_SEARCH_PROVIDER(self));
+
+	/* Release current list of all installed applications and search index
+	 * and get new list. Search index will be rebuilt at next search.
+	 */
+	_xfdashboard_applications_search_provider_release_applications(self);
+	_xfdashboard_applications_search_provider_load_applications(self);
+}
+
+/* An application was removed to database */
+static void _xfdashboard_applications_search_provider_on_application_removed(XfdashboardApplicationsSearchProvider *self,
+																				GAppInfo *inAppInfo,
+																				gpointer inUserData)
+{
+	g_return_if_fail(XFDASHBOARD_IS_APPLICATIONS_SEARCH_PROVIDER(self));
+
+	/* Release current list of all installed applications and search index
+	 * and get new list. Search index will be rebuilt at next search.
+	 */
+	_xfdashboard_applications_search_provider_release_applications(self);
+	_xfdashboard_applications_search_provider_load_applications(self);
 }
 
 /* Drag of an menu item begins */
@@ -762,35 +965,37 @@ static void _xfdashboard_applications_search_provider_on_drag_end(ClutterDragAct
 	}
 }
 
-/* Check if given app info matches search terms and return score as fraction
- * between 0.0and 1.0 - so called "relevance". A negative score means that
- * the given app info does not match at all.
+/* Check if given entry of search index matches search terms and return score
+ * as fraction between 0.0and 1.0 - so called "relevance". A negative score
+ * means that the given entry does not match at all.
  */
 static gfloat _xfdashboard_applications_search_provider_score(XfdashboardApplicationsSearchProvider *self,
-																gchar **inSearchTerms,
-																GAppInfo *inAppInfo)
+																XfdashboardSearchQuery *inQuery,
+																const XfdashboardApplicationsSearchProviderIndexEntry *inEntry)
 {
 	XfdashboardApplicationsSearchProviderPrivate		*priv;
-	gchar												*title;
-	gchar												*description;
+	const gchar											**searchTerms;
+	const gchar											*title;
+	const gchar											*description;
 	const gchar											*command;
-	const gchar											*value;
 	gint												matchesFound, matchesExpected;
 	gfloat												pointsSearch;
 	gfloat												score;
+	guint												i;
 
 	g_return_val_if_fail(XFDASHBOARD_IS_APPLICATIONS_SEARCH_PROVIDER(self), -1.0f);
-	g_return_val_if_fail(G_IS_APP_INFO(inAppInfo), -1.0f);
+	g_return_val_if_fail(XFDASHBOARD_IS_SEARCH_QUERY(inQuery), -1.0f);
+	g_return_val_if_fail(inEntry, -1.0f);
 
 	priv=self->priv;
 	score=-1.0f;
 
 	/* Empty search term matches no menu item */
-	if(!inSearchTerms) return(0.0f);
-
-	matchesExpected=g_strv_length(inSearchTerms);
+	matchesExpected=xfdashboard_search_query_get_terms_count(inQuery);
 	if(matchesExpected==0) return(0.0f);
 
+	searchTerms=xfdashboard_search_query_get_normalized_terms(inQuery);
+
 	/* Calculate the highest score points possible which is the highest
 	 * launch count among all applications, display name matches all search terms,
 	 * description matches all search terms and also the command matches all
@@ -807,38 +1012,51 @@ static gfloat _xfdashboard_applications_search_provider_score(XfdashboardApplica
 	 * which is also the result score when *not* taking the launch count of
 	 * application into account.
 	 */
-	value=g_app_info_get_display_name(inAppInfo);
-	if(value) title=g_utf8_strdown(value, -1);
-		else title=NULL;
-
-	value=g_app_info_get_description(inAppInfo);
-	if(value) description=g_utf8_strdown(value, -1);
-		else description=NULL;
-
-	command=g_app_info_get_executable(inAppInfo);
+	title=(inEntry->titleOffset>=0 ? priv->searchIndexStrings+inEntry->titleOffset : NULL);
+	description=(inEntry->descriptionOffset>=0 ? priv->searchIndexStrings+inEntry->descriptionOffset : NULL);
+	command=(inEntry->commandOffset>=0 ? priv->searchIndexStrings+inEntry->commandOffset : NULL);
 
 	matchesFound=0;
 	pointsSearch=0.0f;
-	while(*inSearchTerms)
+	for(i=0; searchTerms[i]; i++)
 	{
 		gboolean						termMatch;
-		gchar							*commandPos;
+		const gchar						*commandPos;
 		gfloat							pointsTerm;
+		gsize							termLength;
+		const guint64					*termMask;
+		guint							fuzzyErrors;
+		gint							errors;
 
 		/* Reset "found" indicator and score of current search term */
 		termMatch=FALSE;
 		pointsTerm=0.0f;
+		termLength=xfdashboard_search_query_get_normalized_term_length(inQuery, i);
+		termMask=xfdashboard_search_query_get_normalized_term_mask(inQuery, i);
+		fuzzyErrors=_xfdashboard_applications_search_provider_get_fuzzy_errors(self, termLength);
 
 		/* Check for current search term */
 		if(title &&
-			g_strstr_len(title, -1, *inSearchTerms))
+			_xfdashboard_search_match_find(title, inEntry->titleLength, searchTerms[i], termLength))
 		{
 			pointsTerm+=0.4;
 			termMatch=TRUE;
 		}
+			else if(title && fuzzyErrors>0)
+			{
+				/* Title did not match exactly so try an approximate match
+				 * but weight it less the more errors were needed.
+				 */
+				errors=_xfdashboard_search_match_fuzzy_find(title, inEntry->titleLength, termMask, termLength, fuzzyErrors);
+				if(errors>0)
+				{
+					pointsTerm+=0.4*(termLength-errors)/termLength;
+					termMatch=TRUE;
+				}
+			}
 
 		if(description &&
-			g_strstr_len(description, -1, *inSearchTerms))
+			_xfdashboard_search_match_find(description, inEntry->descriptionLength, searchTerms[i], termLength))
 		{
 			pointsTerm+=0.2;
 			termMatch=TRUE;
@@ -846,13 +1064,22 @@ static gfloat _xfdashboard_applications_search_provider_score(XfdashboardApplica
 
 		if(command)
 		{
-			commandPos=g_strstr_len(command, -1, *inSearchTerms);
+			commandPos=_xfdashboard_search_match_find(command, inEntry->commandLength, searchTerms[i], termLength);
 			if(commandPos &&
 				(commandPos==command || *(commandPos-1)==G_DIR_SEPARATOR))
 			{
 				pointsTerm+=0.4;
 				termMatch=TRUE;
 			}
+				else if(fuzzyErrors>0)
+				{
+					errors=_xfdashboard_search_match_fuzzy_find(command, inEntry->commandLength, termMask, termLength, fuzzyErrors);
+					if(errors>0)
+					{
+						pointsTerm+=0.4*(termLength-errors)/termLength;
+						termMatch=TRUE;
+					}
+				}
 		}
 
 		/* Increase match counter if we found a match */
@@ -861,9 +1088,6 @@ static gfloat _xfdashboard_applications_search_provider_score(XfdashboardApplica
 			matchesFound++;
 			pointsSearch+=pointsTerm;
 		}
-
-		/* Continue with next search term */
-		inSearchTerms++;
 	}
 
 	/* If we got a match in either title, description or command for each search term
@@ -896,7 +1120,7 @@ static gfloat _xfdashboard_applications_search_provider_score(XfdashboardApplica
 		{
 			maxPoints+=(_xfdashboard_applications_search_provider_statistics.maxUsedCounter*1.0f);
 
-			stats=_xfdashboard_applications_search_provider_statistics_get(g_app_info_get_id(inAppInfo));
+			stats=_xfdashboard_applications_search_provider_statistics_get(g_app_info_get_id(G_APP_INFO(inEntry->appInfo)));
 			if(stats) currentPoints+=(stats->usedCounter*1.0f);
 		}
 
@@ -907,10 +1131,6 @@ static gfloat _xfdashboard_applications_search_provider_score(XfdashboardApplica
 			else score=1.0f;
 	}
 
-	/* Release allocated resources */
-	if(description) g_free(description);
-	if(title) g_free(title);
-
 	/* Return score of this application for requested search terms */
 	return(score);
 }
@@ -992,22 +1212,18 @@ static const gchar* _xfdashboard_applications_search_provider_get_icon(Xfdashboa
 	return("go-home");
 }
 
-/* Get result set for requested search terms */
-static XfdashboardSearchResultSet* _xfdashboard_applications_search_provider_get_result_set(XfdashboardSearchProvider *inProvider,
-																							const gchar **inSearchTerms,
-																							XfdashboardSearchResultSet *inPreviousResultSet)
+/* Begin search job for requested search query */
+static gpointer _xfdashboard_applications_search_provider_begin_search_job(XfdashboardSearchProvider *inProvider,
+																			XfdashboardSearchQuery *inQuery,
+																			XfdashboardSearchResultSet *inPreviousResultSet,
+																			XfdashboardSearchResultSet *inResultSet)
 {
 	XfdashboardApplicationsSearchProvider				*self;
 	XfdashboardApplicationsSearchProviderPrivate		*priv;
-	XfdashboardSearchResultSet							*resultSet;
-	GList												*iter;
-	guint												numberTerms;
-	gchar												**terms, **termsIter;
-	GVariant											*resultItem;
-	XfdashboardDesktopAppInfo							*appInfo;
-	gfloat												score;
+	XfdashboardApplicationsSearchProviderJob			*job;
 
 	g_return_val_if_fail(XFDASHBOARD_IS_APPLICATIONS_SEARCH_PROVIDER(inProvider), NULL);
+	g_return_val_if_fail(XFDASHBOARD_IS_SEARCH_QUERY(inQuery), NULL);
 
 	self=XFDASHBOARD_APPLICATIONS_SEARCH_PROVIDER(inProvider);
 	priv=self->priv;
@@ -1015,97 +1231,131 @@ static XfdashboardSearchResultSet* _xfdashboard_applications_search_provider_get
 	/* Set new match mode */
 	priv->currentSortMode=priv->nextSortMode;
 
-	/* To perform case-insensitive searches through model convert all search terms
-	 * to lower-case before starting search.
-	 * Remember that string list must be NULL terminated.
+	/* If no search term is given, there is nothing to search for */
+	if(xfdashboard_search_query_get_terms_count(inQuery)==0) return(NULL);
+
+	/* Create job. The query provides search terms already normalized for
+	 * case-insensitive matching against search index.
 	 */
-	numberTerms=g_strv_length((gchar**)inSearchTerms);
-	if(numberTerms==0)
-	{
-		/* If we get here no search term is given, return no result set */
-		return(NULL);
-	}
+	job=g_new0(XfdashboardApplicationsSearchProviderJob, 1);
+	job->query=g_object_ref(inQuery);
 
-	terms=g_new(gchar*, numberTerms+1);
-	if(!terms)
-	{
-		g_critical(_("Could not allocate memory to copy search criterias for case-insensitive search"));
-		return(NULL);
-	}
+	/* An extended search term may match approximately even if the previous one
+	 * did not, so do not limit result to previous result set when matching fuzzy.
+	 */
+	if(inPreviousResultSet && priv->fuzzyMaxErrors==0) job->previousResultSet=g_object_ref(inPreviousResultSet);
+	job->resultSet=g_object_ref(inResultSet);
 
-	termsIter=terms;
-	while(*inSearchTerms)
-	{
-		*termsIter=g_utf8_strdown(*inSearchTerms, -1);
+	/* Make sure search index of all applications is available. Hidden desktop
+	 * app infos are not part of search index.
+	 */
+	_xfdashboard_applications_search_provider_create_search_index(self);
+	job->position=0;
+	job->searchIndexStamp=priv->searchIndexStamp;
 
-		/* Move to next entry where to store lower-case and
-		 * initialize with NULL for NULL termination of list.
-		 */
-		termsIter++;
-		*termsIter=NULL;
+	/* Sort result set */
+	xfdashboard_search_result_set_set_sort_func_full(job->resultSet,
+														_xfdashboard_applications_search_provider_sort_result_set,
+														g_object_ref(self),
+														g_object_unref);
 
-		/* Move to next search term to convert to lower-case */
-		inSearchTerms++;
-	}
+	/* Return new job */
+	return(job);
+}
+
+/* Run search job until all entries in search index were checked or deadline
+ * is reached.
+ */
+static gboolean _xfdashboard_applications_search_provider_run_search_job(XfdashboardSearchProvider *inProvider,
+																			gpointer inJob,
+																			gint64 inDeadline)
+{
+	XfdashboardApplicationsSearchProvider				*self;
+	XfdashboardApplicationsSearchProviderPrivate		*priv;
+	XfdashboardApplicationsSearchProviderJob			*job;
+	GVariant											*resultItem;
+	XfdashboardApplicationsSearchProviderIndexEntry		*entry;
+	guint												i;
+	gfloat												score;
 
-	/* Create empty result set to store matching result items */
-	resultSet=xfdashboard_search_result_set_new();
+	g_return_val_if_fail(XFDASHBOARD_IS_APPLICATIONS_SEARCH_PROVIDER(inProvider), FALSE);
+	g_return_val_if_fail(inJob, FALSE);
 
-	/* Perform search */
-	for(iter=priv->allApps; iter; iter=g_list_next(iter))
+	self=XFDASHBOARD_APPLICATIONS_SEARCH_PROVIDER(inProvider);
+	priv=self->priv;
+	job=(XfdashboardApplicationsSearchProviderJob*)inJob;
+
+	/* If search index was rebuilt since last run of this job, the position
+	 * in search index is invalid, so restart at beginning. Result items
+	 * already found are kept in result set.
+	 */
+	_xfdashboard_applications_search_provider_create_search_index(self);
+	if(job->searchIndexStamp!=priv->searchIndexStamp)
 	{
-		/* Get app info to check for match */
-		appInfo=XFDASHBOARD_DESKTOP_APP_INFO(iter->data);
+		job->position=0;
+		job->searchIndexStamp=priv->searchIndexStamp;
+	}
 
-		/* If desktop app info should be hidden then continue with next one */
-		if(xfdashboard_desktop_app_info_get_hidden(appInfo) ||
-			xfdashboard_desktop_app_info_get_nodisplay(appInfo))
+	/* Perform search */
+	for(i=job->position; i<priv->searchIndex->len; i++)
+	{
+		/* Check from time to time if deadline was reached but make sure
+		 * the job progresses at each run.
+		 */
+		if(i>job->position &&
+			((i-job->position) % SEARCH_JOB_DEADLINE_CHECK_INTERVAL)==0 &&
+			g_get_monotonic_time()>=inDeadline)
 		{
-			continue;
+			break;
 		}
 
+		/* Get entry of search index to check for match */
+		entry=&g_array_index(priv->searchIndex, XfdashboardApplicationsSearchProviderIndexEntry, i);
+
+		/* Check for a match against search terms */
+		score=_xfdashboard_applications_search_provider_score(self, job->query, entry);
+		if(score<0.0f) continue;
+
 		/* Get result item */
-		resultItem=g_variant_new_string(g_app_info_get_id(G_APP_INFO(appInfo)));
+		resultItem=g_variant_new_string(g_app_info_get_id(G_APP_INFO(entry->appInfo)));
 
-		/* Check if current app info is in previous result set and should be checked
-		 * if a previous result set is provided.
+		/* Only add result item if there is no previous result set or if
+		 * it is in previous result set and if it was not added before.
 		 */
-		if(!inPreviousResultSet ||
-			xfdashboard_search_result_set_has_item(inPreviousResultSet, resultItem))
+		if((!job->previousResultSet || xfdashboard_search_result_set_has_item(job->previousResultSet, resultItem)) &&
+			!xfdashboard_search_result_set_has_item(job->resultSet, resultItem))
 		{
-			/* Check for a match against search terms */
-			score=_xfdashboard_applications_search_provider_score(self, terms, G_APP_INFO(appInfo));
-			if(score>=0.0f)
-			{
-				xfdashboard_search_result_set_add_item(resultSet, g_variant_ref(resultItem));
-				xfdashboard_search_result_set_set_item_score(resultSet, resultItem, score);
-			}
+			xfdashboard_search_result_set_add_item(job->resultSet, g_variant_ref(resultItem));
+			xfdashboard_search_result_set_set_item_score(job->resultSet, resultItem, score);
 		}
 
 		/* Release allocated resources */
 		g_variant_unref(resultItem);
 	}
 
-	/* Sort result set */
-	xfdashboard_search_result_set_set_sort_func_full(resultSet,
-														_xfdashboard_applications_search_provider_sort_result_set,
-														g_object_ref(self),
-														g_object_unref);
+	/* Remember position to continue at next run. The job is finished if all
+	 * entries in search index were checked.
+	 */
+	job->position=i;
+	return(i<priv->searchIndex->len);
+}
 
-	/* Release allocated resources */
-	if(terms)
-	{
-		termsIter=terms;
-		while(*termsIter)
-		{
-			g_free(*termsIter);
-			termsIter++;
-		}
-		g_free(terms);
-	}
+/* End search job and release its resources */
+static void _xfdashboard_applications_search_provider_end_search_job(XfdashboardSearchProvider *inProvider,
+																		gpointer inJob)
+{
+	XfdashboardApplicationsSearchProviderJob			*job;
+
+	g_return_if_fail(XFDASHBOARD_IS_APPLICATIONS_SEARCH_PROVIDER(inProvider));
+	g_return_if_fail(inJob);
 
-	/* Return result set */
-	return(resultSet);
+	job=(XfdashboardApplicationsSearchProviderJob*)inJob;
+
+	/* Release allocated resources */
+	if(job->resultSet) g_object_unref(job->resultSet);
+	if(job->previousResultSet) g_object_unref(job->previousResultSet);
+	if(job->query) g_object_unref(job->query);
+	g_free(job);
 }
 
 /* Create actor for a result item of the result set returned from a search request */
@@ -1196,11 +1446,7 @@ static void _xfdashboard_applications_search_provider_dispose(GObject *inObject)
 		priv->appDB=NULL;
 	}
 
-	if(priv->allApps)
-	{
-		g_list_free_full(priv->allApps, g_object_unref);
-		priv->allApps=NULL;
-	}
+	_xfdashboard_applications_search_provider_release_applications(self);
 
 	if(priv->xfconfSortModeBindingID)
 	{
@@ -1208,6 +1454,12 @@ static void _xfdashboard_applications_search_provider_dispose(GObject *inObject)
 		priv->xfconfSortModeBindingID=0;
 	}
 
+	if(priv->xfconfFuzzyMaxErrorsBindingID)
+	{
+		xfconf_g_property_unbind(priv->xfconfFuzzyMaxErrorsBindingID);
+		priv->xfconfFuzzyMaxErrorsBindingID=0;
+	}
+
 	if(priv->xfconfChannel)
 	{
 		priv->xfconfChannel=NULL;
@@ -1231,6 +1483,10 @@ static void _xfdashboard_applications_search_provider_set_property(GObject *inOb
 			xfdashboard_applications_search_provider_set_sort_mode(self, g_value_get_flags(inValue));
 			break;
 
+		case PROP_FUZZY_MAX_ERRORS:
+			xfdashboard_applications_search_provider_set_fuzzy_max_errors(self, g_value_get_uint(inValue));
+			break;
+
 		default:
 			G_OBJECT_WARN_INVALID_PROPERTY_ID(inObject, inPropID, inSpec);
 			break;
@@ -1251,6 +1507,10 @@ static void _xfdashboard_applications_search_provider_get_property(GObject *inOb
 			g_value_set_flags(outValue, priv->nextSortMode);
 			break;
 
+		case PROP_FUZZY_MAX_ERRORS:
+			g_value_set_uint(outValue, priv->fuzzyMaxErrors);
+			break;
+
 		default:
 			G_OBJECT_WARN_INVALID_PROPERTY_ID(inObject, inPropID, inSpec);
 			break;
@@ -1274,7 +1534,9 @@ static void xfdashboard_applications_search_provider_class_init(XfdashboardAppli
 	providerClass->initialize=_xfdashboard_applications_search_provider_initialize;
 	providerClass->get_name=_xfdashboard_applications_search_provider_get_name;
 	providerClass->get_icon=_xfdashboard_applications_search_provider_get_icon;
-	providerClass->get_result_set=_xfdashboard_applications_search_provider_get_result_set;
+	providerClass->begin_search_job=_xfdashboard_applications_search_provider_begin_search_job;
+	providerClass->run_search_job=_xfdashboard_applications_search_provider_run_search_job;
+	providerClass->end_search_job=_xfdashboard_applications_search_provider_end_search_job;
 	providerClass->create_result_actor=_xfdashboard_applications_search_provider_create_result_actor;
 	providerClass->activate_result=_xfdashboard_applications_search_provider_activate_result;
 
@@ -1290,6 +1552,14 @@ static void xfdashboard_applications_search_provider_class_init(XfdashboardAppli
 							XFDASHBOARD_APPLICATIONS_SEARCH_PROVIDER_SORT_MODE_NONE,
 							G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
 
+	XfdashboardApplicationsSearchProviderProperties[PROP_FUZZY_MAX_ERRORS]=
+		g_param_spec_uint("fuzzy-max-errors",
+							_("Fuzzy maximum errors"),
+							_("Maximum number of typing errors allowed in a search term to match an application approximately. Zero disables fuzzy matching."),
+							0, FUZZY_MAX_ERRORS,
+							0,
+							G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
 	g_object_class_install_properties(gobjectClass, PROP_LAST, XfdashboardApplicationsSearchProviderProperties);
 }
 
@@ -1306,6 +1576,7 @@ static void xfdashboard_applications_search_provider_init(XfdashboardApplication
 	priv->xfconfChannel=xfdashboard_application_get_xfconf_channel(NULL);
 	priv->currentSortMode=XFDASHBOARD_APPLICATIONS_SEARCH_PROVIDER_SORT_MODE_NONE;
 	priv->nextSortMode=XFDASHBOARD_APPLICATIONS_SEARCH_PROVIDER_SORT_MODE_NONE;
+	priv->fuzzyMaxErrors=0;
 
 	/* Get application database */
 	priv->appDB=xfdashboard_application_database_get_default();
@@ -1319,7 +1590,10 @@ static void xfdashboard_applications_search_provider_init(XfdashboardApplication
 														self);
 
 	/* Get list of all installed applications */
-	priv->allApps=xfdashboard_application_database_get_all_applications(priv->appDB);
+	priv->searchIndexStrings=NULL;
+	priv->searchIndex=NULL;
+	priv->searchIndexStamp=0;
+	_xfdashboard_applications_search_provider_load_applications(self);
 
 	/* Bind to xfconf to react on changes */
 	priv->xfconfSortModeBindingID=
@@ -1328,6 +1602,13 @@ static void xfdashboard_applications_search_provider_init(XfdashboardApplication
 								G_TYPE_UINT,
 								self,
 								"sort-mode");
+
+	priv->xfconfFuzzyMaxErrorsBindingID=
+		xfconf_g_property_bind(priv->xfconfChannel,
+								FUZZY_MAX_ERRORS_XFCONF_PROP,
+								G_TYPE_UINT,
+								self,
+								"fuzzy-max-errors");
 }
 
 /* IMPLEMENTATION: Public API */
@@ -1358,3 +1639,31 @@ void xfdashboard_applications_search_provider_set_sort_mode(XfdashboardApplicati
 		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardApplicationsSearchProviderProperties[PROP_SORT_MODE]);
 	}
 }
+
+/* Get/set maximum number of errors for fuzzy matching */
+guint xfdashboard_applications_search_provider_get_fuzzy_max_errors(XfdashboardApplicationsSearchProvider *self)
+{
+	g_return_val_if_fail(XFDASHBOARD_IS_APPLICATIONS_SEARCH_PROVIDER(self), 0);
+
+	return(self->priv->fuzzyMaxErrors);
+}
+
+void xfdashboard_applications_search_provider_set_fuzzy_max_errors(XfdashboardApplicationsSearchProvider *self, guint inMaxErrors)
+{
+	XfdashboardApplicationsSearchProviderPrivate	*priv;
+
+	g_return_if_fail(XFDASHBOARD_IS_APPLICATIONS_SEARCH_PROVIDER(self));
+	g_return_if_fail(inMaxErrors<=FUZZY_MAX_ERRORS);
+
+	priv=self->priv;
+
+	/* Set value if changed */
+	if(priv->fuzzyMaxErrors!=inMaxErrors)
+	{
+		/* Set value */
+		priv->fuzzyMaxErrors=inMaxErrors;
+
+		/* Notify about property change */
+		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardApplicationsSearchProviderProperties[PROP_FUZZY_MAX_ERRORS]);
+	}
+}
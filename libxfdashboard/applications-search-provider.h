@@ -82,6 +82,9 @@ GType xfdashboard_applications_search_provider_get_type(void) G_GNUC_CONST;
 XfdashboardApplicationsSearchProviderSortMode xfdashboard_applications_search_provider_get_sort_mode(XfdashboardApplicationsSearchProvider *self);
 void xfdashboard_applications_search_provider_set_sort_mode(XfdashboardApplicationsSearchProvider *self, const XfdashboardApplicationsSearchProviderSortMode inMode);
 
+guint xfdashboard_applications_search_provider_get_fuzzy_max_errors(XfdashboardApplicationsSearchProvider *self);
+void xfdashboard_applications_search_provider_set_fuzzy_max_errors(XfdashboardApplicationsSearchProvider *self, guint inMaxErrors);
+
 G_END_DECLS
 
 #endif	/* __LIBXFDASHBOARD_APPLICATIONS_SEARCH_PROVIDER__ */
@@ -658,6 +658,28 @@ static void _xfdashboard_applications_view_on_model_loaded(XfdashboardApplicatio
 	xfdashboard_applications_menu_model_filter_by_section(priv->apps, GARCON_MENU(priv->currentRootMenuElement));
 }
 
+/* The application will be suspended */
+static void _xfdashboard_applications_view_on_application_suspend(XfdashboardApplicationsView *self, gpointer inUserData)
+{
+	XfdashboardApplicationsViewPrivate	*priv;
+
+	g_return_if_fail(XFDASHBOARD_IS_APPLICATIONS_VIEW(self));
+	g_return_if_fail(XFDASHBOARD_IS_APPLICATION(inUserData));
+
+	priv=self->priv;
+
+	/* The view will be rebuilt from top-level entry when application is
+	 * resumed, so its actors can be destroyed now if requested to release
+	 * memory while suspended.
+	 */
+	if(xfdashboard_application_get_suspend_memory_policy(XFDASHBOARD_APPLICATION(inUserData))>=XFDASHBOARD_SUSPEND_MEMORY_POLICY_VIEWS)
+	{
+		xfdashboard_focusable_set_selection(XFDASHBOARD_FOCUSABLE(self), NULL);
+		clutter_actor_destroy_all_children(CLUTTER_ACTOR(self));
+		clutter_layout_manager_layout_changed(priv->layout);
+	}
+}
+
 /* The application will be resumed */
 static void _xfdashboard_applications_view_on_application_resume(XfdashboardApplicationsView *self, gpointer inUserData)
 {
@@ -1443,6 +1465,7 @@ static void xfdashboard_applications_view_init(XfdashboardApplicationsView *self
 
 	/* Connect signal to application */
 	application=xfdashboard_application_get_default();
+	g_signal_connect_swapped(application, "suspend", G_CALLBACK(_xfdashboard_applications_view_on_application_suspend), self);
 	g_signal_connect_swapped(application, "resume", G_CALLBACK(_xfdashboard_applications_view_on_application_resume), self);
 
 	/* Bind to xfconf to react on changes */
@@ -602,7 +602,7 @@ void xfdashboard_background_set_background_type(XfdashboardBackground *self, con
 		priv->type=inType;
 
 		/* Force redraw of background canvas */
-		if(priv->fillCanvas) clutter_content_invalidate(priv->fillCanvas);
+		if(priv->fillCanvas) xfdashboard_actor_invalidate_content(XFDASHBOARD_ACTOR(self), priv->fillCanvas);
 
 		/* Enable or disable drawing outline */
 		if(priv->outline)
@@ -664,7 +664,7 @@ void xfdashboard_background_set_fill_color(XfdashboardBackground *self, const Cl
 		priv->fillColor=clutter_color_copy(inColor);
 
 		/* Invalidate canvas to get it redrawn */
-		if(priv->fillCanvas) clutter_content_invalidate(priv->fillCanvas);
+		if(priv->fillCanvas) xfdashboard_actor_invalidate_content(XFDASHBOARD_ACTOR(self), priv->fillCanvas);
 
 		/* Notify about property change */
 		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardBackgroundProperties[PROP_FILL_COLOR]);
@@ -694,7 +694,7 @@ void xfdashboard_background_set_fill_corners(XfdashboardBackground *self, Xfdash
 		priv->fillCorners=inCorners;
 
 		/* Invalidate canvas to get it redrawn */
-		if(priv->fillCanvas) clutter_content_invalidate(priv->fillCanvas);
+		if(priv->fillCanvas) xfdashboard_actor_invalidate_content(XFDASHBOARD_ACTOR(self), priv->fillCanvas);
 
 		/* Notify about property change */
 		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardBackgroundProperties[PROP_FILL_CORNERS]);
@@ -725,7 +725,7 @@ void xfdashboard_background_set_fill_corner_radius(XfdashboardBackground *self,
 		priv->fillCornersRadius=inRadius;
 
 		/* Invalidate canvas to get it redrawn */
-		if(priv->fillCanvas) clutter_content_invalidate(priv->fillCanvas);
+		if(priv->fillCanvas) xfdashboard_actor_invalidate_content(XFDASHBOARD_ACTOR(self), priv->fillCanvas);
 
 		/* Notify about property change */
 		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardBackgroundProperties[PROP_FILL_CORNERS_RADIUS]);
@@ -916,7 +916,7 @@ void xfdashboard_background_set_image(XfdashboardBackground *self, ClutterImage
 		if(inImage) priv->image=CLUTTER_IMAGE(g_object_ref(inImage));
 
 		/* Invalidate canvas to get it redrawn */
-		if(priv->image) clutter_content_invalidate(CLUTTER_CONTENT(priv->image));
+		if(priv->image) xfdashboard_actor_invalidate_content(XFDASHBOARD_ACTOR(self), CLUTTER_CONTENT(priv->image));
 
 		/* Notify about property change */
 		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardBackgroundProperties[PROP_IMAGE]);
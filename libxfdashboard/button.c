@@ -1584,7 +1584,7 @@ void xfdashboard_button_set_padding(XfdashboardButton *self, const gfloat inPadd
 	{
 		/* Set value */
 		priv->padding=inPadding;
-		clutter_actor_queue_relayout(CLUTTER_ACTOR(self));
+		xfdashboard_actor_queue_relayout(XFDASHBOARD_ACTOR(self));
 
 		/* Update actor */
 		xfdashboard_background_set_corner_radius(XFDASHBOARD_BACKGROUND(self), priv->padding);
@@ -1616,7 +1616,7 @@ void xfdashboard_button_set_spacing(XfdashboardButton *self, const gfloat inSpac
 	{
 		/* Set value */
 		priv->spacing=inSpacing;
-		clutter_actor_queue_relayout(CLUTTER_ACTOR(self));
+		xfdashboard_actor_queue_relayout(XFDASHBOARD_ACTOR(self));
 
 		/* Notify about property change */
 		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardButtonProperties[PROP_SPACING]);
@@ -1660,7 +1660,7 @@ void xfdashboard_button_set_style(XfdashboardButton *self, const XfdashboardButt
 		}
 			else clutter_actor_hide(CLUTTER_ACTOR(priv->actorIcon));
 
-		clutter_actor_queue_relayout(CLUTTER_ACTOR(self));
+		xfdashboard_actor_queue_relayout(XFDASHBOARD_ACTOR(self));
 
 		/* Notify about property change */
 		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardButtonProperties[PROP_STYLE]);
@@ -1945,7 +1945,7 @@ void xfdashboard_button_set_icon_orientation(XfdashboardButton *self, const Xfda
 		/* Set value */
 		priv->iconOrientation=inOrientation;
 
-		clutter_actor_queue_relayout(CLUTTER_ACTOR(self));
+		xfdashboard_actor_queue_relayout(XFDASHBOARD_ACTOR(self));
 
 		/* Notify about property change */
 		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardButtonProperties[PROP_ICON_ORIENTATION]);
@@ -2067,7 +2067,7 @@ void xfdashboard_button_set_ellipsize_mode(XfdashboardButton *self, const PangoE
 		priv->labelEllipsize=inMode;
 
 		clutter_text_set_ellipsize(CLUTTER_TEXT(priv->actorLabel), priv->labelEllipsize);
-		clutter_actor_queue_relayout(CLUTTER_ACTOR(self));
+		xfdashboard_actor_queue_relayout(XFDASHBOARD_ACTOR(self));
 
 		/* Notify about property change */
 		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardButtonProperties[PROP_TEXT_ELLIPSIZE_MODE]);
@@ -2097,7 +2097,7 @@ void xfdashboard_button_set_single_line_mode(XfdashboardButton *self, const gboo
 		priv->isSingleLineMode=inSingleLineMode;
 
 		clutter_text_set_single_line_mode(CLUTTER_TEXT(priv->actorLabel), priv->isSingleLineMode);
-		clutter_actor_queue_relayout(CLUTTER_ACTOR(self));
+		xfdashboard_actor_queue_relayout(XFDASHBOARD_ACTOR(self));
 
 		/* Notify about property change */
 		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardButtonProperties[PROP_TEXT_SINGLE_LINE]);
@@ -27,9 +27,11 @@
 #endif
 
 #include <glib/gi18n-lib.h>
+#include <string.h>
 
 #include <libxfdashboard/desktop-app-info.h>
 #include <libxfdashboard/application-database.h>
+#include <libxfdashboard/desktop-entry.h>
 #include <libxfdashboard/compat.h>
 
 
@@ -55,10 +57,7 @@ struct _XfdashboardDesktopAppInfoPrivate
 	gboolean			inited;
 	gboolean			isValid;
 
-	GarconMenuItem		*item;
-	guint				itemChangedID;
-
-	gchar				*binaryExecutable;
+	XfdashboardDesktopEntry			*entry;
 };
 
 /* Properties */
@@ -94,14 +93,72 @@ typedef struct
 	gchar	*desktopFile;
 } XfdashboardDesktopAppInfoChildSetupData;
 
-/* Menu item has changed */
-static void _xfdashboard_desktop_app_info_on_item_changed(XfdashboardDesktopAppInfo *self,
-															gpointer inUserData)
+/* Create values of desktop entry from menu item */
+static XfdashboardDesktopEntry* _xfdashboard_desktop_app_info_entry_new_from_menu_item(GarconMenuItem *inMenuItem)
+{
+	XfdashboardDesktopEntryValues			values;
+	const gchar								*command;
+
+	g_return_val_if_fail(GARCON_IS_MENU_ITEM(inMenuItem), NULL);
+
+	/* The strings are only borrowed from menu item as they are copied
+	 * into memory block of desktop entry.
+	 */
+	command=garcon_menu_item_get_command(inMenuItem);
+
+	values.name=(gchar*)garcon_menu_item_get_name(inMenuItem);
+	values.comment=(gchar*)garcon_menu_item_get_comment(inMenuItem);
+	values.command=(gchar*)(command ? command : "");
+	values.iconName=(gchar*)garcon_menu_item_get_icon_name(inMenuItem);
+	values.path=(gchar*)garcon_menu_item_get_path(inMenuItem);
+	values.requiresTerminal=garcon_menu_item_requires_terminal(inMenuItem);
+	values.supportsStartupNotification=garcon_menu_item_supports_startup_notification(inMenuItem);
+	values.isHidden=garcon_menu_item_get_hidden(inMenuItem);
+	values.noDisplay=garcon_menu_item_get_no_display(inMenuItem);
+	values.showInEnvironment=garcon_menu_item_get_show_in_environment(inMenuItem);
+
+	if(!values.name) values.name="";
+
+	return(_xfdashboard_desktop_entry_new(&values));
+}
+
+/* Load values of desktop entry from desktop file */
+static XfdashboardDesktopEntry* _xfdashboard_desktop_app_info_entry_new_from_file(GFile *inFile,
+																					GError **outError)
 {
+	XfdashboardDesktopEntry				*entry;
+	gchar								*contents;
+	gsize								length;
+
+	g_return_val_if_fail(G_IS_FILE(inFile), NULL);
+	g_return_val_if_fail(outError==NULL || *outError==NULL, NULL);
+
+	if(!g_file_load_contents(inFile, NULL, &contents, &length, NULL, outError)) return(NULL);
+
+	entry=_xfdashboard_desktop_entry_new_from_data(contents, length, garcon_get_environment(), outError);
+	g_free(contents);
+
+	return(entry);
+}
+
+/* Replace desktop entry */
+static void _xfdashboard_desktop_app_info_set_entry(XfdashboardDesktopAppInfo *self,
+													XfdashboardDesktopEntry *inEntry)
+{
+	XfdashboardDesktopAppInfoPrivate	*priv;
+
 	g_return_if_fail(XFDASHBOARD_IS_DESKTOP_APP_INFO(self));
 
-	/* Emit 'changed' signal for this desktop app info */
-	g_signal_emit(self, XfdashboardDesktopAppInfoSignals[SIGNAL_CHANGED], 0);
+	priv=self->priv;
+
+	/* Replace current desktop entry with new one and take ownership */
+	if(priv->entry)
+	{
+		_xfdashboard_desktop_entry_free(priv->entry);
+		priv->entry=NULL;
+	}
+
+	priv->entry=inEntry;
 }
 
 /* Set desktop ID */
@@ -145,12 +202,13 @@ static void _xfdashboard_desktop_app_info_set_file(XfdashboardDesktopAppInfo *se
 	/* Set value if changed */
 	if(!(priv->file && inFile && g_file_equal(priv->file, inFile)))
 	{
+		XfdashboardDesktopEntry			*entry;
 		gboolean						valid;
 
 		/* Freeze notification */
 		g_object_freeze_notify(G_OBJECT(self));
 
-		/* Replace current file to menu item with new one */
+		/* Replace current desktop file with new one */
 		if(priv->file)
 		{
 			g_object_unref(priv->file);
@@ -158,59 +216,23 @@ static void _xfdashboard_desktop_app_info_set_file(XfdashboardDesktopAppInfo *se
 		}
 		if(inFile) priv->file=g_object_ref(inFile);
 
-		/* Replace current menu item with new one */
-		if(priv->item)
-		{
-			if(priv->itemChangedID)
-			{
-				g_signal_handler_disconnect(priv->item, priv->itemChangedID);
-				priv->itemChangedID=0;
-			}
-
-			g_object_unref(priv->item);
-			priv->item=NULL;
-		}
-
+		/* Load desktop entry from new file */
+		entry=NULL;
 		if(priv->file)
 		{
-			priv->item=garcon_menu_item_new(priv->file);
-		}
-
-		/* Connect signal to get notified about changes of menu item */
-		if(priv->item)
-		{
-			priv->itemChangedID=g_signal_connect_swapped(priv->item,
-															"changed",
-															G_CALLBACK(_xfdashboard_desktop_app_info_on_item_changed),
-															self);
-		}
-
-		/* Get path to executable file for this application by striping white-space from
-		 * the beginning of the command to execute when launching up to first white-space
-		 * after the first command-line argument (which is the command).
-		 */
-		if(priv->binaryExecutable)
-		{
-			g_free(priv->binaryExecutable);
-			priv->binaryExecutable=NULL;
-		}
+			GError						*error;
 
-		if(priv->item)
-		{
-			const gchar						*command;
-			const gchar						*commandStart;
-			const gchar						*commandEnd;
-
-			command=garcon_menu_item_get_command(priv->item);
-
-			while(*command==' ') command++;
-			commandStart=command;
-
-			while(*command && *command!=' ') command++;
-			commandEnd=command;
-
-			priv->binaryExecutable=g_strndup(commandStart, commandEnd-commandStart);
+			error=NULL;
+			entry=_xfdashboard_desktop_app_info_entry_new_from_file(priv->file, &error);
+			if(!entry)
+			{
+				g_debug("Could not load desktop entry for '%s': %s",
+							priv->desktopID ? priv->desktopID : "<unknown>",
+							error ? error->message : _("Unknown error"));
+				if(error) g_error_free(error);
+			}
 		}
+		_xfdashboard_desktop_app_info_set_entry(self, entry);
 
 		/* Notify about property change */
 		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardDesktopAppInfoProperties[PROP_FILE]);
@@ -221,13 +243,13 @@ static void _xfdashboard_desktop_app_info_set_file(XfdashboardDesktopAppInfo *se
 			g_signal_emit(self, XfdashboardDesktopAppInfoSignals[SIGNAL_CHANGED], 0);
 		}
 
-		/* Desktop file is set, menu item loaded - this desktop app info is inited now */
+		/* Desktop file is set, desktop entry loaded - this desktop app info is inited now */
 		priv->inited=TRUE;
 
-		/* Check if this app info is valid (either file is not set or file and menu item is set */
+		/* Check if this app info is valid (either file is not set or file and desktop entry is set */
 		valid=FALSE;
 		if(!priv->file ||
-			(priv->file && priv->item))
+			(priv->file && priv->entry))
 		{
 			valid=TRUE;
 		}
@@ -318,7 +340,9 @@ static gboolean _xfdashboard_desktop_app_info_expand_macros(XfdashboardDesktopAp
 	priv=self->priv;
 
 	/* Get command-line whose macros to expand */
-	command=garcon_menu_item_get_command(priv->item);
+	if(!priv->entry) return(FALSE);
+
+	command=priv->entry->command;
 
 	/* Iterate through command-line char by char and expand known macros */
 	filesOrUriAdded=FALSE;
@@ -366,7 +390,7 @@ static gboolean _xfdashboard_desktop_app_info_expand_macros(XfdashboardDesktopAp
 					const gchar			*iconName;
 					gchar				*quotedIconName;
 
-					iconName=garcon_menu_item_get_icon_name(priv->item);
+					iconName=priv->entry->iconName;
 					if(iconName)
 					{
 						quotedIconName=g_shell_quote(iconName);
@@ -384,7 +408,7 @@ static gboolean _xfdashboard_desktop_app_info_expand_macros(XfdashboardDesktopAp
 					const gchar			*name;
 					gchar				*quotedName;
 
-					name=garcon_menu_item_get_name(priv->item);
+					name=priv->entry->name;
 					if(name)
 					{
 						quotedName=g_shell_quote(name);
@@ -396,14 +420,12 @@ static gboolean _xfdashboard_desktop_app_info_expand_macros(XfdashboardDesktopAp
 
 				case 'k':
 				{
-					GFile				*desktopFile;
 					gchar				*filename;
 					gchar				*quotedFilename;
 
-					desktopFile=garcon_menu_item_get_file(priv->item);
-					if(desktopFile)
+					if(priv->file)
 					{
-						filename=g_file_get_path(desktopFile);
+						filename=g_file_get_path(priv->file);
 						if(filename)
 						{
 							quotedFilename=g_shell_quote(filename);
@@ -412,8 +434,6 @@ static gboolean _xfdashboard_desktop_app_info_expand_macros(XfdashboardDesktopAp
 
 							g_free(filename);
 						}
-
-						g_object_unref(desktopFile);
 					}
 
 					break;
@@ -533,7 +553,7 @@ static gboolean _xfdashboard_desktop_app_info_launch_appinfo_internal(Xfdashboar
 	 * NOTE: The space at end of command is important to separate
 	 *       the command we prepend from command-line of application.
 	 */
-	if(garcon_menu_item_requires_terminal(priv->item))
+	if(priv->entry->requiresTerminal)
 	{
 		g_string_prepend(expanded, "exo-open --launch TerminalEmulator ");
 	}
@@ -575,7 +595,7 @@ static gboolean _xfdashboard_desktop_app_info_launch_appinfo_internal(Xfdashboar
 													filesToLaunch);
 
 		/* Get startup notification ID if it is supported by application */
-		if(garcon_menu_item_supports_startup_notification(priv->item))
+		if(priv->entry->supportsStartupNotification)
 		{
 			startupNotificationID=g_app_launch_context_get_startup_notify_id(inContext,
 																				G_APP_INFO(self),
@@ -588,7 +608,7 @@ static gboolean _xfdashboard_desktop_app_info_launch_appinfo_internal(Xfdashboar
 	}
 
 	/* Get working directory and test if directory exists */
-	workingDirectory=garcon_menu_item_get_path(priv->item);
+	workingDirectory=priv->entry->path;
 	if(!workingDirectory || !*workingDirectory)
 	{
 		/* Working directory was either NULL or is an empty string,
@@ -626,7 +646,7 @@ static gboolean _xfdashboard_desktop_app_info_launch_appinfo_internal(Xfdashboar
 	{
 		GDBusConnection							*sessionBus;
 
-		g_debug("Launching %s succeeded with PID %ld.", garcon_menu_item_get_name(priv->item), (long)launchedPID);
+		g_debug("Launching %s succeeded with PID %ld.", priv->entry->name, (long)launchedPID);
 
 		/* Open connection to DBUS session bus and send notification about
 		 * successful launch of application. Then flush and close DBUS
@@ -720,7 +740,7 @@ static gboolean _xfdashboard_desktop_app_info_launch_appinfo_internal(Xfdashboar
 	}
 		else
 		{
-			g_warning("Launching %s failed!", garcon_menu_item_get_name(priv->item));
+			g_warning("Launching %s failed!", priv->entry->name);
 
 			/* Propagate error */
 			g_propagate_error(outError, error);
@@ -775,12 +795,11 @@ static gboolean _xfdashboard_desktop_app_info_gappinfo_equal(GAppInfo *inLeft, G
 	left=XFDASHBOARD_DESKTOP_APP_INFO(inLeft);
 	right=XFDASHBOARD_DESKTOP_APP_INFO(inRight);
 
-	/* If one of both instance do not have a menu item return FALSE */
-	if(!left->priv->item || !right->priv->item) return(FALSE);
+	/* If one of both instance do not have a desktop file return FALSE */
+	if(!left->priv->file || !right->priv->file) return(FALSE);
 
-	/* Return result of check if menu item of both GAppInfos are equal */
-	return(garcon_menu_element_equal(GARCON_MENU_ELEMENT(left->priv->item),
-										GARCON_MENU_ELEMENT(right->priv->item)));
+	/* Return result of check if desktop files of both GAppInfos are equal */
+	return(g_file_equal(left->priv->file, right->priv->file));
 }
 
 /* Get ID of GAppInfo */
@@ -809,11 +828,11 @@ static const gchar* _xfdashboard_desktop_app_info_gappinfo_get_name(GAppInfo *in
 	self=XFDASHBOARD_DESKTOP_APP_INFO(inAppInfo);
 	priv=self->priv;
 
-	/* If desktop app info has no item return NULL here */
-	if(!priv->item) return(NULL);
+	/* If desktop app info has no desktop entry return NULL here */
+	if(!priv->entry) return(NULL);
 
-	/* Return name of menu item */
-	return(garcon_menu_item_get_name(priv->item));
+	/* Return name of desktop entry */
+	return(priv->entry->name);
 }
 
 /* Get description of GAppInfo */
@@ -827,11 +846,11 @@ static const gchar* _xfdashboard_desktop_app_info_gappinfo_get_description(GAppI
 	self=XFDASHBOARD_DESKTOP_APP_INFO(inAppInfo);
 	priv=self->priv;
 
-	/* If desktop app info has no item return NULL here */
-	if(!priv->item) return(NULL);
+	/* If desktop app info has no desktop entry return NULL here */
+	if(!priv->entry) return(NULL);
 
-	/* Return comment of menu item as description */
-	return(garcon_menu_item_get_comment(priv->item));
+	/* Return comment of desktop entry as description */
+	return(priv->entry->comment);
 }
 
 /* Get path to executable binary of GAppInfo */
@@ -845,8 +864,11 @@ static const gchar* _xfdashboard_desktop_app_info_gappinfo_get_executable(GAppIn
 	self=XFDASHBOARD_DESKTOP_APP_INFO(inAppInfo);
 	priv=self->priv;
 
-	/* Return comment of menu item as description */
-	return(priv->binaryExecutable);
+	/* If desktop app info has no desktop entry return NULL here */
+	if(!priv->entry) return(NULL);
+
+	/* Return executable of desktop entry */
+	return(priv->entry->binaryExecutable);
 }
 
 /* Get icon of GAppInfo */
@@ -863,10 +885,10 @@ static GIcon* _xfdashboard_desktop_app_info_gappinfo_get_icon(GAppInfo *inAppInf
 	priv=self->priv;
 	icon=NULL;
 
-	/* Create icon from path of menu item */
-	if(priv->item)
+	/* Create icon from path of desktop entry */
+	if(priv->entry)
 	{
-		iconFilename=garcon_menu_item_get_icon_name(priv->item);
+		iconFilename=priv->entry->iconName;
 		if(iconFilename)
 		{
 			if(!g_path_is_absolute(iconFilename)) icon=g_themed_icon_new(iconFilename);
@@ -899,12 +921,12 @@ static gboolean _xfdashboard_desktop_app_info_gappinfo_supports_uris(GAppInfo *i
 	priv=self->priv;
 	result=FALSE;
 
-	/* Check if command at menu item contains "%u" or "%U"
+	/* Check if command at desktop entry contains "%u" or "%U"
 	 * indicating URIs as command-line parameters.
 	 */
-	if(priv->item)
+	if(priv->entry)
 	{
-		command=garcon_menu_item_get_command(priv->item);
+		command=priv->entry->command;
 		if(command)
 		{
 			if(!result && strstr(command, "%u")) result=TRUE;
@@ -930,12 +952,12 @@ static gboolean _xfdashboard_desktop_app_info_gappinfo_supports_files(GAppInfo *
 	priv=self->priv;
 	result=FALSE;
 
-	/* Check if command at menu item contains "%f" or "%F"
+	/* Check if command at desktop entry contains "%f" or "%F"
 	 * indicating file paths as command-line parameters.
 	 */
-	if(priv->item)
+	if(priv->entry)
 	{
-		command=garcon_menu_item_get_command(priv->item);
+		command=priv->entry->command;
 		if(command)
 		{
 			if(!result && strstr(command, "%f")) result=TRUE;
@@ -1023,11 +1045,11 @@ static gboolean _xfdashboard_desktop_app_info_gappinfo_should_show(GAppInfo *inA
 	self=XFDASHBOARD_DESKTOP_APP_INFO(inAppInfo);
 	priv=self->priv;
 
-	/* If desktop app info has no item return FALSE here */
-	if(!priv->item) return(FALSE);
+	/* If desktop app info has no desktop entry return FALSE here */
+	if(!priv->entry) return(FALSE);
 
-	/* Check if menu item should be shown in current environment */
-	return(garcon_menu_item_get_show_in_environment(priv->item));
+	/* Check if desktop entry should be shown in current environment */
+	return(priv->entry->showInEnvironment);
 }
 
 /* Get command-line of GAppInfo with which the application will be started */
@@ -1041,11 +1063,11 @@ static const gchar* _xfdashboard_desktop_app_info_gappinfo_get_commandline(GAppI
 	self=XFDASHBOARD_DESKTOP_APP_INFO(inAppInfo);
 	priv=self->priv;
 
-	/* If desktop app info has no item return NULL here */
-	if(!priv->item) return(NULL);
+	/* If desktop app info has no desktop entry return NULL here */
+	if(!priv->entry) return(NULL);
 
-	/* Return command of menu item */
-	return(garcon_menu_item_get_command(priv->item));
+	/* Return command of desktop entry */
+	return(priv->entry->command);
 }
 
 /* Get display name of GAppInfo */
@@ -1059,11 +1081,11 @@ static const gchar* _xfdashboard_desktop_app_info_gappinfo_get_display_name(GApp
 	self=XFDASHBOARD_DESKTOP_APP_INFO(inAppInfo);
 	priv=self->priv;
 
-	/* If desktop app info has no item return NULL here */
-	if(!priv->item) return(NULL);
+	/* If desktop app info has no desktop entry return NULL here */
+	if(!priv->entry) return(NULL);
 
-	/* Return name of menu item */
-	return(garcon_menu_item_get_name(priv->item));
+	/* Return name of desktop entry */
+	return(priv->entry->name);
 }
 
 /* Interface initialization
@@ -1096,22 +1118,10 @@ static void _xfdashboard_desktop_app_info_dispose(GObject *inObject)
 	XfdashboardDesktopAppInfoPrivate	*priv=self->priv;
 
 	/* Release allocated variables */
-	if(priv->binaryExecutable)
+	if(priv->entry)
 	{
-		g_free(priv->binaryExecutable);
-		priv->binaryExecutable=NULL;
-	}
-
-	if(priv->item)
-	{
-		if(priv->itemChangedID)
-		{
-			g_signal_handler_disconnect(priv->item, priv->itemChangedID);
-			priv->itemChangedID=0;
-		}
-
-		g_object_unref(priv->item);
-		priv->item=NULL;
+		_xfdashboard_desktop_entry_free(priv->entry);
+		priv->entry=NULL;
 	}
 
 	if(priv->file)
@@ -1249,9 +1259,7 @@ static void xfdashboard_desktop_app_info_init(XfdashboardDesktopAppInfo *self)
 	priv->isValid=FALSE;
 	priv->desktopID=NULL;
 	priv->file=NULL;
-	priv->item=NULL;
-	priv->itemChangedID=0;
-	priv->binaryExecutable=NULL;
+	priv->entry=NULL;
 }
 
 /* IMPLEMENTATION: Public API */
@@ -1330,8 +1338,10 @@ GAppInfo* xfdashboard_desktop_app_info_new_from_menu_item(GarconMenuItem *inMenu
 	/* Create this class instance from menu item loaded from given URI */
 	instance=XFDASHBOARD_DESKTOP_APP_INFO(g_object_new(XFDASHBOARD_TYPE_DESKTOP_APP_INFO, NULL));
 
-	/* Set menu item but increase reference counter */
-	instance->priv->item=GARCON_MENU_ITEM(g_object_ref(inMenuItem));
+	/* Take values of desktop entry from already loaded menu item instead
+	 * of parsing the desktop file again.
+	 */
+	_xfdashboard_desktop_app_info_set_entry(instance, _xfdashboard_desktop_app_info_entry_new_from_menu_item(inMenuItem));
 
 	/* Copy desktop ID from menu item if available */
 	desktopID=garcon_menu_item_get_desktop_id(inMenuItem);
@@ -1340,7 +1350,7 @@ GAppInfo* xfdashboard_desktop_app_info_new_from_menu_item(GarconMenuItem *inMenu
 	/* Copy file object and do not use g_object_set to set it
 	 * in created instance to prevent the property setter function
 	 * _xfdashboard_desktop_app_info_set_file to be called which
-	 * would unreference the just referenced menu item.
+	 * would parse the desktop file again.
 	 */
 	file=garcon_menu_item_get_file(inMenuItem);
 	instance->priv->file=G_FILE(g_object_ref(file));
@@ -1372,10 +1382,10 @@ gboolean xfdashboard_desktop_app_info_get_hidden(XfdashboardDesktopAppInfo *self
 	priv=self->priv;
 	isHidden=TRUE;
 
-	/* If a menu item exists get hidden state from it  */
-	if(priv->item)
+	/* If a desktop entry exists get hidden state from it  */
+	if(priv->entry)
 	{
-		isHidden=garcon_menu_item_get_hidden(priv->item);
+		isHidden=priv->entry->isHidden;
 	}
 
 	return(isHidden);
@@ -1392,10 +1402,10 @@ gboolean xfdashboard_desktop_app_info_get_nodisplay(XfdashboardDesktopAppInfo *s
 	priv=self->priv;
 	noDisplay=TRUE;
 
-	/* If a menu item exists get "NoDisplay" value from it */
-	if(priv->item)
+	/* If a desktop entry exists get "NoDisplay" value from it */
+	if(priv->entry)
 	{
-		noDisplay=garcon_menu_item_get_no_display(priv->item);
+		noDisplay=priv->entry->noDisplay;
 	}
 
 	return(noDisplay);
@@ -1420,20 +1430,28 @@ gboolean xfdashboard_desktop_app_info_reload(XfdashboardDesktopAppInfo *self)
 	priv=self->priv;
 	success=FALSE;
 
-	/* Reload menu item */
-	if(priv->item)
+	/* Reload desktop entry from desktop file. Keep current values if
+	 * desktop file could not be parsed.
+	 */
+	if(priv->file)
 	{
+		XfdashboardDesktopEntry			*entry;
 		GError							*error;
 
 		error=NULL;
-		success=garcon_menu_item_reload(priv->item, NULL, &error);
-		if(!success)
+		entry=_xfdashboard_desktop_app_info_entry_new_from_file(priv->file, &error);
+		if(entry)
 		{
-			g_warning(_("Could not reload desktop application information for '%s': %s"),
-						garcon_menu_item_get_name(priv->item),
-						error ? error->message : _("Unknown error"));
-			if(error) g_error_free(error);
+			_xfdashboard_desktop_app_info_set_entry(self, entry);
+			success=TRUE;
 		}
+			else
+			{
+				g_warning(_("Could not reload desktop application information for '%s': %s"),
+							priv->entry ? priv->entry->name : priv->desktopID,
+							error ? error->message : _("Unknown error"));
+				if(error) g_error_free(error);
+			}
 	}
 
 	/* If reload was successful emit changed signal */
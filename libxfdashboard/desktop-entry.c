@@ -0,0 +1,503 @@
+/*
+ * desktop-entry: Parser and compact storage of values of desktop files
+ * 
+ * Copyright 2012-2016 Stephan Haller <nomad@froevel.de>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ * 
+ * 
+ */
+
+#include "config.h"
+
+#include <libxfdashboard/desktop-entry.h>
+
+#include <glib/gi18n-lib.h>
+#include <string.h>
+
+
+/* IMPLEMENTATION: Private variables and methods */
+#define XFDASHBOARD_DESKTOP_ENTRY_GROUP					"[Desktop Entry]"
+#define XFDASHBOARD_DESKTOP_ENTRY_UNLOCALIZED_PRIORITY	G_MAXINT
+
+/* Copy string into memory block of desktop entry and return copy */
+static const gchar* _xfdashboard_desktop_entry_pack_string(gchar **ioData, const gchar *inString, gsize inLength)
+{
+	gchar								*copy;
+
+	copy=*ioData;
+	memcpy(copy, inString, inLength);
+	copy[inLength]=0;
+	*ioData+=inLength+1;
+
+	return(copy);
+}
+
+/* Get priority of locale of a localized key, i.e. its position in list of
+ * languages of current locale. A lower value means a better match. Returns -1
+ * if locale is not in list and the key is not needed.
+ */
+static gint _xfdashboard_desktop_entry_get_locale_priority(const gchar * const *inLanguages, const gchar *inLocale, gsize inLength)
+{
+	gint					i;
+
+	for(i=0; inLanguages[i]; i++)
+	{
+		/* The "C" locale is the unlocalized key */
+		if(strcmp(inLanguages[i], "C")==0) break;
+
+		if(strlen(inLanguages[i])==inLength &&
+			strncmp(inLanguages[i], inLocale, inLength)==0)
+		{
+			return(i);
+		}
+	}
+
+	return(-1);
+}
+
+/* Unescape value of a key. If a list separator is given, the list separator
+ * can be escaped and is unescaped, too.
+ */
+static gchar* _xfdashboard_desktop_entry_unescape(const gchar *inValue, gsize inLength, gchar inListSeparator)
+{
+	gchar					*result;
+	gchar					*out;
+	const gchar				*end;
+
+	result=out=g_new(gchar, inLength+1);
+	end=inValue+inLength;
+
+	while(inValue<end)
+	{
+		if(*inValue=='\\' && inValue+1<end)
+		{
+			inValue++;
+			switch(*inValue)
+			{
+				case 's':
+					*out++=' ';
+					break;
+
+				case 'n':
+					*out++='\n';
+					break;
+
+				case 't':
+					*out++='\t';
+					break;
+
+				case 'r':
+					*out++='\r';
+					break;
+
+				case '\\':
+					*out++='\\';
+					break;
+
+				default:
+					if(inListSeparator && *inValue==inListSeparator) *out++=inListSeparator;
+						else
+						{
+							*out++='\\';
+							*out++=*inValue;
+						}
+					break;
+			}
+			inValue++;
+		}
+			else *out++=*inValue++;
+	}
+	*out=0;
+
+	return(result);
+}
+
+/* Get boolean value of a key */
+static gboolean _xfdashboard_desktop_entry_parse_boolean(const gchar *inValue, gsize inLength)
+{
+	if(inLength==4 && strncmp(inValue, "true", 4)==0) return(TRUE);
+	if(inLength==1 && *inValue=='1') return(TRUE);
+
+	return(FALSE);
+}
+
+/* Check if any entry of a list value matches current environment */
+static gboolean _xfdashboard_desktop_entry_list_has_environment(const gchar *inValue, gsize inLength, gchar **inEnvironments)
+{
+	const gchar				*iter;
+	const gchar				*itemStart;
+	const gchar				*end;
+	gchar					*item;
+	gchar					**environment;
+	gboolean				found;
+
+	found=FALSE;
+	end=inValue+inLength;
+	itemStart=inValue;
+
+	/* Iterate through list and check each list entry at unescaped separator
+	 * or at end of value.
+	 */
+	for(iter=inValue; iter<=end && !found; iter++)
+	{
+		/* Skip escaped characters */
+		if(iter+1<end && *iter=='\\')
+		{
+			iter++;
+			continue;
+		}
+
+		if(iter<end && *iter!=';') continue;
+
+		/* Check list entry found against names of current environment */
+		if(iter>itemStart)
+		{
+			item=_xfdashboard_desktop_entry_unescape(itemStart, iter-itemStart, ';');
+			for(environment=inEnvironments; *environment && !found; environment++)
+			{
+				if(g_strcmp0(item, *environment)==0) found=TRUE;
+			}
+			g_free(item);
+		}
+
+		itemStart=iter+1;
+	}
+
+	return(found);
+}
+
+
+/* IMPLEMENTATION: Public API */
+
+/* Release strings of collected values of desktop entry */
+void _xfdashboard_desktop_entry_values_clear(XfdashboardDesktopEntryValues *ioValues)
+{
+	g_return_if_fail(ioValues);
+
+	if(ioValues->name) g_free(ioValues->name);
+	if(ioValues->comment) g_free(ioValues->comment);
+	if(ioValues->command) g_free(ioValues->command);
+	if(ioValues->iconName) g_free(ioValues->iconName);
+	if(ioValues->path) g_free(ioValues->path);
+	memset(ioValues, 0, sizeof(XfdashboardDesktopEntryValues));
+}
+
+/* Create desktop entry from collected values */
+XfdashboardDesktopEntry* _xfdashboard_desktop_entry_new(const XfdashboardDesktopEntryValues *inValues)
+{
+	XfdashboardDesktopEntry				*entry;
+	const gchar							*command;
+	const gchar							*commandStart;
+	gsize								commandLength;
+	gsize								nameLength;
+	gsize								commentLength;
+	gsize								binaryLength;
+	gsize								iconNameLength;
+	gsize								pathLength;
+	gchar								*data;
+
+	g_return_val_if_fail(inValues, NULL);
+	g_return_val_if_fail(inValues->name && inValues->command, NULL);
+
+	/* Get path to executable file for this application by striping white-space from
+	 * the beginning of the command to execute when launching up to first white-space
+	 * after the first command-line argument (which is the command).
+	 */
+	command=inValues->command;
+	while(*command==' ') command++;
+	commandStart=command;
+
+	while(*command && *command!=' ') command++;
+	binaryLength=command-commandStart;
+
+	/* Allocate one memory block for desktop entry and all its strings */
+	nameLength=strlen(inValues->name);
+	commentLength=inValues->comment ? strlen(inValues->comment) : 0;
+	commandLength=strlen(inValues->command);
+	iconNameLength=inValues->iconName ? strlen(inValues->iconName) : 0;
+	pathLength=inValues->path ? strlen(inValues->path) : 0;
+
+	entry=g_malloc0(sizeof(XfdashboardDesktopEntry)+
+						nameLength+1+
+						(inValues->comment ? commentLength+1 : 0)+
+						commandLength+1+
+						binaryLength+1+
+						(inValues->iconName ? iconNameLength+1 : 0)+
+						(inValues->path ? pathLength+1 : 0));
+	data=(gchar*)(entry+1);
+
+	entry->name=_xfdashboard_desktop_entry_pack_string(&data, inValues->name, nameLength);
+	if(inValues->comment) entry->comment=_xfdashboard_desktop_entry_pack_string(&data, inValues->comment, commentLength);
+	entry->command=_xfdashboard_desktop_entry_pack_string(&data, inValues->command, commandLength);
+	entry->binaryExecutable=_xfdashboard_desktop_entry_pack_string(&data, commandStart, binaryLength);
+	if(inValues->iconName) entry->iconName=_xfdashboard_desktop_entry_pack_string(&data, inValues->iconName, iconNameLength);
+	if(inValues->path) entry->path=_xfdashboard_desktop_entry_pack_string(&data, inValues->path, pathLength);
+
+	entry->requiresTerminal=(inValues->requiresTerminal ? 1 : 0);
+	entry->supportsStartupNotification=(inValues->supportsStartupNotification ? 1 : 0);
+	entry->isHidden=(inValues->isHidden ? 1 : 0);
+	entry->noDisplay=(inValues->noDisplay ? 1 : 0);
+	entry->showInEnvironment=(inValues->showInEnvironment ? 1 : 0);
+
+	return(entry);
+}
+
+/* Parse desktop file in one pass. Only keys of group "Desktop Entry" used by
+ * desktop app info are kept. Localized keys are only kept if they match
+ * current locale better than the one seen before, all other translations
+ * are dropped while scanning without copying them. Scanning stops at first
+ * group following "Desktop Entry", so desktop actions are never scanned.
+ * Keys not used at all, like "MimeType", are skipped without copying them.
+ * Launch keys are parsed in the same pass as "Exec" so they always belong to
+ * the same version of the desktop file and launching never reads it again.
+ */
+XfdashboardDesktopEntry* _xfdashboard_desktop_entry_new_from_data(const gchar *inData,
+																	gsize inLength,
+																	const gchar *inEnvironment,
+																	GError **outError)
+{
+	XfdashboardDesktopEntryValues			values;
+	XfdashboardDesktopEntry				*entry;
+	const gchar							*line;
+	const gchar							*lineEnd;
+	const gchar							*dataEnd;
+	gboolean							inDesktopGroup;
+	gboolean							foundDesktopGroup;
+	gint								namePriority;
+	gint								commentPriority;
+	gboolean							hasOnlyShowIn;
+	gboolean							matchesOnlyShowIn;
+	gboolean							matchesNotShowIn;
+	gchar								**environments;
+	const gchar * const					*languages;
+
+	g_return_val_if_fail(inData, NULL);
+	g_return_val_if_fail(outError==NULL || *outError==NULL, NULL);
+
+	memset(&values, 0, sizeof(XfdashboardDesktopEntryValues));
+	inDesktopGroup=FALSE;
+	foundDesktopGroup=FALSE;
+	namePriority=-1;
+	commentPriority=-1;
+	hasOnlyShowIn=FALSE;
+	matchesOnlyShowIn=FALSE;
+	matchesNotShowIn=FALSE;
+
+	/* Get list of languages of current locale once as looking it up checks
+	 * the environment variables of locale each time.
+	 */
+	languages=g_get_language_names();
+
+	/* Get list of names of current environment */
+	environments=inEnvironment ? g_strsplit(inEnvironment, ":", -1) : g_new0(gchar*, 1);
+
+	/* Scan desktop file line by line */
+	dataEnd=inData+inLength;
+	for(line=inData; line<dataEnd; line=lineEnd+1)
+	{
+		const gchar						*key;
+		gsize							keyLength;
+		const gchar						*locale;
+		gsize							localeLength;
+		const gchar						*value;
+		const gchar						*valueEnd;
+		gsize							valueLength;
+		gint							priority;
+
+		/* Find end of line */
+		lineEnd=memchr(line, '\n', dataEnd-line);
+		if(!lineEnd) lineEnd=dataEnd;
+
+		/* Skip leading white-space, empty lines and comments */
+		while(line<lineEnd && g_ascii_isspace(*line)) line++;
+		if(line==lineEnd || *line=='#') continue;
+
+		/* Check for start of group. Stop at first group following group
+		 * "Desktop Entry" as all keys needed were seen.
+		 */
+		if(*line=='[')
+		{
+			if(inDesktopGroup) break;
+
+			inDesktopGroup=(lineEnd-line>=(gssize)strlen(XFDASHBOARD_DESKTOP_ENTRY_GROUP) &&
+							strncmp(line, XFDASHBOARD_DESKTOP_ENTRY_GROUP, strlen(XFDASHBOARD_DESKTOP_ENTRY_GROUP))==0);
+			if(inDesktopGroup) foundDesktopGroup=TRUE;
+			continue;
+		}
+
+		if(!inDesktopGroup) continue;
+
+		/* Split line into key, locale and value */
+		key=line;
+		value=memchr(line, '=', lineEnd-line);
+		if(!value) continue;
+
+		valueEnd=lineEnd;
+		while(valueEnd>value+1 && (*(valueEnd-1)=='\r' || *(valueEnd-1)==' ' || *(valueEnd-1)=='\t')) valueEnd--;
+
+		keyLength=value-key;
+		while(keyLength>0 && g_ascii_isspace(key[keyLength-1])) keyLength--;
+
+		value++;
+		while(value<valueEnd && (*value==' ' || *value=='\t')) value++;
+		valueLength=valueEnd-value;
+
+		locale=NULL;
+		localeLength=0;
+		if(keyLength>2 && key[keyLength-1]==']')
+		{
+			locale=memchr(key, '[', keyLength);
+			if(!locale) continue;
+
+			localeLength=(key+keyLength-1)-(locale+1);
+			keyLength=locale-key;
+			locale++;
+		}
+
+		/* Get priority of key. Unlocalized keys have the lowest priority
+		 * and keys localized for other locales are dropped here.
+		 */
+		if(locale)
+		{
+			priority=_xfdashboard_desktop_entry_get_locale_priority(languages, locale, localeLength);
+			if(priority<0) continue;
+		}
+			else priority=XFDASHBOARD_DESKTOP_ENTRY_UNLOCALIZED_PRIORITY;
+
+#define KEY_IS(inName)		(keyLength==strlen(inName) && strncmp(key, inName, keyLength)==0)
+
+		/* Handle localized keys */
+		if(KEY_IS("Name"))
+		{
+			if(namePriority<0 || priority<namePriority)
+			{
+				if(values.name) g_free(values.name);
+				values.name=_xfdashboard_desktop_entry_unescape(value, valueLength, 0);
+				namePriority=priority;
+			}
+			continue;
+		}
+
+		if(KEY_IS("Comment"))
+		{
+			if(commentPriority<0 || priority<commentPriority)
+			{
+				if(values.comment) g_free(values.comment);
+				values.comment=_xfdashboard_desktop_entry_unescape(value, valueLength, 0);
+				commentPriority=priority;
+			}
+			continue;
+		}
+
+		/* All other keys are only used unlocalized */
+		if(locale) continue;
+
+		if(KEY_IS("Exec"))
+		{
+			if(values.command) g_free(values.command);
+			values.command=_xfdashboard_desktop_entry_unescape(value, valueLength, 0);
+		}
+			else if(KEY_IS("Icon"))
+			{
+				if(values.iconName) g_free(values.iconName);
+				values.iconName=_xfdashboard_desktop_entry_unescape(value, valueLength, 0);
+			}
+			else if(KEY_IS("Path"))
+			{
+				if(values.path) g_free(values.path);
+				values.path=_xfdashboard_desktop_entry_unescape(value, valueLength, 0);
+			}
+			else if(KEY_IS("Terminal"))
+			{
+				values.requiresTerminal=_xfdashboard_desktop_entry_parse_boolean(value, valueLength);
+			}
+			else if(KEY_IS("StartupNotify"))
+			{
+				values.supportsStartupNotification=_xfdashboard_desktop_entry_parse_boolean(value, valueLength);
+			}
+			else if(KEY_IS("Hidden"))
+			{
+				values.isHidden=_xfdashboard_desktop_entry_parse_boolean(value, valueLength);
+			}
+			else if(KEY_IS("NoDisplay"))
+			{
+				values.noDisplay=_xfdashboard_desktop_entry_parse_boolean(value, valueLength);
+			}
+			else if(KEY_IS("OnlyShowIn"))
+			{
+				hasOnlyShowIn=TRUE;
+				matchesOnlyShowIn=_xfdashboard_desktop_entry_list_has_environment(value, valueLength, environments);
+			}
+			else if(KEY_IS("NotShowIn"))
+			{
+				matchesNotShowIn=_xfdashboard_desktop_entry_list_has_environment(value, valueLength, environments);
+			}
+
+#undef KEY_IS
+	}
+
+	/* Determine if desktop entry should be shown in current environment the
+	 * same way as menu items do. "OnlyShowIn" takes precedence over "NotShowIn".
+	 */
+	if(!inEnvironment) values.showInEnvironment=TRUE;
+		else if(hasOnlyShowIn) values.showInEnvironment=matchesOnlyShowIn;
+		else values.showInEnvironment=!matchesNotShowIn;
+
+	g_strfreev(environments);
+
+	/* Check that required keys exist */
+	if(!foundDesktopGroup)
+	{
+		g_set_error_literal(outError,
+							G_KEY_FILE_ERROR,
+							G_KEY_FILE_ERROR_GROUP_NOT_FOUND,
+							_("Desktop file does not have group 'Desktop Entry'"));
+		_xfdashboard_desktop_entry_values_clear(&values);
+		return(NULL);
+	}
+
+	if(!values.name || !g_utf8_validate(values.name, -1, NULL) || !values.command)
+	{
+		g_set_error_literal(outError,
+							G_KEY_FILE_ERROR,
+							G_KEY_FILE_ERROR_KEY_NOT_FOUND,
+							_("Desktop file does not have a valid name or command"));
+		_xfdashboard_desktop_entry_values_clear(&values);
+		return(NULL);
+	}
+
+	if(values.comment && !g_utf8_validate(values.comment, -1, NULL))
+	{
+		g_free(values.comment);
+		values.comment=NULL;
+	}
+
+	/* Create desktop entry from collected values */
+	entry=_xfdashboard_desktop_entry_new(&values);
+	_xfdashboard_desktop_entry_values_clear(&values);
+
+	return(entry);
+}
+
+/* Free desktop entry */
+void _xfdashboard_desktop_entry_free(XfdashboardDesktopEntry *inEntry)
+{
+	g_return_if_fail(inEntry);
+
+	/* Strings are stored in same memory block, so just free the memory block */
+	g_free(inEntry);
+}
@@ -0,0 +1,84 @@
+/*
+ * desktop-entry: Parser and compact storage of values of desktop files
+ * 
+ * Copyright 2012-2016 Stephan Haller <nomad@froevel.de>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ * 
+ * 
+ */
+
+#ifndef __LIBXFDASHBOARD_DESKTOP_ENTRY__
+#define __LIBXFDASHBOARD_DESKTOP_ENTRY__
+
+/* This header is private to library and not installed. Its functions are
+ * not exported as their names start with an underscore.
+ */
+#if !defined(LIBXFDASHBOARD_COMPILATION)
+#error "<libxfdashboard/desktop-entry.h> is private to libxfdashboard and cannot be included."
+#endif
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* Values of desktop entry used by desktop app info. All strings and the
+ * entry itself are stored in one memory block.
+ */
+typedef struct _XfdashboardDesktopEntry				XfdashboardDesktopEntry;
+struct _XfdashboardDesktopEntry
+{
+	const gchar	*name;
+	const gchar	*comment;
+	const gchar	*command;
+	const gchar	*binaryExecutable;
+	const gchar	*iconName;
+	const gchar	*path;
+	guint		requiresTerminal : 1;
+	guint		supportsStartupNotification : 1;
+	guint		isHidden : 1;
+	guint		noDisplay : 1;
+	guint		showInEnvironment : 1;
+};
+
+/* Values of desktop entry collected while parsing a desktop file */
+typedef struct _XfdashboardDesktopEntryValues	XfdashboardDesktopEntryValues;
+struct _XfdashboardDesktopEntryValues
+{
+	gchar		*name;
+	gchar		*comment;
+	gchar		*command;
+	gchar		*iconName;
+	gchar		*path;
+	gboolean	requiresTerminal;
+	gboolean	supportsStartupNotification;
+	gboolean	isHidden;
+	gboolean	noDisplay;
+	gboolean	showInEnvironment;
+};
+
+void _xfdashboard_desktop_entry_values_clear(XfdashboardDesktopEntryValues *ioValues);
+
+XfdashboardDesktopEntry* _xfdashboard_desktop_entry_new(const XfdashboardDesktopEntryValues *inValues);
+XfdashboardDesktopEntry* _xfdashboard_desktop_entry_new_from_data(const gchar *inData,
+																	gsize inLength,
+																	const gchar *inEnvironment,
+																	GError **outError);
+void _xfdashboard_desktop_entry_free(XfdashboardDesktopEntry *inEntry);
+
+G_END_DECLS
+
+#endif	/* __LIBXFDASHBOARD_DESKTOP_ENTRY__ */
@@ -45,6 +45,8 @@ G_DEFINE_TYPE(XfdashboardEmblemEffect,
 				CLUTTER_TYPE_EFFECT)
 
 /* Private structure - access only by public API if needed */
+typedef struct _XfdashboardEmblemEffectTexture		XfdashboardEmblemEffectTexture;
+
 #define XFDASHBOARD_EMBLEM_EFFECT_GET_PRIVATE(obj) \
 	(G_TYPE_INSTANCE_GET_PRIVATE((obj), XFDASHBOARD_TYPE_EMBLEM_EFFECT, XfdashboardEmblemEffectPrivate))
 
@@ -59,11 +61,7 @@ struct _XfdashboardEmblemEffectPrivate
 	XfdashboardAnchorPoint		anchorPoint;
 
 	/* Instance related */
-	ClutterContent				*icon;
-	guint						loadSuccessSignalID;
-	guint						loadFailedSignalID;
-
-	CoglPipeline				*pipeline;
+	XfdashboardEmblemEffectTexture	*texture;
 };
 
 /* Properties */
@@ -84,37 +82,187 @@ enum
 static GParamSpec* XfdashboardEmblemEffectProperties[PROP_LAST]={ 0, };
 
 /* IMPLEMENTATION: Private variables and methods */
-static CoglPipeline		*_xfdashboard_emblem_effect_base_pipeline=NULL;
 
-/* Icon image was loaded */
-static void _xfdashboard_emblem_effect_on_load_finished(XfdashboardEmblemEffect *self, gpointer inUserData)
+/* Emblem textures are shared by all emblem effects drawing the same icon
+ * at the same size. Each shared texture waits for its image being loaded
+ * only once and has one pipeline so that Cogl can batch the rectangles of
+ * all emblems drawn with it.
+ */
+struct _XfdashboardEmblemEffectTexture
 {
-	XfdashboardEmblemEffectPrivate		*priv;
+	gint						refCount;
+	gchar						*key;
 
-	g_return_if_fail(XFDASHBOARD_IS_EMBLEM_EFFECT(self));
+	ClutterContent				*icon;
+	guint						loadSuccessSignalID;
+	guint						loadFailedSignalID;
 
-	priv=self->priv;
+	CoglPipeline				*pipeline;
+
+	GSList						*effects;
+};
+
+static GHashTable		*_xfdashboard_emblem_effect_textures=NULL;
+static CoglPipeline		*_xfdashboard_emblem_effect_base_pipeline=NULL;
+
+/* Icon image of shared emblem texture was loaded */
+static void _xfdashboard_emblem_effect_texture_on_load_finished(XfdashboardEmblemEffectTexture *self, gpointer inUserData)
+{
+	GSList								*iter;
+
+	g_return_if_fail(self);
 
 	/* Disconnect signal handlers */
-	if(priv->loadSuccessSignalID)
+	if(self->loadSuccessSignalID)
 	{
-		g_signal_handler_disconnect(priv->icon, priv->loadSuccessSignalID);
-		priv->loadSuccessSignalID=0;
+		g_signal_handler_disconnect(self->icon, self->loadSuccessSignalID);
+		self->loadSuccessSignalID=0;
 	}
 
-	if(priv->loadFailedSignalID)
+	if(self->loadFailedSignalID)
 	{
-		g_signal_handler_disconnect(priv->icon, priv->loadFailedSignalID);
-		priv->loadFailedSignalID=0;
+		g_signal_handler_disconnect(self->icon, self->loadFailedSignalID);
+		self->loadFailedSignalID=0;
 	}
 
 	/* Set image at pipeline */
-	cogl_pipeline_set_layer_texture(priv->pipeline,
+	cogl_pipeline_set_layer_texture(self->pipeline,
 									0,
-									clutter_image_get_texture(CLUTTER_IMAGE(priv->icon)));
+									clutter_image_get_texture(CLUTTER_IMAGE(self->icon)));
 
-	/* Invalidate effect to get it redrawn */
-	clutter_effect_queue_repaint(CLUTTER_EFFECT(self));
+	/* Invalidate all effects using this texture to get them redrawn */
+	for(iter=self->effects; iter; iter=g_slist_next(iter))
+	{
+		clutter_effect_queue_repaint(CLUTTER_EFFECT(iter->data));
+	}
+}
+
+/* Get shared emblem texture for icon at size for an emblem effect */
+static XfdashboardEmblemEffectTexture* _xfdashboard_emblem_effect_texture_get(XfdashboardEmblemEffect *inEffect,
+																				const gchar *inIconName,
+																				gint inSize)
+{
+	XfdashboardEmblemEffectTexture		*texture;
+	XfdashboardImageContentLoadingState	loadingState;
+	gchar								*key;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_EMBLEM_EFFECT(inEffect), NULL);
+	g_return_val_if_fail(inIconName, NULL);
+	g_return_val_if_fail(inSize>0, NULL);
+
+	/* Create registry of shared emblem textures if not done yet */
+	if(G_UNLIKELY(!_xfdashboard_emblem_effect_textures))
+	{
+		_xfdashboard_emblem_effect_textures=g_hash_table_new(g_str_hash, g_str_equal);
+	}
+
+	/* Check if a shared emblem texture exists already and use it */
+	key=g_strdup_printf("%s,%d", inIconName, inSize);
+	texture=(XfdashboardEmblemEffectTexture*)g_hash_table_lookup(_xfdashboard_emblem_effect_textures, key);
+	if(texture)
+	{
+		g_free(key);
+
+		texture->refCount++;
+		texture->effects=g_slist_prepend(texture->effects, inEffect);
+
+		return(texture);
+	}
+
+	/* Create shared emblem texture with its own pipeline */
+	if(G_UNLIKELY(!_xfdashboard_emblem_effect_base_pipeline))
+	{
+		CoglContext						*context;
+
+		/* Get context to create base pipeline */
+		context=clutter_backend_get_cogl_context(clutter_get_default_backend());
+
+		/* Create base pipeline */
+		_xfdashboard_emblem_effect_base_pipeline=cogl_pipeline_new(context);
+		cogl_pipeline_set_layer_null_texture(_xfdashboard_emblem_effect_base_pipeline,
+												0, /* layer number */
+												COGL_TEXTURE_TYPE_2D);
+	}
+
+	texture=g_new0(XfdashboardEmblemEffectTexture, 1);
+	texture->refCount=1;
+	texture->key=key;
+	texture->pipeline=cogl_pipeline_copy(_xfdashboard_emblem_effect_base_pipeline);
+	texture->effects=g_slist_prepend(NULL, inEffect);
+
+	/* Get image from cache */
+	texture->icon=xfdashboard_image_content_new_for_icon_name(inIconName, inSize);
+
+	/* Ensure image is being loaded */
+	loadingState=xfdashboard_image_content_get_state(XFDASHBOARD_IMAGE_CONTENT(texture->icon));
+	if(loadingState==XFDASHBOARD_IMAGE_CONTENT_LOADING_STATE_NONE ||
+		loadingState==XFDASHBOARD_IMAGE_CONTENT_LOADING_STATE_LOADING)
+	{
+		/* Connect signals just because we need to wait for image being loaded */
+		texture->loadSuccessSignalID=g_signal_connect_swapped(texture->icon,
+																"loaded",
+																G_CALLBACK(_xfdashboard_emblem_effect_texture_on_load_finished),
+																texture);
+		texture->loadFailedSignalID=g_signal_connect_swapped(texture->icon,
+																"loading-failed",
+																G_CALLBACK(_xfdashboard_emblem_effect_texture_on_load_finished),
+																texture);
+
+		/* If image is not being loaded currently enforce loading now */
+		if(loadingState==XFDASHBOARD_IMAGE_CONTENT_LOADING_STATE_NONE)
+		{
+			xfdashboard_image_content_force_load(XFDASHBOARD_IMAGE_CONTENT(texture->icon));
+		}
+	}
+		else
+		{
+			/* Image is already loaded so set image at pipeline */
+			cogl_pipeline_set_layer_texture(texture->pipeline,
+											0,
+											clutter_image_get_texture(CLUTTER_IMAGE(texture->icon)));
+		}
+
+	/* Register shared emblem texture */
+	g_hash_table_insert(_xfdashboard_emblem_effect_textures, texture->key, texture);
+
+	return(texture);
+}
+
+/* Release shared emblem texture used by an emblem effect */
+static void _xfdashboard_emblem_effect_texture_release(XfdashboardEmblemEffectTexture *self,
+														XfdashboardEmblemEffect *inEffect)
+{
+	g_return_if_fail(self);
+	g_return_if_fail(self->refCount>0);
+
+	/* Forget emblem effect */
+	self->effects=g_slist_remove(self->effects, inEffect);
+
+	/* Decrease reference counter and destroy shared emblem texture
+	 * if it is not used anymore.
+	 */
+	self->refCount--;
+	if(self->refCount>0) return;
+
+	g_hash_table_remove(_xfdashboard_emblem_effect_textures, self->key);
+
+	if(self->loadSuccessSignalID)
+	{
+		g_signal_handler_disconnect(self->icon, self->loadSuccessSignalID);
+		self->loadSuccessSignalID=0;
+	}
+
+	if(self->loadFailedSignalID)
+	{
+		g_signal_handler_disconnect(self->icon, self->loadFailedSignalID);
+		self->loadFailedSignalID=0;
+	}
+
+	g_object_unref(self->icon);
+	cogl_object_unref(self->pipeline);
+	g_slist_free(self->effects);
+	g_free(self->key);
+	g_free(self);
 }
 
 /* IMPLEMENTATION: ClutterEffect */
@@ -149,40 +297,10 @@ static void _xfdashboard_emblem_effect_paint(ClutterEffect *inEffect, ClutterEff
 	/* If no icon name is set do not apply this effect */
 	if(!priv->iconName) return;
 
-	/* Load image if not done yet */
-	if(!priv->icon)
+	/* Get shared emblem texture if not done yet */
+	if(!priv->texture)
 	{
-		/* Get image from cache */
-		priv->icon=xfdashboard_image_content_new_for_icon_name(priv->iconName, priv->iconSize);
-
-		/* Ensure image is being loaded */
-		loadingState=xfdashboard_image_content_get_state(XFDASHBOARD_IMAGE_CONTENT(priv->icon));
-		if(loadingState==XFDASHBOARD_IMAGE_CONTENT_LOADING_STATE_NONE ||
-			loadingState==XFDASHBOARD_IMAGE_CONTENT_LOADING_STATE_LOADING)
-		{
-			/* Connect signals just because we need to wait for image being loaded */
-			priv->loadSuccessSignalID=g_signal_connect_swapped(priv->icon,
-																"loaded",
-																G_CALLBACK(_xfdashboard_emblem_effect_on_load_finished),
-																self);
-			priv->loadFailedSignalID=g_signal_connect_swapped(priv->icon,
-																"loading-failed",
-																G_CALLBACK(_xfdashboard_emblem_effect_on_load_finished),
-																self);
-
-			/* If image is not being loaded currently enforce loading now */
-			if(loadingState==XFDASHBOARD_IMAGE_CONTENT_LOADING_STATE_NONE)
-			{
-				xfdashboard_image_content_force_load(XFDASHBOARD_IMAGE_CONTENT(priv->icon));
-			}
-		}
-			else
-			{
-				/* Image is already loaded so set image at pipeline */
-				cogl_pipeline_set_layer_texture(priv->pipeline,
-												0,
-												clutter_image_get_texture(CLUTTER_IMAGE(priv->icon)));
-			}
+		priv->texture=_xfdashboard_emblem_effect_texture_get(self, priv->iconName, priv->iconSize);
 	}
 
 	/* Get actor size and apply padding. If actor width or height will drop
@@ -206,7 +324,7 @@ static void _xfdashboard_emblem_effect_paint(ClutterEffect *inEffect, ClutterEff
 	actorHeight=actorBox.y2-actorBox.y1;
 
 	/* Get texture size */
-	clutter_content_get_preferred_size(CLUTTER_CONTENT(priv->icon), &textureWidth, &textureHeight);
+	clutter_content_get_preferred_size(priv->texture->icon, &textureWidth, &textureHeight);
 	clutter_actor_box_init(&textureCoordBox, 0.0f, 0.0f, 1.0f, 1.0f);
 
 	/* Get boundary in X axis depending on anchorPoint and scaled width */
@@ -306,7 +424,7 @@ static void _xfdashboard_emblem_effect_paint(ClutterEffect *inEffect, ClutterEff
 	}
 
 	/* Draw icon if image was loaded */
-	loadingState=xfdashboard_image_content_get_state(XFDASHBOARD_IMAGE_CONTENT(priv->icon));
+	loadingState=xfdashboard_image_content_get_state(XFDASHBOARD_IMAGE_CONTENT(priv->texture->icon));
 	if(loadingState!=XFDASHBOARD_IMAGE_CONTENT_LOADING_STATE_LOADED_SUCCESSFULLY &&
 		loadingState!=XFDASHBOARD_IMAGE_CONTENT_LOADING_STATE_LOADED_FAILED)
 	{
@@ -316,9 +434,12 @@ static void _xfdashboard_emblem_effect_paint(ClutterEffect *inEffect, ClutterEff
 		return;
 	}
 
+	/* Draw with pipeline of shared emblem texture. Rectangles of emblems
+	 * drawn in sequence with the same pipeline are batched by Cogl.
+	 */
 	framebuffer=cogl_get_draw_framebuffer();
 	cogl_framebuffer_draw_textured_rectangle(framebuffer,
-												priv->pipeline,
+												priv->texture->pipeline,
 												rectangleBox.x1, rectangleBox.y1,
 												rectangleBox.x2, rectangleBox.y2,
 												textureCoordBox.x1, textureCoordBox.y1,
@@ -334,30 +455,10 @@ static void _xfdashboard_emblem_effect_dispose(GObject *inObject)
 	XfdashboardEmblemEffect			*self=XFDASHBOARD_EMBLEM_EFFECT(inObject);
 	XfdashboardEmblemEffectPrivate	*priv=self->priv;
 
-	if(priv->pipeline)
-	{
-		cogl_object_unref(priv->pipeline);
-		priv->pipeline=NULL;
-	}
-
-	if(priv->icon)
+	if(priv->texture)
 	{
-		/* Disconnect any connected signal handler */
-		if(priv->loadSuccessSignalID)
-		{
-			g_signal_handler_disconnect(priv->icon, priv->loadSuccessSignalID);
-			priv->loadSuccessSignalID=0;
-		}
-
-		if(priv->loadFailedSignalID)
-		{
-			g_signal_handler_disconnect(priv->icon, priv->loadFailedSignalID);
-			priv->loadFailedSignalID=0;
-		}
-
-		/* Release image itself */
-		g_object_unref(priv->icon);
-		priv->icon=NULL;
+		_xfdashboard_emblem_effect_texture_release(priv->texture, self);
+		priv->texture=NULL;
 	}
 
 	if(priv->iconName)
@@ -536,26 +637,7 @@ static void xfdashboard_emblem_effect_init(XfdashboardEmblemEffect *self)
 	priv->xAlign=0.0f;
 	priv->yAlign=0.0f;
 	priv->anchorPoint=XFDASHBOARD_ANCHOR_POINT_NONE;
-	priv->icon=NULL;
-	priv->loadSuccessSignalID=0;
-	priv->loadFailedSignalID=0;
-
-	/* Set up pipeline */
-	if(G_UNLIKELY(!_xfdashboard_emblem_effect_base_pipeline))
-    {
-		CoglContext					*context;
-
-		/* Get context to create base pipeline */
-		context=clutter_backend_get_cogl_context(clutter_get_default_backend());
-
-		/* Create base pipeline */
-		_xfdashboard_emblem_effect_base_pipeline=cogl_pipeline_new(context);
-		cogl_pipeline_set_layer_null_texture(_xfdashboard_emblem_effect_base_pipeline,
-												0, /* layer number */
-												COGL_TEXTURE_TYPE_2D);
-	}
-
-	priv->pipeline=cogl_pipeline_copy(_xfdashboard_emblem_effect_base_pipeline);
+	priv->texture=NULL;
 }
 
 /* IMPLEMENTATION: Public API */
@@ -584,17 +666,17 @@ void xfdashboard_emblem_effect_set_icon_name(XfdashboardEmblemEffect *self, cons
 	priv=self->priv;
 
 	/* Set value if changed */
-	if(priv->icon || g_strcmp0(priv->iconName, inIconName)!=0)
+	if(priv->texture || g_strcmp0(priv->iconName, inIconName)!=0)
 	{
 		/* Set value */
 		if(priv->iconName) g_free(priv->iconName);
 		priv->iconName=g_strdup(inIconName);
 
-		/* Dispose any icon image loaded */
-		if(priv->icon)
+		/* Release any shared emblem texture used */
+		if(priv->texture)
 		{
-			g_object_unref(priv->icon);
-			priv->icon=NULL;
+			_xfdashboard_emblem_effect_texture_release(priv->texture, self);
+			priv->texture=NULL;
 		}
 
 		/* Invalidate effect to get it redrawn */
@@ -628,11 +710,11 @@ void xfdashboard_emblem_effect_set_icon_size(XfdashboardEmblemEffect *self, cons
 		/* Set value */
 		priv->iconSize=inSize;
 
-		/* Dispose any icon image loaded */
-		if(priv->icon)
+		/* Release any shared emblem texture used */
+		if(priv->texture)
 		{
-			g_object_unref(priv->icon);
-			priv->icon=NULL;
+			_xfdashboard_emblem_effect_texture_release(priv->texture, self);
+			priv->texture=NULL;
 		}
 
 		/* Invalidate effect to get it redrawn */
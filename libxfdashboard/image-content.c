@@ -33,6 +33,7 @@
 
 #include <libxfdashboard/application.h>
 #include <libxfdashboard/stylable.h>
+#include <libxfdashboard/instrumentation.h>
 #include <libxfdashboard/compat.h>
 
 
@@ -80,6 +81,8 @@ struct _XfdashboardImageContentPrivate
 
 	guint								contentAttachedSignalID;
 	guint								iconThemeChangedSignalID;
+
+	gboolean							isReleased;
 };
 
 /* Properties */
@@ -113,9 +116,15 @@ static guint XfdashboardImageContentSignals[SIGNAL_LAST]={ 0, };
 /* IMPLEMENTATION: Private variables and methods */
 static GHashTable*	_xfdashboard_image_content_cache=NULL;
 static guint		_xfdashboard_image_content_cache_shutdownSignalID=0;
+static guint		_xfdashboard_image_content_cache_suspendSignalID=0;
+static guint		_xfdashboard_image_content_cache_resumeSignalID=0;
 
 #define XFDASHBOARD_IMAGE_CONTENT_DEFAULT_FALLBACK_ICON_NAME		"image-missing"
 
+/* Forward declarations */
+static void _xfdashboard_image_content_on_application_suspend(XfdashboardApplication *inApplication, gpointer inUserData);
+static void _xfdashboard_image_content_on_application_resume(XfdashboardApplication *inApplication, gpointer inUserData);
+
 /* Get image from cache if available */
 static ClutterImage* _xfdashboard_image_content_get_cached_image(const gchar *inKey)
 {
@@ -128,7 +137,13 @@ static ClutterImage* _xfdashboard_image_content_get_cached_image(const gchar *in
 	if(!_xfdashboard_image_content_cache) return(NULL);
 
 	/* Lookup key in cache and return image if found */
-	if(!g_hash_table_contains(_xfdashboard_image_content_cache, inKey)) return(NULL);
+	if(!g_hash_table_contains(_xfdashboard_image_content_cache, inKey))
+	{
+		xfdashboard_instrumentation_add(XFDASHBOARD_INSTRUMENTATION_COUNTER_IMAGE_CACHE_MISSES, 1);
+		return(NULL);
+	}
+
+	xfdashboard_instrumentation_add(XFDASHBOARD_INSTRUMENTATION_COUNTER_IMAGE_CACHE_HITS, 1);
 
 	/* Get loaded image and reference it */
 	image=CLUTTER_IMAGE(g_hash_table_lookup(_xfdashboard_image_content_cache, inKey));
@@ -152,6 +167,12 @@ static void _xfdashboard_image_content_destroy_cache(void)
 	g_signal_handler_disconnect(application, _xfdashboard_image_content_cache_shutdownSignalID);
 	_xfdashboard_image_content_cache_shutdownSignalID=0;
 
+	g_signal_handler_disconnect(application, _xfdashboard_image_content_cache_suspendSignalID);
+	_xfdashboard_image_content_cache_suspendSignalID=0;
+
+	g_signal_handler_disconnect(application, _xfdashboard_image_content_cache_resumeSignalID);
+	_xfdashboard_image_content_cache_resumeSignalID=0;
+
 	/* Destroy cache hashtable */
 	cacheSize=g_hash_table_size(_xfdashboard_image_content_cache);
 	if(cacheSize>0) g_warning(_("Destroying image cache still containing %d images."), cacheSize);
@@ -178,6 +199,12 @@ static void _xfdashboard_image_content_create_cache(void)
 	 */
 	application=xfdashboard_application_get_default();
 	_xfdashboard_image_content_cache_shutdownSignalID=g_signal_connect(application, "shutdown-final", G_CALLBACK(_xfdashboard_image_content_destroy_cache), NULL);
+
+	/* Connect to "suspend" and "resume" signal of application to release
+	 * textures of cached images while suspended if requested.
+	 */
+	_xfdashboard_image_content_cache_suspendSignalID=g_signal_connect(application, "suspend", G_CALLBACK(_xfdashboard_image_content_on_application_suspend), NULL);
+	_xfdashboard_image_content_cache_resumeSignalID=g_signal_connect(application, "resume", G_CALLBACK(_xfdashboard_image_content_on_application_resume), NULL);
 }
 
 /* Remove image from cache */
@@ -1033,6 +1060,78 @@ static void _xfdashboard_image_content_on_attached(ClutterContent *inContent,
 	}
 }
 
+/* Application was suspended so release textures of loaded images if requested */
+static void _xfdashboard_image_content_on_application_suspend(XfdashboardApplication *inApplication, gpointer inUserData)
+{
+	GHashTableIter						iter;
+	XfdashboardImageContent				*image;
+	XfdashboardImageContentPrivate		*priv;
+	guint								released;
+
+	g_return_if_fail(XFDASHBOARD_IS_APPLICATION(inApplication));
+
+	/* Check if textures should be released */
+	if(xfdashboard_application_get_suspend_memory_policy(inApplication)<XFDASHBOARD_SUSPEND_MEMORY_POLICY_TEXTURES) return;
+
+	/* Only images in cache can be released */
+	if(!_xfdashboard_image_content_cache) return;
+
+	/* Replace texture of each successfully loaded image by an empty one.
+	 * The image will be reloaded when application is resumed.
+	 */
+	released=0;
+	g_hash_table_iter_init(&iter, _xfdashboard_image_content_cache);
+	while(g_hash_table_iter_next(&iter, NULL, (gpointer*)&image))
+	{
+		priv=image->priv;
+
+		if(priv->type==XFDASHBOARD_IMAGE_TYPE_NONE ||
+			priv->loadState!=XFDASHBOARD_IMAGE_CONTENT_LOADING_STATE_LOADED_SUCCESSFULLY)
+		{
+			continue;
+		}
+
+		_xfdashboard_image_content_set_empty_image(image);
+		priv->loadState=XFDASHBOARD_IMAGE_CONTENT_LOADING_STATE_NONE;
+		priv->isReleased=TRUE;
+		released++;
+	}
+
+	g_debug("Released textures of %u cached images on suspend", released);
+}
+
+/* Application was resumed so reload images whose textures were released */
+static void _xfdashboard_image_content_on_application_resume(XfdashboardApplication *inApplication, gpointer inUserData)
+{
+	GHashTableIter						iter;
+	XfdashboardImageContent				*image;
+	GList								*reloadImages;
+	GList								*reloadIter;
+
+	g_return_if_fail(XFDASHBOARD_IS_APPLICATION(inApplication));
+
+	/* Only images in cache could have been released */
+	if(!_xfdashboard_image_content_cache) return;
+
+	/* Collect images to reload first as reloading may modify cache */
+	reloadImages=NULL;
+	g_hash_table_iter_init(&iter, _xfdashboard_image_content_cache);
+	while(g_hash_table_iter_next(&iter, NULL, (gpointer*)&image))
+	{
+		if(!image->priv->isReleased) continue;
+
+		image->priv->isReleased=FALSE;
+		reloadImages=g_list_prepend(reloadImages, g_object_ref(image));
+	}
+
+	/* Reload images */
+	for(reloadIter=reloadImages; reloadIter; reloadIter=g_list_next(reloadIter))
+	{
+		_xfdashboard_image_content_on_attached(CLUTTER_CONTENT(reloadIter->data), NULL, NULL);
+	}
+	g_list_free_full(reloadImages, g_object_unref);
+}
+
 /* IMPLEMENTATION: Interface XfdashboardStylable */
 
 /* Get stylable properties of stage */
@@ -1265,6 +1364,7 @@ void xfdashboard_image_content_init(XfdashboardImageContent *self)
 	priv->gicon=NULL;
 	priv->iconSize=0;
 	priv->loadState=XFDASHBOARD_IMAGE_CONTENT_LOADING_STATE_NONE;
+	priv->isReleased=FALSE;
 	priv->iconTheme=gtk_icon_theme_get_default();
 	priv->missingIconName=g_strdup(XFDASHBOARD_IMAGE_CONTENT_DEFAULT_FALLBACK_ICON_NAME);
 
@@ -0,0 +1,111 @@
+/*
+ * instrumentation: Counters of library internals for performance
+ *                  inspection at runtime
+ * 
+ * Copyright 2012-2016 Stephan Haller <nomad@froevel.de>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ * 
+ * 
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <libxfdashboard/instrumentation.h>
+
+#include <libxfdashboard/compat.h>
+
+
+/* IMPLEMENTATION: Private variables and methods */
+#define XFDASHBOARD_INSTRUMENTATION_COUNTERS	(XFDASHBOARD_INSTRUMENTATION_COUNTER_SEARCH_TIME+1)
+
+/* Number of users which enabled instrumentation */
+static guint		_xfdashboard_instrumentation_users=0;
+
+/* Values of counters */
+static gint64		_xfdashboard_instrumentation_counters[XFDASHBOARD_INSTRUMENTATION_COUNTERS]={ 0, };
+
+
+/* IMPLEMENTATION: Public API */
+
+/* Enable collecting counters. Each call must be balanced by a call to
+ * xfdashboard_instrumentation_disable(). Counters are reset when collecting
+ * starts, except for counters which are always kept up-to-date by set().
+ */
+void xfdashboard_instrumentation_enable(void)
+{
+	if(_xfdashboard_instrumentation_users==0)
+	{
+		_xfdashboard_instrumentation_counters[XFDASHBOARD_INSTRUMENTATION_COUNTER_RESTYLES]=0;
+		_xfdashboard_instrumentation_counters[XFDASHBOARD_INSTRUMENTATION_COUNTER_IMAGE_CACHE_HITS]=0;
+		_xfdashboard_instrumentation_counters[XFDASHBOARD_INSTRUMENTATION_COUNTER_IMAGE_CACHE_MISSES]=0;
+		_xfdashboard_instrumentation_counters[XFDASHBOARD_INSTRUMENTATION_COUNTER_SEARCHES]=0;
+		_xfdashboard_instrumentation_counters[XFDASHBOARD_INSTRUMENTATION_COUNTER_SEARCH_TIME]=0;
+
+		g_debug("Enabled instrumentation");
+	}
+
+	_xfdashboard_instrumentation_users++;
+}
+
+/* Disable collecting counters */
+void xfdashboard_instrumentation_disable(void)
+{
+	g_return_if_fail(_xfdashboard_instrumentation_users>0);
+
+	_xfdashboard_instrumentation_users--;
+	if(_xfdashboard_instrumentation_users==0) g_debug("Disabled instrumentation");
+}
+
+/* Check if counters are collected */
+gboolean xfdashboard_instrumentation_is_enabled(void)
+{
+	return(_xfdashboard_instrumentation_users>0 ? TRUE : FALSE);
+}
+
+/* Add value to counter. Nothing is done if instrumentation is not enabled,
+ * so callers in hot paths only pay for this check.
+ */
+void xfdashboard_instrumentation_add(XfdashboardInstrumentationCounter inCounter, gint64 inValue)
+{
+	if(G_LIKELY(_xfdashboard_instrumentation_users==0)) return;
+
+	g_return_if_fail(inCounter<XFDASHBOARD_INSTRUMENTATION_COUNTERS);
+
+	_xfdashboard_instrumentation_counters[inCounter]+=inValue;
+}
+
+/* Set counter to value. Unlike xfdashboard_instrumentation_add() the value is
+ * stored even if instrumentation is not enabled. It is meant for counters of
+ * current states which change rarely, e.g. number of existing objects, to be
+ * valid as soon as instrumentation gets enabled.
+ */
+void xfdashboard_instrumentation_set(XfdashboardInstrumentationCounter inCounter, gint64 inValue)
+{
+	g_return_if_fail(inCounter<XFDASHBOARD_INSTRUMENTATION_COUNTERS);
+
+	_xfdashboard_instrumentation_counters[inCounter]=inValue;
+}
+
+/* Get current value of counter */
+gint64 xfdashboard_instrumentation_get(XfdashboardInstrumentationCounter inCounter)
+{
+	g_return_val_if_fail(inCounter<XFDASHBOARD_INSTRUMENTATION_COUNTERS, 0);
+
+	return(_xfdashboard_instrumentation_counters[inCounter]);
+}
@@ -0,0 +1,68 @@
+/*
+ * instrumentation: Counters of library internals for performance
+ *                  inspection at runtime
+ * 
+ * Copyright 2012-2016 Stephan Haller <nomad@froevel.de>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ * 
+ * 
+ */
+
+#ifndef __LIBXFDASHBOARD_INSTRUMENTATION__
+#define __LIBXFDASHBOARD_INSTRUMENTATION__
+
+#if !defined(__LIBXFDASHBOARD_H_INSIDE__) && !defined(LIBXFDASHBOARD_COMPILATION)
+#error "Only <libxfdashboard/libxfdashboard.h> can be included directly."
+#endif
+
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+/**
+ * XfdashboardInstrumentationCounter:
+ * @XFDASHBOARD_INSTRUMENTATION_COUNTER_RESTYLES: Number of actors restyled by theme.
+ * @XFDASHBOARD_INSTRUMENTATION_COUNTER_WINDOW_CONTENTS: Number of live window textures currently existing.
+ * @XFDASHBOARD_INSTRUMENTATION_COUNTER_IMAGE_CACHE_HITS: Number of images found in image cache.
+ * @XFDASHBOARD_INSTRUMENTATION_COUNTER_IMAGE_CACHE_MISSES: Number of images not found in image cache.
+ * @XFDASHBOARD_INSTRUMENTATION_COUNTER_SEARCHES: Number of searches performed.
+ * @XFDASHBOARD_INSTRUMENTATION_COUNTER_SEARCH_TIME: Time in microseconds spent to update search results.
+ *
+ * Counters of library internals collected while instrumentation is enabled.
+ */
+typedef enum /*< prefix=XFDASHBOARD_INSTRUMENTATION_COUNTER >*/
+{
+	XFDASHBOARD_INSTRUMENTATION_COUNTER_RESTYLES=0,
+	XFDASHBOARD_INSTRUMENTATION_COUNTER_WINDOW_CONTENTS,
+	XFDASHBOARD_INSTRUMENTATION_COUNTER_IMAGE_CACHE_HITS,
+	XFDASHBOARD_INSTRUMENTATION_COUNTER_IMAGE_CACHE_MISSES,
+	XFDASHBOARD_INSTRUMENTATION_COUNTER_SEARCHES,
+	XFDASHBOARD_INSTRUMENTATION_COUNTER_SEARCH_TIME
+} XfdashboardInstrumentationCounter;
+
+/* Public API */
+void xfdashboard_instrumentation_enable(void);
+void xfdashboard_instrumentation_disable(void);
+gboolean xfdashboard_instrumentation_is_enabled(void);
+
+void xfdashboard_instrumentation_add(XfdashboardInstrumentationCounter inCounter, gint64 inValue);
+void xfdashboard_instrumentation_set(XfdashboardInstrumentationCounter inCounter, gint64 inValue);
+gint64 xfdashboard_instrumentation_get(XfdashboardInstrumentationCounter inCounter);
+
+G_END_DECLS
+
+#endif	/* __LIBXFDASHBOARD_INSTRUMENTATION__ */
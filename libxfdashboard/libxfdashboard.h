@@ -52,6 +52,7 @@
 #include <libxfdashboard/focusable.h>
 #include <libxfdashboard/focus-manager.h>
 #include <libxfdashboard/image-content.h>
+#include <libxfdashboard/instrumentation.h>
 #include <libxfdashboard/libxfdashboard.h>
 #include <libxfdashboard/live-window.h>
 #include <libxfdashboard/live-workspace.h>
@@ -63,6 +64,7 @@
 #include <libxfdashboard/scrollbar.h>
 #include <libxfdashboard/search-manager.h>
 #include <libxfdashboard/search-provider.h>
+#include <libxfdashboard/search-query.h>
 #include <libxfdashboard/search-result-container.h>
 #include <libxfdashboard/search-result-set.h>
 #include <libxfdashboard/search-view.h>
@@ -76,6 +78,7 @@
 #include <libxfdashboard/theme-layout.h>
 #include <libxfdashboard/toggle-button.h>
 #include <libxfdashboard/tooltip-action.h>
+#include <libxfdashboard/transition-manager.h>
 #include <libxfdashboard/types.h>
 #include <libxfdashboard/utils.h>
 #include <libxfdashboard/view.h>
@@ -83,6 +86,7 @@
 #include <libxfdashboard/viewpad.h>
 #include <libxfdashboard/view-selector.h>
 #include <libxfdashboard/window-content.h>
+#include <libxfdashboard/windows-search-provider.h>
 #include <libxfdashboard/windows-view.h>
 #include <libxfdashboard/window-tracker.h>
 #include <libxfdashboard/window-tracker-monitor.h>
@@ -62,11 +62,18 @@ struct _XfdashboardLiveWorkspacePrivate
 	XfdashboardStageBackgroundImageType		backgroundType;
 	gboolean								showWorkspaceName;
 	gfloat									workspaceNamePadding;
+	guint									cacheRefreshInterval;
 
 	/* Instance related */
 	XfdashboardWindowTracker				*windowTracker;
 	ClutterActor							*backgroundImageLayer;
 	ClutterActor							*actorTitle;
+
+	CoglTexture								*cacheTexture;
+	CoglOffscreen							*cacheOffscreen;
+	CoglPipeline							*cachePipeline;
+	gboolean								cacheRefreshDue;
+	guint									cacheRefreshID;
 };
 
 /* Properties */
@@ -80,6 +87,7 @@ enum
 	PROP_BACKGROUND_IMAGE_TYPE,
 	PROP_SHOW_WORKSPACE_NAME,
 	PROP_WORKSPACE_NAME_PADDING,
+	PROP_CACHE_REFRESH_INTERVAL,
 
 	PROP_LAST
 };
@@ -453,6 +461,171 @@ static void _xfdashboard_live_workspace_on_desktop_window_opened(XfdashboardLive
 	}
 }
 
+/* Release cached composite texture of workspace */
+static void _xfdashboard_live_workspace_cache_release(XfdashboardLiveWorkspace *self)
+{
+	XfdashboardLiveWorkspacePrivate		*priv;
+
+	g_return_if_fail(XFDASHBOARD_IS_LIVE_WORKSPACE(self));
+
+	priv=self->priv;
+
+	/* Remove pending refresh */
+	if(priv->cacheRefreshID)
+	{
+		g_source_remove(priv->cacheRefreshID);
+		priv->cacheRefreshID=0;
+	}
+
+	/* Release offscreen framebuffer and texture */
+	if(priv->cacheOffscreen)
+	{
+		cogl_object_unref(priv->cacheOffscreen);
+		priv->cacheOffscreen=NULL;
+	}
+
+	if(priv->cacheTexture)
+	{
+		cogl_object_unref(priv->cacheTexture);
+		priv->cacheTexture=NULL;
+	}
+
+	/* Force re-rendering of cache at next paint */
+	priv->cacheRefreshDue=TRUE;
+}
+
+/* Refresh interval for cached composite texture elapsed */
+static gboolean _xfdashboard_live_workspace_on_cache_refresh_timeout(gpointer inUserData)
+{
+	XfdashboardLiveWorkspace			*self;
+	XfdashboardLiveWorkspacePrivate		*priv;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_LIVE_WORKSPACE(inUserData), G_SOURCE_REMOVE);
+
+	self=XFDASHBOARD_LIVE_WORKSPACE(inUserData);
+	priv=self->priv;
+
+	/* Source will be removed so forget its ID */
+	priv->cacheRefreshID=0;
+
+	/* Queue a redraw at this actor which will re-render the cached texture */
+	priv->cacheRefreshDue=TRUE;
+	clutter_actor_queue_redraw(CLUTTER_ACTOR(self));
+
+	return(G_SOURCE_REMOVE);
+}
+
+/* Render all children except title actor into cached composite texture */
+static gboolean _xfdashboard_live_workspace_cache_update(XfdashboardLiveWorkspace *self,
+															gfloat inWidth,
+															gfloat inHeight)
+{
+	XfdashboardLiveWorkspacePrivate		*priv;
+	CoglFramebuffer						*framebuffer;
+	ClutterActorIter					iter;
+	ClutterActor						*child;
+	gint								textureWidth;
+	gint								textureHeight;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_LIVE_WORKSPACE(self), FALSE);
+
+	priv=self->priv;
+
+	/* Determine size of texture needed */
+	textureWidth=(gint)ceil(inWidth);
+	textureHeight=(gint)ceil(inHeight);
+	if(textureWidth<=0 || textureHeight<=0) return(FALSE);
+
+	/* Drop texture if size of actor changed */
+	if(priv->cacheTexture &&
+		(cogl_texture_get_width(priv->cacheTexture)!=(guint)textureWidth ||
+			cogl_texture_get_height(priv->cacheTexture)!=(guint)textureHeight))
+	{
+		if(priv->cacheOffscreen)
+		{
+			cogl_object_unref(priv->cacheOffscreen);
+			priv->cacheOffscreen=NULL;
+		}
+
+		cogl_object_unref(priv->cacheTexture);
+		priv->cacheTexture=NULL;
+	}
+
+	/* Create texture and offscreen framebuffer to render into if needed */
+	if(!priv->cacheTexture)
+	{
+#if COGL_VERSION_CHECK(1, 18, 0)
+		CoglContext						*context;
+		CoglError						*error;
+
+		context=clutter_backend_get_cogl_context(clutter_get_default_backend());
+		priv->cacheTexture=COGL_TEXTURE(cogl_texture_2d_new_with_size(context, textureWidth, textureHeight));
+		priv->cacheOffscreen=cogl_offscreen_new_with_texture(priv->cacheTexture);
+
+		error=NULL;
+		if(!cogl_framebuffer_allocate(COGL_FRAMEBUFFER(priv->cacheOffscreen), &error))
+		{
+			g_warning(_("Could not create cached texture of workspace: %s"),
+						(error && error->message) ? error->message : _("Unknown error"));
+
+			if(error) cogl_error_free(error);
+			_xfdashboard_live_workspace_cache_release(self);
+			return(FALSE);
+		}
+#else
+		priv->cacheTexture=cogl_texture_new_with_size(textureWidth,
+														textureHeight,
+														COGL_TEXTURE_NO_SLICING,
+														COGL_PIXEL_FORMAT_RGBA_8888_PRE);
+		if(priv->cacheTexture) priv->cacheOffscreen=cogl_offscreen_new_to_texture(priv->cacheTexture);
+
+		if(!priv->cacheTexture || !priv->cacheOffscreen)
+		{
+			g_warning(_("Could not create cached texture of workspace"));
+
+			_xfdashboard_live_workspace_cache_release(self);
+			return(FALSE);
+		}
+#endif
+
+		/* Create pipeline to draw cached texture with */
+		if(!priv->cachePipeline)
+		{
+			CoglContext					*pipelineContext;
+
+			pipelineContext=clutter_backend_get_cogl_context(clutter_get_default_backend());
+			priv->cachePipeline=cogl_pipeline_new(pipelineContext);
+		}
+		cogl_pipeline_set_layer_texture(priv->cachePipeline, 0, priv->cacheTexture);
+	}
+
+	/* Render children into offscreen framebuffer. The orthographic projection
+	 * maps this actor's coordinate space onto the whole texture, so children
+	 * can just be painted with their usual transformations.
+	 */
+	framebuffer=COGL_FRAMEBUFFER(priv->cacheOffscreen);
+	cogl_push_framebuffer(framebuffer);
+
+	cogl_framebuffer_orthographic(framebuffer, 0.0f, 0.0f, inWidth, inHeight, -1.0f, 100.0f);
+	cogl_framebuffer_identity_matrix(framebuffer);
+	cogl_framebuffer_clear4f(framebuffer, COGL_BUFFER_BIT_COLOR, 0.0f, 0.0f, 0.0f, 0.0f);
+
+	clutter_actor_iter_init(&iter, CLUTTER_ACTOR(self));
+	while(clutter_actor_iter_next(&iter, &child))
+	{
+		if(child==priv->actorTitle) continue;
+
+		clutter_actor_paint(child);
+	}
+
+	cogl_pop_framebuffer();
+
+	/* Cached texture is up-to-date now */
+	priv->cacheRefreshDue=FALSE;
+
+	return(TRUE);
+}
+
 /* IMPLEMENTATION: ClutterActor */
 
 /* Get preferred width/height */
@@ -693,6 +866,132 @@ static void _xfdashboard_live_workspace_allocate(ClutterActor *self,
 		}
 }
 
+/* A redraw was queued at this actor or one of its children */
+static void _xfdashboard_live_workspace_queue_redraw(ClutterActor *inActor, ClutterActor *inOrigin)
+{
+	XfdashboardLiveWorkspace			*self;
+	XfdashboardLiveWorkspacePrivate		*priv;
+
+	g_return_if_fail(XFDASHBOARD_IS_LIVE_WORKSPACE(inActor));
+
+	self=XFDASHBOARD_LIVE_WORKSPACE(inActor);
+	priv=self->priv;
+
+	/* If cached composite texture is used, damage at any window child marks
+	 * the cache as dirty and it is re-rendered when the refresh interval
+	 * elapsed. Until then the stage may still be redrawn, e.g. because the
+	 * same window content is shown live in windows view, but this actor
+	 * keeps painting its cached texture instead of compositing all windows.
+	 * The redraw cannot be suppressed here as clutter has already scheduled
+	 * the stage update for the origin actor when this function is called.
+	 */
+	if(priv->cacheRefreshInterval>0 &&
+		inOrigin!=inActor &&
+		priv->actorTitle &&
+		!clutter_actor_contains(priv->actorTitle, inOrigin))
+	{
+		if(!priv->cacheRefreshID)
+		{
+			priv->cacheRefreshID=clutter_threads_add_timeout(priv->cacheRefreshInterval,
+																_xfdashboard_live_workspace_on_cache_refresh_timeout,
+																self);
+		}
+	}
+
+	/* A redraw queued at this actor itself requires an up-to-date cache */
+	if(inOrigin==inActor) priv->cacheRefreshDue=TRUE;
+
+	/* Call parent's class queue-redraw method */
+	if(CLUTTER_ACTOR_CLASS(xfdashboard_live_workspace_parent_class)->queue_redraw)
+	{
+		CLUTTER_ACTOR_CLASS(xfdashboard_live_workspace_parent_class)->queue_redraw(inActor, inOrigin);
+	}
+}
+
+/* Get paint volume of this actor */
+static gboolean _xfdashboard_live_workspace_get_paint_volume(ClutterActor *inActor,
+																ClutterPaintVolume *outVolume)
+{
+	XfdashboardLiveWorkspacePrivate		*priv;
+	ClutterActorIter					iter;
+	ClutterActor						*child;
+	const ClutterPaintVolume			*childVolume;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_LIVE_WORKSPACE(inActor), FALSE);
+
+	priv=XFDASHBOARD_LIVE_WORKSPACE(inActor)->priv;
+
+	/* This actor paints at least its allocation */
+	if(!clutter_paint_volume_set_from_allocation(outVolume, inActor)) return(FALSE);
+
+	/* If clipped to monitor or drawn from cached texture nothing will be
+	 * painted outside the allocation.
+	 */
+	if(priv->monitor || priv->cacheRefreshInterval>0) return(TRUE);
+
+	/* Otherwise windows partly outside of screen may be painted outside
+	 * of allocation so add the paint volumes of all children.
+	 */
+	clutter_actor_iter_init(&iter, inActor);
+	while(clutter_actor_iter_next(&iter, &child))
+	{
+		if(!clutter_actor_is_visible(child)) continue;
+
+		childVolume=clutter_actor_get_transformed_paint_volume(child, inActor);
+		if(!childVolume) return(FALSE);
+
+		clutter_paint_volume_union(outVolume, childVolume);
+	}
+
+	return(TRUE);
+}
+
+/* Paint this actor */
+static void _xfdashboard_live_workspace_paint(ClutterActor *inActor)
+{
+	XfdashboardLiveWorkspace			*self;
+	XfdashboardLiveWorkspacePrivate		*priv;
+	gfloat								width, height;
+
+	g_return_if_fail(XFDASHBOARD_IS_LIVE_WORKSPACE(inActor));
+
+	self=XFDASHBOARD_LIVE_WORKSPACE(inActor);
+	priv=self->priv;
+
+	/* If cached composite texture is not used, paint all children as usual */
+	if(priv->cacheRefreshInterval==0)
+	{
+		CLUTTER_ACTOR_CLASS(xfdashboard_live_workspace_parent_class)->paint(inActor);
+		return;
+	}
+
+	/* Re-render cached texture if missing or out of date */
+	clutter_actor_get_size(inActor, &width, &height);
+	if(!priv->cacheTexture ||
+		priv->cacheRefreshDue ||
+		cogl_texture_get_width(priv->cacheTexture)!=(guint)ceil(width) ||
+		cogl_texture_get_height(priv->cacheTexture)!=(guint)ceil(height))
+	{
+		if(!_xfdashboard_live_workspace_cache_update(self, width, height))
+		{
+			/* Fallback to paint all children as usual */
+			CLUTTER_ACTOR_CLASS(xfdashboard_live_workspace_parent_class)->paint(inActor);
+			return;
+		}
+	}
+
+	/* Draw cached texture as one quad */
+	cogl_framebuffer_draw_textured_rectangle(cogl_get_draw_framebuffer(),
+												priv->cachePipeline,
+												0.0f, 0.0f,
+												width, height,
+												0.0f, 0.0f,
+												1.0f, 1.0f);
+
+	/* Paint title actor on top of cached texture */
+	if(priv->actorTitle) clutter_actor_paint(priv->actorTitle);
+}
+
 /* IMPLEMENTATION: GObject */
 
 /* Dispose this object */
@@ -704,6 +1003,14 @@ static void _xfdashboard_live_workspace_dispose(GObject *inObject)
 	/* Dispose allocated resources */
 	g_object_set_data(inObject, WINDOW_DATA_KEY, NULL);
 
+	_xfdashboard_live_workspace_cache_release(self);
+
+	if(priv->cachePipeline)
+	{
+		cogl_object_unref(priv->cachePipeline);
+		priv->cachePipeline=NULL;
+	}
+
 	if(priv->actorTitle)
 	{
 		clutter_actor_destroy(priv->actorTitle);
@@ -773,6 +1080,10 @@ static void _xfdashboard_live_workspace_set_property(GObject *inObject,
 			xfdashboard_live_workspace_set_workspace_name_padding(self, g_value_get_float(inValue));
 			break;
 
+		case PROP_CACHE_REFRESH_INTERVAL:
+			xfdashboard_live_workspace_set_cache_refresh_interval(self, g_value_get_uint(inValue));
+			break;
+
 		default:
 			G_OBJECT_WARN_INVALID_PROPERTY_ID(inObject, inPropID, inSpec);
 			break;
@@ -812,6 +1123,10 @@ static void _xfdashboard_live_workspace_get_property(GObject *inObject,
 			g_value_set_float(outValue, self->priv->workspaceNamePadding);
 			break;
 
+		case PROP_CACHE_REFRESH_INTERVAL:
+			g_value_set_uint(outValue, self->priv->cacheRefreshInterval);
+			break;
+
 		default:
 			G_OBJECT_WARN_INVALID_PROPERTY_ID(inObject, inPropID, inSpec);
 			break;
@@ -832,6 +1147,9 @@ static void xfdashboard_live_workspace_class_init(XfdashboardLiveWorkspaceClass
 	clutterActorClass->get_preferred_width=_xfdashboard_live_workspace_get_preferred_width;
 	clutterActorClass->get_preferred_height=_xfdashboard_live_workspace_get_preferred_height;
 	clutterActorClass->allocate=_xfdashboard_live_workspace_allocate;
+	clutterActorClass->paint=_xfdashboard_live_workspace_paint;
+	clutterActorClass->get_paint_volume=_xfdashboard_live_workspace_get_paint_volume;
+	clutterActorClass->queue_redraw=_xfdashboard_live_workspace_queue_redraw;
 
 	gobjectClass->dispose=_xfdashboard_live_workspace_dispose;
 	gobjectClass->set_property=_xfdashboard_live_workspace_set_property;
@@ -885,6 +1203,14 @@ static void xfdashboard_live_workspace_class_init(XfdashboardLiveWorkspaceClass
 							0.0f,
 							G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
 
+	XfdashboardLiveWorkspaceProperties[PROP_CACHE_REFRESH_INTERVAL]=
+		g_param_spec_uint("cache-refresh-interval",
+							_("Cache refresh interval"),
+							_("Interval in milliseconds at which the cached texture of workspace is re-rendered on changes. If zero the workspace is drawn live without a cache"),
+							0, G_MAXUINT,
+							0,
+							G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
 	g_object_class_install_properties(gobjectClass, PROP_LAST, XfdashboardLiveWorkspaceProperties);
 
 	/* Define stylable properties */
@@ -892,6 +1218,7 @@ static void xfdashboard_live_workspace_class_init(XfdashboardLiveWorkspaceClass
 	xfdashboard_actor_install_stylable_property(actorClass, XfdashboardLiveWorkspaceProperties[PROP_BACKGROUND_IMAGE_TYPE]);
 	xfdashboard_actor_install_stylable_property(actorClass, XfdashboardLiveWorkspaceProperties[PROP_SHOW_WORKSPACE_NAME]);
 	xfdashboard_actor_install_stylable_property(actorClass, XfdashboardLiveWorkspaceProperties[PROP_WORKSPACE_NAME_PADDING]);
+	xfdashboard_actor_install_stylable_property(actorClass, XfdashboardLiveWorkspaceProperties[PROP_CACHE_REFRESH_INTERVAL]);
 
 	/* Define signals */
 	XfdashboardLiveWorkspaceSignals[SIGNAL_CLICKED]=
@@ -924,6 +1251,12 @@ static void xfdashboard_live_workspace_init(XfdashboardLiveWorkspace *self)
 	priv->monitor=NULL;
 	priv->showWorkspaceName=FALSE;
 	priv->workspaceNamePadding=0.0f;
+	priv->cacheRefreshInterval=0;
+	priv->cacheTexture=NULL;
+	priv->cacheOffscreen=NULL;
+	priv->cachePipeline=NULL;
+	priv->cacheRefreshDue=TRUE;
+	priv->cacheRefreshID=0;
 
 	/* Set up this actor */
 	clutter_actor_set_reactive(CLUTTER_ACTOR(self), TRUE);
@@ -1298,3 +1631,38 @@ void xfdashboard_live_workspace_set_workspace_name_padding(XfdashboardLiveWorksp
 		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardLiveWorkspaceProperties[PROP_WORKSPACE_NAME_PADDING]);
 	}
 }
+
+/* Get/set interval at which cached texture of workspace is re-rendered */
+guint xfdashboard_live_workspace_get_cache_refresh_interval(XfdashboardLiveWorkspace *self)
+{
+	g_return_val_if_fail(XFDASHBOARD_IS_LIVE_WORKSPACE(self), 0);
+
+	return(self->priv->cacheRefreshInterval);
+}
+
+void xfdashboard_live_workspace_set_cache_refresh_interval(XfdashboardLiveWorkspace *self, guint inInterval)
+{
+	XfdashboardLiveWorkspacePrivate		*priv;
+
+	g_return_if_fail(XFDASHBOARD_IS_LIVE_WORKSPACE(self));
+
+	priv=self->priv;
+
+	/* Set value if changed */
+	if(priv->cacheRefreshInterval!=inInterval)
+	{
+		/* Set value */
+		priv->cacheRefreshInterval=inInterval;
+
+		/* Release cached texture as it is either not needed anymore or
+		 * will be re-rendered at next paint.
+		 */
+		_xfdashboard_live_workspace_cache_release(self);
+
+		/* Enforce a redraw of this actor */
+		clutter_actor_queue_redraw(CLUTTER_ACTOR(self));
+
+		/* Notify about property change */
+		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardLiveWorkspaceProperties[PROP_CACHE_REFRESH_INTERVAL]);
+	}
+}
@@ -93,6 +93,9 @@ void xfdashboard_live_workspace_set_show_workspace_name(XfdashboardLiveWorkspace
 gfloat xfdashboard_live_workspace_get_workspace_name_padding(XfdashboardLiveWorkspace *self);
 void xfdashboard_live_workspace_set_workspace_name_padding(XfdashboardLiveWorkspace *self, gfloat inPadding);
 
+guint xfdashboard_live_workspace_get_cache_refresh_interval(XfdashboardLiveWorkspace *self);
+void xfdashboard_live_workspace_set_cache_refresh_interval(XfdashboardLiveWorkspace *self, guint inInterval);
+
 G_END_DECLS
 
 #endif
@@ -82,6 +82,7 @@ struct _XfdashboardQuicklaunchPrivate
 	/* Instance related */
 	XfconfChannel					*xfconfChannel;
 	guint							xfconfFavouritesBindingID;
+	guint							favouritesNotifyID;
 
 	gfloat							scaleCurrent;
 
@@ -135,6 +136,8 @@ static guint XfdashboardQuicklaunchSignals[SIGNAL_LAST]={ 0, };
 
 /* IMPLEMENTATION: Private variables and methods */
 #define FAVOURITES_XFCONF_PROP				"/favourites"
+#define FAVOURITES_NOTIFY_DELAY				500
+
 
 #define LAUNCH_NEW_INSTANCE_XFCONF_PROP		"/always-launch-new-instance"
 #define DEFAULT_LAUNCH_NEW_INSTANCE			TRUE
@@ -1511,13 +1514,83 @@ static ClutterActor* _xfdashboard_quicklaunch_create_favourite_actor(Xfdashboard
 	return(actor);
 }
 
-/* Update property from icons in quicklaunch */
+/* Get desktop ID or, if it has none, path of desktop file of application button
+ * as stored in favourites. Returned string must be freed with g_free().
+ */
+static gchar* _xfdashboard_quicklaunch_get_desktop_file_for_actor(ClutterActor *inActor)
+{
+	GAppInfo						*desktopAppInfo;
+	gchar							*desktopFile;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_APPLICATION_BUTTON(inActor), NULL);
+
+	desktopFile=NULL;
+
+	desktopAppInfo=xfdashboard_application_button_get_app_info(XFDASHBOARD_APPLICATION_BUTTON(inActor));
+	if(desktopAppInfo &&
+		XFDASHBOARD_IS_DESKTOP_APP_INFO(desktopAppInfo))
+	{
+		desktopFile=g_strdup(g_app_info_get_id(desktopAppInfo));
+		if(!desktopFile)
+		{
+			GFile					*file;
+
+			file=xfdashboard_desktop_app_info_get_file(XFDASHBOARD_DESKTOP_APP_INFO(desktopAppInfo));
+			if(file) desktopFile=g_file_get_path(file);
+		}
+	}
+
+	return(desktopFile);
+}
+
+/* Check if both arrays of favourites contain the same desktop files in same order */
+static gboolean _xfdashboard_quicklaunch_favourites_equal(GPtrArray *inLeft, GPtrArray *inRight)
+{
+	guint							i;
+
+	if(!inLeft || !inRight) return(inLeft==inRight);
+	if(inLeft->len!=inRight->len) return(FALSE);
+
+	for(i=0; i<inLeft->len; i++)
+	{
+		if(g_strcmp0(g_value_get_string((GValue*)g_ptr_array_index(inLeft, i)),
+						g_value_get_string((GValue*)g_ptr_array_index(inRight, i)))!=0)
+		{
+			return(FALSE);
+		}
+	}
+
+	return(TRUE);
+}
+
+/* Timeout for delayed notification about changed favourites was reached */
+static gboolean _xfdashboard_quicklaunch_on_favourites_notify_timeout(gpointer inUserData)
+{
+	XfdashboardQuicklaunch			*self;
+	XfdashboardQuicklaunchPrivate	*priv;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_QUICKLAUNCH(inUserData), G_SOURCE_REMOVE);
+
+	self=XFDASHBOARD_QUICKLAUNCH(inUserData);
+	priv=self->priv;
+
+	/* Notify about property change which stores favourites in xfconf */
+	priv->favouritesNotifyID=0;
+	g_object_notify_by_pspec(G_OBJECT(self), XfdashboardQuicklaunchProperties[PROP_FAVOURITES]);
+
+	return(G_SOURCE_REMOVE);
+}
+
+/* Update property from icons in quicklaunch. Notification about the changed
+ * property and so storing it in xfconf is delayed and coalesced with further
+ * changes made shortly after, e.g. when reordering favourites step by step.
+ */
 static void _xfdashboard_quicklaunch_update_property_from_icons(XfdashboardQuicklaunch *self)
 {
 	XfdashboardQuicklaunchPrivate	*priv;
 	ClutterActor					*child;
 	ClutterActorIter				iter;
-	GAppInfo						*desktopAppInfo;
+	GPtrArray						*favourites;
 	gchar							*desktopFile;
 	GValue							*desktopValue;
 
@@ -1525,106 +1598,113 @@ static void _xfdashboard_quicklaunch_update_property_from_icons(XfdashboardQuick
 
 	priv=self->priv;
 
-	/* Free current list of desktop files */
-	if(priv->favourites)
-	{
-		xfconf_array_free(priv->favourites);
-		priv->favourites=NULL;
-	}
-
-	/* Create array of strings pointing to desktop files for new order,
-	 * update quicklaunch and store settings
-	 */
-	priv->favourites=g_ptr_array_new();
+	/* Create array of strings pointing to desktop files for new order */
+	favourites=g_ptr_array_sized_new(priv->favourites ? priv->favourites->len+1 : 0);
 
 	clutter_actor_iter_init(&iter, CLUTTER_ACTOR(self));
 	while(clutter_actor_iter_next(&iter, &child))
 	{
-		desktopFile=NULL;
-
 		/* Only add desktop file if it is an application button for
 		 * a favourite and provides a desktop ID or desktop file name
 		 */
- 		if(!XFDASHBOARD_IS_APPLICATION_BUTTON(child)) continue;
+		if(!XFDASHBOARD_IS_APPLICATION_BUTTON(child)) continue;
 		if(!xfdashboard_stylable_has_class(XFDASHBOARD_STYLABLE(child), "favourite-app")) continue;
 
-		desktopAppInfo=xfdashboard_application_button_get_app_info(XFDASHBOARD_APPLICATION_BUTTON(child));
-		if(desktopAppInfo &&
-			XFDASHBOARD_IS_DESKTOP_APP_INFO(desktopAppInfo))
-		{
-			desktopFile=g_strdup(g_app_info_get_id(desktopAppInfo));
-			if(!desktopFile)
-			{
-				GFile				*file;
-
-				file=xfdashboard_desktop_app_info_get_file(XFDASHBOARD_DESKTOP_APP_INFO(desktopAppInfo));
-				if(file) desktopFile=g_file_get_path(file);
-			}
-		}
+		desktopFile=_xfdashboard_quicklaunch_get_desktop_file_for_actor(child);
 		if(!desktopFile) continue;
 
-		/* Add desktop file name to array */
+		/* Add desktop file name to array. The array takes ownership of string. */
 		desktopValue=g_value_init(g_new0(GValue, 1), G_TYPE_STRING);
-		g_value_set_string(desktopValue, desktopFile);
-		g_ptr_array_add(priv->favourites, desktopValue);
+		g_value_take_string(desktopValue, desktopFile);
+		g_ptr_array_add(favourites, desktopValue);
+	}
 
-		/* Release allocated resources */
-		g_free(desktopFile);
+	/* If favourites did not change, e.g. an icon was dropped at its old
+	 * position, there is nothing to store.
+	 */
+	if(_xfdashboard_quicklaunch_favourites_equal(priv->favourites, favourites))
+	{
+		xfconf_array_free(favourites);
+		return;
 	}
 
-	/* Notify about property change */
-	g_object_notify_by_pspec(G_OBJECT(self), XfdashboardQuicklaunchProperties[PROP_FAVOURITES]);
+	/* Replace current list of desktop files */
+	if(priv->favourites) xfconf_array_free(priv->favourites);
+	priv->favourites=favourites;
+
+	/* (Re-)Schedule notification about property change */
+	if(priv->favouritesNotifyID) g_source_remove(priv->favouritesNotifyID);
+	priv->favouritesNotifyID=g_timeout_add(FAVOURITES_NOTIFY_DELAY,
+											_xfdashboard_quicklaunch_on_favourites_notify_timeout,
+											self);
 }
 
-/* Update icons in quicklaunch from property */
+/* Update icons in quicklaunch from property. Application buttons of desktop
+ * files which are still favourites are kept and only moved to their new
+ * position, so only buttons of added or removed favourites are touched.
+ */
 static void _xfdashboard_quicklaunch_update_icons_from_property(XfdashboardQuicklaunch *self)
 {
 	XfdashboardQuicklaunchPrivate	*priv;
 	ClutterActor					*child;
 	ClutterActorIter				iter;
+	GHashTable						*existingActors;
+	GHashTableIter					existingIter;
 	guint							i;
 	ClutterActor					*actor;
 	GValue							*desktopFile;
-	GAppInfo						*currentSelectionAppInfo;
+	gchar							*actorDesktopFile;
 	const gchar						*desktopFilename;
 	GAppInfo						*appInfo;
 
 	g_return_if_fail(XFDASHBOARD_IS_QUICKLAUNCH(self));
 
 	priv=self->priv;
-	currentSelectionAppInfo=NULL;
 
-	/* If current selection is an application button then remember it
-	 * to reselect it after favourites are re-setup.
+	/* Collect application buttons of current favourites by their desktop file.
+	 * Buttons without desktop file or for the same desktop file as another one
+	 * cannot be reused and are destroyed.
 	 */
-	if(priv->selectedItem &&
-		XFDASHBOARD_IS_APPLICATION_BUTTON(priv->selectedItem))
-	{
-		currentSelectionAppInfo=xfdashboard_application_button_get_app_info(XFDASHBOARD_APPLICATION_BUTTON(priv->selectedItem));
+	existingActors=g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
 
-		g_debug("Going to destroy current selection %p (%s) for desktop ID '%s'",
-					priv->selectedItem, G_OBJECT_TYPE_NAME(priv->selectedItem),
-					g_app_info_get_id(xfdashboard_application_button_get_app_info(XFDASHBOARD_APPLICATION_BUTTON(priv->selectedItem))));
-	}
-
-	/* Remove all application buttons */
 	clutter_actor_iter_init(&iter, CLUTTER_ACTOR(self));
 	while(clutter_actor_iter_next(&iter, &child))
 	{
-		if(XFDASHBOARD_IS_APPLICATION_BUTTON(child) &&
-			xfdashboard_stylable_has_class(XFDASHBOARD_STYLABLE(child), "favourite-app"))
+		if(!XFDASHBOARD_IS_APPLICATION_BUTTON(child)) continue;
+		if(!xfdashboard_stylable_has_class(XFDASHBOARD_STYLABLE(child), "favourite-app")) continue;
+
+		actorDesktopFile=_xfdashboard_quicklaunch_get_desktop_file_for_actor(child);
+		if(actorDesktopFile &&
+			!g_hash_table_contains(existingActors, actorDesktopFile))
 		{
-			clutter_actor_iter_destroy(&iter);
+			g_hash_table_insert(existingActors, actorDesktopFile, child);
 		}
+			else
+			{
+				if(child==priv->selectedItem) xfdashboard_focusable_set_selection(XFDASHBOARD_FOCUSABLE(self), NULL);
+				clutter_actor_iter_destroy(&iter);
+				g_free(actorDesktopFile);
+			}
 	}
 
-	/* Now re-add all application icons for current favourites */
+	/* Move existing or add new application icons for current favourites
+	 * in order of favourites in front of dynamically added ones.
+	 */
 	for(i=0; i<priv->favourites->len; i++)
 	{
-		/* Create application button from desktop file and hide label in quicklaunch */
 		desktopFile=(GValue*)g_ptr_array_index(priv->favourites, i);
-
 		desktopFilename=g_value_get_string(desktopFile);
+
+		/* Reuse application button if one exists for desktop file */
+		actor=CLUTTER_ACTOR(g_hash_table_lookup(existingActors, desktopFilename));
+		if(actor)
+		{
+			g_hash_table_remove(existingActors, desktopFilename);
+			clutter_actor_set_child_below_sibling(CLUTTER_ACTOR(self), actor, priv->separatorFavouritesToDynamic);
+			continue;
+		}
+
+		/* Create application button from desktop file and hide label in quicklaunch */
 		if(g_path_is_absolute(desktopFilename)) appInfo=xfdashboard_desktop_app_info_new_from_path(desktopFilename);
 			else
 			{
@@ -1636,27 +1716,27 @@ static void _xfdashboard_quicklaunch_update_icons_from_property(XfdashboardQuick
 		clutter_actor_show(actor);
 		clutter_actor_insert_child_below(CLUTTER_ACTOR(self), actor, priv->separatorFavouritesToDynamic);
 
-		/* Select this item if it matches the previously selected item
-		 * which was destroyed in the meantime.
-		 */
-		if(currentSelectionAppInfo)
-		{
-			/* Check if newly created application button matches current selection
-			 * then reselect newly create actor as current selection.
-			 */
-			if(g_app_info_equal(G_APP_INFO(appInfo), currentSelectionAppInfo))
-			{
-				xfdashboard_focusable_set_selection(XFDASHBOARD_FOCUSABLE(self), actor);
-
-				g_debug("Select newly created actor %p (%s) because it matches desktop ID '%s'",
-							actor, G_OBJECT_TYPE_NAME(actor),
-							g_app_info_get_id(xfdashboard_application_button_get_app_info(XFDASHBOARD_APPLICATION_BUTTON(actor))));
-			}
-		}
+		g_debug("Created favourite actor %p for desktop file '%s'", actor, desktopFilename);
 
 		/* Release allocated resources */
 		g_object_unref(appInfo);
 	}
+
+	/* Destroy remaining application buttons as their desktop files
+	 * are not favourites anymore.
+	 */
+	g_hash_table_iter_init(&existingIter, existingActors);
+	while(g_hash_table_iter_next(&existingIter, NULL, (gpointer*)&actor))
+	{
+		g_debug("Destroying favourite actor %p (%s) which is not a favourite anymore",
+					actor, G_OBJECT_TYPE_NAME(actor));
+
+		if(actor==priv->selectedItem) xfdashboard_focusable_set_selection(XFDASHBOARD_FOCUSABLE(self), NULL);
+		clutter_actor_destroy(actor);
+	}
+
+	/* Release allocated resources */
+	g_hash_table_destroy(existingActors);
 }
 
 /* Set up favourites array from string array value */
@@ -1664,6 +1744,7 @@ static void _xfdashboard_quicklaunch_set_favourites(XfdashboardQuicklaunch *self
 {
 	XfdashboardQuicklaunchPrivate	*priv;
 	GPtrArray						*desktopFiles;
+	GPtrArray						*favourites;
 	guint							i;
 	GValue							*element;
 	GValue							*desktopFile;
@@ -1673,18 +1754,11 @@ static void _xfdashboard_quicklaunch_set_favourites(XfdashboardQuicklaunch *self
 
 	priv=self->priv;
 
-	/* Free current list of favourites */
-	if(priv->favourites)
-	{
-		xfconf_array_free(priv->favourites);
-		priv->favourites=NULL;
-	}
-
 	/* Copy array of string pointing to desktop files */
 	desktopFiles=g_value_get_boxed(inValue);
 	if(desktopFiles)
 	{
-		priv->favourites=g_ptr_array_sized_new(desktopFiles->len);
+		favourites=g_ptr_array_sized_new(desktopFiles->len);
 		for(i=0; i<desktopFiles->len; ++i)
 		{
 			element=(GValue*)g_ptr_array_index(desktopFiles, i);
@@ -1694,11 +1768,33 @@ static void _xfdashboard_quicklaunch_set_favourites(XfdashboardQuicklaunch *self
 			{
 				desktopFile=g_value_init(g_new0(GValue, 1), G_TYPE_STRING);
 				g_value_copy(element, desktopFile);
-				g_ptr_array_add(priv->favourites, desktopFile);
+				g_ptr_array_add(favourites, desktopFile);
 			}
 		}
 	}
-		else priv->favourites=g_ptr_array_new();
+		else favourites=g_ptr_array_new();
+
+	/* Do nothing if favourites did not change, e.g. when xfconf reports
+	 * back the value which was just stored from this quicklaunch.
+	 */
+	if(_xfdashboard_quicklaunch_favourites_equal(priv->favourites, favourites))
+	{
+		xfconf_array_free(favourites);
+		return;
+	}
+
+	/* Replace current list of favourites. A pending notification about
+	 * favourites changed in this quicklaunch is dropped as the new value
+	 * takes precedence.
+	 */
+	if(priv->favouritesNotifyID)
+	{
+		g_source_remove(priv->favouritesNotifyID);
+		priv->favouritesNotifyID=0;
+	}
+
+	if(priv->favourites) xfconf_array_free(priv->favourites);
+	priv->favourites=favourites;
 
 	/* Update list of icons for desktop files */
 	_xfdashboard_quicklaunch_update_icons_from_property(self);
@@ -1749,6 +1845,9 @@ static void _xfdashboard_quicklaunch_setup_default_favourites(XfdashboardQuickla
 		}
 	}
 
+	/* Update list of icons for desktop files */
+	_xfdashboard_quicklaunch_update_icons_from_property(self);
+
 	/* Notify about property change */
 	g_object_notify_by_pspec(G_OBJECT(self), XfdashboardQuicklaunchProperties[PROP_FAVOURITES]);
 }
@@ -2961,6 +3060,15 @@ static void _xfdashboard_quicklaunch_dispose(GObject *inObject)
 	XfdashboardQuicklaunchPrivate	*priv=XFDASHBOARD_QUICKLAUNCH(inObject)->priv;
 
 	/* Release our allocated variables */
+	if(priv->favouritesNotifyID)
+	{
+		/* Store pending changes of favourites before unbinding from xfconf */
+		g_source_remove(priv->favouritesNotifyID);
+		priv->favouritesNotifyID=0;
+
+		g_object_notify_by_pspec(inObject, XfdashboardQuicklaunchProperties[PROP_FAVOURITES]);
+	}
+
 	if(priv->xfconfFavouritesBindingID)
 	{
 		xfconf_g_property_unbind(priv->xfconfFavouritesBindingID);
@@ -3263,6 +3371,7 @@ static void xfdashboard_quicklaunch_init(XfdashboardQuicklaunch *self)
 	priv->scaleMax=DEFAULT_SCALE_MAX;
 	priv->scaleStep=DEFAULT_SCALE_STEP;
 	priv->xfconfChannel=xfdashboard_application_get_xfconf_channel(NULL);
+	priv->favouritesNotifyID=0;
 	priv->dragMode=DRAG_MODE_NONE;
 	priv->dragPreviewIcon=NULL;
 	priv->selectedItem=NULL;
@@ -56,6 +56,7 @@ struct _XfdashboardScrollbarPrivate
 	ClutterColor			*sliderColor;
 
 	/* Instance related */
+	ClutterActor			*sliderActor;
 	ClutterContent			*slider;
 	ClutterSize				lastViewportSize;
 	ClutterSize				lastSliderSize;
@@ -338,7 +339,90 @@ static gboolean _xfdashboard_scrollbar_on_scroll_event(ClutterActor *inActor,
 	return(CLUTTER_EVENT_STOP);
 }
 
-/* Rectangle canvas should be redrawn */
+/* Move slider to position matching current value. The slider is only
+ * translated, so its canvas does not need to be redrawn.
+ */
+static void _xfdashboard_scrollbar_update_slider_position(XfdashboardScrollbar *self)
+{
+	XfdashboardScrollbarPrivate		*priv;
+	gfloat							sliderLength;
+
+	g_return_if_fail(XFDASHBOARD_IS_SCROLLBAR(self));
+
+	priv=self->priv;
+
+	/* Get length of area where slider can be moved in */
+	if(priv->orientation==CLUTTER_ORIENTATION_HORIZONTAL) sliderLength=priv->lastSliderSize.width;
+		else sliderLength=priv->lastSliderSize.height;
+
+	/* Calculate position of slider */
+	if(priv->range>0.0f) priv->sliderPosition=MAX(0, (priv->value/priv->range)*sliderLength);
+		else priv->sliderPosition=0.0f;
+	priv->sliderPosition=MIN(priv->sliderPosition, sliderLength);
+	if(priv->sliderPosition+priv->sliderSize>sliderLength) priv->sliderPosition=MAX(0, sliderLength-priv->sliderSize);
+
+	/* Move slider */
+	if(priv->orientation==CLUTTER_ORIENTATION_HORIZONTAL)
+	{
+		clutter_actor_set_translation(priv->sliderActor, priv->sliderPosition, 0.0f, 0.0f);
+	}
+		else
+		{
+			clutter_actor_set_translation(priv->sliderActor, 0.0f, priv->sliderPosition, 0.0f);
+		}
+}
+
+/* Calculate size of slider and the value range it covers for last allocation */
+static void _xfdashboard_scrollbar_update_slider_size(XfdashboardScrollbar *self)
+{
+	XfdashboardScrollbarPrivate		*priv;
+	gfloat							viewportLength;
+	gfloat							sliderLength;
+	gfloat							barValueRange;
+
+	g_return_if_fail(XFDASHBOARD_IS_SCROLLBAR(self));
+
+	priv=self->priv;
+
+	/* Get length of viewport and area where slider can be moved in */
+	if(priv->orientation==CLUTTER_ORIENTATION_HORIZONTAL)
+	{
+		viewportLength=priv->lastViewportSize.width;
+		sliderLength=priv->lastSliderSize.width;
+	}
+		else
+		{
+			viewportLength=priv->lastViewportSize.height;
+			sliderLength=priv->lastSliderSize.height;
+		}
+
+	/* Calculate size of slider and value range covered by slider */
+	if(priv->range>viewportLength) priv->sliderSize=(viewportLength/priv->range)*sliderLength;
+		else priv->sliderSize=sliderLength;
+
+	if(sliderLength>0.0f) barValueRange=(priv->sliderSize/sliderLength)*priv->range;
+		else barValueRange=priv->range;
+
+	/* Set value if changed */
+	if(barValueRange!=priv->valueRange)
+	{
+		/* Set value */
+		priv->valueRange=barValueRange;
+
+		/* Notify about property change */
+		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardScrollbarProperties[PROP_VALUE_RANGE]);
+
+		/* Adjust value to fit into range (respecting value-range) if needed */
+		if(priv->value+priv->valueRange>priv->range)
+		{
+			xfdashboard_scrollbar_set_value(self, MAX(0.0f, priv->range-priv->valueRange));
+		}
+	}
+}
+
+/* Slider canvas should be redrawn. It is only redrawn if size of slider or
+ * its style changes but not if slider is moved.
+ */
 static gboolean _xfdashboard_scrollbar_on_draw_slider(XfdashboardScrollbar *self,
 														cairo_t *inContext,
 														int inWidth,
@@ -348,7 +432,6 @@ static gboolean _xfdashboard_scrollbar_on_draw_slider(XfdashboardScrollbar *self
 	XfdashboardScrollbarPrivate		*priv;
 	gdouble							radius;
 	gdouble							top, left, bottom, right;
-	gdouble							barValueRange;
 
 	g_return_val_if_fail(XFDASHBOARD_IS_SCROLLBAR(self), TRUE);
 	g_return_val_if_fail(CLUTTER_IS_CANVAS(inUserData), TRUE);
@@ -370,50 +453,11 @@ static gboolean _xfdashboard_scrollbar_on_draw_slider(XfdashboardScrollbar *self
 	radius=MIN(priv->sliderRadius, inWidth/2.0f);
 	radius=MIN(radius, inHeight/2.0f);
 
-	/* Calculate bounding coordinates for slider and viewport */
-	priv->lastViewportSize.width=inWidth;
-	priv->lastViewportSize.height=inHeight;
-	priv->lastSliderSize.width=MAX(0, inWidth-(2*priv->spacing));
-	priv->lastSliderSize.height=MAX(0, inHeight-(2*priv->spacing));
-
-	if(priv->orientation==CLUTTER_ORIENTATION_HORIZONTAL)
-	{
-		if(priv->range > priv->lastViewportSize.width)
-		{
-			priv->sliderSize=(priv->lastViewportSize.width/priv->range)*priv->lastSliderSize.width;
-		}
-			else priv->sliderSize=priv->lastSliderSize.width;
-
-		barValueRange=(priv->sliderSize/priv->lastSliderSize.width)*priv->range;
-
-		priv->sliderPosition=MAX(0, (priv->value/priv->range)*priv->lastSliderSize.width);
-		priv->sliderPosition=MIN(priv->sliderPosition, priv->lastSliderSize.width);
-		if(priv->sliderPosition+priv->sliderSize>priv->lastSliderSize.width) priv->sliderPosition=priv->lastSliderSize.width-priv->sliderSize;
-
-		top=priv->spacing;
-		bottom=priv->lastSliderSize.height;
-		left=priv->sliderPosition;
-		right=priv->sliderPosition+priv->sliderSize;
-	}
-		else
-		{
-			if(priv->range > priv->lastViewportSize.height)
-			{
-				priv->sliderSize=(priv->lastViewportSize.height/priv->range)*priv->lastSliderSize.height;
-			}
-				else priv->sliderSize=priv->lastSliderSize.height;
-
-			barValueRange=(priv->sliderSize/priv->lastSliderSize.height)*priv->range;
-
-			priv->sliderPosition=MAX(0, (priv->value/priv->range)*priv->lastSliderSize.height);
-			priv->sliderPosition=MIN(priv->sliderPosition, priv->lastSliderSize.height);
-			if(priv->sliderPosition+priv->sliderSize>priv->lastSliderSize.height) priv->sliderPosition=priv->lastSliderSize.height-priv->sliderSize;
-
-			left=priv->spacing;
-			right=priv->lastSliderSize.width;
-			top=priv->sliderPosition;
-			bottom=priv->sliderPosition+priv->sliderSize;
-		}
+	/* Slider fills the whole canvas */
+	left=0.0;
+	top=0.0;
+	right=inWidth;
+	bottom=inHeight;
 
 	/* Draw slider */
 	if(radius>0.0f)
@@ -430,31 +474,15 @@ static gboolean _xfdashboard_scrollbar_on_draw_slider(XfdashboardScrollbar *self
 		cairo_line_to(inContext, left+radius, bottom);
 		cairo_arc(inContext, left+radius, bottom-radius, radius, G_PI/2.0, G_PI);
 
-		cairo_line_to(inContext, left, radius);
+		cairo_line_to(inContext, left, top+radius);
 	}
 		else
 		{
-			cairo_rectangle(inContext, left, top, right, bottom);
+			cairo_rectangle(inContext, left, top, right-left, bottom-top);
 		}
 
 	cairo_fill(inContext);
 
-	/* Set value if changed */
-	if(barValueRange!=priv->valueRange)
-	{
-		/* Set value */
-		priv->valueRange=barValueRange;
-
-		/* Notify about property change */
-		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardScrollbarProperties[PROP_VALUE_RANGE]);
-
-		/* Adjust value to fit into range (respecting value-range) if needed */
-		if(priv->value+priv->valueRange>priv->range)
-		{
-			xfdashboard_scrollbar_set_value(self, priv->range-priv->valueRange);
-		}
-	}
-
 	/* Done drawing */
 	return(CLUTTER_EVENT_STOP);
 }
@@ -536,14 +564,43 @@ static void _xfdashboard_scrollbar_allocate(ClutterActor *self,
 												ClutterAllocationFlags inFlags)
 {
 	XfdashboardScrollbarPrivate		*priv=XFDASHBOARD_SCROLLBAR(self)->priv;
+	ClutterActorBox					sliderBox;
 
 	/* Chain up to store the allocation of the actor */
 	CLUTTER_ACTOR_CLASS(xfdashboard_scrollbar_parent_class)->allocate(self, inBox, inFlags);
 
-	/* Set size of slider canvas */
+	/* Calculate bounding sizes for slider and viewport */
+	priv->lastViewportSize.width=clutter_actor_box_get_width(inBox);
+	priv->lastViewportSize.height=clutter_actor_box_get_height(inBox);
+	priv->lastSliderSize.width=MAX(0, priv->lastViewportSize.width-(2*priv->spacing));
+	priv->lastSliderSize.height=MAX(0, priv->lastViewportSize.height-(2*priv->spacing));
+
+	/* Calculate size of slider and allocate it at start of scrollbar. Its
+	 * position is set by translating it.
+	 */
+	_xfdashboard_scrollbar_update_slider_size(XFDASHBOARD_SCROLLBAR(self));
+
+	sliderBox.x1=priv->spacing;
+	sliderBox.y1=priv->spacing;
+	if(priv->orientation==CLUTTER_ORIENTATION_HORIZONTAL)
+	{
+		sliderBox.x2=sliderBox.x1+priv->sliderSize;
+		sliderBox.y2=sliderBox.y1+priv->lastSliderSize.height;
+	}
+		else
+		{
+			sliderBox.x2=sliderBox.x1+priv->lastSliderSize.width;
+			sliderBox.y2=sliderBox.y1+priv->sliderSize;
+		}
+	clutter_actor_allocate(priv->sliderActor, &sliderBox, inFlags);
+
+	/* Set size of slider canvas. It is only redrawn if its size changed. */
 	clutter_canvas_set_size(CLUTTER_CANVAS(priv->slider),
-								clutter_actor_box_get_width(inBox),
-								clutter_actor_box_get_height(inBox));
+								(gint)clutter_actor_box_get_width(&sliderBox),
+								(gint)clutter_actor_box_get_height(&sliderBox));
+
+	/* Move slider to position of current value */
+	_xfdashboard_scrollbar_update_slider_position(XFDASHBOARD_SCROLLBAR(self));
 }
 
 /* IMPLEMENTATION: GObject */
@@ -561,6 +618,12 @@ static void _xfdashboard_scrollbar_dispose(GObject *inObject)
 		priv->sliderColor=NULL;
 	}
 
+	if(priv->sliderActor)
+	{
+		clutter_actor_destroy(priv->sliderActor);
+		priv->sliderActor=NULL;
+	}
+
 	if(priv->slider)
 	{
 		g_object_unref(priv->slider);
@@ -826,13 +889,15 @@ static void xfdashboard_scrollbar_init(XfdashboardScrollbar *self)
 	priv->sliderRadius=0.0f;
 	priv->sliderColor=NULL;
 	priv->slider=clutter_canvas_new();
+	priv->sliderActor=clutter_actor_new();
 	priv->signalButtonReleasedID=0;
 	priv->signalMotionEventID=0;
 	priv->dragDevice=NULL;
 
 	/* Set up actor */
 	clutter_actor_set_reactive(CLUTTER_ACTOR(self), TRUE);
-	clutter_actor_set_content(CLUTTER_ACTOR(self), priv->slider);
+	clutter_actor_set_content(priv->sliderActor, priv->slider);
+	clutter_actor_add_child(CLUTTER_ACTOR(self), priv->sliderActor);
 	if(priv->orientation==CLUTTER_ORIENTATION_HORIZONTAL) clutter_actor_set_request_mode(CLUTTER_ACTOR(self), CLUTTER_REQUEST_HEIGHT_FOR_WIDTH);
 		else clutter_actor_set_request_mode(CLUTTER_ACTOR(self), CLUTTER_REQUEST_WIDTH_FOR_HEIGHT);
 
@@ -878,7 +943,6 @@ void xfdashboard_scrollbar_set_orientation(XfdashboardScrollbar *self, ClutterOr
 	if(priv->orientation==CLUTTER_ORIENTATION_HORIZONTAL) clutter_actor_set_request_mode(CLUTTER_ACTOR(self), CLUTTER_REQUEST_HEIGHT_FOR_WIDTH);
 		else clutter_actor_set_request_mode(CLUTTER_ACTOR(self), CLUTTER_REQUEST_WIDTH_FOR_HEIGHT);
 
-	if(priv->slider) clutter_content_invalidate(priv->slider);
 	clutter_actor_queue_relayout(CLUTTER_ACTOR(self));
 
 	/* Notify about property change */
@@ -920,8 +984,7 @@ void xfdashboard_scrollbar_set_value(XfdashboardScrollbar *self, gfloat inValue)
 
 	/* Set new value */
 	priv->value=inValue;
-	if(priv->slider) clutter_content_invalidate(priv->slider);
-	clutter_actor_queue_redraw(CLUTTER_ACTOR(self));
+	_xfdashboard_scrollbar_update_slider_position(self);
 
 	/* Notify about property change */
 	g_object_notify_by_pspec(G_OBJECT(self), XfdashboardScrollbarProperties[PROP_VALUE]);
@@ -961,8 +1024,7 @@ void xfdashboard_scrollbar_set_range(XfdashboardScrollbar *self, gfloat inRange)
 
 	/* Set new value */
 	priv->range=inRange;
-	if(priv->slider) clutter_content_invalidate(priv->slider);
-	clutter_actor_queue_redraw(CLUTTER_ACTOR(self));
+	clutter_actor_queue_relayout(CLUTTER_ACTOR(self));
 
 	/* Notify about property change */
 	g_object_notify_by_pspec(G_OBJECT(self), XfdashboardScrollbarProperties[PROP_RANGE]);
@@ -1087,7 +1149,7 @@ void xfdashboard_scrollbar_set_slider_radius(XfdashboardScrollbar *self, gfloat
 
 	/* Set new value */
 	priv->sliderRadius=inRadius;
-	if(priv->slider) clutter_content_invalidate(priv->slider);
+	if(priv->slider) xfdashboard_actor_invalidate_content(XFDASHBOARD_ACTOR(self), priv->slider);
 
 	/* Notify about property change */
 	g_object_notify_by_pspec(G_OBJECT(self), XfdashboardScrollbarProperties[PROP_SLIDER_RADIUS]);
@@ -1118,7 +1180,7 @@ void xfdashboard_scrollbar_set_slider_color(XfdashboardScrollbar *self, const Cl
 		priv->sliderColor=clutter_color_copy(inColor);
 
 		/* Invalidate canvas to get it redrawn */
-		if(priv->slider) clutter_content_invalidate(priv->slider);
+		if(priv->slider) xfdashboard_actor_invalidate_content(XFDASHBOARD_ACTOR(self), priv->slider);
 
 		/* Notify about property change */
 		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardScrollbarProperties[PROP_SLIDER_COLOR]);
@@ -0,0 +1,244 @@
+/*
+ * search-match: Match search terms against strings of search indexes
+ * 
+ * Copyright 2012-2016 Stephan Haller <nomad@froevel.de>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ * 
+ * 
+ */
+
+#include "config.h"
+
+#include <libxfdashboard/search-match.h>
+
+#include <string.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+/* IMPLEMENTATION: Private variables and methods */
+
+/* Vector instructions used by substring search. They are chosen at compile
+ * time, i.e. AVX2 is only used if compiler targets it (e.g. -mavx2). SSE2 is
+ * always available on x86-64. All other platforms use the scalar search.
+ */
+#if defined(__AVX2__)
+typedef __m256i										XfdashboardSearchMatchBlock;
+
+#define XFDASHBOARD_SEARCH_MATCH_BLOCK_SIZE			32
+#define XFDASHBOARD_SEARCH_MATCH_BLOCK_SET(c)		_mm256_set1_epi8(c)
+#define XFDASHBOARD_SEARCH_MATCH_BLOCK_LOAD(p)		_mm256_loadu_si256((const __m256i*)(p))
+#define XFDASHBOARD_SEARCH_MATCH_BLOCK_MATCHES(inFirst, inFirstBlock, inLast, inLastBlock) \
+	((guint32)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8((inFirst), (inFirstBlock)), \
+													_mm256_cmpeq_epi8((inLast), (inLastBlock)))))
+#elif defined(__SSE2__)
+typedef __m128i										XfdashboardSearchMatchBlock;
+
+#define XFDASHBOARD_SEARCH_MATCH_BLOCK_SIZE			16
+#define XFDASHBOARD_SEARCH_MATCH_BLOCK_SET(c)		_mm_set1_epi8(c)
+#define XFDASHBOARD_SEARCH_MATCH_BLOCK_LOAD(p)		_mm_loadu_si128((const __m128i*)(p))
+#define XFDASHBOARD_SEARCH_MATCH_BLOCK_MATCHES(inFirst, inFirstBlock, inLast, inLastBlock) \
+	((guint32)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8((inFirst), (inFirstBlock)), \
+												_mm_cmpeq_epi8((inLast), (inLastBlock)))))
+#endif
+
+
+/* IMPLEMENTATION: Public API */
+
+/* Find first occurence of needle in haystack with known lengths by scanning
+ * for first character of needle with memchr(). This is the fallback if no
+ * vector instructions are available and handles the remaining positions at
+ * end of haystack which do not fill a complete block.
+ */
+const gchar* _xfdashboard_search_match_find_scalar(const gchar *inHaystack,
+													gsize inHaystackLength,
+													const gchar *inNeedle,
+													gsize inNeedleLength)
+{
+	const gchar										*iter;
+	const gchar										*last;
+
+	if(inNeedleLength==0) return(inHaystack);
+	if(inNeedleLength>inHaystackLength) return(NULL);
+
+	iter=inHaystack;
+	last=inHaystack+(inHaystackLength-inNeedleLength);
+	while(iter<=last)
+	{
+		iter=memchr(iter, *inNeedle, (last-iter)+1);
+		if(!iter) return(NULL);
+
+		if(memcmp(iter+1, inNeedle+1, inNeedleLength-1)==0) return(iter);
+
+		iter++;
+	}
+
+	return(NULL);
+}
+
+/* Find first occurence of needle in haystack with known lengths. Each block
+ * of positions in haystack is compared against first and last character of
+ * needle at once and only positions where both match are compared completely.
+ * This rejects most positions without any branch even if first character of
+ * needle is common in haystack.
+ */
+const gchar* _xfdashboard_search_match_find(const gchar *inHaystack,
+											gsize inHaystackLength,
+											const gchar *inNeedle,
+											gsize inNeedleLength)
+{
+#ifdef XFDASHBOARD_SEARCH_MATCH_BLOCK_SIZE
+	XfdashboardSearchMatchBlock						first;
+	XfdashboardSearchMatchBlock						last;
+	gsize											positions;
+	gsize											i;
+	guint32											matches;
+	gint											bit;
+	const gchar										*result;
+
+	/* Needles of one character are found fastest by memchr() */
+	if(inNeedleLength<2 || inNeedleLength>inHaystackLength)
+	{
+		return(_xfdashboard_search_match_find_scalar(inHaystack, inHaystackLength, inNeedle, inNeedleLength));
+	}
+
+	/* Check all complete blocks of positions. The last block loaded for a
+	 * position ends at last character of haystack at most.
+	 */
+	positions=inHaystackLength-inNeedleLength+1;
+	first=XFDASHBOARD_SEARCH_MATCH_BLOCK_SET(inNeedle[0]);
+	last=XFDASHBOARD_SEARCH_MATCH_BLOCK_SET(inNeedle[inNeedleLength-1]);
+	for(i=0; i+XFDASHBOARD_SEARCH_MATCH_BLOCK_SIZE<=positions; i+=XFDASHBOARD_SEARCH_MATCH_BLOCK_SIZE)
+	{
+		matches=XFDASHBOARD_SEARCH_MATCH_BLOCK_MATCHES(first,
+														XFDASHBOARD_SEARCH_MATCH_BLOCK_LOAD(inHaystack+i),
+														last,
+														XFDASHBOARD_SEARCH_MATCH_BLOCK_LOAD(inHaystack+i+inNeedleLength-1));
+		while(matches)
+		{
+			bit=g_bit_nth_lsf(matches, -1);
+			if(memcmp(inHaystack+i+bit+1, inNeedle+1, inNeedleLength-2)==0) return(inHaystack+i+bit);
+
+			matches&=matches-1;
+		}
+	}
+
+	/* Check remaining positions which do not fill a complete block */
+	result=_xfdashboard_search_match_find_scalar(inHaystack+i, inHaystackLength-i, inNeedle, inNeedleLength);
+	return(result);
+#else
+	return(_xfdashboard_search_match_find_scalar(inHaystack, inHaystackLength, inNeedle, inNeedleLength));
+#endif
+}
+
+/* Build bit mask table of needle for fuzzy search. A cleared bit n in mask
+ * of a byte marks the occurence of this byte at position n in needle. The
+ * table must provide XFDASHBOARD_SEARCH_MATCH_FUZZY_MASK_SIZE entries. It is
+ * left without any cleared bit if needle is too long for fuzzy search.
+ */
+void _xfdashboard_search_match_fuzzy_build_mask(const gchar *inNeedle,
+													gsize inNeedleLength,
+													guint64 *outMask)
+{
+	gsize											i;
+
+	g_return_if_fail(inNeedle || inNeedleLength==0);
+	g_return_if_fail(outMask);
+
+	for(i=0; i<XFDASHBOARD_SEARCH_MATCH_FUZZY_MASK_SIZE; i++) outMask[i]=~G_GUINT64_CONSTANT(0);
+
+	if(inNeedleLength>XFDASHBOARD_SEARCH_MATCH_FUZZY_MAX_NEEDLE_LENGTH) return;
+
+	for(i=0; i<inNeedleLength; i++)
+	{
+		outMask[(guchar)inNeedle[i]]&=~(G_GUINT64_CONSTANT(1) << i);
+	}
+}
+
+/* Find approximate occurence of needle in haystack with at most the given
+ * number of errors (insertions, deletions or substitutions) by using the
+ * bit-parallel algorithm of Wu and Manber. The bit mask table of needle is
+ * built by _xfdashboard_search_match_fuzzy_build_mask(). Returns the lowest
+ * number of errors needed for a match or a negative value if needle does not
+ * match.
+ */
+gint _xfdashboard_search_match_fuzzy_find(const gchar *inHaystack,
+											gsize inHaystackLength,
+											const guint64 *inNeedleMask,
+											gsize inNeedleLength,
+											guint inMaxErrors)
+{
+	guint64											state[XFDASHBOARD_SEARCH_MATCH_FUZZY_MAX_ERRORS+1];
+	guint64											oldState, newState, previousOldState;
+	guint64											matchBit;
+	gint											bestErrors;
+	gsize											i;
+	guint											errors;
+
+	if(inNeedleLength==0) return(0);
+	if(!inNeedleMask || inNeedleLength>XFDASHBOARD_SEARCH_MATCH_FUZZY_MAX_NEEDLE_LENGTH) return(-1);
+	if(inMaxErrors>XFDASHBOARD_SEARCH_MATCH_FUZZY_MAX_ERRORS) inMaxErrors=XFDASHBOARD_SEARCH_MATCH_FUZZY_MAX_ERRORS;
+
+	/* A cleared bit at position n in state of k errors means that the first
+	 * n characters of needle matched with at most k errors. The first k
+	 * characters can always be matched by deleting them.
+	 */
+	for(errors=0; errors<=inMaxErrors; errors++) state[errors]=~G_GUINT64_CONSTANT(0) << (errors+1);
+
+	matchBit=G_GUINT64_CONSTANT(1) << inNeedleLength;
+	bestErrors=-1;
+	for(i=0; i<inHaystackLength && bestErrors!=0; i++)
+	{
+		guint64										mask;
+
+		mask=inNeedleMask[(guchar)inHaystack[i]];
+
+		/* Exact matching state */
+		previousOldState=state[0];
+		state[0]=(state[0] | mask) << 1;
+
+		/* States allowing errors: a match, a substitution, a deletion of
+		 * a character in needle or an insertion of a character in haystack.
+		 */
+		for(errors=1; errors<=inMaxErrors; errors++)
+		{
+			oldState=state[errors];
+			newState=((oldState | mask) << 1) &
+						(previousOldState << 1) &
+						(state[errors-1] << 1) &
+						previousOldState;
+			state[errors]=newState;
+			previousOldState=oldState;
+		}
+
+		/* Remember lowest number of errors of a complete match */
+		for(errors=0; errors<=inMaxErrors; errors++)
+		{
+			if((state[errors] & matchBit)==0)
+			{
+				if(bestErrors<0 || (gint)errors<bestErrors) bestErrors=errors;
+				break;
+			}
+		}
+	}
+
+	return(bestErrors);
+}
@@ -0,0 +1,68 @@
+/*
+ * search-match: Match search terms against strings of search indexes
+ * 
+ * Copyright 2012-2016 Stephan Haller <nomad@froevel.de>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ * 
+ * 
+ */
+
+#ifndef __LIBXFDASHBOARD_SEARCH_MATCH__
+#define __LIBXFDASHBOARD_SEARCH_MATCH__
+
+/* This header is private to library and not installed. Its functions are
+ * not exported as their names start with an underscore.
+ */
+#if !defined(LIBXFDASHBOARD_COMPILATION)
+#error "<libxfdashboard/search-match.h> is private to libxfdashboard and cannot be included."
+#endif
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/* Number of entries in bit mask table of a needle for fuzzy search, i.e. one
+ * for each byte value, the maximum length of such a needle in bytes and the
+ * maximum number of errors allowed.
+ */
+#define XFDASHBOARD_SEARCH_MATCH_FUZZY_MASK_SIZE			256
+#define XFDASHBOARD_SEARCH_MATCH_FUZZY_MAX_NEEDLE_LENGTH	63
+#define XFDASHBOARD_SEARCH_MATCH_FUZZY_MAX_ERRORS			3
+
+const gchar* _xfdashboard_search_match_find(const gchar *inHaystack,
+											gsize inHaystackLength,
+											const gchar *inNeedle,
+											gsize inNeedleLength);
+
+const gchar* _xfdashboard_search_match_find_scalar(const gchar *inHaystack,
+													gsize inHaystackLength,
+													const gchar *inNeedle,
+													gsize inNeedleLength);
+
+void _xfdashboard_search_match_fuzzy_build_mask(const gchar *inNeedle,
+													gsize inNeedleLength,
+													guint64 *outMask);
+
+gint _xfdashboard_search_match_fuzzy_find(const gchar *inHaystack,
+											gsize inHaystackLength,
+											const guint64 *inNeedleMask,
+											gsize inNeedleLength,
+											guint inMaxErrors);
+
+G_END_DECLS
+
+#endif	/* __LIBXFDASHBOARD_SEARCH_MATCH__ */
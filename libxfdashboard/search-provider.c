@@ -281,11 +281,135 @@ XfdashboardSearchResultSet* xfdashboard_search_provider_get_result_set(Xfdashboa
 		return(klass->get_result_set(self, inSearchTerms, inPreviousResultSet));
 	}
 
+	/* If search provider only implements search jobs run the job until
+	 * it is finished and return its result set.
+	 */
+	if(klass->begin_search_job)
+	{
+		XfdashboardSearchQuery		*query;
+		XfdashboardSearchResultSet	*resultSet;
+		gpointer					job;
+
+		query=xfdashboard_search_query_new_from_terms(inSearchTerms);
+		resultSet=xfdashboard_search_result_set_new();
+
+		job=xfdashboard_search_provider_begin_search_job(self, query, inPreviousResultSet, resultSet);
+		if(!job)
+		{
+			g_object_unref(resultSet);
+			g_object_unref(query);
+			return(NULL);
+		}
+
+		while(xfdashboard_search_provider_run_search_job(self, job, G_MAXINT64));
+		xfdashboard_search_provider_end_search_job(self, job);
+
+		g_object_unref(query);
+		return(resultSet);
+	}
+
 	/* If we get here the virtual function was not overridden */
 	XFDASHBOARD_SEARCH_PROVIDER_WARN_NOT_IMPLEMENTED(self, "get_result_set");
 	return(NULL);
 }
 
+/* Check if search provider can perform searches as jobs which are run
+ * in time-bounded slices instead of one synchronous call to get_result_set.
+ */
+gboolean xfdashboard_search_provider_has_search_job(XfdashboardSearchProvider *self)
+{
+	XfdashboardSearchProviderClass	*klass;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_SEARCH_PROVIDER(self), FALSE);
+
+	klass=XFDASHBOARD_SEARCH_PROVIDER_GET_CLASS(self);
+
+	return(klass->begin_search_job &&
+			klass->run_search_job &&
+			klass->end_search_job);
+}
+
+/* Begin a search job for query which adds its matching result items to
+ * provided result set while it is run. The query provides the search terms
+ * already normalized, so search providers do not need to do it again. If a
+ * previous result set is provided do an incremental search on basis of
+ * provided result set. Returns NULL if there is nothing to search for.
+ */
+gpointer xfdashboard_search_provider_begin_search_job(XfdashboardSearchProvider *self,
+														XfdashboardSearchQuery *inQuery,
+														XfdashboardSearchResultSet *inPreviousResultSet,
+														XfdashboardSearchResultSet *inResultSet)
+{
+	XfdashboardSearchProviderClass	*klass;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_SEARCH_PROVIDER(self), NULL);
+	g_return_val_if_fail(XFDASHBOARD_IS_SEARCH_QUERY(inQuery), NULL);
+	g_return_val_if_fail(!inPreviousResultSet || XFDASHBOARD_IS_SEARCH_RESULT_SET(inPreviousResultSet), NULL);
+	g_return_val_if_fail(XFDASHBOARD_IS_SEARCH_RESULT_SET(inResultSet), NULL);
+
+	klass=XFDASHBOARD_SEARCH_PROVIDER_GET_CLASS(self);
+
+	/* Begin search job at search provider */
+	if(klass->begin_search_job)
+	{
+		return(klass->begin_search_job(self, inQuery, inPreviousResultSet, inResultSet));
+	}
+
+	/* If we get here the virtual function was not overridden */
+	XFDASHBOARD_SEARCH_PROVIDER_WARN_NOT_IMPLEMENTED(self, "begin_search_job");
+	return(NULL);
+}
+
+/* Run search job until it is finished or the deadline in monotonic time
+ * is reached. Returns TRUE if the job is not finished yet and must be run
+ * again. The result set of the job contains all result items found so far.
+ */
+gboolean xfdashboard_search_provider_run_search_job(XfdashboardSearchProvider *self,
+													gpointer inJob,
+													gint64 inDeadline)
+{
+	XfdashboardSearchProviderClass	*klass;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_SEARCH_PROVIDER(self), FALSE);
+	g_return_val_if_fail(inJob, FALSE);
+
+	klass=XFDASHBOARD_SEARCH_PROVIDER_GET_CLASS(self);
+
+	/* Run search job at search provider */
+	if(klass->run_search_job)
+	{
+		return(klass->run_search_job(self, inJob, inDeadline));
+	}
+
+	/* If we get here the virtual function was not overridden */
+	XFDASHBOARD_SEARCH_PROVIDER_WARN_NOT_IMPLEMENTED(self, "run_search_job");
+	return(FALSE);
+}
+
+/* End search job and release its resources. This is also used to cancel
+ * a search job which is not finished yet.
+ */
+void xfdashboard_search_provider_end_search_job(XfdashboardSearchProvider *self,
+												gpointer inJob)
+{
+	XfdashboardSearchProviderClass	*klass;
+
+	g_return_if_fail(XFDASHBOARD_IS_SEARCH_PROVIDER(self));
+	g_return_if_fail(inJob);
+
+	klass=XFDASHBOARD_SEARCH_PROVIDER_GET_CLASS(self);
+
+	/* End search job at search provider */
+	if(klass->end_search_job)
+	{
+		klass->end_search_job(self, inJob);
+		return;
+	}
+
+	/* If we get here the virtual function was not overridden */
+	XFDASHBOARD_SEARCH_PROVIDER_WARN_NOT_IMPLEMENTED(self, "end_search_job");
+}
+
 /* Returns an actor for requested result item */
 ClutterActor* xfdashboard_search_provider_create_result_actor(XfdashboardSearchProvider *self,
 																GVariant *inResultItem)
@@ -30,6 +30,7 @@
 
 #include <clutter/clutter.h>
 
+#include <libxfdashboard/search-query.h>
 #include <libxfdashboard/search-result-set.h>
 
 G_BEGIN_DECLS
@@ -82,6 +83,19 @@ struct _XfdashboardSearchProviderClass
 								GVariant *inResultItem,
 								ClutterActor *inActor,
 								const gchar **inSearchTerms);
+
+	/* Search jobs are appended to keep offsets of virtual functions above
+	 * which search providers built against earlier versions rely on.
+	 */
+	gpointer (*begin_search_job)(XfdashboardSearchProvider *self,
+									XfdashboardSearchQuery *inQuery,
+									XfdashboardSearchResultSet *inPreviousResultSet,
+									XfdashboardSearchResultSet *inResultSet);
+	gboolean (*run_search_job)(XfdashboardSearchProvider *self,
+								gpointer inJob,
+								gint64 inDeadline);
+	void (*end_search_job)(XfdashboardSearchProvider *self,
+							gpointer inJob);
 };
 
 /* Public API */
@@ -97,6 +111,17 @@ XfdashboardSearchResultSet* xfdashboard_search_provider_get_result_set(Xfdashboa
 																		const gchar **inSearchTerms,
 																		XfdashboardSearchResultSet *inPreviousResultSet);
 
+gboolean xfdashboard_search_provider_has_search_job(XfdashboardSearchProvider *self);
+gpointer xfdashboard_search_provider_begin_search_job(XfdashboardSearchProvider *self,
+														XfdashboardSearchQuery *inQuery,
+														XfdashboardSearchResultSet *inPreviousResultSet,
+														XfdashboardSearchResultSet *inResultSet);
+gboolean xfdashboard_search_provider_run_search_job(XfdashboardSearchProvider *self,
+													gpointer inJob,
+													gint64 inDeadline);
+void xfdashboard_search_provider_end_search_job(XfdashboardSearchProvider *self,
+												gpointer inJob);
+
 ClutterActor* xfdashboard_search_provider_create_result_actor(XfdashboardSearchProvider *self,
 																GVariant *inResultItem);
 
@@ -0,0 +1,306 @@
+/*
+ * search-query: Search terms of a search normalized once for all
+ *               search providers
+ * 
+ * Copyright 2012-2016 Stephan Haller <nomad@froevel.de>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ * 
+ * 
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <libxfdashboard/search-query.h>
+
+#include <glib/gi18n-lib.h>
+#include <string.h>
+
+#include <libxfdashboard/search-manager.h>
+#include <libxfdashboard/search-match.h>
+#include <libxfdashboard/compat.h>
+
+
+/* Define this class in GObject system */
+G_DEFINE_TYPE(XfdashboardSearchQuery,
+				xfdashboard_search_query,
+				G_TYPE_OBJECT)
+
+/* Private structure - access only by public API if needed */
+#define XFDASHBOARD_SEARCH_QUERY_GET_PRIVATE(obj) \
+	(G_TYPE_INSTANCE_GET_PRIVATE((obj), XFDASHBOARD_TYPE_SEARCH_QUERY, XfdashboardSearchQueryPrivate))
+
+struct _XfdashboardSearchQueryPrivate
+{
+	/* Instance related */
+	gchar							*searchString;
+
+	guint							termsCount;
+	gchar							**terms;
+
+	gchar							**normalizedTerms;
+	gsize							*normalizedTermsLength;
+	guint64							*normalizedTermsMask;
+};
+
+
+/* IMPLEMENTATION: Private variables and methods */
+#define XFDASHBOARD_SEARCH_QUERY_MASK_SIZE		XFDASHBOARD_SEARCH_MATCH_FUZZY_MASK_SIZE
+
+G_STATIC_ASSERT(XFDASHBOARD_SEARCH_QUERY_MAX_MASK_LENGTH<=XFDASHBOARD_SEARCH_MATCH_FUZZY_MAX_NEEDLE_LENGTH);
+
+/* Normalize search terms and precompute everything matchers need for them */
+static void _xfdashboard_search_query_set_terms(XfdashboardSearchQuery *self, gchar **inTerms)
+{
+	XfdashboardSearchQueryPrivate	*priv;
+	guint							i;
+
+	g_return_if_fail(XFDASHBOARD_IS_SEARCH_QUERY(self));
+	g_return_if_fail(inTerms);
+
+	priv=self->priv;
+
+	/* Take list of search terms */
+	priv->terms=inTerms;
+	priv->termsCount=g_strv_length(priv->terms);
+
+	/* Normalize each search term and remember its length in bytes */
+	priv->normalizedTerms=g_new0(gchar*, priv->termsCount+1);
+	priv->normalizedTermsLength=g_new0(gsize, priv->termsCount);
+	for(i=0; i<priv->termsCount; i++)
+	{
+		priv->normalizedTerms[i]=xfdashboard_search_query_normalize_string(priv->terms[i]);
+		priv->normalizedTermsLength[i]=strlen(priv->normalizedTerms[i]);
+	}
+
+	/* Set up bit mask table for each normalized search term which is short
+	 * enough for bit-parallel matching.
+	 */
+	priv->normalizedTermsMask=g_new(guint64, priv->termsCount*XFDASHBOARD_SEARCH_QUERY_MASK_SIZE);
+	for(i=0; i<priv->termsCount; i++)
+	{
+		_xfdashboard_search_match_fuzzy_build_mask(priv->normalizedTerms[i],
+													priv->normalizedTermsLength[i],
+													priv->normalizedTermsMask+(i*XFDASHBOARD_SEARCH_QUERY_MASK_SIZE));
+	}
+}
+
+/* IMPLEMENTATION: GObject */
+
+/* Dispose this object */
+static void _xfdashboard_search_query_dispose(GObject *inObject)
+{
+	XfdashboardSearchQuery			*self=XFDASHBOARD_SEARCH_QUERY(inObject);
+	XfdashboardSearchQueryPrivate	*priv=self->priv;
+
+	/* Release allocated resources */
+	if(priv->normalizedTermsMask)
+	{
+		g_free(priv->normalizedTermsMask);
+		priv->normalizedTermsMask=NULL;
+	}
+
+	if(priv->normalizedTermsLength)
+	{
+		g_free(priv->normalizedTermsLength);
+		priv->normalizedTermsLength=NULL;
+	}
+
+	if(priv->normalizedTerms)
+	{
+		g_strfreev(priv->normalizedTerms);
+		priv->normalizedTerms=NULL;
+	}
+
+	if(priv->terms)
+	{
+		g_strfreev(priv->terms);
+		priv->terms=NULL;
+	}
+	priv->termsCount=0;
+
+	if(priv->searchString)
+	{
+		g_free(priv->searchString);
+		priv->searchString=NULL;
+	}
+
+	/* Call parent's class dispose method */
+	G_OBJECT_CLASS(xfdashboard_search_query_parent_class)->dispose(inObject);
+}
+
+/* Class initialization
+ * Override functions in parent classes and define properties
+ * and signals
+ */
+static void xfdashboard_search_query_class_init(XfdashboardSearchQueryClass *klass)
+{
+	GObjectClass			*gobjectClass=G_OBJECT_CLASS(klass);
+
+	/* Override functions */
+	gobjectClass->dispose=_xfdashboard_search_query_dispose;
+
+	/* Set up private structure */
+	g_type_class_add_private(klass, sizeof(XfdashboardSearchQueryPrivate));
+}
+
+/* Object initialization
+ * Create private structure and set up default values
+ */
+static void xfdashboard_search_query_init(XfdashboardSearchQuery *self)
+{
+	XfdashboardSearchQueryPrivate	*priv;
+
+	priv=self->priv=XFDASHBOARD_SEARCH_QUERY_GET_PRIVATE(self);
+
+	/* Set up default values */
+	priv->searchString=NULL;
+	priv->termsCount=0;
+	priv->terms=NULL;
+	priv->normalizedTerms=NULL;
+	priv->normalizedTermsLength=NULL;
+	priv->normalizedTermsMask=NULL;
+}
+
+/* IMPLEMENTATION: Public API */
+
+/* Create new query for search string which is split into search terms */
+XfdashboardSearchQuery* xfdashboard_search_query_new(const gchar *inSearchString)
+{
+	XfdashboardSearchQuery			*self;
+	gchar							**terms;
+
+	g_return_val_if_fail(inSearchString, NULL);
+
+	/* Split search string into search terms */
+	terms=xfdashboard_search_manager_get_search_terms_from_string(inSearchString, NULL);
+	if(!terms) return(NULL);
+
+	/* Create query */
+	self=XFDASHBOARD_SEARCH_QUERY(g_object_new(XFDASHBOARD_TYPE_SEARCH_QUERY, NULL));
+	self->priv->searchString=g_strdup(inSearchString);
+	_xfdashboard_search_query_set_terms(self, terms);
+
+	return(self);
+}
+
+/* Create new query for list of search terms already split */
+XfdashboardSearchQuery* xfdashboard_search_query_new_from_terms(const gchar **inSearchTerms)
+{
+	XfdashboardSearchQuery			*self;
+
+	g_return_val_if_fail(inSearchTerms, NULL);
+
+	/* Create query */
+	self=XFDASHBOARD_SEARCH_QUERY(g_object_new(XFDASHBOARD_TYPE_SEARCH_QUERY, NULL));
+	self->priv->searchString=g_strjoinv(" ", (gchar**)inSearchTerms);
+	_xfdashboard_search_query_set_terms(self, g_strdupv((gchar**)inSearchTerms));
+
+	return(self);
+}
+
+/* Get search string this query was created for */
+const gchar* xfdashboard_search_query_get_search_string(XfdashboardSearchQuery *self)
+{
+	g_return_val_if_fail(XFDASHBOARD_IS_SEARCH_QUERY(self), NULL);
+
+	return(self->priv->searchString);
+}
+
+/* Get number of search terms */
+guint xfdashboard_search_query_get_terms_count(XfdashboardSearchQuery *self)
+{
+	g_return_val_if_fail(XFDASHBOARD_IS_SEARCH_QUERY(self), 0);
+
+	return(self->priv->termsCount);
+}
+
+/* Get NULL-terminated list of search terms as entered */
+const gchar** xfdashboard_search_query_get_terms(XfdashboardSearchQuery *self)
+{
+	g_return_val_if_fail(XFDASHBOARD_IS_SEARCH_QUERY(self), NULL);
+
+	return((const gchar**)self->priv->terms);
+}
+
+/* Get NULL-terminated list of normalized search terms which can be matched
+ * byte-wise against strings normalized by xfdashboard_search_query_normalize_string().
+ */
+const gchar** xfdashboard_search_query_get_normalized_terms(XfdashboardSearchQuery *self)
+{
+	g_return_val_if_fail(XFDASHBOARD_IS_SEARCH_QUERY(self), NULL);
+
+	return((const gchar**)self->priv->normalizedTerms);
+}
+
+/* Get length in bytes of normalized search term at index */
+gsize xfdashboard_search_query_get_normalized_term_length(XfdashboardSearchQuery *self, guint inIndex)
+{
+	XfdashboardSearchQueryPrivate	*priv;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_SEARCH_QUERY(self), 0);
+
+	priv=self->priv;
+
+	g_return_val_if_fail(inIndex<priv->termsCount, 0);
+
+	return(priv->normalizedTermsLength[inIndex]);
+}
+
+/* Get table of 256 bit masks, one for each byte value, of normalized search
+ * term at index for bit-parallel matching. A cleared bit n in mask of a byte
+ * means that the search term has this byte at position n. Returns NULL if
+ * search term is longer than XFDASHBOARD_SEARCH_QUERY_MAX_MASK_LENGTH bytes.
+ */
+const guint64* xfdashboard_search_query_get_normalized_term_mask(XfdashboardSearchQuery *self, guint inIndex)
+{
+	XfdashboardSearchQueryPrivate	*priv;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_SEARCH_QUERY(self), NULL);
+
+	priv=self->priv;
+
+	g_return_val_if_fail(inIndex<priv->termsCount, NULL);
+
+	if(priv->normalizedTermsLength[inIndex]>XFDASHBOARD_SEARCH_QUERY_MAX_MASK_LENGTH) return(NULL);
+	return(priv->normalizedTermsMask+(inIndex*XFDASHBOARD_SEARCH_QUERY_MASK_SIZE));
+}
+
+/* Normalize string the same way as search terms are normalized, i.e. case
+ * folded and in Unicode normalization form NFKC, so that search terms can be
+ * matched byte-wise against it. Caller is responsible to free result with
+ * g_free().
+ */
+gchar* xfdashboard_search_query_normalize_string(const gchar *inString)
+{
+	gchar							*casefolded;
+	gchar							*normalized;
+
+	g_return_val_if_fail(inString, NULL);
+
+	/* Strings which are not valid UTF-8 are only converted to lower-case
+	 * in ASCII range.
+	 */
+	if(!g_utf8_validate(inString, -1, NULL)) return(g_ascii_strdown(inString, -1));
+
+	casefolded=g_utf8_casefold(inString, -1);
+	normalized=g_utf8_normalize(casefolded, -1, G_NORMALIZE_NFKC);
+	g_free(casefolded);
+
+	return(normalized);
+}
@@ -0,0 +1,94 @@
+/*
+ * search-query: Search terms of a search normalized once for all
+ *               search providers
+ * 
+ * Copyright 2012-2016 Stephan Haller <nomad@froevel.de>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ * 
+ * 
+ */
+
+#ifndef __LIBXFDASHBOARD_SEARCH_QUERY__
+#define __LIBXFDASHBOARD_SEARCH_QUERY__
+
+#if !defined(__LIBXFDASHBOARD_H_INSIDE__) && !defined(LIBXFDASHBOARD_COMPILATION)
+#error "Only <libxfdashboard/libxfdashboard.h> can be included directly."
+#endif
+
+#include <glib-object.h>
+
+G_BEGIN_DECLS
+
+/**
+ * XFDASHBOARD_SEARCH_QUERY_MAX_MASK_LENGTH:
+ *
+ * The maximum length in bytes of a normalized search term for which a
+ * bit-parallel match mask table is precomputed.
+ */
+#define XFDASHBOARD_SEARCH_QUERY_MAX_MASK_LENGTH		63
+
+#define XFDASHBOARD_TYPE_SEARCH_QUERY				(xfdashboard_search_query_get_type())
+#define XFDASHBOARD_SEARCH_QUERY(obj)				(G_TYPE_CHECK_INSTANCE_CAST((obj), XFDASHBOARD_TYPE_SEARCH_QUERY, XfdashboardSearchQuery))
+#define XFDASHBOARD_IS_SEARCH_QUERY(obj)			(G_TYPE_CHECK_INSTANCE_TYPE((obj), XFDASHBOARD_TYPE_SEARCH_QUERY))
+#define XFDASHBOARD_SEARCH_QUERY_CLASS(klass)		(G_TYPE_CHECK_CLASS_CAST((klass), XFDASHBOARD_TYPE_SEARCH_QUERY, XfdashboardSearchQueryClass))
+#define XFDASHBOARD_IS_SEARCH_QUERY_CLASS(klass)	(G_TYPE_CHECK_CLASS_TYPE((klass), XFDASHBOARD_TYPE_SEARCH_QUERY))
+#define XFDASHBOARD_SEARCH_QUERY_GET_CLASS(obj)		(G_TYPE_INSTANCE_GET_CLASS((obj), XFDASHBOARD_TYPE_SEARCH_QUERY, XfdashboardSearchQueryClass))
+
+typedef struct _XfdashboardSearchQuery				XfdashboardSearchQuery;
+typedef struct _XfdashboardSearchQueryClass			XfdashboardSearchQueryClass;
+typedef struct _XfdashboardSearchQueryPrivate		XfdashboardSearchQueryPrivate;
+
+struct _XfdashboardSearchQuery
+{
+	/*< private >*/
+	/* Parent instance */
+	GObject							parent_instance;
+
+	/* Private structure */
+	XfdashboardSearchQueryPrivate	*priv;
+};
+
+struct _XfdashboardSearchQueryClass
+{
+	/*< private >*/
+	/* Parent class */
+	GObjectClass					parent_class;
+
+	/*< public >*/
+	/* Virtual functions */
+};
+
+/* Public API */
+GType xfdashboard_search_query_get_type(void) G_GNUC_CONST;
+
+XfdashboardSearchQuery* xfdashboard_search_query_new(const gchar *inSearchString);
+XfdashboardSearchQuery* xfdashboard_search_query_new_from_terms(const gchar **inSearchTerms);
+
+const gchar* xfdashboard_search_query_get_search_string(XfdashboardSearchQuery *self);
+
+guint xfdashboard_search_query_get_terms_count(XfdashboardSearchQuery *self);
+const gchar** xfdashboard_search_query_get_terms(XfdashboardSearchQuery *self);
+
+const gchar** xfdashboard_search_query_get_normalized_terms(XfdashboardSearchQuery *self);
+gsize xfdashboard_search_query_get_normalized_term_length(XfdashboardSearchQuery *self, guint inIndex);
+const guint64* xfdashboard_search_query_get_normalized_term_mask(XfdashboardSearchQuery *self, guint inIndex);
+
+gchar* xfdashboard_search_query_normalize_string(const gchar *inString);
+
+G_END_DECLS
+
+#endif	/* __LIBXFDASHBOARD_SEARCH_QUERY__ */
@@ -52,12 +52,14 @@
 #include <gtk/gtk.h>
 
 #include <libxfdashboard/search-manager.h>
+#include <libxfdashboard/search-query.h>
 #include <libxfdashboard/focusable.h>
 #include <libxfdashboard/utils.h>
 #include <libxfdashboard/search-result-container.h>
 #include <libxfdashboard/focus-manager.h>
 #include <libxfdashboard/enums.h>
 #include <libxfdashboard/application.h>
+#include <libxfdashboard/instrumentation.h>
 #include <libxfdashboard/compat.h>
 
 
@@ -93,6 +95,10 @@ struct _XfdashboardSearchViewPrivate
 	XfdashboardSearchViewProviderData	*selectionProvider;
 	guint								repaintID;
 
+	guint								searchJobSourceID;
+	gint64								searchStartTime;
+	gboolean							searchJobNotifyNoResults;
+
 	XfdashboardFocusManager				*focusManager;
 };
 
@@ -111,6 +117,8 @@ static guint XfdashboardSearchViewSignals[SIGNAL_LAST]={ 0, };
 #define DELAY_SEARCH_TIMEOUT_XFCONF_PROP		"/components/search-view/delay-search-timeout"
 #define DEFAULT_DELAY_SEARCH_TIMEOUT			0
 
+#define SEARCH_JOB_TIME_SLICE					(5*G_TIME_SPAN_MILLISECOND)
+
 struct _XfdashboardSearchViewProviderData
 {
 	gint								refCount;
@@ -121,6 +129,9 @@ struct _XfdashboardSearchViewProviderData
 	XfdashboardSearchViewSearchTerms	*lastTerms;
 	XfdashboardSearchResultSet			*lastResultSet;
 
+	gpointer							searchJob;
+	XfdashboardSearchResultSet			*searchJobResultSet;
+
 	ClutterActor						*container;
 };
 
@@ -129,7 +140,7 @@ struct _XfdashboardSearchViewSearchTerms
 	gint								refCount;
 
 	gchar								*termString;
-	gchar								**termList;
+	XfdashboardSearchQuery				*query;
 };
 
 /* Callback to ensure current selection is visible after search results were updated */
@@ -161,12 +172,19 @@ static gboolean _xfdashboard_search_view_on_repaint_after_update_callback(gpoint
 static XfdashboardSearchViewSearchTerms* _xfdashboard_search_view_search_terms_new(const gchar *inSearchString)
 {
 	XfdashboardSearchViewSearchTerms	*data;
+	XfdashboardSearchQuery				*query;
+
+	/* Create query once for all providers. It splits search string into
+	 * search terms and normalizes them.
+	 */
+	query=xfdashboard_search_query_new(inSearchString);
+	if(!query) return(NULL);
 
 	/* Create data for provider */
 	data=g_new0(XfdashboardSearchViewSearchTerms, 1);
 	data->refCount=1;
 	data->termString=g_strdup(inSearchString);
-	data->termList=xfdashboard_search_manager_get_search_terms_from_string(inSearchString, NULL);
+	data->query=query;
 
 	return(data);
 }
@@ -189,7 +207,7 @@ static void _xfdashboard_search_view_search_terms_free(XfdashboardSearchViewSear
 #endif
 
 	/* Release allocated resources */
-	if(inData->termList) g_strfreev(inData->termList);
+	if(inData->query) g_object_unref(inData->query);
 	if(inData->termString) g_free(inData->termString);
 	g_free(inData);
 }
@@ -232,11 +250,40 @@ static XfdashboardSearchViewProviderData* _xfdashboard_search_view_provider_data
 	data->view=self;
 	data->lastTerms=NULL;
 	data->lastResultSet=NULL;
+	data->searchJob=NULL;
+	data->searchJobResultSet=NULL;
 	data->container=NULL;
 
 	return(data);
 }
 
+/* Cancel running search job of provider */
+static void _xfdashboard_search_view_provider_data_cancel_search_job(XfdashboardSearchViewProviderData *inData)
+{
+	g_return_if_fail(inData);
+
+	if(!inData->searchJob) return;
+
+	/* End search job */
+	xfdashboard_search_provider_end_search_job(inData->provider, inData->searchJob);
+	inData->searchJob=NULL;
+
+	if(inData->searchJobResultSet)
+	{
+		g_object_unref(inData->searchJobResultSet);
+		inData->searchJobResultSet=NULL;
+	}
+
+	/* The results shown may be incomplete, so the next search at this provider
+	 * must not be an incremental search based on them.
+	 */
+	if(inData->lastTerms)
+	{
+		_xfdashboard_search_view_search_terms_unref(inData->lastTerms);
+		inData->lastTerms=NULL;
+	}
+}
+
 /* Free data for provider */
 static void _xfdashboard_search_view_provider_data_free(XfdashboardSearchViewProviderData *inData)
 {
@@ -254,6 +301,9 @@ static void _xfdashboard_search_view_provider_data_free(XfdashboardSearchViewPro
 	}
 #endif
 
+	/* Cancel running search job */
+	_xfdashboard_search_view_provider_data_cancel_search_job(inData);
+
 	/* Destroy container */
 	if(inData->container)
 	{
@@ -458,7 +508,7 @@ static void _xfdashboard_search_view_on_result_item_clicked(XfdashboardSearchRes
 
 	/* Get search terms to pass them to search provider */
 	searchTerms=NULL;
-	if(priv->lastTerms) searchTerms=(const gchar**)priv->lastTerms->termList;
+	if(priv->lastTerms) searchTerms=xfdashboard_search_query_get_terms(priv->lastTerms->query);
 
 	/* Tell provider to launch search */
 	success=xfdashboard_search_provider_activate_result(providerData->provider,
@@ -493,7 +543,7 @@ static void _xfdashboard_search_view_on_provider_icon_clicked(XfdashboardSearchR
 
 	/* Get search terms to pass them to search provider */
 	searchTerms=NULL;
-	if(priv->lastTerms) searchTerms=(const gchar**)priv->lastTerms->termList;
+	if(priv->lastTerms) searchTerms=xfdashboard_search_query_get_terms(priv->lastTerms->query);
 
 	/* Tell provider to launch search */
 	success=xfdashboard_search_provider_launch_search(providerData->provider, searchTerms);
@@ -700,8 +750,8 @@ static void _xfdashboard_search_view_update_provider_container(XfdashboardSearch
 static gboolean _xfdashboard_search_view_can_do_incremental_search(XfdashboardSearchViewSearchTerms *inProviderLastTerms,
 																	XfdashboardSearchViewSearchTerms *inCurrentSearchTerms)
 {
-	gchar						**iterProvider;
-	gchar						**iterCurrent;
+	const gchar					**iterProvider;
+	const gchar					**iterCurrent;
 
 	g_return_val_if_fail(inCurrentSearchTerms, FALSE);
 
@@ -716,8 +766,8 @@ static gboolean _xfdashboard_search_view_can_do_incremental_search(XfdashboardSe
 	 * has not changed and each term in both search terms is a case-sensitive
 	 * prefix of the term previously used.
 	 */
-	iterProvider=inProviderLastTerms->termList;
-	iterCurrent=inCurrentSearchTerms->termList;
+	iterProvider=xfdashboard_search_query_get_terms(inProviderLastTerms->query);
+	iterCurrent=xfdashboard_search_query_get_terms(inCurrentSearchTerms->query);
 	while(*iterProvider && *iterCurrent)
 	{
 		if(g_strcmp0(*iterProvider, *iterCurrent)>0) return(FALSE);
@@ -738,6 +788,169 @@ static gboolean _xfdashboard_search_view_can_do_incremental_search(XfdashboardSe
 	return(FALSE);
 }
 
+/* If this view has the focus then check if this view has a selection set currently.
+ * If not select the first selectable actor otherwise just ensure the current
+ * selection is visible.
+ */
+static void _xfdashboard_search_view_ensure_selection(XfdashboardSearchView *self)
+{
+	XfdashboardSearchViewPrivate				*priv;
+	ClutterActor								*selection;
+
+	g_return_if_fail(XFDASHBOARD_IS_SEARCH_VIEW(self));
+
+	priv=self->priv;
+
+	if(!xfdashboard_focus_manager_has_focus(priv->focusManager, XFDASHBOARD_FOCUSABLE(self))) return;
+
+	/* Check if this view has a selection set */
+	selection=xfdashboard_focusable_get_selection(XFDASHBOARD_FOCUSABLE(self));
+	if(!selection)
+	{
+		/* Select first selectable item */
+		selection=xfdashboard_focusable_find_selection(XFDASHBOARD_FOCUSABLE(self),
+														NULL,
+														XFDASHBOARD_SELECTION_TARGET_FIRST);
+		xfdashboard_focusable_set_selection(XFDASHBOARD_FOCUSABLE(self), selection);
+	}
+
+	/* Ensure selection is visible. But we have to have for a repaint because
+	 * allocation of this view has not changed yet.
+	 */
+	if(selection &&
+		priv->repaintID==0)
+	{
+		priv->repaintID=clutter_threads_add_repaint_func_full(CLUTTER_REPAINT_FLAGS_QUEUE_REDRAW_ON_ADD | CLUTTER_REPAINT_FLAGS_POST_PAINT,
+																_xfdashboard_search_view_on_repaint_after_update_callback,
+																self,
+																NULL);
+	}
+}
+
+/* Run search jobs of providers for a time slice. This source has a lower
+ * priority than redrawing the stage, so the stage is painted and events are
+ * processed between slices. Partial results are shown after each slice.
+ */
+static gboolean _xfdashboard_search_view_on_search_job_slice(gpointer inUserData)
+{
+	XfdashboardSearchView						*self;
+	XfdashboardSearchViewPrivate				*priv;
+	GList										*providers;
+	GList										*iter;
+	gint64										deadline;
+	gboolean									hasRunningJobs;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_SEARCH_VIEW(inUserData), G_SOURCE_REMOVE);
+
+	self=XFDASHBOARD_SEARCH_VIEW(inUserData);
+	priv=self->priv;
+	hasRunningJobs=FALSE;
+
+	/* Run search jobs of all providers until time slice is used up */
+	deadline=g_get_monotonic_time()+SEARCH_JOB_TIME_SLICE;
+
+	providers=g_list_copy(priv->providers);
+	g_list_foreach(providers, (GFunc)_xfdashboard_search_view_provider_data_ref, NULL);
+	for(iter=providers; iter; iter=g_list_next(iter))
+	{
+		XfdashboardSearchViewProviderData		*providerData;
+		XfdashboardSearchResultSet				*resultSet;
+
+		/* Get data for provider and skip it if it has no running search job */
+		providerData=((XfdashboardSearchViewProviderData*)(iter->data));
+		if(!providerData->searchJob) continue;
+
+		/* If time slice is used up, keep job for next slice */
+		if(g_get_monotonic_time()>=deadline)
+		{
+			hasRunningJobs=TRUE;
+			continue;
+		}
+
+		/* Run search job */
+		resultSet=g_object_ref(providerData->searchJobResultSet);
+		if(xfdashboard_search_provider_run_search_job(providerData->provider, providerData->searchJob, deadline))
+		{
+			/* Job is not finished yet, so show partial results found so far.
+			 * Keep results of previous search until first results were found.
+			 */
+			if(xfdashboard_search_result_set_get_size(resultSet)>0)
+			{
+				_xfdashboard_search_view_update_provider_container(self, providerData, resultSet);
+			}
+
+			hasRunningJobs=TRUE;
+		}
+			else
+			{
+				/* Job is finished, so end it and show its complete result set */
+				xfdashboard_search_provider_end_search_job(providerData->provider, providerData->searchJob);
+				providerData->searchJob=NULL;
+
+				g_object_unref(providerData->searchJobResultSet);
+				providerData->searchJobResultSet=NULL;
+
+				g_debug("Finished search job at search provider %s and got %u result items",
+							G_OBJECT_TYPE_NAME(providerData->provider),
+							xfdashboard_search_result_set_get_size(resultSet));
+
+				_xfdashboard_search_view_update_provider_container(self, providerData, resultSet);
+			}
+
+		/* Release allocated resources */
+		g_object_unref(resultSet);
+	}
+	g_list_free_full(providers, (GDestroyNotify)_xfdashboard_search_view_provider_data_unref);
+
+	/* Select first selectable item if needed and ensure selection is visible */
+	_xfdashboard_search_view_ensure_selection(self);
+
+	/* Emit signal that search was updated */
+	g_signal_emit(self, XfdashboardSearchViewSignals[SIGNAL_SEARCH_UPDATED], 0);
+
+	/* Run this source again if any search job is not finished yet */
+	if(hasRunningJobs) return(G_SOURCE_CONTINUE);
+
+	/* All search jobs for these search terms are finished, so notify if no
+	 * provider found any result and the search should notify about it.
+	 */
+	if(priv->searchJobNotifyNoResults && priv->lastTerms)
+	{
+		guint									numberResults;
+
+		numberResults=0;
+		for(iter=priv->providers; iter; iter=g_list_next(iter))
+		{
+			XfdashboardSearchViewProviderData	*providerData;
+
+			providerData=((XfdashboardSearchViewProviderData*)(iter->data));
+			if(providerData->lastResultSet) numberResults+=xfdashboard_search_result_set_get_size(providerData->lastResultSet);
+		}
+
+		if(numberResults==0)
+		{
+			xfdashboard_notify(CLUTTER_ACTOR(self),
+								xfdashboard_view_get_icon(XFDASHBOARD_VIEW(self)),
+								_("No results found for '%s'"),
+								priv->lastTerms->termString);
+		}
+	}
+	priv->searchJobNotifyNoResults=FALSE;
+
+	/* All search jobs for these search terms are finished, so count search
+	 * and time taken until now at instrumentation.
+	 */
+	if(priv->searchStartTime>0)
+	{
+		xfdashboard_instrumentation_add(XFDASHBOARD_INSTRUMENTATION_COUNTER_SEARCHES, 1);
+		xfdashboard_instrumentation_add(XFDASHBOARD_INSTRUMENTATION_COUNTER_SEARCH_TIME, g_get_monotonic_time()-priv->searchStartTime);
+		priv->searchStartTime=0;
+	}
+
+	priv->searchJobSourceID=0;
+	return(G_SOURCE_REMOVE);
+}
+
 /* Perform search */
 static guint _xfdashboard_search_view_perform_search(XfdashboardSearchView *self, XfdashboardSearchViewSearchTerms *inSearchTerms)
 {
@@ -758,6 +971,16 @@ static guint _xfdashboard_search_view_perform_search(XfdashboardSearchView *self
 	priv=self->priv;
 	numberResults=0;
 
+	/* A search still pending for previous search terms does not notify about
+	 * having no results anymore.
+	 */
+	priv->searchJobNotifyNoResults=FALSE;
+
+	/* Remember start time of search for instrumentation. A search still
+	 * pending for previous search terms is cancelled and not counted.
+	 */
+	priv->searchStartTime=xfdashboard_instrumentation_is_enabled() ? g_get_monotonic_time() : 0;
+
 #ifdef DEBUG
 	/* Start timer for debug search performance */
 	timer=g_timer_new();
@@ -831,6 +1054,9 @@ static guint _xfdashboard_search_view_perform_search(XfdashboardSearchView *self
 		/* Get data for provider to perform search at */
 		providerData=((XfdashboardSearchViewProviderData*)(iter->data));
 
+		/* Cancel search job still running for previous search terms */
+		_xfdashboard_search_view_provider_data_cancel_search_job(providerData);
+
 		/* Check if we can do an incremental search based on previous
 		 * results or if we have to do a full search.
 		 */
@@ -843,9 +1069,53 @@ static guint _xfdashboard_search_view_perform_search(XfdashboardSearchView *self
 			if(providerData->lastResultSet) providerLastResultSet=g_object_ref(providerData->lastResultSet);
 		}
 
-		/* Perform search */
+		/* If provider supports search jobs begin a new job which is run in
+		 * time slices later. The container of provider is updated as results
+		 * are found.
+		 */
+		if(xfdashboard_search_provider_has_search_job(providerData->provider))
+		{
+			providerData->searchJobResultSet=xfdashboard_search_result_set_new();
+			providerData->searchJob=xfdashboard_search_provider_begin_search_job(providerData->provider,
+																					inSearchTerms->query,
+																					providerLastResultSet,
+																					providerData->searchJobResultSet);
+			g_debug("Began %s search job at search provider %s",
+						canDoIncrementalSearch==TRUE ? "incremental" : "full",
+						G_OBJECT_TYPE_NAME(providerData->provider));
+
+			/* Remember new search term as last one at search provider */
+			if(providerData->lastTerms) _xfdashboard_search_view_search_terms_unref(providerData->lastTerms);
+			providerData->lastTerms=_xfdashboard_search_view_search_terms_ref(inSearchTerms);
+
+			if(providerData->searchJob)
+			{
+				/* Schedule running search jobs if not done already */
+				if(!priv->searchJobSourceID)
+				{
+					priv->searchJobSourceID=g_idle_add(_xfdashboard_search_view_on_search_job_slice, self);
+				}
+			}
+				else
+				{
+					/* There is nothing to search for at this provider */
+					g_object_unref(providerData->searchJobResultSet);
+					providerData->searchJobResultSet=NULL;
+
+					_xfdashboard_search_view_update_provider_container(self, providerData, NULL);
+				}
+
+			/* Release allocated resources */
+			if(providerLastResultSet) g_object_unref(providerLastResultSet);
+
+			continue;
+		}
+
+		/* Perform search with search terms as entered for providers which
+		 * do not support queries.
+		 */
 		providerNewResultSet=xfdashboard_search_provider_get_result_set(providerData->provider,
-																		(const gchar**)inSearchTerms->termList,
+																		xfdashboard_search_query_get_terms(inSearchTerms->query),
 																		providerLastResultSet);
 		g_debug("Performed %s search at search provider %s and got %u result items",
 					canDoIncrementalSearch==TRUE ? "incremental" : "full",
@@ -878,6 +1148,17 @@ static guint _xfdashboard_search_view_perform_search(XfdashboardSearchView *self
 	g_timer_destroy(timer);
 #endif
 
+	/* Count search and time taken to update results at instrumentation if
+	 * no search job was started. Otherwise it is counted when the last search
+	 * job has finished.
+	 */
+	if(priv->searchStartTime>0 && !priv->searchJobSourceID)
+	{
+		xfdashboard_instrumentation_add(XFDASHBOARD_INSTRUMENTATION_COUNTER_SEARCHES, 1);
+		xfdashboard_instrumentation_add(XFDASHBOARD_INSTRUMENTATION_COUNTER_SEARCH_TIME, g_get_monotonic_time()-priv->searchStartTime);
+		priv->searchStartTime=0;
+	}
+
 	/* Reselect first or last item at provider if we remembered the provider where
 	 * the item should be reselected and if selection has changed while updating results.
 	 */
@@ -910,37 +1191,8 @@ static guint _xfdashboard_search_view_perform_search(XfdashboardSearchView *self
 		}
 	}
 
-	/* If this view has the focus then check if this view has a selection set currently.
-	 * If not select the first selectable actor otherwise just ensure the current
-	 * selection is visible.
-	 */
-	if(xfdashboard_focus_manager_has_focus(priv->focusManager, XFDASHBOARD_FOCUSABLE(self)))
-	{
-		ClutterActor							*selection;
-
-		/* Check if this view has a selection set */
-		selection=xfdashboard_focusable_get_selection(XFDASHBOARD_FOCUSABLE(self));
-		if(!selection)
-		{
-			/* Select first selectable item */
-			selection=xfdashboard_focusable_find_selection(XFDASHBOARD_FOCUSABLE(self),
-															NULL,
-															XFDASHBOARD_SELECTION_TARGET_FIRST);
-			xfdashboard_focusable_set_selection(XFDASHBOARD_FOCUSABLE(self), selection);
-		}
-
-		/* Ensure selection is visible. But we have to have for a repaint because
-		 * allocation of this view has not changed yet.
-		 */
-		if(selection &&
-			priv->repaintID==0)
-		{
-			priv->repaintID=clutter_threads_add_repaint_func_full(CLUTTER_REPAINT_FLAGS_QUEUE_REDRAW_ON_ADD | CLUTTER_REPAINT_FLAGS_POST_PAINT,
-																	_xfdashboard_search_view_on_repaint_after_update_callback,
-																	self,
-																	NULL);
-		}
-	}
+	/* Select first selectable item if needed and ensure selection is visible */
+	_xfdashboard_search_view_ensure_selection(self);
 
 	/* Emit signal that search was updated */
 	g_signal_emit(self, XfdashboardSearchViewSignals[SIGNAL_SEARCH_UPDATED], 0);
@@ -965,10 +1217,18 @@ static gboolean _xfdashboard_search_view_on_perform_search_delayed_timeout(gpoin
 	numberResults=_xfdashboard_search_view_perform_search(self, priv->delaySearchTerms);
 	if(numberResults==0)
 	{
-		xfdashboard_notify(CLUTTER_ACTOR(self),
-							xfdashboard_view_get_icon(XFDASHBOARD_VIEW(self)),
-							_("No results found for '%s'"),
-							priv->delaySearchTerms->termString);
+		/* If search jobs are still running, notify when they are finished */
+		if(priv->searchJobSourceID)
+		{
+			priv->searchJobNotifyNoResults=TRUE;
+		}
+			else
+			{
+				xfdashboard_notify(CLUTTER_ACTOR(self),
+									xfdashboard_view_get_icon(XFDASHBOARD_VIEW(self)),
+									_("No results found for '%s'"),
+									priv->delaySearchTerms->termString);
+			}
 	}
 
 	/* Release allocated resources */
@@ -1584,6 +1844,13 @@ static void _xfdashboard_search_view_dispose(GObject *inObject)
 		priv->delaySearchTimeoutID=0;
 	}
 
+	if(priv->searchJobSourceID)
+	{
+		g_source_remove(priv->searchJobSourceID);
+		priv->searchJobSourceID=0;
+	}
+	priv->searchStartTime=0;
+
 	if(priv->delaySearchTerms)
 	{
 		_xfdashboard_search_view_search_terms_unref(priv->delaySearchTerms);
@@ -1698,6 +1965,9 @@ static void xfdashboard_search_view_init(XfdashboardSearchView *self)
 	priv->selectionProvider=NULL;
 	priv->focusManager=xfdashboard_focus_manager_get_default();
 	priv->repaintID=0;
+	priv->searchJobSourceID=0;
+	priv->searchStartTime=0;
+	priv->searchJobNotifyNoResults=FALSE;
 	priv->xfconfChannel=xfdashboard_application_get_xfconf_channel(NULL);
 
 	/* Set up view (Note: Search view is disabled by default!) */
@@ -1763,6 +2033,15 @@ void xfdashboard_search_view_reset_search(XfdashboardSearchView *self)
 		priv->delaySearchTimeoutID=0;
 	}
 
+	/* Remove source running search jobs if set */
+	if(priv->searchJobSourceID)
+	{
+		g_source_remove(priv->searchJobSourceID);
+		priv->searchJobSourceID=0;
+	}
+	priv->searchStartTime=0;
+	priv->searchJobNotifyNoResults=FALSE;
+
 	/* Reset all search providers by destroying actors, destroying containers,
 	 * clearing mappings and release all other allocated resources used.
 	 */
@@ -1775,6 +2054,9 @@ void xfdashboard_search_view_reset_search(XfdashboardSearchView *self)
 		/* Get data for provider to reset */
 		providerData=((XfdashboardSearchViewProviderData*)(iter->data));
 
+		/* Cancel running search job */
+		_xfdashboard_search_view_provider_data_cancel_search_job(providerData);
+
 		/* Destroy container */
 		if(providerData->container)
 		{
@@ -28,6 +28,7 @@
 #include <libxfdashboard/stage-interface.h>
 
 #include <glib/gi18n-lib.h>
+#include <math.h>
 
 #include <libxfdashboard/actor.h>
 #include <libxfdashboard/enums.h>
@@ -143,6 +144,43 @@ static void xfdashboard_stage_interface_parent_set(ClutterActor *inActor, Clutte
 	}
 }
 
+/* A redraw was queued at this actor or one of its children */
+static void _xfdashboard_stage_interface_queue_redraw(ClutterActor *inActor, ClutterActor *inOrigin)
+{
+	ClutterActorClass					*parentClass;
+	ClutterActorBox						allocation;
+	cairo_rectangle_int_t				clip;
+
+	g_return_if_fail(XFDASHBOARD_IS_STAGE_INTERFACE(inActor));
+
+	/* If a child queued a redraw but cannot tell which area it will paint to,
+	 * the stage would redraw itself completely, i.e. all monitors. As each
+	 * stage interface covers exactly one monitor and all its children are
+	 * placed within it, track this damage at this monitor only by queuing
+	 * a redraw clipped to the allocation of this stage interface instead.
+	 */
+	if(inOrigin!=inActor &&
+		clutter_actor_has_allocation(inActor) &&
+		!clutter_actor_get_paint_volume(inOrigin))
+	{
+		clutter_actor_get_allocation_box(inActor, &allocation);
+
+		clip.x=0;
+		clip.y=0;
+		clip.width=(gint)ceil(clutter_actor_box_get_width(&allocation));
+		clip.height=(gint)ceil(clutter_actor_box_get_height(&allocation));
+		clutter_actor_queue_redraw_with_clip(inActor, &clip);
+		return;
+	}
+
+	/* Call parent's virtual function */
+	parentClass=CLUTTER_ACTOR_CLASS(xfdashboard_stage_interface_parent_class);
+	if(parentClass->queue_redraw)
+	{
+		parentClass->queue_redraw(inActor, inOrigin);
+	}
+}
+
 /* Get preferred width/height */
 static void _xfdashboard_stage_interface_get_preferred_height(ClutterActor *inActor,
 																gfloat inForWidth,
@@ -315,6 +353,7 @@ static void xfdashboard_stage_interface_class_init(XfdashboardStageInterfaceClas
 	clutterActorClass->parent_set=xfdashboard_stage_interface_parent_set;
 	clutterActorClass->get_preferred_width=_xfdashboard_stage_interface_get_preferred_width;
 	clutterActorClass->get_preferred_height=_xfdashboard_stage_interface_get_preferred_height;
+	clutterActorClass->queue_redraw=_xfdashboard_stage_interface_queue_redraw;
 
 	gobjectClass->dispose=_xfdashboard_stage_interface_dispose;
 	gobjectClass->set_property=_xfdashboard_stage_interface_set_property;
@@ -638,6 +638,27 @@ static void _xfdashboard_stage_on_application_suspend(XfdashboardStage *self, gp
 
 	/* Hide tooltip */
 	if(priv->tooltip) clutter_actor_hide(priv->tooltip);
+
+	/* If search should be reset on resume and memory should be released while
+	 * suspended, reset search now to release result sets and actors of search
+	 * view early.
+	 */
+	if(priv->searchbox &&
+		!xfdashboard_text_box_is_empty(XFDASHBOARD_TEXT_BOX(priv->searchbox)) &&
+		xfdashboard_application_get_suspend_memory_policy(XFDASHBOARD_APPLICATION(inUserData))>=XFDASHBOARD_SUSPEND_MEMORY_POLICY_VIEWS &&
+		xfconf_channel_get_bool(xfdashboard_application_get_xfconf_channel(NULL),
+								RESET_SEARCH_ON_RESUME_XFCONF_PROP,
+								DEFAULT_RESET_SEARCH_ON_RESUME))
+	{
+		XfdashboardView					*searchView;
+
+		/* Reset search in search view */
+		searchView=xfdashboard_viewpad_find_view_by_type(XFDASHBOARD_VIEWPAD(priv->viewpad), XFDASHBOARD_TYPE_SEARCH_VIEW);
+		if(searchView) xfdashboard_search_view_reset_search(XFDASHBOARD_SEARCH_VIEW(searchView));
+
+		/* Reset text in search box */
+		xfdashboard_text_box_set_text(XFDASHBOARD_TEXT_BOX(priv->searchbox), NULL);
+	}
 }
 
 /* The application will be resumed */
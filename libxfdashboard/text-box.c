@@ -1021,7 +1021,7 @@ void xfdashboard_text_box_set_padding(XfdashboardTextBox *self, gfloat inPadding
 	if(priv->padding!=inPadding)
 	{
 		priv->padding=inPadding;
-		clutter_actor_queue_relayout(CLUTTER_ACTOR(self));
+		xfdashboard_actor_queue_relayout(XFDASHBOARD_ACTOR(self));
 
 		/* Notify about property change */
 		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardTextBoxProperties[PROP_PADDING]);
@@ -1049,7 +1049,7 @@ void xfdashboard_text_box_set_spacing(XfdashboardTextBox *self, gfloat inSpacing
 	if(priv->spacing!=inSpacing)
 	{
 		priv->spacing=inSpacing;
-		clutter_actor_queue_relayout(CLUTTER_ACTOR(self));
+		xfdashboard_actor_queue_relayout(XFDASHBOARD_ACTOR(self));
 
 		/* Notify about property change */
 		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardTextBoxProperties[PROP_SPACING]);
@@ -1094,7 +1094,7 @@ void xfdashboard_text_box_set_editable(XfdashboardTextBox *self, gboolean isEdit
 				clutter_actor_hide(priv->actorHintLabel);
 			}
 
-		clutter_actor_queue_relayout(CLUTTER_ACTOR(self));
+		xfdashboard_actor_queue_relayout(XFDASHBOARD_ACTOR(self));
 
 		/* Notify about property change */
 		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardTextBoxProperties[PROP_EDITABLE]);
@@ -1157,7 +1157,7 @@ void xfdashboard_text_box_set_text(XfdashboardTextBox *self, const gchar *inMark
 				clutter_actor_hide(priv->actorHintLabel);
 			}
 
-		clutter_actor_queue_relayout(CLUTTER_ACTOR(self));
+		xfdashboard_actor_queue_relayout(XFDASHBOARD_ACTOR(self));
 
 		/* Notify about property change */
 		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardTextBoxProperties[PROP_TEXT]);
@@ -1206,7 +1206,7 @@ void xfdashboard_text_box_set_text_font(XfdashboardTextBox *self, const gchar *i
 		priv->textFont=g_strdup(inFont);
 
 		clutter_text_set_font_name(CLUTTER_TEXT(priv->actorTextBox), priv->textFont);
-		clutter_actor_queue_relayout(CLUTTER_ACTOR(self));
+		xfdashboard_actor_queue_relayout(XFDASHBOARD_ACTOR(self));
 
 		/* Notify about property change */
 		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardTextBoxProperties[PROP_TEXT_FONT]);
@@ -1440,7 +1440,7 @@ void xfdashboard_text_box_set_hint_text(XfdashboardTextBox *self, const gchar *i
 	{
 		/* Set value */
 		clutter_text_set_markup(CLUTTER_TEXT(priv->actorHintLabel), inMarkupText);
-		clutter_actor_queue_relayout(CLUTTER_ACTOR(self));
+		xfdashboard_actor_queue_relayout(XFDASHBOARD_ACTOR(self));
 
 		/* Notify about property change */
 		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardTextBoxProperties[PROP_HINT_TEXT]);
@@ -1505,7 +1505,7 @@ void xfdashboard_text_box_set_hint_text_font(XfdashboardTextBox *self, const gch
 		priv->hintTextFont=g_strdup(inFont);
 
 		clutter_text_set_font_name(CLUTTER_TEXT(priv->actorHintLabel), priv->hintTextFont);
-		clutter_actor_queue_relayout(CLUTTER_ACTOR(self));
+		xfdashboard_actor_queue_relayout(XFDASHBOARD_ACTOR(self));
 
 		/* Notify about property change */
 		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardTextBoxProperties[PROP_HINT_TEXT_FONT]);
@@ -1579,14 +1579,14 @@ void xfdashboard_text_box_set_primary_icon(XfdashboardTextBox *self, const gchar
 			/* Show icon */
 			priv->showPrimaryIcon=TRUE;
 			clutter_actor_show(priv->actorPrimaryIcon);
-			clutter_actor_queue_relayout(CLUTTER_ACTOR(self));
+			xfdashboard_actor_queue_relayout(XFDASHBOARD_ACTOR(self));
 		}
 			else
 			{
 				/* Hide icon */
 				priv->showPrimaryIcon=FALSE;
 				clutter_actor_hide(priv->actorPrimaryIcon);
-				clutter_actor_queue_relayout(CLUTTER_ACTOR(self));
+				xfdashboard_actor_queue_relayout(XFDASHBOARD_ACTOR(self));
 			}
 
 		/* Notify about property change */
@@ -1630,14 +1630,14 @@ void xfdashboard_text_box_set_secondary_icon(XfdashboardTextBox *self, const gch
 			/* Show icon */
 			priv->showSecondaryIcon=TRUE;
 			clutter_actor_show(priv->actorSecondaryIcon);
-			clutter_actor_queue_relayout(CLUTTER_ACTOR(self));
+			xfdashboard_actor_queue_relayout(XFDASHBOARD_ACTOR(self));
 		}
 			else
 			{
 				/* Hide icon */
 				priv->showSecondaryIcon=FALSE;
 				clutter_actor_hide(priv->actorSecondaryIcon);
-				clutter_actor_queue_relayout(CLUTTER_ACTOR(self));
+				xfdashboard_actor_queue_relayout(XFDASHBOARD_ACTOR(self));
 			}
 
 		/* Notify about property change */
@@ -60,8 +60,11 @@ struct _XfdashboardThemeCSSPrivate
 	GSList		*names;
 
 	GHashTable	*registeredFunctions;
+	gpointer	functionCache;
 
 	gint		offsetLine;
+
+	GThreadPool	*parserPool;
 };
 
 /* Properties */
@@ -106,6 +109,61 @@ struct _XfdashboardThemeCSSTableCopyData
 	const gchar						*name;
 };
 
+typedef struct _XfdashboardThemeCSSParsedFile		XfdashboardThemeCSSParsedFile;
+struct _XfdashboardThemeCSSParsedFile
+{
+	gint							refCount;
+
+	gchar							*filename;
+	gint							priority;
+	GSList							*importedBy;
+
+	GMutex							lock;
+	GCond							finishedCond;
+	gboolean						finished;
+
+	GList							*entries;
+	guint							lines;
+	GError							*error;
+};
+
+typedef enum /*< skip,prefix=XFDASHBOARD_THEME_CSS_PARSED_ENTRY_TYPE >*/
+{
+	XFDASHBOARD_THEME_CSS_PARSED_ENTRY_TYPE_BLOCK=0,
+	XFDASHBOARD_THEME_CSS_PARSED_ENTRY_TYPE_IMPORT
+} XfdashboardThemeCSSParsedEntryType;
+
+typedef struct _XfdashboardThemeCSSParsedEntry		XfdashboardThemeCSSParsedEntry;
+struct _XfdashboardThemeCSSParsedEntry
+{
+	XfdashboardThemeCSSParsedEntryType	type;
+	guint								line;
+	guint								position;
+
+	/* Block */
+	GList								*selectors;
+	GList								*properties;
+	gboolean							doResolveAt;
+
+	/* Import */
+	XfdashboardThemeCSSParsedFile		*import;
+};
+
+typedef struct _XfdashboardThemeCSSParsedProperty	XfdashboardThemeCSSParsedProperty;
+struct _XfdashboardThemeCSSParsedProperty
+{
+	gchar								*key;
+	gchar								*value;
+	guint								line;
+	guint								position;
+};
+
+#if GLIB_CHECK_VERSION(2, 36, 0)
+#define XFDASHBOARD_THEME_CSS_PARSER_MAX_THREADS	(g_get_num_processors())
+#else
+#define XFDASHBOARD_THEME_CSS_PARSER_MAX_THREADS	4
+#endif
+
 #define XFDASHBOARD_THEME_CSS_FUNCTION_CALLBACK(f)	((XfdashboardThemeCSSFunctionCallback)(f))
 typedef gboolean (*XfdashboardThemeCSSFunctionCallback)(XfdashboardThemeCSS *self,
 														const gchar *inName,
@@ -113,6 +171,39 @@ typedef gboolean (*XfdashboardThemeCSSFunctionCallback)(XfdashboardThemeCSS *sel
 														GValue *outResult,
 														GError **outError);
 
+typedef enum /*< skip,flags,prefix=XFDASHBOARD_THEME_CSS_FUNCTION_FLAG >*/
+{
+	XFDASHBOARD_THEME_CSS_FUNCTION_FLAG_NONE=0,
+	XFDASHBOARD_THEME_CSS_FUNCTION_FLAG_CACHEABLE=1 << 0,
+	XFDASHBOARD_THEME_CSS_FUNCTION_FLAG_DEPENDS_ON_ICON_THEME=1 << 1
+} XfdashboardThemeCSSFunctionFlags;
+
+typedef struct _XfdashboardThemeCSSFunction			XfdashboardThemeCSSFunction;
+struct _XfdashboardThemeCSSFunction
+{
+	XfdashboardThemeCSSFunctionCallback		callback;
+	XfdashboardThemeCSSFunctionFlags		flags;
+};
+
+/* Results of CSS functions are shared by all theme instances so that a
+ * reloaded theme can use the results computed for the previous one.
+ * Functions are only called when merging parsed files into a theme
+ * which happens in the thread calling xfdashboard_theme_css_add_file().
+ */
+typedef struct _XfdashboardThemeCSSFunctionCache	XfdashboardThemeCSSFunctionCache;
+struct _XfdashboardThemeCSSFunctionCache
+{
+	gint									refCount;
+
+	GHashTable								*results;
+	GHashTable								*iconThemeResults;
+
+	GtkIconTheme							*iconTheme;
+	guint									iconThemeChangedSignalID;
+};
+
+static XfdashboardThemeCSSFunctionCache		*_xfdashboard_theme_css_function_cache=NULL;
+
 /* Forward declarations */
 static void _xfdashboard_theme_css_set_error(XfdashboardThemeCSS *self,
 												GError **outError,
@@ -130,6 +221,11 @@ static gchar* _xfdashboard_theme_css_resolve_at_identifier_by_string(Xfdashboard
 																		GScanner *inScopeScanner,
 																		GList *inScopeSelectors);
 
+static void _xfdashboard_theme_css_parsed_entry_free(XfdashboardThemeCSSParsedEntry *inEntry);
+
+static void _xfdashboard_theme_css_parsed_file_queue(XfdashboardThemeCSS *self,
+														XfdashboardThemeCSSParsedFile *inFile);
+
 /* Helper function to set up GError object in this parser */
 static void _xfdashboard_theme_css_set_error(XfdashboardThemeCSS *self,
 												GError **outError,
@@ -247,6 +343,98 @@ static XfdashboardThemeCSSSelector* _xfdashboard_theme_css_selector_new(const gc
 	return(selector);
 }
 
+/* Destroy parsed property */
+static void _xfdashboard_theme_css_parsed_property_free(XfdashboardThemeCSSParsedProperty *inProperty)
+{
+	g_return_if_fail(inProperty);
+
+	/* Free allocated resources */
+	if(inProperty->key) g_free(inProperty->key);
+	if(inProperty->value) g_free(inProperty->value);
+
+	/* Free parsed property itself */
+	g_slice_free(XfdashboardThemeCSSParsedProperty, inProperty);
+}
+
+/* Create parsed CSS file which is shared between the thread parsing it and
+ * the one merging it into theme.
+ */
+static XfdashboardThemeCSSParsedFile* _xfdashboard_theme_css_parsed_file_new(const gchar *inFilename,
+																				gint inPriority,
+																				XfdashboardThemeCSSParsedFile *inImportedBy)
+{
+	XfdashboardThemeCSSParsedFile	*file;
+	GSList							*iter;
+
+	g_return_val_if_fail(inFilename && *inFilename, NULL);
+
+	file=g_slice_new0(XfdashboardThemeCSSParsedFile);
+	file->refCount=1;
+	file->filename=g_strdup(inFilename);
+	file->priority=inPriority;
+	file->finished=FALSE;
+	g_mutex_init(&file->lock);
+	g_cond_init(&file->finishedCond);
+
+	/* Remember all files importing this one to detect recursive imports */
+	if(inImportedBy)
+	{
+		for(iter=inImportedBy->importedBy; iter; iter=g_slist_next(iter))
+		{
+			file->importedBy=g_slist_prepend(file->importedBy, g_strdup((const gchar*)iter->data));
+		}
+		file->importedBy=g_slist_prepend(file->importedBy, g_strdup(inImportedBy->filename));
+	}
+
+	return(file);
+}
+
+static XfdashboardThemeCSSParsedFile* _xfdashboard_theme_css_parsed_file_ref(XfdashboardThemeCSSParsedFile *inFile)
+{
+	g_return_val_if_fail(inFile, NULL);
+
+	g_atomic_int_inc(&inFile->refCount);
+	return(inFile);
+}
+
+static void _xfdashboard_theme_css_parsed_file_unref(XfdashboardThemeCSSParsedFile *inFile)
+{
+	g_return_if_fail(inFile);
+
+	if(!g_atomic_int_dec_and_test(&inFile->refCount)) return;
+
+	/* Free allocated resources */
+	if(inFile->entries) g_list_free_full(inFile->entries, (GDestroyNotify)_xfdashboard_theme_css_parsed_entry_free);
+	if(inFile->importedBy) g_slist_free_full(inFile->importedBy, g_free);
+	if(inFile->error) g_error_free(inFile->error);
+	if(inFile->filename) g_free(inFile->filename);
+
+	g_cond_clear(&inFile->finishedCond);
+	g_mutex_clear(&inFile->lock);
+
+	/* Free parsed file itself */
+	g_slice_free(XfdashboardThemeCSSParsedFile, inFile);
+}
+
+/* Destroy parsed entry */
+static void _xfdashboard_theme_css_parsed_entry_free(XfdashboardThemeCSSParsedEntry *inEntry)
+{
+	g_return_if_fail(inEntry);
+
+	/* Free allocated resources */
+	if(inEntry->selectors)
+	{
+		g_list_foreach(inEntry->selectors, (GFunc)_xfdashboard_theme_css_selector_free, NULL);
+		g_list_free(inEntry->selectors);
+	}
+
+	if(inEntry->properties) g_list_free_full(inEntry->properties, (GDestroyNotify)_xfdashboard_theme_css_parsed_property_free);
+	if(inEntry->import) _xfdashboard_theme_css_parsed_file_unref(inEntry->import);
+
+	/* Free parsed entry itself */
+	g_slice_free(XfdashboardThemeCSSParsedEntry, inEntry);
+}
+
 /* Get function argument and transform it to requested type.
  * Returned value must first be cleared with g_value_unset and
  * then freed with g_free.
@@ -872,12 +1060,125 @@ static gboolean _xfdashboard_theme_css_function_rgb_rgba(XfdashboardThemeCSS *se
 	return(TRUE);
 }
 
+/* Icon theme has changed so forget all results of CSS functions depending on it */
+static void _xfdashboard_theme_css_function_cache_on_icon_theme_changed(GtkIconTheme *inIconTheme,
+																		gpointer inUserData)
+{
+	XfdashboardThemeCSSFunctionCache	*cache;
+
+	g_return_if_fail(inUserData);
+
+	cache=(XfdashboardThemeCSSFunctionCache*)inUserData;
+
+	g_debug("Icon theme changed so forgetting %u cached results of CSS functions depending on it",
+				g_hash_table_size(cache->iconThemeResults));
+	g_hash_table_remove_all(cache->iconThemeResults);
+}
+
+/* Create, ref and unref shared cache of CSS function results */
+static XfdashboardThemeCSSFunctionCache* _xfdashboard_theme_css_function_cache_ref(void)
+{
+	XfdashboardThemeCSSFunctionCache	*cache;
+
+	/* Create cache if it does not exist yet */
+	if(!_xfdashboard_theme_css_function_cache)
+	{
+		cache=g_new0(XfdashboardThemeCSSFunctionCache, 1);
+		cache->refCount=0;
+		cache->results=g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+		cache->iconThemeResults=g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+
+		cache->iconTheme=GTK_ICON_THEME(g_object_ref(gtk_icon_theme_get_default()));
+		cache->iconThemeChangedSignalID=g_signal_connect(cache->iconTheme,
+															"changed",
+															G_CALLBACK(_xfdashboard_theme_css_function_cache_on_icon_theme_changed),
+															cache);
+
+		_xfdashboard_theme_css_function_cache=cache;
+	}
+
+	/* Take a reference on cache and return it */
+	_xfdashboard_theme_css_function_cache->refCount++;
+	return(_xfdashboard_theme_css_function_cache);
+}
+
+static void _xfdashboard_theme_css_function_cache_unref(XfdashboardThemeCSSFunctionCache *inCache)
+{
+	g_return_if_fail(inCache);
+	g_return_if_fail(inCache==_xfdashboard_theme_css_function_cache);
+
+	/* Release reference and destroy cache if it was the last one */
+	inCache->refCount--;
+	if(inCache->refCount>0) return;
+
+	if(inCache->iconThemeChangedSignalID)
+	{
+		g_signal_handler_disconnect(inCache->iconTheme, inCache->iconThemeChangedSignalID);
+		inCache->iconThemeChangedSignalID=0;
+	}
+
+	if(inCache->iconTheme) g_object_unref(inCache->iconTheme);
+	if(inCache->iconThemeResults) g_hash_table_destroy(inCache->iconThemeResults);
+	if(inCache->results) g_hash_table_destroy(inCache->results);
+	g_free(inCache);
+
+	_xfdashboard_theme_css_function_cache=NULL;
+}
+
+/* Build key to lookup result of a CSS function in cache from normalized arguments */
+static gchar* _xfdashboard_theme_css_function_cache_get_key(XfdashboardThemeCSS *self,
+																const gchar *inName,
+																XfdashboardThemeCSSFunction *inFunction,
+																GList *inArguments)
+{
+	XfdashboardThemeCSSPrivate			*priv;
+	GString								*key;
+	gchar								*argument;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_THEME_CSS(self), NULL);
+	g_return_val_if_fail(inName && *inName, NULL);
+	g_return_val_if_fail(inFunction, NULL);
+
+	priv=self->priv;
+
+	/* Functions depending on icon theme also resolve paths relative to theme
+	 * so theme path is part of key. Each part of key is prefixed with its
+	 * length so parts containing separators, e.g. quoted arguments containing
+	 * commas, cannot make different calls share the same key.
+	 */
+	key=g_string_new(NULL);
+	if(inFunction->flags & XFDASHBOARD_THEME_CSS_FUNCTION_FLAG_DEPENDS_ON_ICON_THEME)
+	{
+		g_string_append_printf(key, "%" G_GSIZE_FORMAT ":%s\n",
+								priv->themePath ? strlen(priv->themePath) : 0,
+								priv->themePath ? priv->themePath : "");
+	}
+
+	/* Add function name and its arguments stripped from leading and trailing
+	 * whitespace.
+	 */
+	g_string_append(key, inName);
+	g_string_append_c(key, '(');
+	for(; inArguments; inArguments=g_list_next(inArguments))
+	{
+		argument=g_strstrip(g_strdup((const gchar*)inArguments->data));
+		g_string_append_printf(key, "%" G_GSIZE_FORMAT ":%s", strlen(argument), argument);
+		if(g_list_next(inArguments)) g_string_append_c(key, ',');
+		g_free(argument);
+	}
+	g_string_append_c(key, ')');
+
+	return(g_string_free(key, FALSE));
+}
+
 /* Register CSS function */
 static void _xfdashboard_theme_css_register_function(XfdashboardThemeCSS *self,
 														const gchar *inName,
-														XfdashboardThemeCSSFunctionCallback inCallback)
+														XfdashboardThemeCSSFunctionCallback inCallback,
+														XfdashboardThemeCSSFunctionFlags inFlags)
 {
 	XfdashboardThemeCSSPrivate		*priv;
+	XfdashboardThemeCSSFunction		*function;
 
 	g_return_if_fail(XFDASHBOARD_IS_THEME_CSS(self));
 	g_return_if_fail(inName);
@@ -893,7 +1194,7 @@ static void _xfdashboard_theme_css_register_function(XfdashboardThemeCSS *self,
 		priv->registeredFunctions=g_hash_table_new_full(g_str_hash,
 														g_str_equal,
 														g_free,
-														NULL);
+														g_free);
 	}
 
 	/* Check if a function with this name is already registered */
@@ -903,10 +1204,14 @@ static void _xfdashboard_theme_css_register_function(XfdashboardThemeCSS *self,
 		return;
 	}
 
-	/* Register function by adding name (as key) and callback (as value) to
-	 * hash-table of registered functions.
+	/* Register function by adding name (as key) and callback with its flags
+	 * (as value) to hash-table of registered functions.
 	 */
-	g_hash_table_insert(priv->registeredFunctions, g_strdup(inName), inCallback);
+	function=g_new0(XfdashboardThemeCSSFunction, 1);
+	function->callback=inCallback;
+	function->flags=inFlags;
+
+	g_hash_table_insert(priv->registeredFunctions, g_strdup(inName), function);
 }
 
 /* Resolve '@' identifier.
@@ -924,7 +1229,7 @@ static gchar* _xfdashboard_theme_css_parse_at_identifier(XfdashboardThemeCSS *se
 	XfdashboardThemeCSSSelector				*selector;
 	gpointer								value;
 	gchar									*errorMessage;
-	XfdashboardThemeCSSFunctionCallback		functionCallback;
+	XfdashboardThemeCSSFunction				*function;
 
 	g_return_val_if_fail(XFDASHBOARD_IS_THEME_CSS(self), NULL);
 	g_return_val_if_fail(ioScanner, NULL);
@@ -950,7 +1255,7 @@ static gchar* _xfdashboard_theme_css_parse_at_identifier(XfdashboardThemeCSS *se
 	/* Check if identifier is a function then parse function argument and
 	 * call function.
 	 */
-	if(g_hash_table_lookup_extended(priv->registeredFunctions, identifier, NULL, (gpointer*)&functionCallback))
+	if(g_hash_table_lookup_extended(priv->registeredFunctions, identifier, NULL, (gpointer*)&function))
 	{
 		gboolean				error;
 		GList					*arguments;
@@ -958,6 +1263,8 @@ static gchar* _xfdashboard_theme_css_parse_at_identifier(XfdashboardThemeCSS *se
 		GScannerConfig			*scannerConfig;
 		GScannerConfig			*oldScannerConfig;
 		gchar					*result;
+		gchar					*cacheKey;
+		GHashTable				*cacheTable;
 
 		error=FALSE;
 		arguments=NULL;
@@ -1181,6 +1488,38 @@ static gchar* _xfdashboard_theme_css_parse_at_identifier(XfdashboardThemeCSS *se
 		ioScanner->config=oldScannerConfig;
 		g_free(scannerConfig);
 
+		/* Lookup result of function with same arguments in cache if no error
+		 * occured so far and function is cacheable.
+		 */
+		cacheKey=NULL;
+		cacheTable=NULL;
+		if(!error &&
+			(function->flags & XFDASHBOARD_THEME_CSS_FUNCTION_FLAG_CACHEABLE) &&
+			priv->functionCache)
+		{
+			XfdashboardThemeCSSFunctionCache	*cache;
+			const gchar							*cachedResult;
+
+			cache=(XfdashboardThemeCSSFunctionCache*)priv->functionCache;
+			if(function->flags & XFDASHBOARD_THEME_CSS_FUNCTION_FLAG_DEPENDS_ON_ICON_THEME) cacheTable=cache->iconThemeResults;
+				else cacheTable=cache->results;
+
+			cacheKey=_xfdashboard_theme_css_function_cache_get_key(self, identifier, function, arguments);
+			cachedResult=(const gchar*)g_hash_table_lookup(cacheTable, cacheKey);
+			if(cachedResult)
+			{
+				g_debug("Using cached result '%s' for function call %s", cachedResult, cacheKey);
+
+				/* Release allocated resources */
+				if(arguments) g_list_free_full(arguments, (GDestroyNotify)g_free);
+				g_free(cacheKey);
+				g_free(identifier);
+
+				/* Return cached value */
+				return(g_strdup(cachedResult));
+			}
+		}
+
 		/* Do function call if no error occured so far */
 		if(!error)
 		{
@@ -1192,7 +1531,7 @@ static gchar* _xfdashboard_theme_css_parse_at_identifier(XfdashboardThemeCSS *se
 			functionError=NULL;
 
 			g_debug("Calling registered function %s with %d arguments", identifier, g_list_length(arguments));
-			functionSuccess=(functionCallback)(self, identifier, arguments, &functionValue, &functionError);
+			functionSuccess=(function->callback)(self, identifier, arguments, &functionValue, &functionError);
 			if(functionSuccess)
 			{
 				GValue			stringValue=G_VALUE_INIT;
@@ -1203,6 +1542,13 @@ static gchar* _xfdashboard_theme_css_parse_at_identifier(XfdashboardThemeCSS *se
 				if(g_value_transform(&functionValue, &stringValue))
 				{
 					result=g_value_dup_string(&stringValue);
+
+					/* Remember result in cache if function is cacheable */
+					if(cacheKey && result)
+					{
+						g_hash_table_insert(cacheTable, cacheKey, g_strdup(result));
+						cacheKey=NULL;
+					}
 				}
 					else
 					{
@@ -1265,6 +1611,7 @@ static gchar* _xfdashboard_theme_css_parse_at_identifier(XfdashboardThemeCSS *se
 
 		/* Release allocated resources */
 		if(arguments) g_list_free_full(arguments, (GDestroyNotify)g_free);
+		if(cacheKey) g_free(cacheKey);
 		g_free(identifier);
 
 		/* Return value found */
@@ -1473,7 +1820,6 @@ static gchar* _xfdashboard_theme_css_resolve_at_identifier_by_string(Xfdashboard
 /* Parse CSS from stream */
 static GTokenType _xfdashboard_theme_css_parse_css_key_value(XfdashboardThemeCSS *self,
 																GScanner *inScanner,
-																GList *inScopeSelectors,
 																gboolean inDoResolveAt,
 																gchar **outKey,
 																gchar **outValue)
@@ -1615,33 +1961,19 @@ static GTokenType _xfdashboard_theme_css_parse_css_key_value(XfdashboardThemeCSS
 		return(';');
 	}
 
-	/* Resolve '@' identifiers if requested */
-	if(inDoResolveAt && *outValue)
-	{
-		gchar		*resolvedValue;
-
-		/* Resolve value */
-		g_debug("Resolving css value '%s'", *outValue);
-		resolvedValue=_xfdashboard_theme_css_resolve_at_identifier_by_string(self,
-																				*outValue,
-																				inScanner,
-																				inScopeSelectors);
-		g_debug("Resolved css value '%s' to '%s'", *outValue, resolvedValue);
-
-		/* Release old value and set new one */
-		g_free(*outValue);
-		*outValue=resolvedValue;
-	}
-
-	/* Strip leading and trailing whitespace from value */
-	if(*outValue) g_strstrip(*outValue);
+	/* Resolving '@' identifiers is deferred until the parsed file is merged
+	 * into theme because the constants in scope are only known at that time.
+	 * So only strip leading and trailing whitespace from value if it will
+	 * not be resolved later.
+	 */
+	if(!inDoResolveAt && *outValue) g_strstrip(*outValue);
 
 	/* Restore old parser options */
 	inScanner->config=oldScannerConfig;
 	g_free(scannerConfig);
 
-	/* If no value (means NULL value) is set when '@' identifiers were resolved
-	 * then an error is occurred.
+	/* If no value (means NULL value) is set but '@' identifiers should be
+	 * resolved then an error is occurred.
 	 */
 	if(inDoResolveAt && !*outValue) return(G_TOKEN_ERROR);
 
@@ -1651,17 +1983,17 @@ static GTokenType _xfdashboard_theme_css_parse_css_key_value(XfdashboardThemeCSS
 
 static GTokenType _xfdashboard_theme_css_parse_css_styles(XfdashboardThemeCSS *self,
 															GScanner *inScanner,
-															GList *inScopeSelectors,
 															gboolean inDoResolveAt,
-															GHashTable *ioHashtable)
+															GList **ioProperties)
 {
-	GTokenType		token;
-	gchar			*key;
-	gchar			*value;
+	GTokenType							token;
+	gchar								*key;
+	gchar								*value;
+	XfdashboardThemeCSSParsedProperty	*property;
 
 	g_return_val_if_fail(XFDASHBOARD_IS_THEME_CSS(self), G_TOKEN_ERROR);
 	g_return_val_if_fail(inScanner, G_TOKEN_ERROR);
-	g_return_val_if_fail(ioHashtable, G_TOKEN_ERROR);
+	g_return_val_if_fail(ioProperties, G_TOKEN_ERROR);
 
 	/* Check that style begin with left curly bracket */
 	token=g_scanner_get_next_token(inScanner);
@@ -1677,14 +2009,27 @@ static GTokenType _xfdashboard_theme_css_parse_css_styles(XfdashboardThemeCSS *s
 		/* Parse key and value */
 		token=_xfdashboard_theme_css_parse_css_key_value(self,
 															inScanner,
-															inScopeSelectors,
 															inDoResolveAt,
 															&key,
 															&value);
-		if(token!=G_TOKEN_NONE) return(token);
+		if(token!=G_TOKEN_NONE)
+		{
+			/* Release allocated resources */
+			if(key) g_free(key);
+			if(value) g_free(value);
+
+			return(token);
+		}
 
-		/* Insert key and value into hashtable */
-		g_hash_table_insert(ioHashtable, key, value);
+		/* Remember key and value with its location in stream as it is
+		 * needed for error messages when resolving value later.
+		 */
+		property=g_slice_new0(XfdashboardThemeCSSParsedProperty);
+		property->key=key;
+		property->value=value;
+		property->line=g_scanner_cur_line(inScanner);
+		property->position=g_scanner_cur_position(inScanner);
+		*ioProperties=g_list_prepend(*ioProperties, property);
 
 		/* Get next token */
 		token=g_scanner_peek_next_token(inScanner);
@@ -1700,23 +2045,21 @@ static GTokenType _xfdashboard_theme_css_parse_css_styles(XfdashboardThemeCSS *s
 
 static GTokenType _xfdashboard_theme_css_command_import(XfdashboardThemeCSS *self,
 														GScanner *inScanner,
-														GList **ioSelectors)
+														XfdashboardThemeCSSParsedFile *ioFile)
 {
-	XfdashboardThemeCSSPrivate	*priv;
-	GTokenType					token;
-	GScannerConfig				*scannerConfig;
-	GScannerConfig				*oldScannerConfig;
-	gchar						*filename;
-	GError						*error;
-	gint						oldLineOffset;
+	XfdashboardThemeCSSPrivate		*priv;
+	GTokenType						token;
+	GScannerConfig					*scannerConfig;
+	GScannerConfig					*oldScannerConfig;
+	gchar							*filename;
+	XfdashboardThemeCSSParsedEntry	*entry;
 
 	g_return_val_if_fail(XFDASHBOARD_IS_THEME_CSS(self), G_TOKEN_ERROR);
 	g_return_val_if_fail(inScanner, G_TOKEN_ERROR);
-	g_return_val_if_fail(ioSelectors, G_TOKEN_ERROR);
+	g_return_val_if_fail(ioFile, G_TOKEN_ERROR);
 
 	priv=self->priv;
 	filename=NULL;
-	error=NULL;
 
 	/* Set parser option to parse property value and parse them */
 	scannerConfig=(GScannerConfig*)g_memdup(inScanner->config, sizeof(GScannerConfig));
@@ -1886,16 +2229,18 @@ static GTokenType _xfdashboard_theme_css_command_import(XfdashboardThemeCSS *sel
 		}
 	}
 
-	oldLineOffset=priv->offsetLine;
-	priv->offsetLine+=g_scanner_cur_line(inScanner);
-	if(!xfdashboard_theme_css_add_file(self, filename, GPOINTER_TO_INT(inScanner->user_data), &error))
+	/* Check that CSS file to import is not importing itself directly
+	 * or indirectly as it would never stop importing.
+	 */
+	if(g_strcmp0(ioFile->filename, filename)==0 ||
+		g_slist_find_custom(ioFile->importedBy, filename, (GCompareFunc)g_strcmp0))
 	{
 		gchar					*errorMessage;
 
 		/* Build error message */
 		errorMessage=g_strdup_printf(_("Failed to import CSS file '%s': %s"),
 										filename,
-										error && error->message ? error->message : _("Unknown error"));
+										_("File is already being imported"));
 
 		/* Show parser error message */
 		g_scanner_unexp_token(inScanner,
@@ -1911,31 +2256,36 @@ static GTokenType _xfdashboard_theme_css_command_import(XfdashboardThemeCSS *sel
 		g_free(scannerConfig);
 
 		/* Release allocated resources */
-		if(error) g_error_free(error);
-		if(errorMessage) g_free(errorMessage);
-		if(filename) g_free(filename);
-
-		/* Correct line offset */
-		priv->offsetLine-=oldLineOffset;
+		g_free(errorMessage);
+		g_free(filename);
 
 		/* Return error result */
 		return(G_TOKEN_ERROR);
 	}
 
-	g_debug("Imported CSS file '%s'", filename);
+	/* Remember CSS file to import at this location in stream and let it be
+	 * loaded and parsed by a worker thread while we continue parsing this
+	 * stream. The parsed CSS file will be merged into theme at this location
+	 * later when all files were parsed.
+	 */
+	entry=g_slice_new0(XfdashboardThemeCSSParsedEntry);
+	entry->type=XFDASHBOARD_THEME_CSS_PARSED_ENTRY_TYPE_IMPORT;
+	entry->line=g_scanner_cur_line(inScanner);
+	entry->position=g_scanner_cur_position(inScanner);
+	entry->import=_xfdashboard_theme_css_parsed_file_new(filename, GPOINTER_TO_INT(inScanner->user_data), ioFile);
+	ioFile->entries=g_list_prepend(ioFile->entries, entry);
 
-	/* Correct line offset */
-	priv->offsetLine-=oldLineOffset;
+	_xfdashboard_theme_css_parsed_file_queue(self, entry->import);
+	g_debug("Queued CSS file '%s' for import", filename);
 
 	/* Restore old parser options */
 	inScanner->config=oldScannerConfig;
 	g_free(scannerConfig);
 
 	/* Release allocated resources */
-	if(error) g_error_free(error);
-	if(filename) g_free(filename);
+	g_free(filename);
 
-	/* Import was successful so return success value */
+	/* Import was successfully queued so return success value */
 	return(G_TOKEN_NONE);
 }
 
@@ -1967,19 +2317,18 @@ static gboolean _xfdashboard_theme_css_parse_css_ruleset_finish(XfdashboardCssSe
 
 static GTokenType _xfdashboard_theme_css_parse_css_ruleset(XfdashboardThemeCSS *self,
 															GScanner *inScanner,
+															XfdashboardThemeCSSParsedFile *ioFile,
 															GList **ioSelectors)
 {
-	XfdashboardThemeCSSPrivate		*priv;
 	GTokenType						token;
 	XfdashboardThemeCSSSelector		*selector;
 	gboolean						hasAtSelector;
 
 	g_return_val_if_fail(XFDASHBOARD_IS_THEME_CSS(self), G_TOKEN_ERROR);
 	g_return_val_if_fail(inScanner, G_TOKEN_ERROR);
+	g_return_val_if_fail(ioFile, G_TOKEN_ERROR);
 	g_return_val_if_fail(ioSelectors, G_TOKEN_ERROR);
 
-	priv=self->priv;
-
 	/* Parse comma-seperated selectors until a left curly bracket is found */
 	selector=NULL;
 	hasAtSelector=FALSE;
@@ -2035,8 +2384,6 @@ static GTokenType _xfdashboard_theme_css_parse_css_ruleset(XfdashboardThemeCSS *
 																							self);
 				if(!selector->selector) return(G_TOKEN_ERROR);
 
-				xfdashboard_css_selector_adjust_to_offset(selector->selector, priv->offsetLine, 0);
-
 				/* If we get here selector could be parse so set type */
 				selector->type=XFDASHBOARD_THEME_CSS_SELECTOR_TYPE_SELECTOR;
 				break;
@@ -2076,7 +2423,7 @@ static GTokenType _xfdashboard_theme_css_parse_css_ruleset(XfdashboardThemeCSS *
 					{
 						token=_xfdashboard_theme_css_command_import(self,
 																	inScanner,
-																	ioSelectors);
+																	ioFile);
 						if(token!=G_TOKEN_NONE) return(token);
 					}
 					/* If we get here the '@'-identifier is unknown and could not be handled, skip it */
@@ -2152,26 +2499,25 @@ static GTokenType _xfdashboard_theme_css_parse_css_ruleset(XfdashboardThemeCSS *
 
 static GTokenType _xfdashboard_theme_css_parse_css_block(XfdashboardThemeCSS *self,
 															GScanner *inScanner,
-															GList **ioSelectors,
-															GList **ioStyles)
+															XfdashboardThemeCSSParsedFile *ioFile)
 {
 	GTokenType						token;
 	GList							*selectors;
+	GList							*properties;
 	GList							*iter;
-	GHashTable						*styles;
 	XfdashboardThemeCSSSelector		*selector;
+	XfdashboardThemeCSSParsedEntry	*entry;
 	gboolean						doResolveAt;
 
 	g_return_val_if_fail(XFDASHBOARD_IS_THEME_CSS(self), G_TOKEN_ERROR);
 	g_return_val_if_fail(inScanner, G_TOKEN_ERROR);
-	g_return_val_if_fail(ioSelectors, G_TOKEN_ERROR);
-	g_return_val_if_fail(ioStyles, G_TOKEN_ERROR);
+	g_return_val_if_fail(ioFile, G_TOKEN_ERROR);
 
 	selectors=NULL;
-	styles=NULL;
+	properties=NULL;
 
 	/* CSS blocks begin with rulesets (list of selectors) - parse them */
-	token=_xfdashboard_theme_css_parse_css_ruleset(self, inScanner, &selectors);
+	token=_xfdashboard_theme_css_parse_css_ruleset(self, inScanner, ioFile, &selectors);
 	if(token!=G_TOKEN_NONE)
 	{
 		g_list_foreach(selectors, (GFunc)_xfdashboard_theme_css_selector_free, NULL);
@@ -2194,71 +2540,56 @@ static GTokenType _xfdashboard_theme_css_parse_css_block(XfdashboardThemeCSS *se
 		}
 	}
 
-	/* Create a hash table for the properties */
-	styles=g_hash_table_new_full(g_str_hash,
-									g_str_equal,
-									g_free,
-									(GDestroyNotify)g_free);
-
+	/* Parse the properties */
 	token=_xfdashboard_theme_css_parse_css_styles(self,
 													inScanner,
-													*ioSelectors,
 													doResolveAt,
-													styles);
+													&properties);
 	if(token!=G_TOKEN_NONE)
 	{
 		g_list_foreach(selectors, (GFunc)_xfdashboard_theme_css_selector_free, NULL);
 		g_list_free(selectors);
 
-		g_hash_table_unref(styles);
+		g_list_free_full(properties, (GDestroyNotify)_xfdashboard_theme_css_parsed_property_free);
 
 		return(token);
 	}
 
-	/* Assign all the selectors to this style */
-	for(iter=selectors; iter; iter=g_list_next(iter))
-	{
-		selector=(XfdashboardThemeCSSSelector*)iter->data;
-		selector->style=g_hash_table_ref(styles);
-	}
-
-	/* Store selectors and styles */
-	*ioSelectors=g_list_concat(*ioSelectors, selectors);
-	*ioStyles=g_list_append(*ioStyles, styles);
+	/* Store selectors and properties. They will be assigned to a style and
+	 * added to theme when this file is merged.
+	 */
+	entry=g_slice_new0(XfdashboardThemeCSSParsedEntry);
+	entry->type=XFDASHBOARD_THEME_CSS_PARSED_ENTRY_TYPE_BLOCK;
+	entry->line=g_scanner_cur_line(inScanner);
+	entry->position=g_scanner_cur_position(inScanner);
+	entry->selectors=selectors;
+	entry->properties=g_list_reverse(properties);
+	entry->doResolveAt=doResolveAt;
+	ioFile->entries=g_list_prepend(ioFile->entries, entry);
 
 	return(token);
 }
 
 static gboolean _xfdashboard_theme_css_parse_css(XfdashboardThemeCSS *self,
 													GInputStream *inStream,
-													const gchar *inName,
-													gint inPriority,
-													GList **outSelectors,
-													GList **outStyles,
+													XfdashboardThemeCSSParsedFile *ioFile,
 													GError **outError)
 {
-	XfdashboardThemeCSSPrivate		*priv;
 	GScanner						*scanner;
 	GTokenType						token;
 	gboolean						success;
-	GList							*selectors;
-	GList							*styles;
 
 	g_return_val_if_fail(XFDASHBOARD_IS_THEME_CSS(self), FALSE);
 	g_return_val_if_fail(G_IS_INPUT_STREAM(inStream), FALSE);
+	g_return_val_if_fail(ioFile && ioFile->entries==NULL, FALSE);
 	g_return_val_if_fail(outError==NULL || *outError==NULL, FALSE);
-	g_return_val_if_fail(outSelectors && *outSelectors==NULL, FALSE);
-	g_return_val_if_fail(outStyles && *outStyles==NULL, FALSE);
 
-	priv=self->priv;
 	success=TRUE;
-	selectors=NULL;
-	styles=NULL;
 
 	/* Create scanner object with default settings */
 	scanner=g_scanner_new(NULL);
-	scanner->input_name=inName;
-	scanner->user_data=GINT_TO_POINTER(inPriority);
+	scanner->input_name=ioFile->filename;
+	scanner->user_data=GINT_TO_POINTER(ioFile->priority);
 
 	/* Set up scanner config
 	 * - Identifiers are allowed to contain '-' (minus sign) as non-first characters
@@ -2301,7 +2632,7 @@ static gboolean _xfdashboard_theme_css_parse_css(XfdashboardThemeCSS *self,
 	token=g_scanner_peek_next_token(scanner);
 	while(token!=G_TOKEN_EOF)
 	{
-		token=_xfdashboard_theme_css_parse_css_block(self, scanner, &selectors, &styles);
+		token=_xfdashboard_theme_css_parse_css_block(self, scanner, ioFile);
 		if(token!=G_TOKEN_NONE) break;
 
 		/* Get next token of input stream */
@@ -2329,28 +2660,346 @@ static gboolean _xfdashboard_theme_css_parse_css(XfdashboardThemeCSS *self,
 
 		success=FALSE;
 
-		/* Free selectors and styles */
+		/* Free parsed entries */
+		g_list_free_full(ioFile->entries, (GDestroyNotify)_xfdashboard_theme_css_parsed_entry_free);
+		ioFile->entries=NULL;
+	}
+
+	/* Remember parsed entries in order of appearance and the number of lines
+	 * parsed in scanner which will be added to line offset when merging.
+	 */
+	ioFile->entries=g_list_reverse(ioFile->entries);
+	ioFile->lines=g_scanner_cur_line(scanner);
+
+	/* Destroy scanner */
+	g_scanner_destroy(scanner);
+
+	/* Return success result */
+	return(success);
+}
+
+/* Load and parse CSS file. This function may be called in a worker thread
+ * so it must not access any state of theme which is not constant.
+ */
+static void _xfdashboard_theme_css_parse_file(XfdashboardThemeCSS *self,
+												XfdashboardThemeCSSParsedFile *ioFile)
+{
+	GFile							*file;
+	GFileInputStream				*stream;
+	GError							*error;
+
+	g_return_if_fail(XFDASHBOARD_IS_THEME_CSS(self));
+	g_return_if_fail(ioFile);
+
+	error=NULL;
+
+	/* Load and parse CSS file */
+	file=g_file_new_for_path(ioFile->filename);
+	if(!file)
+	{
+		_xfdashboard_theme_css_set_error(self,
+											&error,
+											XFDASHBOARD_THEME_CSS_ERROR_UNSUPPORTED_STREAM,
+											_("Could not get file for path '%s'"),
+											ioFile->filename);
+	}
+		else
+		{
+			stream=g_file_read(file, NULL, &error);
+			if(stream)
+			{
+				_xfdashboard_theme_css_parse_css(self, G_INPUT_STREAM(stream), ioFile, &error);
+				g_object_unref(stream);
+			}
+
+			g_object_unref(file);
+		}
+
+	/* Remember error if any occurred and wake up anyone waiting for this file */
+	g_mutex_lock(&ioFile->lock);
+	ioFile->error=error;
+	ioFile->finished=TRUE;
+	g_cond_broadcast(&ioFile->finishedCond);
+	g_mutex_unlock(&ioFile->lock);
+}
+
+/* Worker thread function to load and parse imported CSS files */
+static void _xfdashboard_theme_css_parse_file_in_thread(gpointer inData, gpointer inUserData)
+{
+	XfdashboardThemeCSSParsedFile	*file;
+
+	g_return_if_fail(inData);
+	g_return_if_fail(XFDASHBOARD_IS_THEME_CSS(inUserData));
+
+	file=(XfdashboardThemeCSSParsedFile*)inData;
+
+	/* Parse file and release reference taken when queued */
+	_xfdashboard_theme_css_parse_file(XFDASHBOARD_THEME_CSS(inUserData), file);
+	_xfdashboard_theme_css_parsed_file_unref(file);
+}
+
+/* Queue CSS file to get loaded and parsed by a worker thread */
+static void _xfdashboard_theme_css_parsed_file_queue(XfdashboardThemeCSS *self,
+														XfdashboardThemeCSSParsedFile *inFile)
+{
+	XfdashboardThemeCSSPrivate		*priv;
+	GError							*error;
+
+	g_return_if_fail(XFDASHBOARD_IS_THEME_CSS(self));
+	g_return_if_fail(inFile);
+
+	priv=self->priv;
+	error=NULL;
+
+	/* Take a reference on file for the worker thread. It will be released
+	 * by the worker thread after the file was parsed.
+	 */
+	_xfdashboard_theme_css_parsed_file_ref(inFile);
+
+	/* Push file to pool of worker threads. If no new thread could be
+	 * created the file stays queued and will be parsed by a thread
+	 * already running.
+	 */
+	if(!g_thread_pool_push(priv->parserPool, inFile, &error))
+	{
+		g_warning(_("Could not start worker thread to parse CSS file '%s': %s"),
+					inFile->filename,
+					error && error->message ? error->message : _("Unknown error"));
+		if(error) g_error_free(error);
+	}
+}
+
+/* Merge parsed CSS file into theme. Resolves all '@' identifiers of parsed
+ * properties with the constants in scope at the location in cascade order
+ * and merges imported files at the location they were imported at.
+ */
+static gboolean _xfdashboard_theme_css_merge_parsed_file(XfdashboardThemeCSS *self,
+															XfdashboardThemeCSSParsedFile *inFile,
+															GError **outError)
+{
+	XfdashboardThemeCSSPrivate			*priv;
+	GScanner							*scanner;
+	GList								*selectors;
+	GList								*styles;
+	GList								*iter;
+	GList								*propertyIter;
+	GList								*selectorIter;
+	XfdashboardThemeCSSParsedEntry		*entry;
+	XfdashboardThemeCSSParsedProperty	*property;
+	XfdashboardThemeCSSSelector			*selector;
+	GHashTable							*style;
+	gchar								*value;
+	GError								*error;
+	gint								oldLineOffset;
+	gboolean							success;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_THEME_CSS(self), FALSE);
+	g_return_val_if_fail(inFile, FALSE);
+	g_return_val_if_fail(outError==NULL || *outError==NULL, FALSE);
+
+	priv=self->priv;
+	selectors=NULL;
+	styles=NULL;
+	error=NULL;
+	success=TRUE;
+
+	/* Wait for worker thread to finish loading and parsing file */
+	g_mutex_lock(&inFile->lock);
+	while(!inFile->finished) g_cond_wait(&inFile->finishedCond, &inFile->lock);
+	g_mutex_unlock(&inFile->lock);
+
+	/* Check if file could be loaded and parsed */
+	if(inFile->error)
+	{
+		g_propagate_error(outError, g_error_copy(inFile->error));
+		return(FALSE);
+	}
+
+	/* Create scanner which is only used to show error messages at the location
+	 * in parsed file where the failing property or import was found.
+	 */
+	scanner=g_scanner_new(NULL);
+	scanner->input_name=inFile->filename;
+
+	/* Iterate through parsed entries in order of appearance and merge them */
+	for(iter=inFile->entries; success && iter; iter=g_list_next(iter))
+	{
+		entry=(XfdashboardThemeCSSParsedEntry*)iter->data;
+
+		/* Merge imported file at this location */
+		if(entry->type==XFDASHBOARD_THEME_CSS_PARSED_ENTRY_TYPE_IMPORT)
+		{
+			oldLineOffset=priv->offsetLine;
+			priv->offsetLine+=entry->line;
+			if(!_xfdashboard_theme_css_merge_parsed_file(self, entry->import, &error))
+			{
+				gchar					*errorMessage;
+
+				/* Build error message */
+				errorMessage=g_strdup_printf(_("Failed to import CSS file '%s': %s"),
+												entry->import->filename,
+												error && error->message ? error->message : _("Unknown error"));
+
+				/* Show parser error message */
+				scanner->line=entry->line;
+				scanner->position=entry->position;
+				g_scanner_unexp_token(scanner,
+										G_TOKEN_ERROR,
+										NULL,
+										NULL,
+										NULL,
+										errorMessage,
+										TRUE);
+
+				/* Set error */
+				_xfdashboard_theme_css_set_error(self,
+													outError,
+													XFDASHBOARD_THEME_CSS_ERROR_PARSER_ERROR,
+													"%s",
+													errorMessage);
+
+				/* Release allocated resources */
+				if(error) g_error_free(error);
+				g_free(errorMessage);
+
+				success=FALSE;
+			}
+				else g_debug("Imported CSS file '%s'", entry->import->filename);
+
+			/* Correct line offset */
+			priv->offsetLine-=oldLineOffset;
+
+			continue;
+		}
+
+		/* Create a hash table for the properties and resolve '@' identifiers
+		 * in values if requested. Constants are looked up in selectors of this
+		 * file merged so far and then in all ones merged into theme before.
+		 */
+		style=g_hash_table_new_full(g_str_hash,
+									g_str_equal,
+									g_free,
+									(GDestroyNotify)g_free);
+
+		for(propertyIter=entry->properties; success && propertyIter; propertyIter=g_list_next(propertyIter))
+		{
+			property=(XfdashboardThemeCSSParsedProperty*)propertyIter->data;
+
+			/* Take value from parsed property */
+			value=property->value;
+			property->value=NULL;
+
+			/* Resolve '@' identifiers if requested */
+			if(entry->doResolveAt && value)
+			{
+				gchar		*resolvedValue;
+
+				/* Resolve value */
+				scanner->line=property->line;
+				scanner->position=property->position;
+
+				g_debug("Resolving css value '%s'", value);
+				resolvedValue=_xfdashboard_theme_css_resolve_at_identifier_by_string(self,
+																						value,
+																						scanner,
+																						selectors);
+				g_debug("Resolved css value '%s' to '%s'", value, resolvedValue);
+
+				/* Release old value and set new one */
+				g_free(value);
+				value=resolvedValue;
+
+				/* If no value (means NULL value) is set when '@' identifiers
+				 * were resolved then an error is occurred.
+				 */
+				if(!value)
+				{
+					_xfdashboard_theme_css_set_error(self,
+														outError,
+														XFDASHBOARD_THEME_CSS_ERROR_PARSER_ERROR,
+														_("Could not resolve value of property '%s' in CSS file '%s' at line %u"),
+														property->key,
+														inFile->filename,
+														property->line);
+
+					success=FALSE;
+					break;
+				}
+
+				/* Strip leading and trailing whitespace from resolved value */
+				g_strstrip(value);
+			}
+
+			/* Insert key and value into hashtable */
+			g_hash_table_insert(style, property->key, value);
+			property->key=NULL;
+		}
+
+		if(!success)
+		{
+			g_hash_table_unref(style);
+			break;
+		}
+
+		/* Adjust selectors to line offset and assign all the selectors to this style */
+		for(selectorIter=entry->selectors; selectorIter; selectorIter=g_list_next(selectorIter))
+		{
+			selector=(XfdashboardThemeCSSSelector*)selectorIter->data;
+
+			if(selector->selector) xfdashboard_css_selector_adjust_to_offset(selector->selector, priv->offsetLine, 0);
+			selector->style=g_hash_table_ref(style);
+		}
+
+		/* Store selectors and styles */
+		selectors=g_list_concat(selectors, entry->selectors);
+		entry->selectors=NULL;
+
+		styles=g_list_append(styles, style);
+	}
+
+	/* Add lines parsed in scanner to line offset */
+	priv->offsetLine+=inFile->lines+1;
+
+	/* Destroy scanner */
+	g_scanner_destroy(scanner);
+
+	/* If merging failed free selectors and styles and return failure result */
+	if(!success)
+	{
 		g_list_foreach(selectors, (GFunc)_xfdashboard_theme_css_selector_free, NULL);
 		g_list_free(selectors);
-		selectors=NULL;
 
 		g_list_foreach(styles, (GFunc)g_hash_table_unref, NULL);
 		g_list_free(styles);
-		styles=NULL;
+
+		return(FALSE);
 	}
 
-	/* Add lines parsed in scanner to line offset */
-	priv->offsetLine+=g_scanner_cur_line(scanner)+1;
+	/* If we get here loading, parsing and merging CSS file was successful
+	 * so add filename to list of loaded sources, add selectors and styles
+	 * to list of selectors and styles in this theme and return TRUE
+	 */
+	priv->names=g_slist_prepend(priv->names, g_strdup(inFile->filename));
 
-	/* Return selectors and styles */
-	if(outSelectors) *outSelectors=selectors;
-	if(outStyles) *outStyles=styles;
+	if(selectors)
+	{
+		priv->selectors=g_list_concat(priv->selectors, selectors);
+		g_debug("Successfully parsed '%s' and added %d selectors - total %d selectors",
+					inFile->filename,
+					g_list_length(selectors),
+					g_list_length(priv->selectors));
+	}
 
-	/* Destroy scanner */
-	g_scanner_destroy(scanner);
+	if(styles)
+	{
+		priv->styles=g_list_concat(priv->styles, styles);
+		g_debug("Successfully parsed '%s' and added %d styles - total %d styles",
+					inFile->filename,
+					g_list_length(styles),
+					g_list_length(priv->styles));
+	}
 
-	/* Return success result */
-	return(success);
+	return(TRUE);
 }
 
 /* Callback for sorting selector matches by score */
@@ -2402,6 +3051,13 @@ static void _xfdashboard_theme_css_dispose(GObject *inObject)
 	XfdashboardThemeCSSPrivate		*priv=self->priv;
 
 	/* Release allocated resources */
+	if(priv->parserPool)
+	{
+		/* Wait for all worker threads to finish as they use this object */
+		g_thread_pool_free(priv->parserPool, FALSE, TRUE);
+		priv->parserPool=NULL;
+	}
+
 	if(priv->themePath)
 	{
 		g_free(priv->themePath);
@@ -2435,6 +3091,12 @@ static void _xfdashboard_theme_css_dispose(GObject *inObject)
 		priv->registeredFunctions=NULL;
 	}
 
+	if(priv->functionCache)
+	{
+		_xfdashboard_theme_css_function_cache_unref((XfdashboardThemeCSSFunctionCache*)priv->functionCache);
+		priv->functionCache=NULL;
+	}
+
 	/* Call parent's class dispose method */
 	G_OBJECT_CLASS(xfdashboard_theme_css_parent_class)->dispose(inObject);
 }
@@ -2507,22 +3169,25 @@ void xfdashboard_theme_css_init(XfdashboardThemeCSS *self)
 	priv->styles=NULL;
 	priv->names=NULL;
 	priv->registeredFunctions=NULL;
+	priv->functionCache=_xfdashboard_theme_css_function_cache_ref();
 	priv->offsetLine=0;
+	priv->parserPool=NULL;
 
 	/* Register CSS functions */
-#define REGISTER_CSS_FUNC(name, callback) \
+#define REGISTER_CSS_FUNC(name, callback, flags) \
 	_xfdashboard_theme_css_register_function(self, \
 												name, \
-												XFDASHBOARD_THEME_CSS_FUNCTION_CALLBACK(callback));
-
-	REGISTER_CSS_FUNC("rgb", _xfdashboard_theme_css_function_rgb_rgba);
-	REGISTER_CSS_FUNC("rgba", _xfdashboard_theme_css_function_rgb_rgba);
-	REGISTER_CSS_FUNC("mix", _xfdashboard_theme_css_function_mix);
-	REGISTER_CSS_FUNC("lighter", _xfdashboard_theme_css_function_lighter_darker);
-	REGISTER_CSS_FUNC("darker", _xfdashboard_theme_css_function_lighter_darker);
-	REGISTER_CSS_FUNC("shade", _xfdashboard_theme_css_function_shade);
-	REGISTER_CSS_FUNC("alpha", _xfdashboard_theme_css_function_alpha);
-	REGISTER_CSS_FUNC("try_icons", _xfdashboard_theme_css_function_try_icons)
+												XFDASHBOARD_THEME_CSS_FUNCTION_CALLBACK(callback), \
+												flags);
+
+	REGISTER_CSS_FUNC("rgb", _xfdashboard_theme_css_function_rgb_rgba, XFDASHBOARD_THEME_CSS_FUNCTION_FLAG_CACHEABLE);
+	REGISTER_CSS_FUNC("rgba", _xfdashboard_theme_css_function_rgb_rgba, XFDASHBOARD_THEME_CSS_FUNCTION_FLAG_CACHEABLE);
+	REGISTER_CSS_FUNC("mix", _xfdashboard_theme_css_function_mix, XFDASHBOARD_THEME_CSS_FUNCTION_FLAG_CACHEABLE);
+	REGISTER_CSS_FUNC("lighter", _xfdashboard_theme_css_function_lighter_darker, XFDASHBOARD_THEME_CSS_FUNCTION_FLAG_CACHEABLE);
+	REGISTER_CSS_FUNC("darker", _xfdashboard_theme_css_function_lighter_darker, XFDASHBOARD_THEME_CSS_FUNCTION_FLAG_CACHEABLE);
+	REGISTER_CSS_FUNC("shade", _xfdashboard_theme_css_function_shade, XFDASHBOARD_THEME_CSS_FUNCTION_FLAG_CACHEABLE);
+	REGISTER_CSS_FUNC("alpha", _xfdashboard_theme_css_function_alpha, XFDASHBOARD_THEME_CSS_FUNCTION_FLAG_CACHEABLE);
+	REGISTER_CSS_FUNC("try_icons", _xfdashboard_theme_css_function_try_icons, XFDASHBOARD_THEME_CSS_FUNCTION_FLAG_CACHEABLE | XFDASHBOARD_THEME_CSS_FUNCTION_FLAG_DEPENDS_ON_ICON_THEME)
 
 #undef REGISTER_CSS_FUNC
 }
@@ -2551,90 +3216,48 @@ gboolean xfdashboard_theme_css_add_file(XfdashboardThemeCSS *self,
 											GError **outError)
 {
 	XfdashboardThemeCSSPrivate		*priv;
-	GFile							*file;
-	GFileInputStream				*stream;
+	XfdashboardThemeCSSParsedFile	*file;
 	GError							*error;
-	GList							*selectors;
-	GList							*styles;
+	gboolean						success;
 
 	g_return_val_if_fail(XFDASHBOARD_IS_THEME_CSS(self), FALSE);
 	g_return_val_if_fail(inPath!=NULL && *inPath!=0, FALSE);
 	g_return_val_if_fail(outError==NULL || *outError==NULL, FALSE);
 
 	priv=self->priv;
-	selectors=NULL;
-	styles=NULL;
-
-	/* Load and parse CSS file */
-	file=g_file_new_for_path(inPath);
-	if(!file)
-	{
-		_xfdashboard_theme_css_set_error(self,
-											outError,
-											XFDASHBOARD_THEME_CSS_ERROR_UNSUPPORTED_STREAM,
-											_("Could not get file for path '%s'"),
-											inPath);
-
-		return(FALSE);
-	}
-
 	error=NULL;
-	stream=g_file_read(file, NULL, &error);
-	if(error)
-	{
-		g_propagate_error(outError, error);
 
-		/* Release allocated resources */
-		g_object_unref(file);
-
-		return(FALSE);
-	}
-
-	_xfdashboard_theme_css_parse_css(self,
-										G_INPUT_STREAM(stream),
-										inPath,
-										inPriority,
-										&selectors,
-										&styles,
-										&error);
-	if(error)
+	/* Create pool of worker threads which load and parse imported CSS files
+	 * in parallel if not done already.
+	 */
+	if(!priv->parserPool)
 	{
-		g_propagate_error(outError, error);
-
-		/* Release allocated resources */
-		g_object_unref(file);
-
-		return(FALSE);
+		priv->parserPool=g_thread_pool_new(_xfdashboard_theme_css_parse_file_in_thread,
+											self,
+											XFDASHBOARD_THEME_CSS_PARSER_MAX_THREADS,
+											FALSE,
+											&error);
+		if(!priv->parserPool)
+		{
+			g_propagate_error(outError, error);
+			return(FALSE);
+		}
 	}
 
-	/* If we get here adding, loading and parsing CSS file was successful
-	 * so add filename to list of loaded sources, add selectors and styles
-	 * to list of selectors and styles in this theme and return TRUE
+	/* Load and parse CSS file. Any CSS file it imports is queued for
+	 * loading and parsing in worker threads while this file is parsed.
 	 */
-	priv->names=g_slist_prepend(priv->names, strdup(inPath));
+	file=_xfdashboard_theme_css_parsed_file_new(inPath, inPriority, NULL);
+	_xfdashboard_theme_css_parse_file(self, file);
 
-	if(selectors)
-	{
-		priv->selectors=g_list_concat(priv->selectors, selectors);
-		g_debug("Successfully parsed '%s' and added %d selectors - total %d selectors",
-					inPath,
-					g_list_length(selectors),
-					g_list_length(priv->selectors));
-	}
-
-	if(styles)
-	{
-		priv->styles=g_list_concat(priv->styles, styles);
-		g_debug("Successfully parsed '%s' and added %d styles - total %d styles",
-					inPath,
-					g_list_length(styles),
-					g_list_length(priv->styles));
-	}
+	/* Merge parsed CSS file and all imported ones in cascade order into theme */
+	success=_xfdashboard_theme_css_merge_parsed_file(self, file, &error);
+	if(!success) g_propagate_error(outError, error);
 
 	/* Release allocated resources */
-	g_object_unref(file);
+	_xfdashboard_theme_css_parsed_file_unref(file);
 
-	return(TRUE);
+	return(success);
 }
 
 /* Return properties for a stylable actor */
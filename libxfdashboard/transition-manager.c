@@ -0,0 +1,900 @@
+/*
+ * transition-manager: Single-instance managing animated transitions of
+ *                     actor properties defined by theme
+ * 
+ * Copyright 2012-2016 Stephan Haller <nomad@froevel.de>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ * 
+ * 
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <libxfdashboard/transition-manager.h>
+
+#include <glib/gi18n-lib.h>
+#include <math.h>
+
+#include <libxfdashboard/compat.h>
+
+
+/* Define this class in GObject system */
+G_DEFINE_TYPE(XfdashboardTransitionManager,
+				xfdashboard_transition_manager,
+				G_TYPE_OBJECT)
+
+/* Private structure - access only by public API if needed */
+#define XFDASHBOARD_TRANSITION_MANAGER_GET_PRIVATE(obj) \
+	(G_TYPE_INSTANCE_GET_PRIVATE((obj), XFDASHBOARD_TYPE_TRANSITION_MANAGER, XfdashboardTransitionManagerPrivate))
+
+struct _XfdashboardTransitionManagerPrivate
+{
+	/* Properties related */
+	gboolean				reducedMotion;
+
+	/* Instance related */
+	GHashTable				*compiledTransitions;
+	GList					*transitions;
+
+	ClutterTimeline			*clock;
+	guint64					clockTime;
+};
+
+/* Properties */
+enum
+{
+	PROP_0,
+
+	PROP_REDUCED_MOTION,
+
+	PROP_LAST
+};
+
+static GParamSpec* XfdashboardTransitionManagerProperties[PROP_LAST]={ 0, };
+
+
+/* IMPLEMENTATION: Private variables and methods */
+#define XFDASHBOARD_TRANSITION_MANAGER_ALL_PROPERTIES		"all"
+
+typedef gdouble (*XfdashboardTransitionManagerEasingFunc)(gdouble inProgress);
+
+typedef struct _XfdashboardTransitionManagerEasing			XfdashboardTransitionManagerEasing;
+struct _XfdashboardTransitionManagerEasing
+{
+	const gchar								*name;
+	XfdashboardTransitionManagerEasingFunc	func;
+};
+
+typedef struct _XfdashboardTransitionManagerSpecItem		XfdashboardTransitionManagerSpecItem;
+struct _XfdashboardTransitionManagerSpecItem
+{
+	const gchar								*propertyName;
+	guint									duration;
+	XfdashboardTransitionManagerEasingFunc	easing;
+};
+
+typedef struct _XfdashboardTransitionManagerSpec			XfdashboardTransitionManagerSpec;
+struct _XfdashboardTransitionManagerSpec
+{
+	guint									itemsCount;
+	XfdashboardTransitionManagerSpecItem	*items;
+};
+
+typedef struct _XfdashboardTransitionManagerTransition		XfdashboardTransitionManagerTransition;
+struct _XfdashboardTransitionManagerTransition
+{
+	XfdashboardTransitionManager			*manager;
+	ClutterActor							*actor;
+	guint									actorDestroySignalID;
+	const gchar								*propertyName;
+
+	GValue									fromValue;
+	GValue									toValue;
+
+	guint64									startTime;
+	guint									duration;
+	XfdashboardTransitionManagerEasingFunc	easing;
+};
+
+/* Single instance of transition manager */
+static XfdashboardTransitionManager*		_xfdashboard_transition_manager=NULL;
+
+/* Easing functions */
+static gdouble _xfdashboard_transition_manager_easing_linear(gdouble inProgress)
+{
+	return(inProgress);
+}
+
+static gdouble _xfdashboard_transition_manager_easing_in_quad(gdouble inProgress)
+{
+	return(inProgress*inProgress);
+}
+
+static gdouble _xfdashboard_transition_manager_easing_out_quad(gdouble inProgress)
+{
+	return(-inProgress*(inProgress-2.0));
+}
+
+static gdouble _xfdashboard_transition_manager_easing_in_out_quad(gdouble inProgress)
+{
+	if(inProgress<0.5) return(2.0*inProgress*inProgress);
+	return(-2.0*inProgress*inProgress+4.0*inProgress-1.0);
+}
+
+static gdouble _xfdashboard_transition_manager_easing_in_cubic(gdouble inProgress)
+{
+	return(inProgress*inProgress*inProgress);
+}
+
+static gdouble _xfdashboard_transition_manager_easing_out_cubic(gdouble inProgress)
+{
+	gdouble		p=inProgress-1.0;
+
+	return(p*p*p+1.0);
+}
+
+static gdouble _xfdashboard_transition_manager_easing_in_out_cubic(gdouble inProgress)
+{
+	gdouble		p;
+
+	if(inProgress<0.5) return(4.0*inProgress*inProgress*inProgress);
+
+	p=2.0*inProgress-2.0;
+	return(0.5*p*p*p+1.0);
+}
+
+static gdouble _xfdashboard_transition_manager_easing_in_sine(gdouble inProgress)
+{
+	return(1.0-cos(inProgress*G_PI_2));
+}
+
+static gdouble _xfdashboard_transition_manager_easing_out_sine(gdouble inProgress)
+{
+	return(sin(inProgress*G_PI_2));
+}
+
+static gdouble _xfdashboard_transition_manager_easing_in_out_sine(gdouble inProgress)
+{
+	return(-0.5*(cos(G_PI*inProgress)-1.0));
+}
+
+/* Known easing modes. Names follow ClutterAnimationMode nicks and CSS
+ * keywords are mapped to cubic easing.
+ */
+static const XfdashboardTransitionManagerEasing		_xfdashboard_transition_manager_easings[]=
+	{
+		{ "linear", _xfdashboard_transition_manager_easing_linear },
+		{ "ease-in-quad", _xfdashboard_transition_manager_easing_in_quad },
+		{ "ease-out-quad", _xfdashboard_transition_manager_easing_out_quad },
+		{ "ease-in-out-quad", _xfdashboard_transition_manager_easing_in_out_quad },
+		{ "ease-in-cubic", _xfdashboard_transition_manager_easing_in_cubic },
+		{ "ease-out-cubic", _xfdashboard_transition_manager_easing_out_cubic },
+		{ "ease-in-out-cubic", _xfdashboard_transition_manager_easing_in_out_cubic },
+		{ "ease-in-sine", _xfdashboard_transition_manager_easing_in_sine },
+		{ "ease-out-sine", _xfdashboard_transition_manager_easing_out_sine },
+		{ "ease-in-out-sine", _xfdashboard_transition_manager_easing_in_out_sine },
+		{ "ease", _xfdashboard_transition_manager_easing_in_out_cubic },
+		{ "ease-in", _xfdashboard_transition_manager_easing_in_cubic },
+		{ "ease-out", _xfdashboard_transition_manager_easing_out_cubic },
+		{ "ease-in-out", _xfdashboard_transition_manager_easing_in_out_cubic },
+		{ NULL, NULL }
+	};
+
+/* Free compiled transition specification */
+static void _xfdashboard_transition_manager_spec_free(XfdashboardTransitionManagerSpec *inSpec)
+{
+	g_return_if_fail(inSpec);
+
+	g_free(inSpec->items);
+	g_free(inSpec);
+}
+
+/* Parse duration in milliseconds or seconds, e.g. "200ms" or "0.2s" */
+static gboolean _xfdashboard_transition_manager_parse_duration(const gchar *inString, guint *outDuration)
+{
+	gdouble		value;
+	gchar		*unit;
+
+	g_return_val_if_fail(inString, FALSE);
+
+	value=g_ascii_strtod(inString, &unit);
+	if(unit==inString || value<0.0) return(FALSE);
+
+	if(g_strcmp0(unit, "s")==0) value*=1000.0;
+		else if(*unit && g_strcmp0(unit, "ms")!=0) return(FALSE);
+
+	if(outDuration) *outDuration=(guint)(value+0.5);
+	return(TRUE);
+}
+
+/* Compile string of comma-separated transitions like
+ * "opacity 200ms ease-out-quad, translation-x 0.15s" into a specification.
+ * Each transition consists of the property name or "all", the duration and
+ * an optional easing mode which defaults to "linear". Invalid transitions are
+ * skipped with a warning.
+ */
+static XfdashboardTransitionManagerSpec* _xfdashboard_transition_manager_compile(const gchar *inTransitions)
+{
+	XfdashboardTransitionManagerSpec		*spec;
+	GArray									*items;
+	gchar									**transitions;
+	gchar									**iter;
+
+	g_return_val_if_fail(inTransitions, NULL);
+
+	items=g_array_new(FALSE, FALSE, sizeof(XfdashboardTransitionManagerSpecItem));
+
+	transitions=g_strsplit(inTransitions, ",", -1);
+	for(iter=transitions; *iter; iter++)
+	{
+		XfdashboardTransitionManagerSpecItem	item;
+		gchar									*parts[3];
+		gchar									**tokens;
+		gchar									**token;
+		gint									partsCount;
+		const XfdashboardTransitionManagerEasing	*easing;
+
+		/* Split transition into its non-empty parts */
+		partsCount=0;
+		tokens=g_strsplit_set(g_strstrip(*iter), " \t", -1);
+		for(token=tokens; *token; token++)
+		{
+			if(!**token) continue;
+
+			if(partsCount>=3)
+			{
+				partsCount=-1;
+				break;
+			}
+			parts[partsCount++]=*token;
+		}
+
+		/* Skip empty transitions silently */
+		if(partsCount==0)
+		{
+			g_strfreev(tokens);
+			continue;
+		}
+
+		/* Check and convert parts */
+		item.propertyName=NULL;
+		item.duration=0;
+		item.easing=_xfdashboard_transition_manager_easing_linear;
+
+		if(partsCount>=2 &&
+			_xfdashboard_transition_manager_parse_duration(parts[1], &item.duration))
+		{
+			item.propertyName=g_intern_string(parts[0]);
+		}
+
+		if(item.propertyName && partsCount==3)
+		{
+			for(easing=_xfdashboard_transition_manager_easings; easing->name; easing++)
+			{
+				if(g_strcmp0(easing->name, parts[2])==0) break;
+			}
+
+			if(easing->name) item.easing=easing->func;
+				else item.propertyName=NULL;
+		}
+
+		if(item.propertyName) g_array_append_val(items, item);
+			else
+			{
+				g_warning(_("Invalid transition '%s' in '%s'"), *iter, inTransitions);
+			}
+
+		/* Release allocated resources */
+		g_strfreev(tokens);
+	}
+	g_strfreev(transitions);
+
+	/* Create specification */
+	spec=g_new0(XfdashboardTransitionManagerSpec, 1);
+	spec->itemsCount=items->len;
+	spec->items=(XfdashboardTransitionManagerSpecItem*)g_array_free(items, FALSE);
+
+	return(spec);
+}
+
+/* Get transition for property from string of transitions. The string is
+ * only compiled the first time it is used.
+ */
+static const XfdashboardTransitionManagerSpecItem* _xfdashboard_transition_manager_lookup(XfdashboardTransitionManager *self,
+																							const gchar *inTransitions,
+																							const gchar *inPropertyName)
+{
+	XfdashboardTransitionManagerPrivate		*priv;
+	XfdashboardTransitionManagerSpec		*spec;
+	const gchar								*allProperties;
+	gint									i;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_TRANSITION_MANAGER(self), NULL);
+	g_return_val_if_fail(inTransitions, NULL);
+	g_return_val_if_fail(inPropertyName, NULL);
+
+	priv=self->priv;
+
+	/* Get compiled specification or compile it now */
+	spec=(XfdashboardTransitionManagerSpec*)g_hash_table_lookup(priv->compiledTransitions, inTransitions);
+	if(!spec)
+	{
+		spec=_xfdashboard_transition_manager_compile(inTransitions);
+		g_hash_table_insert(priv->compiledTransitions, g_strdup(inTransitions), spec);
+	}
+
+	/* Later transitions override earlier ones like in CSS. Property names are
+	 * interned strings so they can be compared by pointer.
+	 */
+	allProperties=g_intern_static_string(XFDASHBOARD_TRANSITION_MANAGER_ALL_PROPERTIES);
+	for(i=((gint)spec->itemsCount)-1; i>=0; i--)
+	{
+		if(spec->items[i].propertyName==inPropertyName ||
+			spec->items[i].propertyName==allProperties)
+		{
+			return(&spec->items[i]);
+		}
+	}
+
+	return(NULL);
+}
+
+/* Check if values of a type can be interpolated */
+static gboolean _xfdashboard_transition_manager_can_interpolate(GType inType)
+{
+	switch(G_TYPE_FUNDAMENTAL(inType))
+	{
+		case G_TYPE_UCHAR:
+		case G_TYPE_INT:
+		case G_TYPE_UINT:
+		case G_TYPE_FLOAT:
+		case G_TYPE_DOUBLE:
+			return(TRUE);
+
+		default:
+			break;
+	}
+
+	return(inType==CLUTTER_TYPE_COLOR);
+}
+
+/* Interpolate between two values of same type */
+static void _xfdashboard_transition_manager_interpolate(const GValue *inFrom,
+														const GValue *inTo,
+														gdouble inProgress,
+														GValue *outValue)
+{
+	switch(G_TYPE_FUNDAMENTAL(G_VALUE_TYPE(inFrom)))
+	{
+		case G_TYPE_UCHAR:
+			g_value_set_uchar(outValue, (guchar)CLAMP(floor(g_value_get_uchar(inFrom)+(g_value_get_uchar(inTo)-g_value_get_uchar(inFrom))*inProgress+0.5), 0, G_MAXUINT8));
+			break;
+
+		case G_TYPE_INT:
+			g_value_set_int(outValue, (gint)floor(g_value_get_int(inFrom)+(((gdouble)g_value_get_int(inTo))-g_value_get_int(inFrom))*inProgress+0.5));
+			break;
+
+		case G_TYPE_UINT:
+			g_value_set_uint(outValue, (guint)MAX(0.0, floor(g_value_get_uint(inFrom)+(((gdouble)g_value_get_uint(inTo))-g_value_get_uint(inFrom))*inProgress+0.5)));
+			break;
+
+		case G_TYPE_FLOAT:
+			g_value_set_float(outValue, g_value_get_float(inFrom)+(g_value_get_float(inTo)-g_value_get_float(inFrom))*inProgress);
+			break;
+
+		case G_TYPE_DOUBLE:
+			g_value_set_double(outValue, g_value_get_double(inFrom)+(g_value_get_double(inTo)-g_value_get_double(inFrom))*inProgress);
+			break;
+
+		default:
+			if(G_VALUE_HOLDS(inFrom, CLUTTER_TYPE_COLOR))
+			{
+				const ClutterColor		*fromColor;
+				const ClutterColor		*toColor;
+				ClutterColor			color;
+
+				fromColor=clutter_value_get_color(inFrom);
+				toColor=clutter_value_get_color(inTo);
+				if(fromColor && toColor)
+				{
+					clutter_color_interpolate(fromColor, toColor, inProgress, &color);
+					clutter_value_set_color(outValue, &color);
+				}
+					else g_value_copy(inTo, outValue);
+			}
+				else g_value_copy(inTo, outValue);
+			break;
+	}
+}
+
+/* Find running transition of property at actor */
+static XfdashboardTransitionManagerTransition* _xfdashboard_transition_manager_find(XfdashboardTransitionManager *self,
+																					ClutterActor *inActor,
+																					const gchar *inPropertyName)
+{
+	GList									*iter;
+	XfdashboardTransitionManagerTransition	*transition;
+
+	for(iter=self->priv->transitions; iter; iter=g_list_next(iter))
+	{
+		transition=(XfdashboardTransitionManagerTransition*)iter->data;
+		if(transition->actor==inActor &&
+			transition->propertyName==inPropertyName)
+		{
+			return(transition);
+		}
+	}
+
+	return(NULL);
+}
+
+/* Release resources of transition */
+static void _xfdashboard_transition_manager_transition_free(XfdashboardTransitionManagerTransition *inTransition)
+{
+	g_value_unset(&inTransition->fromValue);
+	g_value_unset(&inTransition->toValue);
+	g_slice_free(XfdashboardTransitionManagerTransition, inTransition);
+}
+
+/* Actor of a running transition was finalized */
+static void _xfdashboard_transition_manager_on_actor_finalized(gpointer inUserData, GObject *inObject)
+{
+	XfdashboardTransitionManagerTransition	*transition;
+	XfdashboardTransitionManagerPrivate		*priv;
+
+	g_return_if_fail(inUserData);
+
+	transition=(XfdashboardTransitionManagerTransition*)inUserData;
+	priv=transition->manager->priv;
+
+	priv->transitions=g_list_remove(priv->transitions, transition);
+	_xfdashboard_transition_manager_transition_free(transition);
+}
+
+/* Remove transition from list of running transitions. If requested the
+ * property is set to final value of transition.
+ */
+static void _xfdashboard_transition_manager_remove(XfdashboardTransitionManager *self,
+													XfdashboardTransitionManagerTransition *inTransition,
+													gboolean inSetFinalValue)
+{
+	XfdashboardTransitionManagerPrivate		*priv;
+
+	priv=self->priv;
+
+	priv->transitions=g_list_remove(priv->transitions, inTransition);
+	g_object_weak_unref(G_OBJECT(inTransition->actor), _xfdashboard_transition_manager_on_actor_finalized, inTransition);
+	if(inTransition->actorDestroySignalID)
+	{
+		g_signal_handler_disconnect(inTransition->actor, inTransition->actorDestroySignalID);
+		inTransition->actorDestroySignalID=0;
+	}
+
+	if(inSetFinalValue)
+	{
+		g_object_set_property(G_OBJECT(inTransition->actor), inTransition->propertyName, &inTransition->toValue);
+	}
+
+	_xfdashboard_transition_manager_transition_free(inTransition);
+
+	/* Stop clock if no transition is running anymore */
+	if(!priv->transitions && priv->clock) clutter_timeline_stop(priv->clock);
+}
+
+/* Actor of a running transition is going to be destroyed. Drop transition
+ * without setting final value as actor has released its resources already
+ * or is going to do so.
+ */
+static void _xfdashboard_transition_manager_on_actor_destroyed(ClutterActor *inActor, gpointer inUserData)
+{
+	XfdashboardTransitionManagerTransition	*transition;
+
+	g_return_if_fail(CLUTTER_IS_ACTOR(inActor));
+	g_return_if_fail(inUserData);
+
+	transition=(XfdashboardTransitionManagerTransition*)inUserData;
+	_xfdashboard_transition_manager_remove(transition->manager, transition, FALSE);
+}
+
+/* Set all running transitions to their final values */
+static void _xfdashboard_transition_manager_finish(XfdashboardTransitionManager *self,
+													ClutterActor *inActor,
+													const gchar *inPropertyName)
+{
+	XfdashboardTransitionManagerPrivate		*priv;
+	GList									*transitions;
+	GList									*iter;
+	XfdashboardTransitionManagerTransition	*transition;
+
+	priv=self->priv;
+
+	/* Setting final values may start or stop other transitions so iterate
+	 * a copy of list and skip transitions removed in the meantime.
+	 */
+	transitions=g_list_copy(priv->transitions);
+	for(iter=transitions; iter; iter=g_list_next(iter))
+	{
+		transition=(XfdashboardTransitionManagerTransition*)iter->data;
+		if(!g_list_find(priv->transitions, transition)) continue;
+
+		if(inActor && transition->actor!=inActor) continue;
+		if(inPropertyName && transition->propertyName!=inPropertyName) continue;
+
+		_xfdashboard_transition_manager_remove(self, transition, TRUE);
+	}
+	g_list_free(transitions);
+}
+
+/* A new frame is going to be painted so advance all running transitions */
+static void _xfdashboard_transition_manager_on_new_frame(XfdashboardTransitionManager *self,
+															gint inElapsed,
+															gpointer inUserData)
+{
+	XfdashboardTransitionManagerPrivate		*priv;
+	GList									*transitions;
+	GList									*iter;
+	XfdashboardTransitionManagerTransition	*transition;
+	gdouble									progress;
+	GValue									value=G_VALUE_INIT;
+
+	g_return_if_fail(XFDASHBOARD_IS_TRANSITION_MANAGER(self));
+	g_return_if_fail(CLUTTER_IS_TIMELINE(inUserData));
+
+	priv=self->priv;
+
+	/* Advance clock by time passed since last frame */
+	priv->clockTime+=clutter_timeline_get_delta(CLUTTER_TIMELINE(inUserData));
+
+	/* Setting a property may start or stop other transitions so iterate
+	 * a copy of list and skip transitions removed in the meantime.
+	 */
+	transitions=g_list_copy(priv->transitions);
+	for(iter=transitions; iter; iter=g_list_next(iter))
+	{
+		transition=(XfdashboardTransitionManagerTransition*)iter->data;
+		if(!g_list_find(priv->transitions, transition)) continue;
+
+		/* Set final value and remove transition if it is completed */
+		if(priv->clockTime>=transition->startTime+transition->duration)
+		{
+			_xfdashboard_transition_manager_remove(self, transition, TRUE);
+			continue;
+		}
+
+		/* Set interpolated value */
+		progress=((gdouble)(priv->clockTime-transition->startTime))/transition->duration;
+		progress=(transition->easing)(progress);
+
+		g_value_init(&value, G_VALUE_TYPE(&transition->toValue));
+		_xfdashboard_transition_manager_interpolate(&transition->fromValue, &transition->toValue, progress, &value);
+		g_object_set_property(G_OBJECT(transition->actor), transition->propertyName, &value);
+		g_value_unset(&value);
+	}
+	g_list_free(transitions);
+}
+
+/* IMPLEMENTATION: GObject */
+
+/* Dispose this object */
+static void _xfdashboard_transition_manager_dispose(GObject *inObject)
+{
+	XfdashboardTransitionManager			*self=XFDASHBOARD_TRANSITION_MANAGER(inObject);
+	XfdashboardTransitionManagerPrivate		*priv=self->priv;
+
+	/* Release allocated resources */
+	if(priv->transitions)
+	{
+		_xfdashboard_transition_manager_finish(self, NULL, NULL);
+		priv->transitions=NULL;
+	}
+
+	if(priv->clock)
+	{
+		clutter_timeline_stop(priv->clock);
+		g_object_unref(priv->clock);
+		priv->clock=NULL;
+	}
+
+	if(priv->compiledTransitions)
+	{
+		g_hash_table_destroy(priv->compiledTransitions);
+		priv->compiledTransitions=NULL;
+	}
+
+	/* Unset singleton */
+	if(G_LIKELY(G_OBJECT(_xfdashboard_transition_manager)==inObject)) _xfdashboard_transition_manager=NULL;
+
+	/* Call parent's class dispose method */
+	G_OBJECT_CLASS(xfdashboard_transition_manager_parent_class)->dispose(inObject);
+}
+
+/* Set/get properties */
+static void _xfdashboard_transition_manager_set_property(GObject *inObject,
+															guint inPropID,
+															const GValue *inValue,
+															GParamSpec *inSpec)
+{
+	XfdashboardTransitionManager			*self=XFDASHBOARD_TRANSITION_MANAGER(inObject);
+
+	switch(inPropID)
+	{
+		case PROP_REDUCED_MOTION:
+			xfdashboard_transition_manager_set_reduced_motion(self, g_value_get_boolean(inValue));
+			break;
+
+		default:
+			G_OBJECT_WARN_INVALID_PROPERTY_ID(inObject, inPropID, inSpec);
+			break;
+	}
+}
+
+static void _xfdashboard_transition_manager_get_property(GObject *inObject,
+															guint inPropID,
+															GValue *outValue,
+															GParamSpec *inSpec)
+{
+	XfdashboardTransitionManager			*self=XFDASHBOARD_TRANSITION_MANAGER(inObject);
+
+	switch(inPropID)
+	{
+		case PROP_REDUCED_MOTION:
+			g_value_set_boolean(outValue, self->priv->reducedMotion);
+			break;
+
+		default:
+			G_OBJECT_WARN_INVALID_PROPERTY_ID(inObject, inPropID, inSpec);
+			break;
+	}
+}
+
+/* Class initialization
+ * Override functions in parent classes and define properties
+ * and signals
+ */
+static void xfdashboard_transition_manager_class_init(XfdashboardTransitionManagerClass *klass)
+{
+	GObjectClass			*gobjectClass=G_OBJECT_CLASS(klass);
+
+	/* Override functions */
+	gobjectClass->dispose=_xfdashboard_transition_manager_dispose;
+	gobjectClass->set_property=_xfdashboard_transition_manager_set_property;
+	gobjectClass->get_property=_xfdashboard_transition_manager_get_property;
+
+	/* Set up private structure */
+	g_type_class_add_private(klass, sizeof(XfdashboardTransitionManagerPrivate));
+
+	/* Define properties */
+	XfdashboardTransitionManagerProperties[PROP_REDUCED_MOTION]=
+		g_param_spec_boolean("reduced-motion",
+								_("Reduced motion"),
+								_("If set all transitions snap to their final state immediately"),
+								FALSE,
+								G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
+	g_object_class_install_properties(gobjectClass, PROP_LAST, XfdashboardTransitionManagerProperties);
+}
+
+/* Object initialization
+ * Create private structure and set up default values
+ */
+static void xfdashboard_transition_manager_init(XfdashboardTransitionManager *self)
+{
+	XfdashboardTransitionManagerPrivate		*priv;
+
+	priv=self->priv=XFDASHBOARD_TRANSITION_MANAGER_GET_PRIVATE(self);
+
+	/* Set default values */
+	priv->reducedMotion=FALSE;
+	priv->compiledTransitions=g_hash_table_new_full(g_str_hash,
+													g_str_equal,
+													g_free,
+													(GDestroyNotify)_xfdashboard_transition_manager_spec_free);
+	priv->transitions=NULL;
+	priv->clockTime=0;
+
+	/* Set up clock driving all transitions. It is a looping timeline which
+	 * is advanced by master clock at each frame of stage while any transition
+	 * is running.
+	 */
+	priv->clock=clutter_timeline_new(1000);
+	clutter_timeline_set_repeat_count(priv->clock, -1);
+	g_signal_connect_swapped(priv->clock, "new-frame", G_CALLBACK(_xfdashboard_transition_manager_on_new_frame), self);
+}
+
+/* IMPLEMENTATION: Public API */
+
+/* Get single instance of manager */
+XfdashboardTransitionManager* xfdashboard_transition_manager_get_default(void)
+{
+	if(G_UNLIKELY(_xfdashboard_transition_manager==NULL))
+	{
+		_xfdashboard_transition_manager=g_object_new(XFDASHBOARD_TYPE_TRANSITION_MANAGER, NULL);
+	}
+		else g_object_ref(_xfdashboard_transition_manager);
+
+	return(_xfdashboard_transition_manager);
+}
+
+/* Get/set reduced motion mode */
+gboolean xfdashboard_transition_manager_get_reduced_motion(XfdashboardTransitionManager *self)
+{
+	g_return_val_if_fail(XFDASHBOARD_IS_TRANSITION_MANAGER(self), FALSE);
+
+	return(self->priv->reducedMotion);
+}
+
+void xfdashboard_transition_manager_set_reduced_motion(XfdashboardTransitionManager *self, gboolean inReducedMotion)
+{
+	XfdashboardTransitionManagerPrivate		*priv;
+
+	g_return_if_fail(XFDASHBOARD_IS_TRANSITION_MANAGER(self));
+
+	priv=self->priv;
+
+	/* Set value if changed */
+	if(priv->reducedMotion!=inReducedMotion)
+	{
+		/* Set value */
+		priv->reducedMotion=inReducedMotion;
+
+		/* Snap all running transitions to their final state */
+		if(priv->reducedMotion) _xfdashboard_transition_manager_finish(self, NULL, NULL);
+
+		/* Notify about property change */
+		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardTransitionManagerProperties[PROP_REDUCED_MOTION]);
+	}
+}
+
+/* Set property of actor to value. If the string of transitions contains
+ * a transition for this property and the actor is visible, the property is
+ * animated to the new value. A transition already running for this property
+ * is retargeted in place and continues from the current value. Otherwise
+ * the value is set immediately.
+ * 
+ * Only properties of numeric types or colors can be animated. Paint-only
+ * properties like opacity or translation should be preferred as animating
+ * properties which affect layout relayouts the actor at each frame.
+ */
+void xfdashboard_transition_manager_set_property(XfdashboardTransitionManager *self,
+													ClutterActor *inActor,
+													const gchar *inTransitions,
+													const gchar *inPropertyName,
+													const GValue *inValue)
+{
+	XfdashboardTransitionManagerPrivate			*priv;
+	GParamSpec									*paramSpec;
+	const gchar									*propertyName;
+	const XfdashboardTransitionManagerSpecItem	*item;
+	XfdashboardTransitionManagerTransition		*transition;
+	GValue										targetValue=G_VALUE_INIT;
+
+	g_return_if_fail(XFDASHBOARD_IS_TRANSITION_MANAGER(self));
+	g_return_if_fail(CLUTTER_IS_ACTOR(inActor));
+	g_return_if_fail(inPropertyName && *inPropertyName);
+	g_return_if_fail(G_IS_VALUE(inValue));
+
+	priv=self->priv;
+
+	/* Check that property exists */
+	paramSpec=g_object_class_find_property(G_OBJECT_GET_CLASS(inActor), inPropertyName);
+	if(!paramSpec)
+	{
+		g_warning(_("Cannot set non-existent property '%s' of class %s"),
+					inPropertyName, G_OBJECT_TYPE_NAME(inActor));
+		return;
+	}
+
+	propertyName=g_intern_string(inPropertyName);
+
+	/* Find transition for property */
+	item=NULL;
+	if(inTransitions &&
+		!priv->reducedMotion &&
+		clutter_actor_is_mapped(inActor) &&
+		_xfdashboard_transition_manager_can_interpolate(G_PARAM_SPEC_VALUE_TYPE(paramSpec)))
+	{
+		item=_xfdashboard_transition_manager_lookup(self, inTransitions, propertyName);
+		if(item && item->duration==0) item=NULL;
+	}
+
+	/* Get running transition of property */
+	transition=_xfdashboard_transition_manager_find(self, inActor, propertyName);
+
+	/* If property should not be animated stop running transition
+	 * and set value immediately.
+	 */
+	if(!item)
+	{
+		if(transition) _xfdashboard_transition_manager_remove(self, transition, FALSE);
+		g_object_set_property(G_OBJECT(inActor), propertyName, inValue);
+		return;
+	}
+
+	/* Convert value to type of property */
+	g_value_init(&targetValue, G_PARAM_SPEC_VALUE_TYPE(paramSpec));
+	if(!g_value_transform(inValue, &targetValue))
+	{
+		g_value_unset(&targetValue);
+
+		if(transition) _xfdashboard_transition_manager_remove(self, transition, FALSE);
+		g_object_set_property(G_OBJECT(inActor), propertyName, inValue);
+		return;
+	}
+
+	/* Keep running transition untouched if it is already heading to this
+	 * value, e.g. when actor is restyled with unchanged values.
+	 */
+	if(transition &&
+		g_param_values_cmp(paramSpec, &transition->toValue, &targetValue)==0)
+	{
+		g_value_unset(&targetValue);
+		return;
+	}
+
+	/* Create new transition or retarget running one in place */
+	if(!transition)
+	{
+		transition=g_slice_new0(XfdashboardTransitionManagerTransition);
+		transition->manager=self;
+		transition->actor=inActor;
+		transition->propertyName=propertyName;
+		g_value_init(&transition->fromValue, G_PARAM_SPEC_VALUE_TYPE(paramSpec));
+		g_value_init(&transition->toValue, G_PARAM_SPEC_VALUE_TYPE(paramSpec));
+
+		g_object_weak_ref(G_OBJECT(inActor), _xfdashboard_transition_manager_on_actor_finalized, transition);
+		transition->actorDestroySignalID=g_signal_connect(inActor,
+															"destroy",
+															G_CALLBACK(_xfdashboard_transition_manager_on_actor_destroyed),
+															transition);
+		priv->transitions=g_list_prepend(priv->transitions, transition);
+	}
+
+	g_object_get_property(G_OBJECT(inActor), propertyName, &transition->fromValue);
+	g_value_copy(&targetValue, &transition->toValue);
+	g_value_unset(&targetValue);
+
+	transition->startTime=priv->clockTime;
+	transition->duration=item->duration;
+	transition->easing=item->easing;
+
+	/* Nothing to animate if property has already the requested value */
+	if(g_param_values_cmp(paramSpec, &transition->fromValue, &transition->toValue)==0)
+	{
+		_xfdashboard_transition_manager_remove(self, transition, FALSE);
+		return;
+	}
+
+	/* Start clock if not running already */
+	if(!clutter_timeline_is_playing(priv->clock)) clutter_timeline_start(priv->clock);
+}
+
+/* Stop running transitions of actor and set their properties to their final
+ * values. If property name is NULL all transitions of actor are stopped.
+ */
+void xfdashboard_transition_manager_stop(XfdashboardTransitionManager *self,
+											ClutterActor *inActor,
+											const gchar *inPropertyName)
+{
+	g_return_if_fail(XFDASHBOARD_IS_TRANSITION_MANAGER(self));
+	g_return_if_fail(CLUTTER_IS_ACTOR(inActor));
+
+	_xfdashboard_transition_manager_finish(self,
+											inActor,
+											inPropertyName ? g_intern_string(inPropertyName) : NULL);
+}
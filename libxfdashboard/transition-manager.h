@@ -0,0 +1,87 @@
+/*
+ * transition-manager: Single-instance managing animated transitions of
+ *                     actor properties defined by theme
+ * 
+ * Copyright 2012-2016 Stephan Haller <nomad@froevel.de>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ * 
+ * 
+ */
+
+#ifndef __LIBXFDASHBOARD_TRANSITION_MANAGER__
+#define __LIBXFDASHBOARD_TRANSITION_MANAGER__
+
+#if !defined(__LIBXFDASHBOARD_H_INSIDE__) && !defined(LIBXFDASHBOARD_COMPILATION)
+#error "Only <libxfdashboard/libxfdashboard.h> can be included directly."
+#endif
+
+#include <clutter/clutter.h>
+
+G_BEGIN_DECLS
+
+#define XFDASHBOARD_TYPE_TRANSITION_MANAGER				(xfdashboard_transition_manager_get_type())
+#define XFDASHBOARD_TRANSITION_MANAGER(obj)				(G_TYPE_CHECK_INSTANCE_CAST((obj), XFDASHBOARD_TYPE_TRANSITION_MANAGER, XfdashboardTransitionManager))
+#define XFDASHBOARD_IS_TRANSITION_MANAGER(obj)			(G_TYPE_CHECK_INSTANCE_TYPE((obj), XFDASHBOARD_TYPE_TRANSITION_MANAGER))
+#define XFDASHBOARD_TRANSITION_MANAGER_CLASS(klass)		(G_TYPE_CHECK_CLASS_CAST((klass), XFDASHBOARD_TYPE_TRANSITION_MANAGER, XfdashboardTransitionManagerClass))
+#define XFDASHBOARD_IS_TRANSITION_MANAGER_CLASS(klass)	(G_TYPE_CHECK_CLASS_TYPE((klass), XFDASHBOARD_TYPE_TRANSITION_MANAGER))
+#define XFDASHBOARD_TRANSITION_MANAGER_GET_CLASS(obj)	(G_TYPE_INSTANCE_GET_CLASS((obj), XFDASHBOARD_TYPE_TRANSITION_MANAGER, XfdashboardTransitionManagerClass))
+
+typedef struct _XfdashboardTransitionManager			XfdashboardTransitionManager;
+typedef struct _XfdashboardTransitionManagerClass		XfdashboardTransitionManagerClass;
+typedef struct _XfdashboardTransitionManagerPrivate		XfdashboardTransitionManagerPrivate;
+
+struct _XfdashboardTransitionManager
+{
+	/*< private >*/
+	/* Parent instance */
+	GObject								parent_instance;
+
+	/* Private structure */
+	XfdashboardTransitionManagerPrivate	*priv;
+};
+
+struct _XfdashboardTransitionManagerClass
+{
+	/*< private >*/
+	/* Parent class */
+	GObjectClass						parent_class;
+
+	/*< public >*/
+	/* Virtual functions */
+};
+
+/* Public API */
+GType xfdashboard_transition_manager_get_type(void) G_GNUC_CONST;
+
+XfdashboardTransitionManager* xfdashboard_transition_manager_get_default(void);
+
+gboolean xfdashboard_transition_manager_get_reduced_motion(XfdashboardTransitionManager *self);
+void xfdashboard_transition_manager_set_reduced_motion(XfdashboardTransitionManager *self, gboolean inReducedMotion);
+
+void xfdashboard_transition_manager_set_property(XfdashboardTransitionManager *self,
+													ClutterActor *inActor,
+													const gchar *inTransitions,
+													const gchar *inPropertyName,
+													const GValue *inValue);
+
+void xfdashboard_transition_manager_stop(XfdashboardTransitionManager *self,
+											ClutterActor *inActor,
+											const gchar *inPropertyName);
+
+G_END_DECLS
+
+#endif	/* __LIBXFDASHBOARD_TRANSITION_MANAGER__ */
@@ -218,6 +218,22 @@ typedef enum /*< prefix=XFDASHBOARD_ANCHOR_POINT >*/
 	XFDASHBOARD_ANCHOR_POINT_CENTER
 } XfdashboardAnchorPoint;
 
+/**
+ * XfdashboardSuspendMemoryPolicy:
+ * @XFDASHBOARD_SUSPEND_MEMORY_POLICY_NONE: Keep all caches and actors when suspended.
+ * @XFDASHBOARD_SUSPEND_MEMORY_POLICY_TEXTURES: Release textures of loaded images when suspended. They are reloaded on resume. Snapshots of windows are kept.
+ * @XFDASHBOARD_SUSPEND_MEMORY_POLICY_VIEWS: Like @XFDASHBOARD_SUSPEND_MEMORY_POLICY_TEXTURES but also destroy actors of views and search results which are rebuilt on resume anyway.
+ *
+ * Determines how much memory is released when the application running in
+ * daemon mode is suspended. Each policy includes the ones before.
+ */
+typedef enum /*< prefix=XFDASHBOARD_SUSPEND_MEMORY_POLICY >*/
+{
+	XFDASHBOARD_SUSPEND_MEMORY_POLICY_NONE=0,
+	XFDASHBOARD_SUSPEND_MEMORY_POLICY_TEXTURES,
+	XFDASHBOARD_SUSPEND_MEMORY_POLICY_VIEWS
+} XfdashboardSuspendMemoryPolicy;
+
 G_END_DECLS
 
 #endif	/* __LIBXFDASHBOARD_TYPES__ */
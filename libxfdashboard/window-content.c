@@ -46,6 +46,7 @@
 #include <libxfdashboard/stylable.h>
 #include <libxfdashboard/window-tracker.h>
 #include <libxfdashboard/enums.h>
+#include <libxfdashboard/instrumentation.h>
 #include <libxfdashboard/compat.h>
 
 
@@ -94,6 +95,7 @@ struct _XfdashboardWindowContentPrivate
 
 	/* Instance related */
 	gboolean								isFallback;
+	gboolean								isSnapshot;
 	CoglTexture								*texture;
 	Window									xWindowID;
 	Pixmap									pixmap;
@@ -110,6 +112,8 @@ struct _XfdashboardWindowContentPrivate
 	guint									workaroundStateSignalID;
 
 	gboolean								suspendAfterResumeOnIdle;
+
+	gboolean								usesXEventFilter;
 };
 
 /* Properties */
@@ -153,6 +157,18 @@ static GParamSpec* XfdashboardWindowContentProperties[PROP_LAST]={ 0, };
 #define WINDOW_CONTENT_CREATION_PRIORITY_XFCONF_PROP	"/window-content-creation-priority"
 #define DEFAULT_WINDOW_CONTENT_CREATION_PRIORITY		"immediate"
 
+#define WINDOW_SNAPSHOT_CACHE_SIZE_XFCONF_PROP			"/window-snapshot-cache-size"
+#define DEFAULT_WINDOW_SNAPSHOT_CACHE_SIZE				32
+
+#define WINDOW_SNAPSHOT_MAX_SIZE						512
+
+typedef struct _XfdashboardWindowContentSnapshot		XfdashboardWindowContentSnapshot;
+struct _XfdashboardWindowContentSnapshot
+{
+	XfdashboardWindowTrackerWindow		*window;
+	CoglTexture							*texture;
+};
+
 struct _XfdashboardWindowContentPriorityMap
 {
 	const gchar		*name;
@@ -184,6 +200,20 @@ static XfdashboardWindowContentPriorityMap	_xfdashboard_window_content_window_cr
 												};
 static guint								_xfdashboard_window_content_window_creation_shutdown_signal_id=0;
 
+static GHashTable*							_xfdashboard_window_content_snapshots=NULL;
+static GQueue								_xfdashboard_window_content_snapshots_lru=G_QUEUE_INIT;
+static guint								_xfdashboard_window_content_snapshots_window_closed_signal_id=0;
+static guint								_xfdashboard_window_content_snapshots_shutdown_signal_id=0;
+
+static guint								_xfdashboard_window_content_x_event_filter_usage=0;
+static GHashTable*							_xfdashboard_window_content_xwindow_map=NULL;
+static GHashTable*							_xfdashboard_window_content_frame_xwindow_cache=NULL;
+#ifdef HAVE_XDAMAGE
+static GHashTable*							_xfdashboard_window_content_damage_map=NULL;
+static GHashTable*							_xfdashboard_window_content_pending_damages=NULL;
+static guint								_xfdashboard_window_content_pending_damages_id=0;
+#endif
+
 /* Forward declarations */
 static void _xfdashboard_window_content_suspend(XfdashboardWindowContent *self);
 static void _xfdashboard_window_content_resume(XfdashboardWindowContent *self);
@@ -406,6 +436,286 @@ static void _xfdashboard_window_content_on_window_creation_priority_shutdown(voi
 	}
 }
 
+/* Free a snapshot of a window */
+static void _xfdashboard_window_content_snapshot_free(XfdashboardWindowContentSnapshot *inSnapshot)
+{
+	g_return_if_fail(inSnapshot);
+
+	if(inSnapshot->texture) cogl_object_unref(inSnapshot->texture);
+	g_free(inSnapshot);
+}
+
+/* Remove snapshot of a window from cache */
+static void _xfdashboard_window_content_snapshots_remove(XfdashboardWindowTrackerWindow *inWindow)
+{
+	GList								*link;
+
+	if(!_xfdashboard_window_content_snapshots) return;
+
+	link=(GList*)g_hash_table_lookup(_xfdashboard_window_content_snapshots, inWindow);
+	if(!link) return;
+
+	g_hash_table_remove(_xfdashboard_window_content_snapshots, inWindow);
+	_xfdashboard_window_content_snapshot_free((XfdashboardWindowContentSnapshot*)link->data);
+	g_queue_delete_link(&_xfdashboard_window_content_snapshots_lru, link);
+}
+
+/* A window was closed so its snapshot is not needed anymore */
+static void _xfdashboard_window_content_snapshots_on_window_closed(XfdashboardWindowTracker *inWindowTracker,
+																	XfdashboardWindowTrackerWindow *inWindow,
+																	gpointer inUserData)
+{
+	_xfdashboard_window_content_snapshots_remove(inWindow);
+}
+
+/* Destroy snapshot cache */
+static void _xfdashboard_window_content_snapshots_destroy(void)
+{
+	XfdashboardWindowTracker			*windowTracker;
+	XfdashboardApplication				*application;
+	XfdashboardWindowContentSnapshot	*snapshot;
+
+	/* Only an existing cache can be destroyed */
+	if(!_xfdashboard_window_content_snapshots) return;
+
+	/* Disconnect signal handlers */
+	windowTracker=xfdashboard_window_tracker_get_default();
+	g_signal_handler_disconnect(windowTracker, _xfdashboard_window_content_snapshots_window_closed_signal_id);
+	_xfdashboard_window_content_snapshots_window_closed_signal_id=0;
+	g_object_unref(windowTracker);
+
+	application=xfdashboard_application_get_default();
+	g_signal_handler_disconnect(application, _xfdashboard_window_content_snapshots_shutdown_signal_id);
+	_xfdashboard_window_content_snapshots_shutdown_signal_id=0;
+
+	/* Release all snapshots */
+	while((snapshot=g_queue_pop_head(&_xfdashboard_window_content_snapshots_lru)))
+	{
+		_xfdashboard_window_content_snapshot_free(snapshot);
+	}
+
+	g_debug("Destroying window snapshot cache");
+	g_hash_table_destroy(_xfdashboard_window_content_snapshots);
+	_xfdashboard_window_content_snapshots=NULL;
+}
+
+/* Store snapshot of a window in cache and evict least recently used ones
+ * if cache exceeds its configured size.
+ */
+static void _xfdashboard_window_content_snapshots_store(XfdashboardWindowTrackerWindow *inWindow, CoglTexture *inTexture)
+{
+	XfdashboardWindowContentSnapshot	*snapshot;
+	guint								maxSize;
+
+	g_return_if_fail(XFDASHBOARD_IS_WINDOW_TRACKER_WINDOW(inWindow));
+	g_return_if_fail(inTexture);
+
+	/* Get maximum size of cache. Do not store anything if cache is disabled. */
+	maxSize=xfconf_channel_get_uint(xfdashboard_application_get_xfconf_channel(NULL),
+									WINDOW_SNAPSHOT_CACHE_SIZE_XFCONF_PROP,
+									DEFAULT_WINDOW_SNAPSHOT_CACHE_SIZE);
+	if(maxSize==0) return;
+
+	/* Create cache if not available */
+	if(!_xfdashboard_window_content_snapshots)
+	{
+		XfdashboardWindowTracker		*windowTracker;
+		XfdashboardApplication			*application;
+
+		_xfdashboard_window_content_snapshots=g_hash_table_new(g_direct_hash, g_direct_equal);
+		g_debug("Created window snapshot cache");
+
+		windowTracker=xfdashboard_window_tracker_get_default();
+		_xfdashboard_window_content_snapshots_window_closed_signal_id=g_signal_connect(windowTracker,
+																						"window-closed",
+																						G_CALLBACK(_xfdashboard_window_content_snapshots_on_window_closed),
+																						NULL);
+
+		application=xfdashboard_application_get_default();
+		_xfdashboard_window_content_snapshots_shutdown_signal_id=g_signal_connect(application,
+																					"shutdown-final",
+																					G_CALLBACK(_xfdashboard_window_content_snapshots_destroy),
+																					NULL);
+	}
+
+	/* Replace any older snapshot of this window */
+	_xfdashboard_window_content_snapshots_remove(inWindow);
+
+	snapshot=g_new0(XfdashboardWindowContentSnapshot, 1);
+	snapshot->window=inWindow;
+	snapshot->texture=cogl_object_ref(inTexture);
+
+	g_queue_push_head(&_xfdashboard_window_content_snapshots_lru, snapshot);
+	g_hash_table_insert(_xfdashboard_window_content_snapshots, inWindow, _xfdashboard_window_content_snapshots_lru.head);
+
+	/* Evict least recently used snapshots */
+	while(g_queue_get_length(&_xfdashboard_window_content_snapshots_lru)>maxSize)
+	{
+		snapshot=(XfdashboardWindowContentSnapshot*)g_queue_peek_tail(&_xfdashboard_window_content_snapshots_lru);
+		_xfdashboard_window_content_snapshots_remove(snapshot->window);
+	}
+}
+
+/* Look up snapshot of a window in cache. Returned texture must be freed
+ * with cogl_object_unref().
+ */
+static CoglTexture* _xfdashboard_window_content_snapshots_lookup(XfdashboardWindowTrackerWindow *inWindow)
+{
+	GList								*link;
+	XfdashboardWindowContentSnapshot	*snapshot;
+
+	if(!_xfdashboard_window_content_snapshots) return(NULL);
+
+	link=(GList*)g_hash_table_lookup(_xfdashboard_window_content_snapshots, inWindow);
+	if(!link) return(NULL);
+
+	/* Mark snapshot as most recently used */
+	g_queue_unlink(&_xfdashboard_window_content_snapshots_lru, link);
+	g_queue_push_head_link(&_xfdashboard_window_content_snapshots_lru, link);
+
+	snapshot=(XfdashboardWindowContentSnapshot*)link->data;
+	return(cogl_object_ref(snapshot->texture));
+}
+
+/* Render a downscaled copy of current live window texture */
+static CoglTexture* _xfdashboard_window_content_create_snapshot(XfdashboardWindowContent *self)
+{
+	XfdashboardWindowContentPrivate		*priv;
+	CoglContext							*context;
+	CoglTexture							*snapshotTexture;
+	CoglOffscreen						*offscreen;
+	CoglFramebuffer						*framebuffer;
+	CoglPipeline						*pipeline;
+	gint								textureWidth;
+	gint								textureHeight;
+	gint								snapshotWidth;
+	gint								snapshotHeight;
+	gfloat								scale;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_WINDOW_CONTENT(self), NULL);
+
+	priv=self->priv;
+
+	/* Only a live window texture can be captured */
+	if(!priv->texture || priv->isFallback || priv->isSnapshot || priv->isSuspended) return(NULL);
+
+	/* Determine size of snapshot */
+	textureWidth=cogl_texture_get_width(priv->texture);
+	textureHeight=cogl_texture_get_height(priv->texture);
+	if(textureWidth<=0 || textureHeight<=0) return(NULL);
+
+	scale=MIN(1.0f, ((gfloat)WINDOW_SNAPSHOT_MAX_SIZE)/MAX(textureWidth, textureHeight));
+	snapshotWidth=MAX(1, (gint)(textureWidth*scale));
+	snapshotHeight=MAX(1, (gint)(textureHeight*scale));
+
+	/* Create texture and offscreen framebuffer to render snapshot into */
+	context=clutter_backend_get_cogl_context(clutter_get_default_backend());
+
+#if COGL_VERSION_CHECK(1, 18, 0)
+	snapshotTexture=COGL_TEXTURE(cogl_texture_2d_new_with_size(context, snapshotWidth, snapshotHeight));
+	offscreen=cogl_offscreen_new_with_texture(snapshotTexture);
+	if(!cogl_framebuffer_allocate(COGL_FRAMEBUFFER(offscreen), NULL))
+	{
+		cogl_object_unref(offscreen);
+		offscreen=NULL;
+	}
+#else
+	snapshotTexture=cogl_texture_new_with_size(snapshotWidth,
+												snapshotHeight,
+												COGL_TEXTURE_NO_SLICING,
+												COGL_PIXEL_FORMAT_RGBA_8888_PRE);
+	offscreen=NULL;
+	if(snapshotTexture) offscreen=cogl_offscreen_new_to_texture(snapshotTexture);
+#endif
+
+	if(!snapshotTexture || !offscreen)
+	{
+		g_warning(_("Could not create snapshot of window '%s'"),
+					xfdashboard_window_tracker_window_get_title(priv->window));
+
+		if(offscreen) cogl_object_unref(offscreen);
+		if(snapshotTexture) cogl_object_unref(snapshotTexture);
+		return(NULL);
+	}
+
+	/* Draw live window texture scaled down into snapshot texture and flush
+	 * it before pixmap of window gets released.
+	 */
+	framebuffer=COGL_FRAMEBUFFER(offscreen);
+	cogl_framebuffer_orthographic(framebuffer, 0.0f, 0.0f, snapshotWidth, snapshotHeight, -1.0f, 100.0f);
+	cogl_framebuffer_identity_matrix(framebuffer);
+	cogl_framebuffer_clear4f(framebuffer, COGL_BUFFER_BIT_COLOR, 0.0f, 0.0f, 0.0f, 0.0f);
+
+	pipeline=cogl_pipeline_new(context);
+	cogl_pipeline_set_layer_texture(pipeline, 0, priv->texture);
+	cogl_pipeline_set_layer_filters(pipeline,
+									0,
+									COGL_PIPELINE_FILTER_LINEAR,
+									COGL_PIPELINE_FILTER_LINEAR);
+	cogl_framebuffer_draw_textured_rectangle(framebuffer,
+												pipeline,
+												0.0f, 0.0f,
+												snapshotWidth, snapshotHeight,
+												0.0f, 0.0f,
+												1.0f, 1.0f);
+	cogl_flush();
+
+	cogl_object_unref(pipeline);
+	cogl_object_unref(offscreen);
+
+	g_debug("Created snapshot of size %dx%d for window '%s'",
+				snapshotWidth, snapshotHeight,
+				xfdashboard_window_tracker_window_get_title(priv->window));
+
+	return(snapshotTexture);
+}
+
+/* Use snapshot as texture for window content */
+static void _xfdashboard_window_content_set_snapshot(XfdashboardWindowContent *self, CoglTexture *inSnapshot)
+{
+	XfdashboardWindowContentPrivate		*priv;
+
+	g_return_if_fail(XFDASHBOARD_IS_WINDOW_CONTENT(self));
+	g_return_if_fail(inSnapshot);
+
+	priv=self->priv;
+
+	if(priv->texture) cogl_object_unref(priv->texture);
+	priv->texture=cogl_object_ref(inSnapshot);
+	priv->isFallback=FALSE;
+	priv->isSnapshot=TRUE;
+
+	/* Invalidate content to get it redrawn with snapshot */
+	clutter_content_invalidate(CLUTTER_CONTENT(self));
+}
+
+/* Window got unmapped so capture snapshot of window while its pixmap is still
+ * valid before suspending live updates and show last known content.
+ */
+static void _xfdashboard_window_content_suspend_with_snapshot(XfdashboardWindowContent *self)
+{
+	XfdashboardWindowContentPrivate		*priv;
+	CoglTexture							*snapshot;
+
+	g_return_if_fail(XFDASHBOARD_IS_WINDOW_CONTENT(self));
+
+	priv=self->priv;
+
+	/* Capture snapshot */
+	snapshot=_xfdashboard_window_content_create_snapshot(self);
+
+	/* Suspend live updates */
+	_xfdashboard_window_content_suspend(self);
+
+	/* Store snapshot in cache and use it */
+	if(snapshot)
+	{
+		_xfdashboard_window_content_snapshots_store(priv->window, snapshot);
+		_xfdashboard_window_content_set_snapshot(self, snapshot);
+		cogl_object_unref(snapshot);
+	}
+}
+
 /* Check if we should workaround unmapped window for requested window and set up workaround */
 static void _xfdashboard_window_content_on_workaround_state_changed(XfdashboardWindowContent *self,
 																	gpointer inUserData)
@@ -574,6 +884,9 @@ static void _xfdashboard_window_content_setup_workaround(XfdashboardWindowConten
 	/* Only workaround unmapped windows */
 	if(!xfdashboard_window_tracker_window_is_minimized(inWindow)) return;
 
+	/* No workaround is needed if a snapshot of window is shown */
+	if(priv->isSnapshot) return;
+
 	/* Check if workaround is already set up */
 	if(priv->workaroundMode!=XFDASHBOARD_WINDOW_CONTENT_WORKAROUND_MODE_NONE) return;
 
@@ -681,58 +994,264 @@ static void _xfdashboard_window_content_on_application_suspended_changed(Xfdashb
 		}
 }
 
-/* Filter X events for damages */
-static ClutterX11FilterReturn _xfdashboard_window_content_on_x_event(XEvent *inXEvent, ClutterEvent *inEvent, gpointer inUserData)
+/* Look up window content by X window */
+static XfdashboardWindowContent* _xfdashboard_window_content_lookup_by_xwindow(Window inXWindowID)
+{
+	if(!_xfdashboard_window_content_xwindow_map || inXWindowID==None) return(NULL);
+
+	return((XfdashboardWindowContent*)g_hash_table_lookup(_xfdashboard_window_content_xwindow_map, GUINT_TO_POINTER(inXWindowID)));
+}
+
+/* Register/unregister X window of window content at central X event dispatcher */
+static void _xfdashboard_window_content_register_xwindow(XfdashboardWindowContent *self)
+{
+	XfdashboardWindowContentPrivate		*priv;
+
+	g_return_if_fail(XFDASHBOARD_IS_WINDOW_CONTENT(self));
+	g_return_if_fail(_xfdashboard_window_content_xwindow_map);
+
+	priv=self->priv;
+
+	if(priv->xWindowID==None) return;
+
+	g_hash_table_insert(_xfdashboard_window_content_xwindow_map, GUINT_TO_POINTER(priv->xWindowID), self);
+}
+
+static void _xfdashboard_window_content_unregister_xwindow(XfdashboardWindowContent *self)
+{
+	XfdashboardWindowContentPrivate		*priv;
+
+	g_return_if_fail(XFDASHBOARD_IS_WINDOW_CONTENT(self));
+
+	priv=self->priv;
+
+	/* Only remove mapping if it still points to this window content */
+	if(_xfdashboard_window_content_lookup_by_xwindow(priv->xWindowID)==self)
+	{
+		g_hash_table_remove(_xfdashboard_window_content_xwindow_map, GUINT_TO_POINTER(priv->xWindowID));
+	}
+}
+
+#ifdef HAVE_XDAMAGE
+/* Invalidate all window contents which got damaged since last time this function was called */
+static gboolean _xfdashboard_window_content_on_flush_pending_damages(gpointer inUserData)
+{
+	GHashTableIter						iter;
+	XfdashboardWindowContent			*content;
+	GSList								*damaged;
+	GSList								*damagedIter;
+
+	/* Source will be removed so forget its ID */
+	_xfdashboard_window_content_pending_damages_id=0;
+
+	if(!_xfdashboard_window_content_pending_damages) return(G_SOURCE_REMOVE);
+
+	/* Take all damaged window contents before invalidating them as invalidation
+	 * may cause new damages to be queued.
+	 */
+	damaged=NULL;
+	g_hash_table_iter_init(&iter, _xfdashboard_window_content_pending_damages);
+	while(g_hash_table_iter_next(&iter, (gpointer*)&content, NULL))
+	{
+		damaged=g_slist_prepend(damaged, g_object_ref(content));
+	}
+	g_hash_table_remove_all(_xfdashboard_window_content_pending_damages);
+
+	/* Update texture for live window content once for all damages received */
+	for(damagedIter=damaged; damagedIter; damagedIter=g_slist_next(damagedIter))
+	{
+		content=XFDASHBOARD_WINDOW_CONTENT(damagedIter->data);
+
+		if(content->priv->workaroundMode==XFDASHBOARD_WINDOW_CONTENT_WORKAROUND_MODE_NONE)
+		{
+			clutter_content_invalidate(CLUTTER_CONTENT(content));
+		}
+	}
+	g_slist_free_full(damaged, g_object_unref);
+
+	return(G_SOURCE_REMOVE);
+}
+
+/* Register/unregister damage of window content at central X event dispatcher */
+static void _xfdashboard_window_content_register_damage(XfdashboardWindowContent *self)
+{
+	XfdashboardWindowContentPrivate		*priv;
+
+	g_return_if_fail(XFDASHBOARD_IS_WINDOW_CONTENT(self));
+	g_return_if_fail(_xfdashboard_window_content_damage_map);
+
+	priv=self->priv;
+
+	if(priv->damage==None) return;
+
+	g_hash_table_insert(_xfdashboard_window_content_damage_map, GUINT_TO_POINTER(priv->damage), self);
+}
+
+static void _xfdashboard_window_content_unregister_damage(XfdashboardWindowContent *self)
 {
-	XfdashboardWindowContent			*self;
 	XfdashboardWindowContentPrivate		*priv;
 
-	g_return_val_if_fail(XFDASHBOARD_IS_WINDOW_CONTENT(inUserData), CLUTTER_X11_FILTER_CONTINUE);
+	g_return_if_fail(XFDASHBOARD_IS_WINDOW_CONTENT(self));
 
-	self=XFDASHBOARD_WINDOW_CONTENT(inUserData);
 	priv=self->priv;
 
+	/* Only remove mapping if it still points to this window content */
+	if(_xfdashboard_window_content_damage_map &&
+		priv->damage!=None &&
+		g_hash_table_lookup(_xfdashboard_window_content_damage_map, GUINT_TO_POINTER(priv->damage))==self)
+	{
+		g_hash_table_remove(_xfdashboard_window_content_damage_map, GUINT_TO_POINTER(priv->damage));
+	}
+
+	/* Drop any pending damage of this window content */
+	if(_xfdashboard_window_content_pending_damages)
+	{
+		g_hash_table_remove(_xfdashboard_window_content_pending_damages, self);
+	}
+}
+#endif
+
+/* Filter X events for all window contents and dispatch them to the window
+ * content affected by looking it up by X window or damage.
+ */
+static ClutterX11FilterReturn _xfdashboard_window_content_on_x_event(XEvent *inXEvent, ClutterEvent *inEvent, gpointer inUserData)
+{
+	XfdashboardWindowContent			*self;
+	XfdashboardWindowContentPrivate		*priv;
+
 	/* Check for mapped, unmapped related X events as pixmap, damage, texture etc.
 	 * needs to get resumed (acquired) or suspended (released)
 	 */
-	if(inXEvent->xany.window==priv->xWindowID)
+	switch(inXEvent->type)
 	{
-		switch(inXEvent->type)
-		{
-			case MapNotify:
-			case ConfigureNotify:
+		case MapNotify:
+		case ConfigureNotify:
+			self=_xfdashboard_window_content_lookup_by_xwindow(inXEvent->xany.window);
+			if(self)
+			{
+				priv=self->priv;
 				priv->isMapped=TRUE;
 				if(!priv->isAppSuspended) _xfdashboard_window_content_resume(self);
-				break;
+			}
+			return(CLUTTER_X11_FILTER_CONTINUE);
 
-			case UnmapNotify:
-			case DestroyNotify:
+		case UnmapNotify:
+			self=_xfdashboard_window_content_lookup_by_xwindow(inXEvent->xany.window);
+			if(self)
+			{
+				priv=self->priv;
+				priv->isMapped=FALSE;
+				_xfdashboard_window_content_suspend_with_snapshot(self);
+			}
+			return(CLUTTER_X11_FILTER_CONTINUE);
+
+		case ReparentNotify:
+			/* Window got reparented so its window frame may have changed */
+			if(_xfdashboard_window_content_frame_xwindow_cache)
+			{
+				g_hash_table_remove(_xfdashboard_window_content_frame_xwindow_cache, GUINT_TO_POINTER(inXEvent->xreparent.window));
+			}
+			return(CLUTTER_X11_FILTER_CONTINUE);
+
+		case DestroyNotify:
+			if(_xfdashboard_window_content_frame_xwindow_cache)
+			{
+				g_hash_table_remove(_xfdashboard_window_content_frame_xwindow_cache, GUINT_TO_POINTER(inXEvent->xdestroywindow.window));
+			}
+
+			self=_xfdashboard_window_content_lookup_by_xwindow(inXEvent->xany.window);
+			if(self)
+			{
+				priv=self->priv;
 				priv->isMapped=FALSE;
 				_xfdashboard_window_content_suspend(self);
-				break;
+			}
+			return(CLUTTER_X11_FILTER_CONTINUE);
 
-			default:
-				/* We do not handle this type of X event, drop through ... */
-				break;
-		}
+		default:
+			/* We do not handle this type of X event, drop through ... */
+			break;
 	}
 
-	/* Check for damage event */
+	/* Check for damage event and remember damaged window content. All damages
+	 * received are handled at once before next frame is drawn.
+	 */
 #ifdef HAVE_XDAMAGE
 	if(_xfdashboard_window_content_have_damage_extension &&
 		_xfdashboard_window_content_damage_event_base &&
 		inXEvent->type==(_xfdashboard_window_content_damage_event_base + XDamageNotify) &&
-		((XDamageNotifyEvent*)inXEvent)->damage==priv->damage &&
-		priv->workaroundMode==XFDASHBOARD_WINDOW_CONTENT_WORKAROUND_MODE_NONE)
+		_xfdashboard_window_content_damage_map)
 	{
-		/* Update texture for live window content */
-		clutter_content_invalidate(CLUTTER_CONTENT(self));
+		self=g_hash_table_lookup(_xfdashboard_window_content_damage_map,
+									GUINT_TO_POINTER(((XDamageNotifyEvent*)inXEvent)->damage));
+		if(self)
+		{
+			g_hash_table_add(_xfdashboard_window_content_pending_damages, self);
+
+			if(!_xfdashboard_window_content_pending_damages_id)
+			{
+				_xfdashboard_window_content_pending_damages_id=
+					clutter_threads_add_idle_full(G_PRIORITY_HIGH_IDLE,
+													_xfdashboard_window_content_on_flush_pending_damages,
+													NULL,
+													NULL);
+			}
+		}
 	}
 #endif
 
 	return(CLUTTER_X11_FILTER_CONTINUE);
 }
 
+/* Take/release a reference on central X event dispatcher which is set up
+ * when first window content is created and removed when last one is destroyed.
+ */
+static void _xfdashboard_window_content_x_event_filter_ref(void)
+{
+	if(_xfdashboard_window_content_x_event_filter_usage++>0) return;
+
+	_xfdashboard_window_content_xwindow_map=g_hash_table_new(g_direct_hash, g_direct_equal);
+	_xfdashboard_window_content_frame_xwindow_cache=g_hash_table_new(g_direct_hash, g_direct_equal);
+#ifdef HAVE_XDAMAGE
+	_xfdashboard_window_content_damage_map=g_hash_table_new(g_direct_hash, g_direct_equal);
+	_xfdashboard_window_content_pending_damages=g_hash_table_new(g_direct_hash, g_direct_equal);
+#endif
+
+	clutter_x11_add_filter(_xfdashboard_window_content_on_x_event, NULL);
+	g_debug("Added central X event filter for window contents");
+}
+
+static void _xfdashboard_window_content_x_event_filter_unref(void)
+{
+	g_return_if_fail(_xfdashboard_window_content_x_event_filter_usage>0);
+
+	if(--_xfdashboard_window_content_x_event_filter_usage>0) return;
+
+	clutter_x11_remove_filter(_xfdashboard_window_content_on_x_event, NULL);
+
+#ifdef HAVE_XDAMAGE
+	if(_xfdashboard_window_content_pending_damages_id)
+	{
+		g_source_remove(_xfdashboard_window_content_pending_damages_id);
+		_xfdashboard_window_content_pending_damages_id=0;
+	}
+
+	g_hash_table_destroy(_xfdashboard_window_content_pending_damages);
+	_xfdashboard_window_content_pending_damages=NULL;
+
+	g_hash_table_destroy(_xfdashboard_window_content_damage_map);
+	_xfdashboard_window_content_damage_map=NULL;
+#endif
+
+	g_hash_table_destroy(_xfdashboard_window_content_frame_xwindow_cache);
+	_xfdashboard_window_content_frame_xwindow_cache=NULL;
+
+	g_hash_table_destroy(_xfdashboard_window_content_xwindow_map);
+	_xfdashboard_window_content_xwindow_map=NULL;
+
+	g_debug("Removed central X event filter for window contents");
+}
+
 /* Release all resources used by this instance */
 static void _xfdashboard_window_content_release_resources(XfdashboardWindowContent *self)
 {
@@ -753,8 +1272,6 @@ static void _xfdashboard_window_content_release_resources(XfdashboardWindowConte
 	/* Release resources. It might be important to release them
 	 * in reverse order as they were created.
 	 */
-	clutter_x11_remove_filter(_xfdashboard_window_content_on_x_event, (gpointer)self);
-
 	clutter_x11_trap_x_errors();
 	{
 		if(priv->texture)
@@ -766,6 +1283,7 @@ static void _xfdashboard_window_content_release_resources(XfdashboardWindowConte
 #ifdef HAVE_XDAMAGE
 		if(priv->damage!=None)
 		{
+			_xfdashboard_window_content_unregister_damage(self);
 			XDamageDestroy(display, priv->damage);
 			XSync(display, False);
 			priv->damage=None;
@@ -779,6 +1297,8 @@ static void _xfdashboard_window_content_release_resources(XfdashboardWindowConte
 
 		if(priv->xWindowID!=None)
 		{
+			_xfdashboard_window_content_unregister_xwindow(self);
+
 #ifdef HAVE_XCOMPOSITE
 			if(_xfdashboard_window_content_have_composite_extension)
 			{
@@ -831,7 +1351,7 @@ static void _xfdashboard_window_content_suspend(XfdashboardWindowContent *self)
 	clutter_x11_trap_x_errors();
 	{
 		/* Suspend live updates from texture */
-		if(priv->texture && !priv->isFallback)
+		if(priv->texture && !priv->isFallback && !priv->isSnapshot)
 		{
 #ifdef HAVE_XDAMAGE
 			cogl_texture_pixmap_x11_set_damage_object(COGL_TEXTURE_PIXMAP_X11(priv->texture), 0, 0);
@@ -842,6 +1362,7 @@ static void _xfdashboard_window_content_suspend(XfdashboardWindowContent *self)
 #ifdef HAVE_XDAMAGE
 		if(priv->damage!=None)
 		{
+			_xfdashboard_window_content_unregister_damage(self);
 			XDamageDestroy(display, priv->damage);
 			XSync(display, False);
 			priv->damage=None;
@@ -1010,6 +1531,7 @@ static gboolean _xfdashboard_window_content_resume_on_idle(gpointer inUserData)
 			{
 				g_warning(_("Could not create damage for window '%s' - using still image of window"), xfdashboard_window_tracker_window_get_title(priv->window));
 			}
+				else _xfdashboard_window_content_register_damage(self);
 		}
 #endif
 
@@ -1032,6 +1554,13 @@ static gboolean _xfdashboard_window_content_resume_on_idle(gpointer inUserData)
 		/* Now we use the window as texture and not the fallback texture anymore */
 		priv->isFallback=FALSE;
 
+		/* Any snapshot of window is outdated now */
+		if(priv->isSnapshot)
+		{
+			_xfdashboard_window_content_snapshots_remove(priv->window);
+			priv->isSnapshot=FALSE;
+		}
+
 		/* Window is not suspended anymore */
 		if(priv->isSuspended!=FALSE)
 		{
@@ -1164,6 +1693,7 @@ static void _xfdashboard_window_content_resume(XfdashboardWindowContent *self)
 			{
 				g_warning(_("Could not create damage for window '%s' - using still image of window"), xfdashboard_window_tracker_window_get_title(priv->window));
 			}
+				else _xfdashboard_window_content_register_damage(self);
 		}
 #endif
 
@@ -1186,6 +1716,13 @@ static void _xfdashboard_window_content_resume(XfdashboardWindowContent *self)
 		/* Now we use the window as texture and not the fallback texture anymore */
 		priv->isFallback=FALSE;
 
+		/* Any snapshot of window is outdated now */
+		if(priv->isSnapshot)
+		{
+			_xfdashboard_window_content_snapshots_remove(priv->window);
+			priv->isSnapshot=FALSE;
+		}
+
 		/* Window is not suspended anymore */
 		if(priv->isSuspended!=FALSE)
 		{
@@ -1216,8 +1753,8 @@ static void _xfdashboard_window_content_resume(XfdashboardWindowContent *self)
 	g_debug("Resuming live texture updates for window '%s'", xfdashboard_window_tracker_window_get_title(priv->window));
 }
 
-/* Find X window for window frame of given X window content */
-static Window _xfdashboard_window_content_get_window_frame_xid(Display *inDisplay, XfdashboardWindowTrackerWindow *inWindow)
+/* Find X window for window frame of given X window content by querying X server */
+static Window _xfdashboard_window_content_query_window_frame_xid(Display *inDisplay, XfdashboardWindowTrackerWindow *inWindow)
 {
 	Window				xWindowID;
 	Window				iterXWindowID;
@@ -1285,6 +1822,47 @@ static Window _xfdashboard_window_content_get_window_frame_xid(Display *inDispla
 	return(foundXWindowID);
 }
 
+/* Find X window for window frame of given X window content. The result is
+ * cached per client X window and invalidated when the client X window gets
+ * reparented or destroyed so the X window tree is only queried once.
+ */
+static Window _xfdashboard_window_content_get_window_frame_xid(Display *inDisplay, XfdashboardWindowTrackerWindow *inWindow)
+{
+	Window				xWindowID;
+	Window				frameXWindowID;
+	gpointer			cachedXWindowID;
+
+	g_return_val_if_fail(inDisplay, 0);
+	g_return_val_if_fail(inWindow, 0);
+
+	/* Get X window */
+	xWindowID=xfdashboard_window_tracker_window_get_xid(inWindow);
+	g_return_val_if_fail(xWindowID!=0, 0);
+
+	/* Check if window frame of X window is cached already. A cached X window ID
+	 * of zero means that no window frame was found for this X window.
+	 */
+	if(_xfdashboard_window_content_frame_xwindow_cache &&
+		g_hash_table_lookup_extended(_xfdashboard_window_content_frame_xwindow_cache,
+										GUINT_TO_POINTER(xWindowID),
+										NULL,
+										&cachedXWindowID))
+	{
+		return((Window)GPOINTER_TO_UINT(cachedXWindowID));
+	}
+
+	/* Query X server for window frame and cache result */
+	frameXWindowID=_xfdashboard_window_content_query_window_frame_xid(inDisplay, inWindow);
+	if(_xfdashboard_window_content_frame_xwindow_cache)
+	{
+		g_hash_table_insert(_xfdashboard_window_content_frame_xwindow_cache,
+							GUINT_TO_POINTER(xWindowID),
+							GUINT_TO_POINTER(frameXWindowID));
+	}
+
+	return(frameXWindowID);
+}
+
 /* Set window to handle and to display */
 static void _xfdashboard_window_content_set_window(XfdashboardWindowContent *self, XfdashboardWindowTrackerWindow *inWindow)
 {
@@ -1395,6 +1973,22 @@ static void _xfdashboard_window_content_set_window(XfdashboardWindowContent *sel
 
 	/* We are interested in receiving mapping events of windows */
 	XSelectInput(display, priv->xWindowID, windowAttrs.your_event_mask | StructureNotifyMask);
+	_xfdashboard_window_content_register_xwindow(self);
+
+	/* If window frame is used we are also interested in receiving reparenting
+	 * events of client window to keep cached window frame valid.
+	 */
+	if(priv->xWindowID!=xfdashboard_window_tracker_window_get_xid(priv->window))
+	{
+		Window							clientXWindowID;
+		XWindowAttributes				clientWindowAttrs;
+
+		clientXWindowID=xfdashboard_window_tracker_window_get_xid(priv->window);
+		if(XGetWindowAttributes(display, clientXWindowID, &clientWindowAttrs))
+		{
+			XSelectInput(display, clientXWindowID, clientWindowAttrs.your_event_mask | StructureNotifyMask);
+		}
+	}
 
 	/* Acquire new window and handle live updates */
 	_xfdashboard_window_content_resume(self);
@@ -1422,6 +2016,21 @@ static void _xfdashboard_window_content_set_window(XfdashboardWindowContent *sel
 	/* Thaw notifications and send them now */
 	g_object_thaw_notify(G_OBJECT(self));
 
+	/* If window is not mapped show its last known content if a snapshot of
+	 * this window was taken before.
+	 */
+	if(priv->isFallback && priv->isSuspended)
+	{
+		CoglTexture						*snapshot;
+
+		snapshot=_xfdashboard_window_content_snapshots_lookup(priv->window);
+		if(snapshot)
+		{
+			_xfdashboard_window_content_set_snapshot(self, snapshot);
+			cogl_object_unref(snapshot);
+		}
+	}
+
 	/* Set up workaround mechanism for unmapped windows if wanted and needed */
 	_xfdashboard_window_content_setup_workaround(self, inWindow);
 }
@@ -1466,6 +2075,7 @@ static void _xfdashboard_window_content_destroy_cache(void)
 	g_debug("Destroying window content cache hashtable");
 	g_hash_table_destroy(_xfdashboard_window_content_cache);
 	_xfdashboard_window_content_cache=NULL;
+	xfdashboard_instrumentation_set(XFDASHBOARD_INSTRUMENTATION_COUNTER_WINDOW_CONTENTS, 0);
 }
 
 /* Create cache hashtable if not already set up */
@@ -1849,6 +2459,12 @@ static void _xfdashboard_window_content_dispose(GObject *inObject)
 	/* Dispose allocated resources */
 	_xfdashboard_window_content_release_resources(self);
 
+	if(priv->usesXEventFilter)
+	{
+		_xfdashboard_window_content_x_event_filter_unref();
+		priv->usesXEventFilter=FALSE;
+	}
+
 	if(priv->workaroundStateSignalID)
 	{
 		g_signal_handler_disconnect(priv->windowTracker, priv->workaroundStateSignalID);
@@ -1875,6 +2491,7 @@ static void _xfdashboard_window_content_dispose(GObject *inObject)
 					xfdashboard_window_tracker_window_get_title(priv->window),
 					G_OBJECT(self)->ref_count);
 		g_hash_table_remove(_xfdashboard_window_content_cache, priv->window);
+		xfdashboard_instrumentation_set(XFDASHBOARD_INSTRUMENTATION_COUNTER_WINDOW_CONTENTS, g_hash_table_size(_xfdashboard_window_content_cache));
 
 		/* Disconnect signals */
 		g_signal_handlers_disconnect_by_data(priv->window, self);
@@ -2195,6 +2812,7 @@ void xfdashboard_window_content_init(XfdashboardWindowContent *self)
 	priv->damage=None;
 #endif
 	priv->isFallback=FALSE;
+	priv->isSnapshot=FALSE;
 	priv->outlineColor=clutter_color_copy(CLUTTER_COLOR_Black);
 	priv->outlineWidth=1.0f;
 	priv->isSuspended=TRUE;
@@ -2218,8 +2836,9 @@ void xfdashboard_window_content_init(XfdashboardWindowContent *self)
 	/* Check extensions (will only be done once) */
 	_xfdashboard_window_content_check_extension();
 
-	/* Add event filter for this instance */
-	clutter_x11_add_filter(_xfdashboard_window_content_on_x_event, self);
+	/* Take reference on central X event dispatcher for all instances */
+	_xfdashboard_window_content_x_event_filter_ref();
+	priv->usesXEventFilter=TRUE;
 
 	/* Style content */
 	xfdashboard_stylable_invalidate(XFDASHBOARD_STYLABLE(self));
@@ -2296,6 +2915,7 @@ ClutterContent* xfdashboard_window_content_new_for_window(XfdashboardWindowTrack
 
 	/* Store new window content into cache */
 	g_hash_table_insert(_xfdashboard_window_content_cache, inWindow, content);
+	xfdashboard_instrumentation_set(XFDASHBOARD_INSTRUMENTATION_COUNTER_WINDOW_CONTENTS, g_hash_table_size(_xfdashboard_window_content_cache));
 	g_debug("Added window content for '%s' with ref-count %d" ,
 				xfdashboard_window_tracker_window_get_title(inWindow),
 				G_OBJECT(content)->ref_count);
@@ -0,0 +1,645 @@
+/*
+ * windows-search-provider: Search provider for searching open windows
+ * 
+ * Copyright 2012-2016 Stephan Haller <nomad@froevel.de>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ * 
+ * 
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <libxfdashboard/windows-search-provider.h>
+
+#include <glib/gi18n-lib.h>
+#include <gtk/gtk.h>
+#include <string.h>
+
+#include <libxfdashboard/application-tracker.h>
+#include <libxfdashboard/window-tracker.h>
+#include <libxfdashboard/button.h>
+#include <libxfdashboard/image-content.h>
+#include <libxfdashboard/compat.h>
+
+
+/* Define this class in GObject system */
+G_DEFINE_TYPE(XfdashboardWindowsSearchProvider,
+				xfdashboard_windows_search_provider,
+				XFDASHBOARD_TYPE_SEARCH_PROVIDER)
+
+/* Private structure - access only by public API if needed */
+#define XFDASHBOARD_WINDOWS_SEARCH_PROVIDER_GET_PRIVATE(obj) \
+	(G_TYPE_INSTANCE_GET_PRIVATE((obj), XFDASHBOARD_TYPE_WINDOWS_SEARCH_PROVIDER, XfdashboardWindowsSearchProviderPrivate))
+
+struct _XfdashboardWindowsSearchProviderPrivate
+{
+	/* Instance related */
+	XfdashboardWindowTracker			*windowTracker;
+	guint								windowOpenedID;
+	guint								windowClosedID;
+	guint								windowNameChangedID;
+
+	XfdashboardApplicationTracker		*appTracker;
+
+	GHashTable							*index;
+};
+
+/* IMPLEMENTATION: Private variables and methods */
+typedef struct _XfdashboardWindowsSearchProviderIndexEntry		XfdashboardWindowsSearchProviderIndexEntry;
+struct _XfdashboardWindowsSearchProviderIndexEntry
+{
+	XfdashboardWindowTrackerWindow		*window;
+
+	gchar								*title;
+	gchar								*instanceNames;
+	gchar								*appName;
+	gboolean							appNameResolved;
+};
+
+typedef struct _XfdashboardWindowsSearchProviderJob				XfdashboardWindowsSearchProviderJob;
+struct _XfdashboardWindowsSearchProviderJob
+{
+	XfdashboardSearchQuery				*query;
+	XfdashboardSearchResultSet			*previousResultSet;
+	XfdashboardSearchResultSet			*resultSet;
+};
+
+/* Free entry of search index */
+static void _xfdashboard_windows_search_provider_index_entry_free(XfdashboardWindowsSearchProviderIndexEntry *inEntry)
+{
+	g_return_if_fail(inEntry);
+
+	/* Release allocated resources */
+	if(inEntry->title) g_free(inEntry->title);
+	if(inEntry->instanceNames) g_free(inEntry->instanceNames);
+	if(inEntry->appName) g_free(inEntry->appName);
+	g_free(inEntry);
+}
+
+/* Update normalized title of window at entry of search index */
+static void _xfdashboard_windows_search_provider_index_entry_update_title(XfdashboardWindowsSearchProviderIndexEntry *inEntry)
+{
+	const gchar							*title;
+
+	g_return_if_fail(inEntry);
+
+	if(inEntry->title) g_free(inEntry->title);
+
+	title=xfdashboard_window_tracker_window_get_title(inEntry->window);
+	if(title) inEntry->title=xfdashboard_search_query_normalize_string(title);
+		else inEntry->title=NULL;
+}
+
+/* Resolve normalized name of application the window of entry of search index
+ * belongs to. The application tracker might not know the window when it was
+ * opened so it is tried again until it could be resolved.
+ */
+static void _xfdashboard_windows_search_provider_index_entry_resolve_app_name(XfdashboardWindowsSearchProvider *self,
+																				XfdashboardWindowsSearchProviderIndexEntry *inEntry)
+{
+	XfdashboardWindowsSearchProviderPrivate		*priv;
+	GAppInfo									*appInfo;
+	const gchar									*appName;
+
+	g_return_if_fail(XFDASHBOARD_IS_WINDOWS_SEARCH_PROVIDER(self));
+	g_return_if_fail(inEntry);
+
+	priv=self->priv;
+
+	/* Do nothing if application name was resolved already */
+	if(inEntry->appNameResolved) return;
+
+	/* Lookup application for window */
+	appInfo=xfdashboard_application_tracker_get_app_info_by_window(priv->appTracker, inEntry->window);
+	if(!appInfo) return;
+
+	appName=g_app_info_get_display_name(appInfo);
+	if(appName) inEntry->appName=xfdashboard_search_query_normalize_string(appName);
+	inEntry->appNameResolved=TRUE;
+
+	/* Release allocated resources */
+	g_object_unref(appInfo);
+}
+
+/* Add window to search index */
+static void _xfdashboard_windows_search_provider_on_window_opened(XfdashboardWindowsSearchProvider *self,
+																	XfdashboardWindowTrackerWindow *inWindow,
+																	gpointer inUserData)
+{
+	XfdashboardWindowsSearchProviderPrivate		*priv;
+	XfdashboardWindowsSearchProviderIndexEntry	*entry;
+	gchar										**names;
+
+	g_return_if_fail(XFDASHBOARD_IS_WINDOWS_SEARCH_PROVIDER(self));
+	g_return_if_fail(XFDASHBOARD_IS_WINDOW_TRACKER_WINDOW(inWindow));
+
+	priv=self->priv;
+
+	/* Do not index stage windows */
+	if(xfdashboard_window_tracker_window_is_stage(inWindow)) return;
+
+	/* Create entry for window */
+	entry=g_new0(XfdashboardWindowsSearchProviderIndexEntry, 1);
+	entry->window=inWindow;
+
+	_xfdashboard_windows_search_provider_index_entry_update_title(entry);
+
+	names=xfdashboard_window_tracker_window_get_instance_names(inWindow);
+	if(names)
+	{
+		gchar									*joinedNames;
+
+		joinedNames=g_strjoinv("\n", names);
+		entry->instanceNames=xfdashboard_search_query_normalize_string(joinedNames);
+		g_free(joinedNames);
+		g_strfreev(names);
+	}
+
+	_xfdashboard_windows_search_provider_index_entry_resolve_app_name(self, entry);
+
+	/* Add entry to search index and replace any existing one */
+	g_hash_table_insert(priv->index, GUINT_TO_POINTER(xfdashboard_window_tracker_window_get_xid(inWindow)), entry);
+}
+
+/* Remove window from search index */
+static void _xfdashboard_windows_search_provider_on_window_closed(XfdashboardWindowsSearchProvider *self,
+																	XfdashboardWindowTrackerWindow *inWindow,
+																	gpointer inUserData)
+{
+	XfdashboardWindowsSearchProviderPrivate		*priv;
+
+	g_return_if_fail(XFDASHBOARD_IS_WINDOWS_SEARCH_PROVIDER(self));
+	g_return_if_fail(XFDASHBOARD_IS_WINDOW_TRACKER_WINDOW(inWindow));
+
+	priv=self->priv;
+
+	g_hash_table_remove(priv->index, GUINT_TO_POINTER(xfdashboard_window_tracker_window_get_xid(inWindow)));
+}
+
+/* Update title of window in search index */
+static void _xfdashboard_windows_search_provider_on_window_name_changed(XfdashboardWindowsSearchProvider *self,
+																		XfdashboardWindowTrackerWindow *inWindow,
+																		gpointer inUserData)
+{
+	XfdashboardWindowsSearchProviderPrivate		*priv;
+	XfdashboardWindowsSearchProviderIndexEntry	*entry;
+
+	g_return_if_fail(XFDASHBOARD_IS_WINDOWS_SEARCH_PROVIDER(self));
+	g_return_if_fail(XFDASHBOARD_IS_WINDOW_TRACKER_WINDOW(inWindow));
+
+	priv=self->priv;
+
+	entry=g_hash_table_lookup(priv->index, GUINT_TO_POINTER(xfdashboard_window_tracker_window_get_xid(inWindow)));
+	if(entry) _xfdashboard_windows_search_provider_index_entry_update_title(entry);
+}
+
+/* Check if given entry of search index matches search terms and return score
+ * as fraction between 0.0 and 1.0 - so called "relevance". A negative score
+ * means that the given entry does not match at all.
+ */
+static gfloat _xfdashboard_windows_search_provider_score(XfdashboardWindowsSearchProvider *self,
+															XfdashboardSearchQuery *inQuery,
+															XfdashboardWindowsSearchProviderIndexEntry *inEntry)
+{
+	const gchar									**searchTerms;
+	gint										matchesFound, matchesExpected;
+	gfloat										pointsSearch;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_WINDOWS_SEARCH_PROVIDER(self), -1.0f);
+	g_return_val_if_fail(XFDASHBOARD_IS_SEARCH_QUERY(inQuery), -1.0f);
+	g_return_val_if_fail(inEntry, -1.0f);
+
+	/* Empty search term matches no window */
+	matchesExpected=xfdashboard_search_query_get_terms_count(inQuery);
+	if(matchesExpected==0) return(-1.0f);
+
+	searchTerms=xfdashboard_search_query_get_normalized_terms(inQuery);
+
+	/* Resolve application name if not done yet */
+	_xfdashboard_windows_search_provider_index_entry_resolve_app_name(self, inEntry);
+
+	/* Check each search term against title, application name and the
+	 * instance names of window. A matching title weights 0.6, a matching
+	 * application name 0.3 and a matching instance name 0.1.
+	 */
+	matchesFound=0;
+	pointsSearch=0.0f;
+	while(*searchTerms)
+	{
+		gboolean								termMatch;
+		gfloat									pointsTerm;
+
+		/* Reset "found" indicator and score of current search term */
+		termMatch=FALSE;
+		pointsTerm=0.0f;
+
+		/* Check for current search term */
+		if(inEntry->title && strstr(inEntry->title, *searchTerms))
+		{
+			pointsTerm+=0.6f;
+			termMatch=TRUE;
+		}
+
+		if(inEntry->appName && strstr(inEntry->appName, *searchTerms))
+		{
+			pointsTerm+=0.3f;
+			termMatch=TRUE;
+		}
+
+		if(inEntry->instanceNames && strstr(inEntry->instanceNames, *searchTerms))
+		{
+			pointsTerm+=0.1f;
+			termMatch=TRUE;
+		}
+
+		/* Increase match counter if we found a match */
+		if(termMatch)
+		{
+			matchesFound++;
+			pointsSearch+=pointsTerm;
+		}
+
+		/* Continue with next search term */
+		searchTerms++;
+	}
+
+	/* Return score if all search terms matched */
+	if(matchesFound<matchesExpected) return(-1.0f);
+
+	return(pointsSearch/matchesExpected);
+}
+
+/* Lookup window for result item */
+static XfdashboardWindowTrackerWindow* _xfdashboard_windows_search_provider_get_window(XfdashboardWindowsSearchProvider *self,
+																						GVariant *inResultItem)
+{
+	XfdashboardWindowsSearchProviderPrivate		*priv;
+	XfdashboardWindowsSearchProviderIndexEntry	*entry;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_WINDOWS_SEARCH_PROVIDER(self), NULL);
+	g_return_val_if_fail(inResultItem, NULL);
+
+	priv=self->priv;
+
+	entry=g_hash_table_lookup(priv->index, GUINT_TO_POINTER(g_variant_get_uint64(inResultItem)));
+	if(!entry) return(NULL);
+
+	return(entry->window);
+}
+
+/* IMPLEMENTATION: XfdashboardSearchProvider */
+
+/* One-time initialization of search provider */
+static void _xfdashboard_windows_search_provider_initialize(XfdashboardSearchProvider *inProvider)
+{
+	XfdashboardWindowsSearchProvider			*self;
+	XfdashboardWindowsSearchProviderPrivate		*priv;
+	GList										*windows;
+
+	g_return_if_fail(XFDASHBOARD_IS_WINDOWS_SEARCH_PROVIDER(inProvider));
+
+	self=XFDASHBOARD_WINDOWS_SEARCH_PROVIDER(inProvider);
+	priv=self->priv;
+
+	/* Build search index of all currently open windows once. It is kept up-to-date
+	 * by signals of window tracker afterwards.
+	 */
+	for(windows=xfdashboard_window_tracker_get_windows(priv->windowTracker); windows; windows=g_list_next(windows))
+	{
+		_xfdashboard_windows_search_provider_on_window_opened(self, XFDASHBOARD_WINDOW_TRACKER_WINDOW(windows->data), NULL);
+	}
+
+	priv->windowOpenedID=g_signal_connect_swapped(priv->windowTracker,
+													"window-opened",
+													G_CALLBACK(_xfdashboard_windows_search_provider_on_window_opened),
+													self);
+	priv->windowClosedID=g_signal_connect_swapped(priv->windowTracker,
+													"window-closed",
+													G_CALLBACK(_xfdashboard_windows_search_provider_on_window_closed),
+													self);
+	priv->windowNameChangedID=g_signal_connect_swapped(priv->windowTracker,
+														"window-name-changed",
+														G_CALLBACK(_xfdashboard_windows_search_provider_on_window_name_changed),
+														self);
+}
+
+/* Get display name for this search provider */
+static const gchar* _xfdashboard_windows_search_provider_get_name(XfdashboardSearchProvider *inProvider)
+{
+	return(_("Windows"));
+}
+
+/* Get icon-name for this search provider */
+static const gchar* _xfdashboard_windows_search_provider_get_icon(XfdashboardSearchProvider *inProvider)
+{
+	return("window-new");
+}
+
+/* Begin search job for requested search query */
+static gpointer _xfdashboard_windows_search_provider_begin_search_job(XfdashboardSearchProvider *inProvider,
+																		XfdashboardSearchQuery *inQuery,
+																		XfdashboardSearchResultSet *inPreviousResultSet,
+																		XfdashboardSearchResultSet *inResultSet)
+{
+	XfdashboardWindowsSearchProviderJob			*job;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_WINDOWS_SEARCH_PROVIDER(inProvider), NULL);
+	g_return_val_if_fail(XFDASHBOARD_IS_SEARCH_QUERY(inQuery), NULL);
+
+	/* If no search term is given, there is nothing to search for */
+	if(xfdashboard_search_query_get_terms_count(inQuery)==0) return(NULL);
+
+	/* Create job. The query provides search terms already normalized in the
+	 * same way as the strings stored in search index.
+	 */
+	job=g_new0(XfdashboardWindowsSearchProviderJob, 1);
+	job->query=g_object_ref(inQuery);
+	if(inPreviousResultSet) job->previousResultSet=g_object_ref(inPreviousResultSet);
+	job->resultSet=g_object_ref(inResultSet);
+
+	/* Return new job */
+	return(job);
+}
+
+/* Run search job. There are only a few windows so the search index is
+ * checked completely at once regardless of deadline.
+ */
+static gboolean _xfdashboard_windows_search_provider_run_search_job(XfdashboardSearchProvider *inProvider,
+																	gpointer inJob,
+																	gint64 inDeadline)
+{
+	XfdashboardWindowsSearchProvider			*self;
+	XfdashboardWindowsSearchProviderPrivate		*priv;
+	XfdashboardWindowsSearchProviderJob			*job;
+	GHashTableIter								iter;
+	gpointer									key;
+	XfdashboardWindowsSearchProviderIndexEntry	*entry;
+	GVariant									*resultItem;
+	gfloat										score;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_WINDOWS_SEARCH_PROVIDER(inProvider), FALSE);
+	g_return_val_if_fail(inJob, FALSE);
+
+	self=XFDASHBOARD_WINDOWS_SEARCH_PROVIDER(inProvider);
+	priv=self->priv;
+	job=(XfdashboardWindowsSearchProviderJob*)inJob;
+
+	/* Perform search on search index */
+	g_hash_table_iter_init(&iter, priv->index);
+	while(g_hash_table_iter_next(&iter, &key, (gpointer*)&entry))
+	{
+		/* Skip windows not shown in any tasklist or pager */
+		if(xfdashboard_window_tracker_window_is_skip_pager(entry->window) ||
+			xfdashboard_window_tracker_window_is_skip_tasklist(entry->window))
+		{
+			continue;
+		}
+
+		/* Check for a match against search terms */
+		score=_xfdashboard_windows_search_provider_score(self, job->query, entry);
+		if(score<0.0f) continue;
+
+		/* Get result item */
+		resultItem=g_variant_new_uint64(GPOINTER_TO_UINT(key));
+
+		/* Only add result item if there is no previous result set or if
+		 * it is in previous result set.
+		 */
+		if(!job->previousResultSet ||
+			xfdashboard_search_result_set_has_item(job->previousResultSet, resultItem))
+		{
+			xfdashboard_search_result_set_add_item(job->resultSet, g_variant_ref(resultItem));
+			xfdashboard_search_result_set_set_item_score(job->resultSet, resultItem, score);
+		}
+
+		/* Release allocated resources */
+		g_variant_unref(resultItem);
+	}
+
+	/* All entries in search index were checked so job is finished */
+	return(FALSE);
+}
+
+/* End search job and release its resources */
+static void _xfdashboard_windows_search_provider_end_search_job(XfdashboardSearchProvider *inProvider,
+																gpointer inJob)
+{
+	XfdashboardWindowsSearchProviderJob			*job;
+
+	g_return_if_fail(XFDASHBOARD_IS_WINDOWS_SEARCH_PROVIDER(inProvider));
+	g_return_if_fail(inJob);
+
+	job=(XfdashboardWindowsSearchProviderJob*)inJob;
+
+	/* Release allocated resources */
+	if(job->resultSet) g_object_unref(job->resultSet);
+	if(job->previousResultSet) g_object_unref(job->previousResultSet);
+	if(job->query) g_object_unref(job->query);
+	g_free(job);
+}
+
+/* Create actor for a result item of the result set returned from a search request */
+static ClutterActor* _xfdashboard_windows_search_provider_create_result_actor(XfdashboardSearchProvider *inProvider,
+																				GVariant *inResultItem)
+{
+	XfdashboardWindowsSearchProvider			*self;
+	XfdashboardWindowsSearchProviderPrivate		*priv;
+	XfdashboardWindowTrackerWindow				*window;
+	ClutterActor								*actor;
+	GAppInfo									*appInfo;
+	GdkPixbuf									*windowIcon;
+	ClutterContent								*iconImage;
+	gchar										*buttonText;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_WINDOWS_SEARCH_PROVIDER(inProvider), NULL);
+	g_return_val_if_fail(inResultItem, NULL);
+
+	self=XFDASHBOARD_WINDOWS_SEARCH_PROVIDER(inProvider);
+	priv=self->priv;
+
+	/* Get window for result item */
+	window=_xfdashboard_windows_search_provider_get_window(self, inResultItem);
+	if(!window)
+	{
+		g_warning(_("Cannot create actor for window ID '%lu' in result set of %s"),
+					(gulong)g_variant_get_uint64(inResultItem),
+					G_OBJECT_TYPE_NAME(inProvider));
+		return(NULL);
+	}
+
+	/* Build text to show at button */
+	appInfo=xfdashboard_application_tracker_get_app_info_by_window(priv->appTracker, window);
+	if(appInfo)
+	{
+		buttonText=g_markup_printf_escaped("<b>%s</b>\n\n%s",
+											xfdashboard_window_tracker_window_get_title(window),
+											g_app_info_get_display_name(appInfo));
+		g_object_unref(appInfo);
+	}
+		else buttonText=g_markup_printf_escaped("<b>%s</b>", xfdashboard_window_tracker_window_get_title(window));
+
+	/* Create actor for result item */
+	actor=xfdashboard_button_new_with_text(buttonText);
+
+	windowIcon=xfdashboard_window_tracker_window_get_icon(window);
+	if(windowIcon)
+	{
+		iconImage=xfdashboard_image_content_new_for_pixbuf(windowIcon);
+		xfdashboard_button_set_style(XFDASHBOARD_BUTTON(actor), XFDASHBOARD_BUTTON_STYLE_BOTH);
+		xfdashboard_button_set_icon_image(XFDASHBOARD_BUTTON(actor), CLUTTER_IMAGE(iconImage));
+		g_object_unref(iconImage);
+	}
+
+	clutter_actor_show(actor);
+
+	/* Release allocated resources */
+	g_free(buttonText);
+
+	/* Return created actor */
+	return(actor);
+}
+
+/* Activate result item by focussing window */
+static gboolean _xfdashboard_windows_search_provider_activate_result(XfdashboardSearchProvider* inProvider,
+																		GVariant *inResultItem,
+																		ClutterActor *inActor,
+																		const gchar **inSearchTerms)
+{
+	XfdashboardWindowsSearchProvider			*self;
+	XfdashboardWindowsSearchProviderPrivate		*priv;
+	XfdashboardWindowTrackerWindow				*window;
+	XfdashboardWindowTrackerWorkspace			*activeWorkspace;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_WINDOWS_SEARCH_PROVIDER(inProvider), FALSE);
+	g_return_val_if_fail(inResultItem, FALSE);
+
+	self=XFDASHBOARD_WINDOWS_SEARCH_PROVIDER(inProvider);
+	priv=self->priv;
+
+	/* Get window for result item */
+	window=_xfdashboard_windows_search_provider_get_window(self, inResultItem);
+	if(!window) return(FALSE);
+
+	/* Move to workspace if window to active is on a different one than the active one */
+	activeWorkspace=xfdashboard_window_tracker_get_active_workspace(priv->windowTracker);
+	if(!xfdashboard_window_tracker_window_is_on_workspace(window, activeWorkspace))
+	{
+		xfdashboard_window_tracker_workspace_activate(xfdashboard_window_tracker_window_get_workspace(window));
+	}
+
+	/* Activate window */
+	xfdashboard_window_tracker_window_activate(window);
+
+	return(TRUE);
+}
+
+/* IMPLEMENTATION: GObject */
+
+/* Dispose this object */
+static void _xfdashboard_windows_search_provider_dispose(GObject *inObject)
+{
+	XfdashboardWindowsSearchProvider			*self=XFDASHBOARD_WINDOWS_SEARCH_PROVIDER(inObject);
+	XfdashboardWindowsSearchProviderPrivate		*priv=self->priv;
+
+	/* Release allocated resouces */
+	if(priv->windowTracker)
+	{
+		if(priv->windowOpenedID)
+		{
+			g_signal_handler_disconnect(priv->windowTracker, priv->windowOpenedID);
+			priv->windowOpenedID=0;
+		}
+
+		if(priv->windowClosedID)
+		{
+			g_signal_handler_disconnect(priv->windowTracker, priv->windowClosedID);
+			priv->windowClosedID=0;
+		}
+
+		if(priv->windowNameChangedID)
+		{
+			g_signal_handler_disconnect(priv->windowTracker, priv->windowNameChangedID);
+			priv->windowNameChangedID=0;
+		}
+
+		g_object_unref(priv->windowTracker);
+		priv->windowTracker=NULL;
+	}
+
+	if(priv->appTracker)
+	{
+		g_object_unref(priv->appTracker);
+		priv->appTracker=NULL;
+	}
+
+	if(priv->index)
+	{
+		g_hash_table_destroy(priv->index);
+		priv->index=NULL;
+	}
+
+	/* Call parent's class dispose method */
+	G_OBJECT_CLASS(xfdashboard_windows_search_provider_parent_class)->dispose(inObject);
+}
+
+/* Class initialization
+ * Override functions in parent classes and define properties
+ * and signals
+ */
+static void xfdashboard_windows_search_provider_class_init(XfdashboardWindowsSearchProviderClass *klass)
+{
+	XfdashboardSearchProviderClass		*providerClass=XFDASHBOARD_SEARCH_PROVIDER_CLASS(klass);
+	GObjectClass						*gobjectClass=G_OBJECT_CLASS(klass);
+
+	/* Override functions */
+	gobjectClass->dispose=_xfdashboard_windows_search_provider_dispose;
+
+	providerClass->initialize=_xfdashboard_windows_search_provider_initialize;
+	providerClass->get_name=_xfdashboard_windows_search_provider_get_name;
+	providerClass->get_icon=_xfdashboard_windows_search_provider_get_icon;
+	providerClass->begin_search_job=_xfdashboard_windows_search_provider_begin_search_job;
+	providerClass->run_search_job=_xfdashboard_windows_search_provider_run_search_job;
+	providerClass->end_search_job=_xfdashboard_windows_search_provider_end_search_job;
+	providerClass->create_result_actor=_xfdashboard_windows_search_provider_create_result_actor;
+	providerClass->activate_result=_xfdashboard_windows_search_provider_activate_result;
+
+	/* Set up private structure */
+	g_type_class_add_private(klass, sizeof(XfdashboardWindowsSearchProviderPrivate));
+}
+
+/* Object initialization
+ * Create private structure and set up default values
+ */
+static void xfdashboard_windows_search_provider_init(XfdashboardWindowsSearchProvider *self)
+{
+	XfdashboardWindowsSearchProviderPrivate		*priv;
+
+	self->priv=priv=XFDASHBOARD_WINDOWS_SEARCH_PROVIDER_GET_PRIVATE(self);
+
+	/* Set up default values */
+	priv->windowTracker=xfdashboard_window_tracker_get_default();
+	priv->windowOpenedID=0;
+	priv->windowClosedID=0;
+	priv->windowNameChangedID=0;
+	priv->appTracker=xfdashboard_application_tracker_get_default();
+	priv->index=g_hash_table_new_full(g_direct_hash,
+										g_direct_equal,
+										NULL,
+										(GDestroyNotify)_xfdashboard_windows_search_provider_index_entry_free);
+}
@@ -0,0 +1,73 @@
+/*
+ * windows-search-provider: Search provider for searching open windows
+ * 
+ * Copyright 2012-2016 Stephan Haller <nomad@froevel.de>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ * 
+ * 
+ */
+
+#ifndef __LIBXFDASHBOARD_WINDOWS_SEARCH_PROVIDER__
+#define __LIBXFDASHBOARD_WINDOWS_SEARCH_PROVIDER__
+
+#if !defined(__LIBXFDASHBOARD_H_INSIDE__) && !defined(LIBXFDASHBOARD_COMPILATION)
+#error "Only <libxfdashboard/libxfdashboard.h> can be included directly."
+#endif
+
+#include <libxfdashboard/search-provider.h>
+
+G_BEGIN_DECLS
+
+/* Object declaration */
+#define XFDASHBOARD_TYPE_WINDOWS_SEARCH_PROVIDER				(xfdashboard_windows_search_provider_get_type())
+#define XFDASHBOARD_WINDOWS_SEARCH_PROVIDER(obj)				(G_TYPE_CHECK_INSTANCE_CAST((obj), XFDASHBOARD_TYPE_WINDOWS_SEARCH_PROVIDER, XfdashboardWindowsSearchProvider))
+#define XFDASHBOARD_IS_WINDOWS_SEARCH_PROVIDER(obj)				(G_TYPE_CHECK_INSTANCE_TYPE((obj), XFDASHBOARD_TYPE_WINDOWS_SEARCH_PROVIDER))
+#define XFDASHBOARD_WINDOWS_SEARCH_PROVIDER_CLASS(klass)		(G_TYPE_CHECK_CLASS_CAST((klass), XFDASHBOARD_TYPE_WINDOWS_SEARCH_PROVIDER, XfdashboardWindowsSearchProviderClass))
+#define XFDASHBOARD_IS_WINDOWS_SEARCH_PROVIDER_CLASS(klass)		(G_TYPE_CHECK_CLASS_TYPE((klass), XFDASHBOARD_TYPE_WINDOWS_SEARCH_PROVIDER))
+#define XFDASHBOARD_WINDOWS_SEARCH_PROVIDER_GET_CLASS(obj)		(G_TYPE_INSTANCE_GET_CLASS((obj), XFDASHBOARD_TYPE_WINDOWS_SEARCH_PROVIDER, XfdashboardWindowsSearchProviderClass))
+
+typedef struct _XfdashboardWindowsSearchProvider				XfdashboardWindowsSearchProvider; 
+typedef struct _XfdashboardWindowsSearchProviderPrivate			XfdashboardWindowsSearchProviderPrivate;
+typedef struct _XfdashboardWindowsSearchProviderClass			XfdashboardWindowsSearchProviderClass;
+
+struct _XfdashboardWindowsSearchProvider
+{
+	/*< private >*/
+	/* Parent instance */
+	XfdashboardSearchProvider					parent_instance;
+
+	/* Private structure */
+	XfdashboardWindowsSearchProviderPrivate		*priv;
+};
+
+struct _XfdashboardWindowsSearchProviderClass
+{
+	/*< private >*/
+	/* Parent class */
+	XfdashboardSearchProviderClass				parent_class;
+
+	/*< public >*/
+	/* Virtual functions */
+};
+
+
+/* Public API */
+GType xfdashboard_windows_search_provider_get_type(void) G_GNUC_CONST;
+
+G_END_DECLS
+
+#endif	/* __LIBXFDASHBOARD_WINDOWS_SEARCH_PROVIDER__ */
@@ -66,6 +66,7 @@ struct _XfdashboardWorkspaceSelectorPrivate
 	gfloat								maxFraction;
 	gboolean							usingFraction;
 	gboolean							showCurrentMonitorOnly;
+	guint								cacheRefreshInterval;
 
 	/* Instance related */
 	XfdashboardWindowTracker			*windowTracker;
@@ -87,6 +88,8 @@ enum
 
 	PROP_SHOW_CURRENT_MONITOR_ONLY,
 
+	PROP_CACHE_REFRESH_INTERVAL,
+
 	PROP_LAST
 };
 
@@ -437,6 +440,7 @@ static void _xfdashboard_workspace_selector_on_workspace_added(XfdashboardWorksp
 		/* Set monitor at newly created live workspace actor */
 		xfdashboard_live_workspace_set_monitor(XFDASHBOARD_LIVE_WORKSPACE(actor), monitor);
 	}
+	xfdashboard_live_workspace_set_cache_refresh_interval(XFDASHBOARD_LIVE_WORKSPACE(actor), priv->cacheRefreshInterval);
 	g_signal_connect_swapped(actor, "clicked", G_CALLBACK(_xfdashboard_workspace_selector_on_workspace_clicked), self);
 	clutter_actor_insert_child_at_index(CLUTTER_ACTOR(self), actor, index);
 
@@ -1168,6 +1172,10 @@ static void _xfdashboard_workspace_selector_set_property(GObject *inObject,
 			xfdashboard_workspace_selector_set_show_current_monitor_only(self, g_value_get_boolean(inValue));
 			break;
 
+		case PROP_CACHE_REFRESH_INTERVAL:
+			xfdashboard_workspace_selector_set_cache_refresh_interval(self, g_value_get_uint(inValue));
+			break;
+
 		default:
 			G_OBJECT_WARN_INVALID_PROPERTY_ID(inObject, inPropID, inSpec);
 			break;
@@ -1208,6 +1216,10 @@ static void _xfdashboard_workspace_selector_get_property(GObject *inObject,
 			g_value_set_boolean(outValue, priv->showCurrentMonitorOnly);
 			break;
 
+		case PROP_CACHE_REFRESH_INTERVAL:
+			g_value_set_uint(outValue, priv->cacheRefreshInterval);
+			break;
+
 		default:
 			G_OBJECT_WARN_INVALID_PROPERTY_ID(inObject, inPropID, inSpec);
 			break;
@@ -1283,6 +1295,14 @@ static void xfdashboard_workspace_selector_class_init(XfdashboardWorkspaceSelect
 								FALSE,
 								G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
 
+	XfdashboardWorkspaceSelectorProperties[PROP_CACHE_REFRESH_INTERVAL]=
+		g_param_spec_uint("cache-refresh-interval",
+							_("Cache refresh interval"),
+							_("Interval in milliseconds at which workspaces are re-rendered into their cached textures on changes. If zero workspaces are drawn live"),
+							0, G_MAXUINT,
+							0,
+							G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS);
+
 	g_object_class_install_properties(gobjectClass, PROP_LAST, XfdashboardWorkspaceSelectorProperties);
 
 	/* Define stylable properties */
@@ -1290,6 +1310,7 @@ static void xfdashboard_workspace_selector_class_init(XfdashboardWorkspaceSelect
 	xfdashboard_actor_install_stylable_property(actorClass, XfdashboardWorkspaceSelectorProperties[PROP_ORIENTATION]);
 	xfdashboard_actor_install_stylable_property(actorClass, XfdashboardWorkspaceSelectorProperties[PROP_MAX_SIZE]);
 	xfdashboard_actor_install_stylable_property(actorClass, XfdashboardWorkspaceSelectorProperties[PROP_MAX_FRACTION]);
+	xfdashboard_actor_install_stylable_property(actorClass, XfdashboardWorkspaceSelectorProperties[PROP_CACHE_REFRESH_INTERVAL]);
 }
 
 /* Object initialization
@@ -1313,6 +1334,7 @@ static void xfdashboard_workspace_selector_init(XfdashboardWorkspaceSelector *se
 	priv->maxFraction=DEFAULT_MAX_FRACTION;
 	priv->usingFraction=DEFAULT_USING_FRACTION;
 	priv->showCurrentMonitorOnly=FALSE;
+	priv->cacheRefreshInterval=0;
 
 	/* Set up this actor */
 	clutter_actor_set_reactive(CLUTTER_ACTOR(self), TRUE);
@@ -1598,3 +1620,42 @@ void xfdashboard_workspace_selector_set_show_current_monitor_only(XfdashboardWor
 		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardWorkspaceSelectorProperties[PROP_SHOW_CURRENT_MONITOR_ONLY]);
 	}
 }
+
+/* Get/set interval at which workspaces are re-rendered into cached textures */
+guint xfdashboard_workspace_selector_get_cache_refresh_interval(XfdashboardWorkspaceSelector *self)
+{
+	g_return_val_if_fail(XFDASHBOARD_IS_WORKSPACE_SELECTOR(self), 0);
+
+	return(self->priv->cacheRefreshInterval);
+}
+
+void xfdashboard_workspace_selector_set_cache_refresh_interval(XfdashboardWorkspaceSelector *self, guint inInterval)
+{
+	XfdashboardWorkspaceSelectorPrivate		*priv;
+	ClutterActorIter						iter;
+	ClutterActor							*child;
+
+	g_return_if_fail(XFDASHBOARD_IS_WORKSPACE_SELECTOR(self));
+
+	priv=self->priv;
+
+	/* Set value if changed */
+	if(priv->cacheRefreshInterval!=inInterval)
+	{
+		/* Set value */
+		priv->cacheRefreshInterval=inInterval;
+
+		/* Iterate through workspace actors and update refresh interval */
+		clutter_actor_iter_init(&iter, CLUTTER_ACTOR(self));
+		while(clutter_actor_iter_next(&iter, &child))
+		{
+			if(XFDASHBOARD_IS_LIVE_WORKSPACE(child))
+			{
+				xfdashboard_live_workspace_set_cache_refresh_interval(XFDASHBOARD_LIVE_WORKSPACE(child), priv->cacheRefreshInterval);
+			}
+		}
+
+		/* Notify about property change */
+		g_object_notify_by_pspec(G_OBJECT(self), XfdashboardWorkspaceSelectorProperties[PROP_CACHE_REFRESH_INTERVAL]);
+	}
+}
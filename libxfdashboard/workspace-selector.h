@@ -86,6 +86,9 @@ gboolean xfdashboard_workspace_selector_is_using_fraction(XfdashboardWorkspaceSe
 gboolean xfdashboard_workspace_selector_get_show_current_monitor_only(XfdashboardWorkspaceSelector *self);
 void xfdashboard_workspace_selector_set_show_current_monitor_only(XfdashboardWorkspaceSelector *self, gboolean inShowCurrentMonitorOnly);
 
+guint xfdashboard_workspace_selector_get_cache_refresh_interval(XfdashboardWorkspaceSelector *self);
+void xfdashboard_workspace_selector_set_cache_refresh_interval(XfdashboardWorkspaceSelector *self, guint inInterval);
+
 G_END_DECLS
 
 #endif	/* __LIBXFDASHBOARD_WORKSPACE_SELECTOR__ */
@@ -0,0 +1,880 @@
+/*
+ * file-search-index: Memory-mapped index of file names in configured
+ *                    directories
+ * 
+ * Copyright 2012-2016 Stephan Haller <nomad@froevel.de>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ * 
+ * 
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "file-search-index.h"
+
+#include <libxfdashboard/libxfdashboard.h>
+#include <glib/gi18n-lib.h>
+#include <glib/gstdio.h>
+#include <gio/gio.h>
+#include <string.h>
+#include <sys/stat.h>
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif
+
+
+/* IMPLEMENTATION: Private variables and methods */
+
+/* The index file starts with a magic followed by the number of paths stored.
+ * Paths are sorted and front-coded, i.e. each entry consists of the number of
+ * bytes shared with previous path and the remaining suffix, both lengths
+ * stored as variable-length integers. Each entry is followed by the length
+ * and bytes of its base name normalized like search terms, so matching does
+ * not need to normalize base names at each search.
+ */
+#define XFDASHBOARD_FILE_SEARCH_INDEX_MAGIC				"XFDFSI02"
+#define XFDASHBOARD_FILE_SEARCH_INDEX_MAGIC_LENGTH		8
+#define XFDASHBOARD_FILE_SEARCH_INDEX_HEADER_LENGTH		(XFDASHBOARD_FILE_SEARCH_INDEX_MAGIC_LENGTH+sizeof(guint32))
+
+/* Delay before rebuilding index after a new directory was created */
+#define XFDASHBOARD_FILE_SEARCH_INDEX_REBUILD_DELAY		60
+
+/* Number of entries checked by a query between checks of its deadline */
+#define XFDASHBOARD_FILE_SEARCH_INDEX_DEADLINE_CHECK_INTERVAL	256
+
+struct _XfdashboardFileSearchIndex
+{
+	gint								refCount;
+
+	/* Settings */
+	gchar								*filename;
+	gchar								**directories;
+	gboolean							includeHidden;
+	guint								rebuildInterval;
+
+	/* Memory-mapped index */
+	GMappedFile							*mappedFile;
+	const guint8						*data;
+	gsize								size;
+	guint32								count;
+
+	/* Changes seen by file monitors since index was built */
+	GHashTable							*addedPaths;
+	GHashTable							*removedPaths;
+	GList								*monitors;
+
+	/* Background rebuild and the changes seen before it started. Only these
+	 * changes are contained in rebuilt index and can be forgotten when it
+	 * finished. A path changed again while rebuilding is removed from them.
+	 */
+	GThread								*thread;
+	GHashTable							*rebuildAddedPaths;
+	GHashTable							*rebuildRemovedPaths;
+	gint								cancelled;
+	GMutex								lock;
+	guint								rebuildDoneSourceID;
+	guint								rebuildDelaySourceID;
+	guint								rebuildIntervalSourceID;
+};
+
+struct _XfdashboardFileSearchIndexQuery
+{
+	XfdashboardFileSearchIndex			*index;
+
+	/* Normalized search terms */
+	gchar								**terms;
+	gsize								*termsLength;
+	guint								maxResults;
+	guint								resultsCount;
+
+	/* Position in memory-mapped index. The mapped file is referenced so the
+	 * query can continue even if index is rebuilt and remapped meanwhile.
+	 */
+	gboolean							addedPathsChecked;
+	GMappedFile							*mappedFile;
+	const guint8						*data;
+	const guint8						*dataEnd;
+	guint32								remaining;
+	GString								*path;
+};
+
+/* Single instance of index shared by plugin and search providers */
+static XfdashboardFileSearchIndex*		_xfdashboard_file_search_index_default=NULL;
+
+/* Check if needle is contained in haystack byte-wise */
+static gboolean _xfdashboard_file_search_index_contains(const gchar *inHaystack,
+														gsize inHaystackLength,
+														const gchar *inNeedle,
+														gsize inNeedleLength)
+{
+	const gchar							*iter;
+	const gchar							*last;
+
+	if(inNeedleLength==0) return(TRUE);
+	if(inNeedleLength>inHaystackLength) return(FALSE);
+
+	last=inHaystack+(inHaystackLength-inNeedleLength);
+	for(iter=inHaystack; iter<=last; iter++)
+	{
+		iter=memchr(iter, *inNeedle, (last-iter)+1);
+		if(!iter) return(FALSE);
+
+		if(memcmp(iter, inNeedle, inNeedleLength)==0) return(TRUE);
+	}
+
+	return(FALSE);
+}
+
+/* Check if normalized base name matches all normalized search terms of query */
+static gboolean _xfdashboard_file_search_index_matches(XfdashboardFileSearchIndexQuery *inQuery,
+														const gchar *inKey,
+														gsize inKeyLength)
+{
+	guint								i;
+
+	for(i=0; inQuery->terms[i]; i++)
+	{
+		if(!_xfdashboard_file_search_index_contains(inKey, inKeyLength, inQuery->terms[i], inQuery->termsLength[i]))
+		{
+			return(FALSE);
+		}
+	}
+
+	return(TRUE);
+}
+
+/* Get base name of path normalized like search terms */
+static gchar* _xfdashboard_file_search_index_get_key(const gchar *inPath)
+{
+	const gchar							*basename;
+
+	basename=strrchr(inPath, G_DIR_SEPARATOR);
+	if(basename) basename++;
+		else basename=inPath;
+
+	return(xfdashboard_search_query_normalize_string(basename));
+}
+
+/* Read/write variable-length integer */
+static gboolean _xfdashboard_file_search_index_read_varint(const guint8 **ioData,
+															const guint8 *inDataEnd,
+															gsize *outValue)
+{
+	gsize								value;
+	guint								shift;
+
+	value=0;
+	shift=0;
+	while(*ioData<inDataEnd && shift<sizeof(gsize)*8)
+	{
+		guint8							byte;
+
+		byte=**ioData;
+		(*ioData)++;
+
+		value|=((gsize)(byte & 0x7f)) << shift;
+		if(!(byte & 0x80))
+		{
+			*outValue=value;
+			return(TRUE);
+		}
+
+		shift+=7;
+	}
+
+	return(FALSE);
+}
+
+static void _xfdashboard_file_search_index_write_varint(GString *ioData, gsize inValue)
+{
+	while(inValue>=0x80)
+	{
+		g_string_append_c(ioData, (gchar)((inValue & 0x7f) | 0x80));
+		inValue>>=7;
+	}
+	g_string_append_c(ioData, (gchar)inValue);
+}
+
+/* Release memory-mapped index */
+static void _xfdashboard_file_search_index_unmap(XfdashboardFileSearchIndex *self)
+{
+	g_return_if_fail(self);
+
+	if(self->mappedFile)
+	{
+		g_mapped_file_unref(self->mappedFile);
+		self->mappedFile=NULL;
+	}
+
+	self->data=NULL;
+	self->size=0;
+	self->count=0;
+}
+
+/* Map index file into memory */
+static void _xfdashboard_file_search_index_map(XfdashboardFileSearchIndex *self)
+{
+	GError								*error;
+
+	g_return_if_fail(self);
+
+	error=NULL;
+
+	/* Release currently mapped index */
+	_xfdashboard_file_search_index_unmap(self);
+
+	/* Map index file if it exists */
+	if(!g_file_test(self->filename, G_FILE_TEST_IS_REGULAR)) return;
+
+	self->mappedFile=g_mapped_file_new(self->filename, FALSE, &error);
+	if(!self->mappedFile)
+	{
+		g_warning(_("Could not map file search index '%s': %s"),
+					self->filename,
+					(error && error->message) ? error->message : _("Unknown error"));
+		if(error) g_error_free(error);
+		return;
+	}
+
+	self->data=(const guint8*)g_mapped_file_get_contents(self->mappedFile);
+	self->size=g_mapped_file_get_length(self->mappedFile);
+
+	/* Check header of index */
+	if(self->size<XFDASHBOARD_FILE_SEARCH_INDEX_HEADER_LENGTH ||
+		memcmp(self->data, XFDASHBOARD_FILE_SEARCH_INDEX_MAGIC, XFDASHBOARD_FILE_SEARCH_INDEX_MAGIC_LENGTH)!=0)
+	{
+		g_warning(_("Ignoring invalid file search index '%s'"), self->filename);
+		_xfdashboard_file_search_index_unmap(self);
+		return;
+	}
+
+	memcpy(&self->count, self->data+XFDASHBOARD_FILE_SEARCH_INDEX_MAGIC_LENGTH, sizeof(guint32));
+	g_debug("Mapped file search index '%s' with %u paths in %lu bytes",
+				self->filename,
+				self->count,
+				(gulong)self->size);
+}
+
+/* Collect all paths below directory without following symbolic links */
+static void _xfdashboard_file_search_index_collect(XfdashboardFileSearchIndex *self,
+													const gchar *inDirectory,
+													GPtrArray *ioPaths)
+{
+	GQueue								directories=G_QUEUE_INIT;
+	gchar								*directory;
+
+	g_queue_push_tail(&directories, g_strdup(inDirectory));
+	while((directory=g_queue_pop_head(&directories)))
+	{
+		GDir							*dir;
+		const gchar						*name;
+
+		/* Stop if rebuild was cancelled */
+		if(g_atomic_int_get(&self->cancelled))
+		{
+			g_free(directory);
+			continue;
+		}
+
+		dir=g_dir_open(directory, 0, NULL);
+		if(dir)
+		{
+			while((name=g_dir_read_name(dir)))
+			{
+				gchar					*path;
+				GStatBuf				statBuffer;
+
+				/* Skip hidden files and directories if not wanted */
+				if(!self->includeHidden && *name=='.') continue;
+
+				path=g_build_filename(directory, name, NULL);
+				g_ptr_array_add(ioPaths, path);
+
+				/* Descend into real directories only */
+				if(g_lstat(path, &statBuffer)==0 && S_ISDIR(statBuffer.st_mode))
+				{
+					g_queue_push_tail(&directories, g_strdup(path));
+				}
+			}
+
+			g_dir_close(dir);
+		}
+
+		g_free(directory);
+	}
+}
+
+/* Compare paths for sorting */
+static gint _xfdashboard_file_search_index_compare_paths(gconstpointer inLeft, gconstpointer inRight)
+{
+	return(strcmp(*((const gchar**)inLeft), *((const gchar**)inRight)));
+}
+
+/* Rebuild has finished so map new index and forget changes it contains */
+static gboolean _xfdashboard_file_search_index_on_rebuild_done(gpointer inUserData)
+{
+	XfdashboardFileSearchIndex			*self;
+	GHashTableIter						iter;
+	const gchar							*path;
+
+	self=(XfdashboardFileSearchIndex*)inUserData;
+
+	g_mutex_lock(&self->lock);
+	self->rebuildDoneSourceID=0;
+	g_mutex_unlock(&self->lock);
+
+	if(self->thread)
+	{
+		g_thread_join(self->thread);
+		self->thread=NULL;
+	}
+
+	_xfdashboard_file_search_index_map(self);
+
+	g_hash_table_iter_init(&iter, self->rebuildAddedPaths);
+	while(g_hash_table_iter_next(&iter, (gpointer*)&path, NULL))
+	{
+		g_hash_table_remove(self->addedPaths, path);
+	}
+
+	g_hash_table_iter_init(&iter, self->rebuildRemovedPaths);
+	while(g_hash_table_iter_next(&iter, (gpointer*)&path, NULL))
+	{
+		g_hash_table_remove(self->removedPaths, path);
+	}
+
+	g_hash_table_destroy(self->rebuildAddedPaths);
+	self->rebuildAddedPaths=NULL;
+	g_hash_table_destroy(self->rebuildRemovedPaths);
+	self->rebuildRemovedPaths=NULL;
+
+	return(G_SOURCE_REMOVE);
+}
+
+/* Thread function to rebuild index */
+static gpointer _xfdashboard_file_search_index_rebuild_thread(gpointer inUserData)
+{
+	XfdashboardFileSearchIndex			*self;
+	GPtrArray							*paths;
+	GString								*data;
+	gchar								**iter;
+	const gchar							*previousPath;
+	guint32								count;
+	guint								i;
+	GError								*error;
+
+	self=(XfdashboardFileSearchIndex*)inUserData;
+	error=NULL;
+
+#if defined(HAVE_SETPRIORITY) && defined(HAVE_SYS_RESOURCE_H)
+	/* Lower priority of this thread. On Linux the nice value set here only
+	 * applies to the calling thread.
+	 */
+	setpriority(PRIO_PROCESS, 0, 19);
+#endif
+
+	/* Collect and sort all paths */
+	paths=g_ptr_array_new_with_free_func(g_free);
+	for(iter=self->directories; iter && *iter; iter++)
+	{
+		_xfdashboard_file_search_index_collect(self, *iter, paths);
+	}
+	g_ptr_array_sort(paths, _xfdashboard_file_search_index_compare_paths);
+
+	if(g_atomic_int_get(&self->cancelled))
+	{
+		g_ptr_array_free(paths, TRUE);
+		return(NULL);
+	}
+
+	/* Build front-coded index */
+	count=paths->len;
+	data=g_string_sized_new(XFDASHBOARD_FILE_SEARCH_INDEX_HEADER_LENGTH+paths->len*16);
+	g_string_append_len(data, XFDASHBOARD_FILE_SEARCH_INDEX_MAGIC, XFDASHBOARD_FILE_SEARCH_INDEX_MAGIC_LENGTH);
+	g_string_append_len(data, (const gchar*)&count, sizeof(guint32));
+
+	previousPath="";
+	for(i=0; i<paths->len; i++)
+	{
+		const gchar						*path;
+		gsize							prefixLength;
+		gsize							pathLength;
+		gchar							*key;
+		gsize							keyLength;
+
+		path=(const gchar*)g_ptr_array_index(paths, i);
+		pathLength=strlen(path);
+
+		for(prefixLength=0; path[prefixLength] && path[prefixLength]==previousPath[prefixLength]; prefixLength++);
+
+		_xfdashboard_file_search_index_write_varint(data, prefixLength);
+		_xfdashboard_file_search_index_write_varint(data, pathLength-prefixLength);
+		g_string_append_len(data, path+prefixLength, pathLength-prefixLength);
+
+		key=_xfdashboard_file_search_index_get_key(path);
+		keyLength=strlen(key);
+		_xfdashboard_file_search_index_write_varint(data, keyLength);
+		g_string_append_len(data, key, keyLength);
+		g_free(key);
+
+		previousPath=path;
+	}
+
+	/* Write index. The index file is replaced atomically, so a memory-mapped
+	 * previous index stays valid until it is unmapped.
+	 */
+	if(g_file_set_contents(self->filename, data->str, data->len, &error))
+	{
+		g_debug("Rebuilt file search index '%s' with %u paths in %lu bytes",
+					self->filename,
+					count,
+					(gulong)data->len);
+	}
+		else
+		{
+			g_warning(_("Could not write file search index '%s': %s"),
+						self->filename,
+						(error && error->message) ? error->message : _("Unknown error"));
+			if(error) g_error_free(error);
+		}
+
+	/* Release allocated resources */
+	g_string_free(data, TRUE);
+	g_ptr_array_free(paths, TRUE);
+
+	/* Notify main thread */
+	g_mutex_lock(&self->lock);
+	if(!g_atomic_int_get(&self->cancelled))
+	{
+		self->rebuildDoneSourceID=g_idle_add(_xfdashboard_file_search_index_on_rebuild_done, self);
+	}
+	g_mutex_unlock(&self->lock);
+
+	return(NULL);
+}
+
+/* Delayed or periodic rebuild of index */
+static gboolean _xfdashboard_file_search_index_on_rebuild_delay(gpointer inUserData)
+{
+	XfdashboardFileSearchIndex			*self;
+
+	self=(XfdashboardFileSearchIndex*)inUserData;
+
+	self->rebuildDelaySourceID=0;
+	xfdashboard_file_search_index_rebuild(self);
+
+	return(G_SOURCE_REMOVE);
+}
+
+static gboolean _xfdashboard_file_search_index_on_rebuild_interval(gpointer inUserData)
+{
+	xfdashboard_file_search_index_rebuild((XfdashboardFileSearchIndex*)inUserData);
+
+	return(G_SOURCE_CONTINUE);
+}
+
+/* A file or directory in a watched directory has changed */
+static void _xfdashboard_file_search_index_on_file_monitor_changed(GFileMonitor *inMonitor,
+																	GFile *inFile,
+																	GFile *inOtherFile,
+																	GFileMonitorEvent inEventType,
+																	gpointer inUserData)
+{
+	XfdashboardFileSearchIndex			*self;
+	gchar								*path;
+	gchar								*basename;
+
+	g_return_if_fail(G_IS_FILE_MONITOR(inMonitor));
+	g_return_if_fail(inUserData);
+
+	self=(XfdashboardFileSearchIndex*)inUserData;
+
+	/* Skip hidden files and directories if not wanted */
+	basename=g_file_get_basename(inFile);
+	if(!basename || (!self->includeHidden && *basename=='.'))
+	{
+		g_free(basename);
+		return;
+	}
+	g_free(basename);
+
+	path=g_file_get_path(inFile);
+	if(!path) return;
+
+	/* A running rebuild may have missed this change */
+	if(self->thread)
+	{
+		g_hash_table_remove(self->rebuildAddedPaths, path);
+		g_hash_table_remove(self->rebuildRemovedPaths, path);
+	}
+
+	switch(inEventType)
+	{
+		case G_FILE_MONITOR_EVENT_CREATED:
+			g_hash_table_remove(self->removedPaths, path);
+			g_hash_table_insert(self->addedPaths, g_strdup(path), _xfdashboard_file_search_index_get_key(path));
+
+			/* Contents of new directories are not watched so schedule rebuild */
+			if(g_file_test(path, G_FILE_TEST_IS_DIR) &&
+				!self->rebuildDelaySourceID)
+			{
+				self->rebuildDelaySourceID=g_timeout_add_seconds(XFDASHBOARD_FILE_SEARCH_INDEX_REBUILD_DELAY,
+																	_xfdashboard_file_search_index_on_rebuild_delay,
+																	self);
+			}
+			break;
+
+		case G_FILE_MONITOR_EVENT_DELETED:
+			g_hash_table_remove(self->addedPaths, path);
+			g_hash_table_add(self->removedPaths, g_strdup(path));
+			break;
+
+		default:
+			break;
+	}
+
+	g_free(path);
+}
+
+/* IMPLEMENTATION: Public API */
+
+/* Create index of file names in directories. The index is stored at file
+ * and rebuilt in background at creation and afterwards periodically.
+ */
+XfdashboardFileSearchIndex* xfdashboard_file_search_index_new(const gchar *inIndexFile,
+																const gchar * const *inDirectories,
+																gboolean inIncludeHidden,
+																guint inRebuildInterval)
+{
+	XfdashboardFileSearchIndex			*self;
+	const gchar * const					*iter;
+	gchar								*indexPath;
+
+	g_return_val_if_fail(inIndexFile && *inIndexFile, NULL);
+	g_return_val_if_fail(inDirectories, NULL);
+
+	self=g_new0(XfdashboardFileSearchIndex, 1);
+	self->refCount=1;
+	self->filename=g_strdup(inIndexFile);
+	self->directories=g_strdupv((gchar**)inDirectories);
+	self->includeHidden=inIncludeHidden;
+	self->rebuildInterval=inRebuildInterval;
+	self->addedPaths=g_hash_table_new_full(g_str_hash, g_str_equal, g_free, g_free);
+	self->removedPaths=g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+	g_mutex_init(&self->lock);
+
+	/* Make sure the path where index is stored exists */
+	indexPath=g_path_get_dirname(self->filename);
+	g_mkdir_with_parents(indexPath, 0700);
+	g_free(indexPath);
+
+	/* Use index of last run until rebuilt */
+	_xfdashboard_file_search_index_map(self);
+
+	/* Watch configured directories for changes */
+	for(iter=inDirectories; *iter; iter++)
+	{
+		GFile							*directory;
+		GFileMonitor					*monitor;
+
+		directory=g_file_new_for_path(*iter);
+		monitor=g_file_monitor_directory(directory, G_FILE_MONITOR_NONE, NULL, NULL);
+		if(monitor)
+		{
+			g_signal_connect(monitor,
+								"changed",
+								G_CALLBACK(_xfdashboard_file_search_index_on_file_monitor_changed),
+								self);
+			self->monitors=g_list_prepend(self->monitors, monitor);
+		}
+		g_object_unref(directory);
+	}
+
+	/* Rebuild index now and periodically */
+	xfdashboard_file_search_index_rebuild(self);
+	if(self->rebuildInterval>0)
+	{
+		self->rebuildIntervalSourceID=g_timeout_add_seconds(self->rebuildInterval,
+															_xfdashboard_file_search_index_on_rebuild_interval,
+															self);
+	}
+
+	return(self);
+}
+
+/* Ref and unref index */
+XfdashboardFileSearchIndex* xfdashboard_file_search_index_ref(XfdashboardFileSearchIndex *self)
+{
+	g_return_val_if_fail(self, NULL);
+
+	self->refCount++;
+	return(self);
+}
+
+void xfdashboard_file_search_index_unref(XfdashboardFileSearchIndex *self)
+{
+	g_return_if_fail(self);
+
+	self->refCount--;
+	if(self->refCount>0) return;
+
+	/* Stop any running rebuild */
+	g_atomic_int_set(&self->cancelled, 1);
+	if(self->thread)
+	{
+		g_thread_join(self->thread);
+		self->thread=NULL;
+	}
+
+	if(self->rebuildDoneSourceID)
+	{
+		g_source_remove(self->rebuildDoneSourceID);
+		self->rebuildDoneSourceID=0;
+	}
+
+	if(self->rebuildDelaySourceID)
+	{
+		g_source_remove(self->rebuildDelaySourceID);
+		self->rebuildDelaySourceID=0;
+	}
+
+	if(self->rebuildIntervalSourceID)
+	{
+		g_source_remove(self->rebuildIntervalSourceID);
+		self->rebuildIntervalSourceID=0;
+	}
+
+	/* Release allocated resources */
+	g_list_free_full(self->monitors, g_object_unref);
+	_xfdashboard_file_search_index_unmap(self);
+	g_hash_table_destroy(self->addedPaths);
+	g_hash_table_destroy(self->removedPaths);
+	if(self->rebuildAddedPaths) g_hash_table_destroy(self->rebuildAddedPaths);
+	if(self->rebuildRemovedPaths) g_hash_table_destroy(self->rebuildRemovedPaths);
+	g_strfreev(self->directories);
+	g_free(self->filename);
+	g_mutex_clear(&self->lock);
+	g_free(self);
+}
+
+/* Rebuild index in background if not rebuilding already */
+void xfdashboard_file_search_index_rebuild(XfdashboardFileSearchIndex *self)
+{
+	GError								*error;
+	GHashTableIter						iter;
+	const gchar							*path;
+
+	g_return_if_fail(self);
+
+	error=NULL;
+
+	if(self->thread) return;
+
+	/* Remember changes seen before rebuild starts */
+	self->rebuildAddedPaths=g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+	g_hash_table_iter_init(&iter, self->addedPaths);
+	while(g_hash_table_iter_next(&iter, (gpointer*)&path, NULL))
+	{
+		g_hash_table_add(self->rebuildAddedPaths, g_strdup(path));
+	}
+
+	self->rebuildRemovedPaths=g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+	g_hash_table_iter_init(&iter, self->removedPaths);
+	while(g_hash_table_iter_next(&iter, (gpointer*)&path, NULL))
+	{
+		g_hash_table_add(self->rebuildRemovedPaths, g_strdup(path));
+	}
+
+	self->thread=g_thread_try_new("xfdashboard-file-search-index",
+									_xfdashboard_file_search_index_rebuild_thread,
+									self,
+									&error);
+	if(!self->thread)
+	{
+		g_warning(_("Could not start rebuilding file search index: %s"),
+					(error && error->message) ? error->message : _("Unknown error"));
+		if(error) g_error_free(error);
+
+		g_hash_table_destroy(self->rebuildAddedPaths);
+		self->rebuildAddedPaths=NULL;
+		g_hash_table_destroy(self->rebuildRemovedPaths);
+		self->rebuildRemovedPaths=NULL;
+	}
+}
+
+/* Create query for paths whose base name contains all search terms. Search
+ * terms must be normalized with xfdashboard_search_query_normalize_string().
+ * The query is answered from memory-mapped index and changes seen since it
+ * was built without accessing the file system while it is run.
+ */
+XfdashboardFileSearchIndexQuery* xfdashboard_file_search_index_query_new(XfdashboardFileSearchIndex *self,
+																		const gchar * const *inSearchTerms,
+																		guint inMaxResults)
+{
+	XfdashboardFileSearchIndexQuery		*query;
+	guint								i;
+
+	g_return_val_if_fail(self, NULL);
+	g_return_val_if_fail(inSearchTerms, NULL);
+
+	query=g_new0(XfdashboardFileSearchIndexQuery, 1);
+	query->index=xfdashboard_file_search_index_ref(self);
+	query->terms=g_strdupv((gchar**)inSearchTerms);
+	query->termsLength=g_new0(gsize, g_strv_length(query->terms));
+	for(i=0; query->terms[i]; i++) query->termsLength[i]=strlen(query->terms[i]);
+	query->maxResults=inMaxResults;
+	query->resultsCount=0;
+	query->addedPathsChecked=FALSE;
+	query->path=g_string_new(NULL);
+
+	if(self->mappedFile && self->data)
+	{
+		query->mappedFile=g_mapped_file_ref(self->mappedFile);
+		query->data=self->data+XFDASHBOARD_FILE_SEARCH_INDEX_HEADER_LENGTH;
+		query->dataEnd=self->data+self->size;
+		query->remaining=self->count;
+	}
+
+	return(query);
+}
+
+/* Run query until all paths were checked, the maximum number of results was
+ * found or the deadline in monotonic time is reached. Matching paths found
+ * are added to array which should free its elements with g_free(). Returns
+ * TRUE if query is not finished yet and must be run again.
+ */
+gboolean xfdashboard_file_search_index_query_run(XfdashboardFileSearchIndexQuery *inQuery,
+													gint64 inDeadline,
+													GPtrArray *ioPaths)
+{
+	XfdashboardFileSearchIndex			*index;
+	GHashTableIter						iter;
+	const gchar							*addedPath;
+	const gchar							*addedKey;
+	guint								checked;
+
+	g_return_val_if_fail(inQuery, FALSE);
+	g_return_val_if_fail(ioPaths, FALSE);
+
+	index=inQuery->index;
+
+	/* Check paths added since index was built. There are only a few of them
+	 * so check them all at once.
+	 */
+	if(!inQuery->addedPathsChecked)
+	{
+		g_hash_table_iter_init(&iter, index->addedPaths);
+		while(g_hash_table_iter_next(&iter, (gpointer*)&addedPath, (gpointer*)&addedKey) &&
+				(inQuery->maxResults==0 || inQuery->resultsCount<inQuery->maxResults))
+		{
+			if(_xfdashboard_file_search_index_matches(inQuery, addedKey, strlen(addedKey)))
+			{
+				g_ptr_array_add(ioPaths, g_strdup(addedPath));
+				inQuery->resultsCount++;
+			}
+		}
+
+		inQuery->addedPathsChecked=TRUE;
+	}
+
+	/* Scan memory-mapped index and reconstruct each front-coded path */
+	checked=0;
+	while(inQuery->remaining>0 &&
+			(inQuery->maxResults==0 || inQuery->resultsCount<inQuery->maxResults))
+	{
+		gsize							prefixLength;
+		gsize							suffixLength;
+		gsize							keyLength;
+		const gchar						*key;
+
+		/* Check from time to time if deadline was reached but make sure
+		 * the query progresses at each run.
+		 */
+		if(checked>0 &&
+			(checked % XFDASHBOARD_FILE_SEARCH_INDEX_DEADLINE_CHECK_INTERVAL)==0 &&
+			g_get_monotonic_time()>=inDeadline)
+		{
+			return(TRUE);
+		}
+		checked++;
+
+		if(!_xfdashboard_file_search_index_read_varint(&inQuery->data, inQuery->dataEnd, &prefixLength) ||
+			!_xfdashboard_file_search_index_read_varint(&inQuery->data, inQuery->dataEnd, &suffixLength) ||
+			prefixLength>inQuery->path->len ||
+			suffixLength>(gsize)(inQuery->dataEnd-inQuery->data))
+		{
+			g_warning(_("File search index '%s' is corrupted"), index->filename);
+			break;
+		}
+
+		g_string_truncate(inQuery->path, prefixLength);
+		g_string_append_len(inQuery->path, (const gchar*)inQuery->data, suffixLength);
+		inQuery->data+=suffixLength;
+
+		if(!_xfdashboard_file_search_index_read_varint(&inQuery->data, inQuery->dataEnd, &keyLength) ||
+			keyLength>(gsize)(inQuery->dataEnd-inQuery->data))
+		{
+			g_warning(_("File search index '%s' is corrupted"), index->filename);
+			break;
+		}
+
+		key=(const gchar*)inQuery->data;
+		inQuery->data+=keyLength;
+		inQuery->remaining--;
+
+		if(_xfdashboard_file_search_index_matches(inQuery, key, keyLength) &&
+			!g_hash_table_contains(index->removedPaths, inQuery->path->str))
+		{
+			g_ptr_array_add(ioPaths, g_strndup(inQuery->path->str, inQuery->path->len));
+			inQuery->resultsCount++;
+		}
+	}
+
+	/* Query is finished */
+	inQuery->remaining=0;
+	return(FALSE);
+}
+
+/* Release query */
+void xfdashboard_file_search_index_query_free(XfdashboardFileSearchIndexQuery *inQuery)
+{
+	g_return_if_fail(inQuery);
+
+	if(inQuery->mappedFile) g_mapped_file_unref(inQuery->mappedFile);
+	g_string_free(inQuery->path, TRUE);
+	g_free(inQuery->termsLength);
+	g_strfreev(inQuery->terms);
+	xfdashboard_file_search_index_unref(inQuery->index);
+	g_free(inQuery);
+}
+
+/* Get/set single instance of index */
+XfdashboardFileSearchIndex* xfdashboard_file_search_index_get_default(void)
+{
+	if(!_xfdashboard_file_search_index_default) return(NULL);
+
+	return(xfdashboard_file_search_index_ref(_xfdashboard_file_search_index_default));
+}
+
+void xfdashboard_file_search_index_set_default(XfdashboardFileSearchIndex *inIndex)
+{
+	if(inIndex) xfdashboard_file_search_index_ref(inIndex);
+	if(_xfdashboard_file_search_index_default) xfdashboard_file_search_index_unref(_xfdashboard_file_search_index_default);
+	_xfdashboard_file_search_index_default=inIndex;
+}
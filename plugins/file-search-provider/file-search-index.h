@@ -0,0 +1,58 @@
+/*
+ * file-search-index: Memory-mapped index of file names in configured
+ *                    directories
+ * 
+ * Copyright 2012-2016 Stephan Haller <nomad@froevel.de>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ * 
+ * 
+ */
+
+#ifndef __XFDASHBOARD_FILE_SEARCH_INDEX__
+#define __XFDASHBOARD_FILE_SEARCH_INDEX__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+typedef struct _XfdashboardFileSearchIndex		XfdashboardFileSearchIndex;
+typedef struct _XfdashboardFileSearchIndexQuery	XfdashboardFileSearchIndexQuery;
+
+/* Public API */
+XfdashboardFileSearchIndex* xfdashboard_file_search_index_new(const gchar *inIndexFile,
+																const gchar * const *inDirectories,
+																gboolean inIncludeHidden,
+																guint inRebuildInterval);
+XfdashboardFileSearchIndex* xfdashboard_file_search_index_ref(XfdashboardFileSearchIndex *self);
+void xfdashboard_file_search_index_unref(XfdashboardFileSearchIndex *self);
+
+void xfdashboard_file_search_index_rebuild(XfdashboardFileSearchIndex *self);
+
+XfdashboardFileSearchIndexQuery* xfdashboard_file_search_index_query_new(XfdashboardFileSearchIndex *self,
+																		const gchar * const *inSearchTerms,
+																		guint inMaxResults);
+gboolean xfdashboard_file_search_index_query_run(XfdashboardFileSearchIndexQuery *inQuery,
+													gint64 inDeadline,
+													GPtrArray *ioPaths);
+void xfdashboard_file_search_index_query_free(XfdashboardFileSearchIndexQuery *inQuery);
+
+XfdashboardFileSearchIndex* xfdashboard_file_search_index_get_default(void);
+void xfdashboard_file_search_index_set_default(XfdashboardFileSearchIndex *inIndex);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,390 @@
+/*
+ * file-search-provider: A search provider for file names in configured
+ *                       directories
+ * 
+ * Copyright 2012-2016 Stephan Haller <nomad@froevel.de>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ * 
+ * 
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "file-search-provider.h"
+
+#include <glib/gi18n-lib.h>
+#include <gio/gio.h>
+#include <string.h>
+
+#include "file-search-index.h"
+
+
+/* Define this class in GObject system */
+G_DEFINE_DYNAMIC_TYPE(XfdashboardFileSearchProvider,
+						xfdashboard_file_search_provider,
+						XFDASHBOARD_TYPE_SEARCH_PROVIDER)
+
+/* Define this class in this plugin */
+XFDASHBOARD_DEFINE_PLUGIN_TYPE(xfdashboard_file_search_provider);
+
+/* Private structure - access only by public API if needed */
+#define XFDASHBOARD_FILE_SEARCH_PROVIDER_GET_PRIVATE(obj) \
+	(G_TYPE_INSTANCE_GET_PRIVATE((obj), XFDASHBOARD_TYPE_FILE_SEARCH_PROVIDER, XfdashboardFileSearchProviderPrivate))
+
+struct _XfdashboardFileSearchProviderPrivate
+{
+	/* Instance related */
+	XfdashboardFileSearchIndex		*index;
+	guint							maxResults;
+};
+
+
+/* IMPLEMENTATION: Private variables and methods */
+#define MAX_RESULTS_XFCONF_PROP		"/plugins/"PLUGIN_ID"/max-results"
+#define DEFAULT_MAX_RESULTS			50
+
+typedef struct _XfdashboardFileSearchProviderJob		XfdashboardFileSearchProviderJob;
+struct _XfdashboardFileSearchProviderJob
+{
+	XfdashboardFileSearchIndexQuery		*indexQuery;
+	XfdashboardSearchResultSet			*resultSet;
+	gsize								termsLength;
+	GPtrArray							*paths;
+};
+
+/* Get score of path for search terms. The more of the base name is covered
+ * by the search terms the higher the score is.
+ */
+static gfloat _xfdashboard_file_search_provider_score(const gchar *inPath, gsize inTermsLength)
+{
+	const gchar						*basename;
+	gsize							basenameLength;
+
+	basename=strrchr(inPath, G_DIR_SEPARATOR);
+	if(basename) basename++;
+		else basename=inPath;
+
+	basenameLength=strlen(basename);
+	if(basenameLength==0) return(0.0f);
+
+	return(MIN(1.0f, ((gfloat)inTermsLength)/basenameLength));
+}
+
+/* IMPLEMENTATION: XfdashboardSearchProvider */
+
+/* One-time initialization of search provider */
+static void _xfdashboard_file_search_provider_initialize(XfdashboardSearchProvider *inProvider)
+{
+	XfdashboardFileSearchProvider			*self;
+	XfdashboardFileSearchProviderPrivate	*priv;
+
+	g_return_if_fail(XFDASHBOARD_IS_FILE_SEARCH_PROVIDER(inProvider));
+
+	self=XFDASHBOARD_FILE_SEARCH_PROVIDER(inProvider);
+	priv=self->priv;
+
+	/* Get index shared by all instances of this search provider */
+	priv->index=xfdashboard_file_search_index_get_default();
+	priv->maxResults=xfconf_channel_get_uint(xfdashboard_application_get_xfconf_channel(NULL),
+												MAX_RESULTS_XFCONF_PROP,
+												DEFAULT_MAX_RESULTS);
+}
+
+/* Get display name for this search provider */
+static const gchar* _xfdashboard_file_search_provider_get_name(XfdashboardSearchProvider *inProvider)
+{
+	return(_("Files"));
+}
+
+/* Get icon-name for this search provider */
+static const gchar* _xfdashboard_file_search_provider_get_icon(XfdashboardSearchProvider *inProvider)
+{
+	return("system-file-manager");
+}
+
+/* Begin search job for requested search query */
+static gpointer _xfdashboard_file_search_provider_begin_search_job(XfdashboardSearchProvider *inProvider,
+																	XfdashboardSearchQuery *inQuery,
+																	XfdashboardSearchResultSet *inPreviousResultSet,
+																	XfdashboardSearchResultSet *inResultSet)
+{
+	XfdashboardFileSearchProvider			*self;
+	XfdashboardFileSearchProviderPrivate	*priv;
+	XfdashboardFileSearchProviderJob		*job;
+	guint									i;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_FILE_SEARCH_PROVIDER(inProvider), NULL);
+	g_return_val_if_fail(XFDASHBOARD_IS_SEARCH_QUERY(inQuery), NULL);
+
+	self=XFDASHBOARD_FILE_SEARCH_PROVIDER(inProvider);
+	priv=self->priv;
+
+	/* If no search term is given or there is no index, there is nothing to search for */
+	if(xfdashboard_search_query_get_terms_count(inQuery)==0 || !priv->index) return(NULL);
+
+	/* Create job. The query provides search terms already normalized in the
+	 * same way as the base names stored in index.
+	 */
+	job=g_new0(XfdashboardFileSearchProviderJob, 1);
+	job->indexQuery=xfdashboard_file_search_index_query_new(priv->index,
+															xfdashboard_search_query_get_normalized_terms(inQuery),
+															priv->maxResults);
+	job->resultSet=g_object_ref(inResultSet);
+	job->paths=g_ptr_array_new_with_free_func(g_free);
+
+	job->termsLength=0;
+	for(i=0; i<xfdashboard_search_query_get_terms_count(inQuery); i++)
+	{
+		job->termsLength+=xfdashboard_search_query_get_normalized_term_length(inQuery, i);
+	}
+
+	/* Return new job */
+	return(job);
+}
+
+/* Run search job until index was scanned completely or deadline is reached */
+static gboolean _xfdashboard_file_search_provider_run_search_job(XfdashboardSearchProvider *inProvider,
+																	gpointer inJob,
+																	gint64 inDeadline)
+{
+	XfdashboardFileSearchProviderJob		*job;
+	gboolean								unfinished;
+	guint									i;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_FILE_SEARCH_PROVIDER(inProvider), FALSE);
+	g_return_val_if_fail(inJob, FALSE);
+
+	job=(XfdashboardFileSearchProviderJob*)inJob;
+
+	/* Query index. It is answered from memory without accessing file system. */
+	unfinished=xfdashboard_file_search_index_query_run(job->indexQuery, inDeadline, job->paths);
+
+	/* Add matching paths found in this run to result set */
+	for(i=0; i<job->paths->len; i++)
+	{
+		const gchar							*path;
+		GVariant							*resultItem;
+
+		/* Paths are in file name encoding which need not be valid UTF-8,
+		 * so store them as byte strings.
+		 */
+		path=(const gchar*)g_ptr_array_index(job->paths, i);
+		resultItem=g_variant_new_bytestring(path);
+
+		xfdashboard_search_result_set_add_item(job->resultSet, g_variant_ref(resultItem));
+		xfdashboard_search_result_set_set_item_score(job->resultSet, resultItem, _xfdashboard_file_search_provider_score(path, job->termsLength));
+
+		g_variant_unref(resultItem);
+	}
+	g_ptr_array_set_size(job->paths, 0);
+
+	return(unfinished);
+}
+
+/* End search job and release its resources */
+static void _xfdashboard_file_search_provider_end_search_job(XfdashboardSearchProvider *inProvider,
+																gpointer inJob)
+{
+	XfdashboardFileSearchProviderJob		*job;
+
+	g_return_if_fail(XFDASHBOARD_IS_FILE_SEARCH_PROVIDER(inProvider));
+	g_return_if_fail(inJob);
+
+	job=(XfdashboardFileSearchProviderJob*)inJob;
+
+	/* Release allocated resources */
+	if(job->indexQuery) xfdashboard_file_search_index_query_free(job->indexQuery);
+	if(job->paths) g_ptr_array_free(job->paths, TRUE);
+	if(job->resultSet) g_object_unref(job->resultSet);
+	g_free(job);
+}
+
+/* Create actor for a result item of the result set returned from a search request */
+static ClutterActor* _xfdashboard_file_search_provider_create_result_actor(XfdashboardSearchProvider *inProvider,
+																			GVariant *inResultItem)
+{
+	ClutterActor							*actor;
+	const gchar								*path;
+	gchar									*basename;
+	gchar									*dirname;
+	gchar									*displayBasename;
+	gchar									*displayDirname;
+	gchar									*buttonText;
+	gchar									*contentType;
+	GIcon									*icon;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_FILE_SEARCH_PROVIDER(inProvider), NULL);
+	g_return_val_if_fail(inResultItem, NULL);
+
+	path=g_variant_get_bytestring(inResultItem);
+
+	/* Build text to show at button */
+	basename=g_path_get_basename(path);
+	dirname=g_path_get_dirname(path);
+	displayBasename=g_filename_display_name(basename);
+	displayDirname=g_filename_display_name(dirname);
+	buttonText=g_markup_printf_escaped("<b>%s</b>\n\n%s", displayBasename, displayDirname);
+
+	/* Create actor for result item. Guess icon from file name only to avoid
+	 * accessing the file system.
+	 */
+	actor=xfdashboard_button_new_with_text(buttonText);
+
+	contentType=g_content_type_guess(basename, NULL, 0, NULL);
+	icon=contentType ? g_content_type_get_icon(contentType) : NULL;
+	if(icon)
+	{
+		xfdashboard_button_set_style(XFDASHBOARD_BUTTON(actor), XFDASHBOARD_BUTTON_STYLE_BOTH);
+		xfdashboard_button_set_gicon(XFDASHBOARD_BUTTON(actor), icon);
+		g_object_unref(icon);
+	}
+
+	clutter_actor_show(actor);
+
+	/* Release allocated resources */
+	g_free(contentType);
+	g_free(buttonText);
+	g_free(displayDirname);
+	g_free(displayBasename);
+	g_free(dirname);
+	g_free(basename);
+
+	/* Return created actor */
+	return(actor);
+}
+
+/* Activate result item by opening file with default application */
+static gboolean _xfdashboard_file_search_provider_activate_result(XfdashboardSearchProvider* inProvider,
+																	GVariant *inResultItem,
+																	ClutterActor *inActor,
+																	const gchar **inSearchTerms)
+{
+	const gchar								*path;
+	gchar									*displayPath;
+	gchar									*uri;
+	GAppLaunchContext						*context;
+	GError									*error;
+	gboolean								success;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_FILE_SEARCH_PROVIDER(inProvider), FALSE);
+	g_return_val_if_fail(inResultItem, FALSE);
+
+	error=NULL;
+
+	/* Get URI of file to open */
+	path=g_variant_get_bytestring(inResultItem);
+	displayPath=g_filename_display_name(path);
+	uri=g_filename_to_uri(path, NULL, &error);
+	if(!uri)
+	{
+		g_warning(_("Could not open file '%s': %s"),
+					displayPath,
+					(error && error->message) ? error->message : _("Unknown error"));
+		if(error) g_error_free(error);
+		g_free(displayPath);
+		return(FALSE);
+	}
+
+	/* Open file with default application */
+	context=xfdashboard_create_app_context(NULL);
+	success=g_app_info_launch_default_for_uri(uri, context, &error);
+	if(!success)
+	{
+		/* Show notification about failed opening file */
+		xfdashboard_notify(CLUTTER_ACTOR(inActor),
+							"dialog-error",
+							_("Could not open file '%s': %s"),
+							displayPath,
+							(error && error->message) ? error->message : _("Unknown error"));
+		g_warning(_("Could not open file '%s': %s"),
+					displayPath,
+					(error && error->message) ? error->message : _("Unknown error"));
+		if(error) g_error_free(error);
+	}
+
+	/* Release allocated resources */
+	g_object_unref(context);
+	g_free(uri);
+	g_free(displayPath);
+
+	return(success);
+}
+
+/* IMPLEMENTATION: GObject */
+
+/* Dispose this object */
+static void _xfdashboard_file_search_provider_dispose(GObject *inObject)
+{
+	XfdashboardFileSearchProvider			*self=XFDASHBOARD_FILE_SEARCH_PROVIDER(inObject);
+	XfdashboardFileSearchProviderPrivate	*priv=self->priv;
+
+	/* Release allocated resources */
+	if(priv->index)
+	{
+		xfdashboard_file_search_index_unref(priv->index);
+		priv->index=NULL;
+	}
+
+	/* Call parent's class dispose method */
+	G_OBJECT_CLASS(xfdashboard_file_search_provider_parent_class)->dispose(inObject);
+}
+
+/* Class initialization
+ * Override functions in parent classes and define properties
+ * and signals
+ */
+void xfdashboard_file_search_provider_class_init(XfdashboardFileSearchProviderClass *klass)
+{
+	XfdashboardSearchProviderClass	*providerClass=XFDASHBOARD_SEARCH_PROVIDER_CLASS(klass);
+	GObjectClass					*gobjectClass=G_OBJECT_CLASS(klass);
+
+	/* Override functions */
+	gobjectClass->dispose=_xfdashboard_file_search_provider_dispose;
+
+	providerClass->initialize=_xfdashboard_file_search_provider_initialize;
+	providerClass->get_icon=_xfdashboard_file_search_provider_get_icon;
+	providerClass->get_name=_xfdashboard_file_search_provider_get_name;
+	providerClass->begin_search_job=_xfdashboard_file_search_provider_begin_search_job;
+	providerClass->run_search_job=_xfdashboard_file_search_provider_run_search_job;
+	providerClass->end_search_job=_xfdashboard_file_search_provider_end_search_job;
+	providerClass->create_result_actor=_xfdashboard_file_search_provider_create_result_actor;
+	providerClass->activate_result=_xfdashboard_file_search_provider_activate_result;
+
+	/* Set up private structure */
+	g_type_class_add_private(klass, sizeof(XfdashboardFileSearchProviderPrivate));
+}
+
+/* Class finalization */
+void xfdashboard_file_search_provider_class_finalize(XfdashboardFileSearchProviderClass *klass)
+{
+}
+
+/* Object initialization
+ * Create private structure and set up default values
+ */
+void xfdashboard_file_search_provider_init(XfdashboardFileSearchProvider *self)
+{
+	XfdashboardFileSearchProviderPrivate	*priv;
+
+	self->priv=priv=XFDASHBOARD_FILE_SEARCH_PROVIDER_GET_PRIVATE(self);
+
+	/* Set up default values */
+	priv->index=NULL;
+	priv->maxResults=DEFAULT_MAX_RESULTS;
+}
@@ -0,0 +1,186 @@
+/*
+ * plugin: Plugin functions for 'file-search-provider'
+ * 
+ * Copyright 2012-2016 Stephan Haller <nomad@froevel.de>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ * 
+ * 
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <libxfdashboard/libxfdashboard.h>
+#include <libxfce4util/libxfce4util.h>
+
+#include "file-search-provider.h"
+#include "file-search-index.h"
+
+
+/* IMPLEMENTATION: Private variables and methods */
+#define DIRECTORIES_XFCONF_PROP				"/plugins/"PLUGIN_ID"/directories"
+
+#define INCLUDE_HIDDEN_XFCONF_PROP			"/plugins/"PLUGIN_ID"/include-hidden"
+#define DEFAULT_INCLUDE_HIDDEN				FALSE
+
+#define REBUILD_INTERVAL_XFCONF_PROP		"/plugins/"PLUGIN_ID"/rebuild-interval"
+#define DEFAULT_REBUILD_INTERVAL			3600
+
+typedef struct _XfdashboardFileSearchProviderPluginPrivate	XfdashboardFileSearchProviderPluginPrivate;
+struct _XfdashboardFileSearchProviderPluginPrivate
+{
+	/* Private structure */
+	XfdashboardFileSearchIndex	*index;
+	gboolean					isRegistered;
+};
+
+
+/* IMPLEMENTATION: XfdashboardPlugin */
+
+/* Forward declarations */
+G_MODULE_EXPORT void plugin_init(XfdashboardPlugin *self);
+
+/* Plugin enable function */
+static void plugin_enable(XfdashboardPlugin *self, gpointer inUserData)
+{
+	XfdashboardFileSearchProviderPluginPrivate	*priv;
+	XfconfChannel								*xfconfChannel;
+	XfdashboardSearchManager					*searchManager;
+	gchar										**directories;
+	gboolean									includeHidden;
+	guint										rebuildInterval;
+	gchar										*indexFile;
+
+	g_return_if_fail(inUserData);
+
+	priv=(XfdashboardFileSearchProviderPluginPrivate*)inUserData;
+
+	/* Get settings. If no directory is configured index home directory. */
+	xfconfChannel=xfdashboard_application_get_xfconf_channel(NULL);
+
+	directories=xfconf_channel_get_string_list(xfconfChannel, DIRECTORIES_XFCONF_PROP);
+	if(!directories || !*directories)
+	{
+		if(directories) g_strfreev(directories);
+
+		directories=g_new0(gchar*, 2);
+		directories[0]=g_strdup(g_get_home_dir());
+	}
+
+	includeHidden=xfconf_channel_get_bool(xfconfChannel,
+											INCLUDE_HIDDEN_XFCONF_PROP,
+											DEFAULT_INCLUDE_HIDDEN);
+
+	rebuildInterval=xfconf_channel_get_uint(xfconfChannel,
+											REBUILD_INTERVAL_XFCONF_PROP,
+											DEFAULT_REBUILD_INTERVAL);
+
+	/* Create index which is shared by all search provider instances. The index
+	 * file is stored in user's cache directory as it can be rebuilt at any time.
+	 */
+	indexFile=g_build_filename(g_get_user_cache_dir(), "xfdashboard", "file-search-index", NULL);
+	priv->index=xfdashboard_file_search_index_new(indexFile,
+													(const gchar * const *)directories,
+													includeHidden,
+													rebuildInterval);
+	xfdashboard_file_search_index_set_default(priv->index);
+	g_debug("Created file search index at '%s' for %u directories",
+				indexFile,
+				g_strv_length(directories));
+
+	/* Register search provider */
+	searchManager=xfdashboard_search_manager_get_default();
+
+	priv->isRegistered=xfdashboard_search_manager_register(searchManager, PLUGIN_ID, XFDASHBOARD_TYPE_FILE_SEARCH_PROVIDER);
+	if(priv->isRegistered)
+	{
+		g_debug("Successfully registered file search provider with ID '%s'", PLUGIN_ID);
+	}
+		else
+		{
+			g_debug("Failed to register file search provider with ID '%s'", PLUGIN_ID);
+		}
+
+	/* Release allocated resources */
+	g_object_unref(searchManager);
+	g_free(indexFile);
+	g_strfreev(directories);
+}
+
+/* Plugin disable function */
+static void plugin_disable(XfdashboardPlugin *self, gpointer inUserData)
+{
+	XfdashboardFileSearchProviderPluginPrivate	*priv;
+	XfdashboardSearchManager					*searchManager;
+
+	g_return_if_fail(inUserData);
+
+	priv=(XfdashboardFileSearchProviderPluginPrivate*)inUserData;
+
+	/* Unregister search provider */
+	if(priv->isRegistered)
+	{
+		searchManager=xfdashboard_search_manager_get_default();
+
+		if(xfdashboard_search_manager_unregister(searchManager, PLUGIN_ID))
+		{
+			g_debug("Successfully unregistered file search provider with ID '%s'", PLUGIN_ID);
+		}
+			else
+			{
+				g_debug("Failed to unregister file search provider with ID '%s'", PLUGIN_ID);
+			}
+
+		g_object_unref(searchManager);
+		priv->isRegistered=FALSE;
+	}
+
+	/* Release index. Any running rebuild is cancelled when the last reference
+	 * is dropped.
+	 */
+	if(priv->index)
+	{
+		xfdashboard_file_search_index_set_default(NULL);
+		xfdashboard_file_search_index_unref(priv->index);
+		priv->index=NULL;
+	}
+}
+
+/* Plugin initialization function */
+G_MODULE_EXPORT void plugin_init(XfdashboardPlugin *self)
+{
+	static XfdashboardFileSearchProviderPluginPrivate	priv={ 0, };
+
+	/* Set up localization */
+	xfce_textdomain(GETTEXT_PACKAGE, PACKAGE_LOCALE_DIR, "UTF-8");
+
+	/* Set plugin info */
+	xfdashboard_plugin_set_info(self,
+								"flags", XFDASHBOARD_PLUGIN_FLAG_EARLY_INITIALIZATION,
+								"name", _("File search provider"),
+								"description", _("Searches file names in configured directories using a background-built index"),
+								"author", "Stephan Haller <nomad@froevel.de>",
+								NULL);
+
+	/* Register GObject types of this plugin */
+	XFDASHBOARD_REGISTER_PLUGIN_TYPE(self, xfdashboard_file_search_provider);
+
+	/* Connect plugin action handlers */
+	g_signal_connect(self, "enable", G_CALLBACK(plugin_enable), &priv);
+	g_signal_connect(self, "disable", G_CALLBACK(plugin_disable), &priv);
+}
@@ -0,0 +1,480 @@
+/*
+ * gnome-shell-search-provider-discovery: Discovers Gnome-Shell search
+ *                                        providers in background and
+ *                                        caches them
+ * 
+ * Copyright 2012-2016 Stephan Haller <nomad@froevel.de>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ * 
+ * 
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gnome-shell-search-provider-discovery.h"
+
+#include <glib/gi18n-lib.h>
+#include <glib/gstdio.h>
+#include <gio/gio.h>
+#include <string.h>
+
+
+/* IMPLEMENTATION: Private variables and methods */
+
+/* Group in data file of a Gnome-Shell search provider */
+#define XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_DISCOVERY_KEYFILE_GROUP		"Shell Search Provider"
+
+/* Group in cache file storing path and modification time of directory the
+ * cached search providers were discovered at. The cache is valid as long as
+ * both do not change. Installing, updating or removing a search provider
+ * replaces or removes its data file which changes the modification time of
+ * the directory.
+ */
+#define XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_DISCOVERY_CACHE_GROUP		"Discovery Cache"
+#define XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_DISCOVERY_CACHE_PATH		"Path"
+#define XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_DISCOVERY_CACHE_MODIFIED	"Modified"
+
+struct _XfdashboardGnomeShellSearchProviderDiscovery
+{
+	/* Settings */
+	gchar													*path;
+	gchar													*cacheFile;
+
+	/* Search providers discovered, only accessed in main thread */
+	GKeyFile												*providers;
+
+	/* Background discovery */
+	GThread													*thread;
+	GMutex													lock;
+	gint													cancelled;
+	GKeyFile												*scanResult;
+	guint													scanDoneSourceID;
+	XfdashboardGnomeShellSearchProviderDiscoveryCallback	callback;
+	gpointer												userData;
+};
+
+static XfdashboardGnomeShellSearchProviderDiscovery*	_xfdashboard_gnome_shell_search_provider_discovery_default=NULL;
+
+/* Keys copied from data file of a Gnome-Shell search provider */
+static const gchar*		_xfdashboard_gnome_shell_search_provider_discovery_keys[]=
+							{
+								"DesktopId",
+								"BusName",
+								"ObjectPath",
+								"Version",
+								NULL
+							};
+
+/* Get modification time of directory in microseconds or 0 if unknown */
+static guint64 _xfdashboard_gnome_shell_search_provider_discovery_get_modified(const gchar *inPath)
+{
+	GFile													*directory;
+	GFileInfo												*info;
+	guint64													modified;
+
+	directory=g_file_new_for_path(inPath);
+	info=g_file_query_info(directory,
+							G_FILE_ATTRIBUTE_TIME_MODIFIED "," G_FILE_ATTRIBUTE_TIME_MODIFIED_USEC,
+							G_FILE_QUERY_INFO_NONE,
+							NULL,
+							NULL);
+
+	modified=0;
+	if(info)
+	{
+		modified=g_file_info_get_attribute_uint64(info, G_FILE_ATTRIBUTE_TIME_MODIFIED)*G_USEC_PER_SEC;
+		modified+=g_file_info_get_attribute_uint32(info, G_FILE_ATTRIBUTE_TIME_MODIFIED_USEC);
+		g_object_unref(info);
+	}
+
+	g_object_unref(directory);
+
+	return(modified);
+}
+
+/* Load cached search providers if cache is still valid for directory */
+static GKeyFile* _xfdashboard_gnome_shell_search_provider_discovery_load_cache(XfdashboardGnomeShellSearchProviderDiscovery *self,
+																				guint64 inModified)
+{
+	GKeyFile												*cache;
+	gchar													*cachedPath;
+	guint64													cachedModified;
+
+	cache=g_key_file_new();
+	if(!g_key_file_load_from_file(cache, self->cacheFile, G_KEY_FILE_NONE, NULL))
+	{
+		g_key_file_free(cache);
+		return(NULL);
+	}
+
+	cachedPath=g_key_file_get_string(cache,
+										XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_DISCOVERY_CACHE_GROUP,
+										XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_DISCOVERY_CACHE_PATH,
+										NULL);
+	cachedModified=g_key_file_get_uint64(cache,
+											XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_DISCOVERY_CACHE_GROUP,
+											XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_DISCOVERY_CACHE_MODIFIED,
+											NULL);
+	if(g_strcmp0(cachedPath, self->path)!=0 || cachedModified!=inModified)
+	{
+		g_debug("Cache of Gnome-Shell search providers at '%s' is outdated", self->cacheFile);
+
+		g_free(cachedPath);
+		g_key_file_free(cache);
+		return(NULL);
+	}
+
+	g_free(cachedPath);
+
+	return(cache);
+}
+
+/* Parse data file of a Gnome-Shell search provider and copy the keys needed
+ * to use it into group named after search provider.
+ */
+static gboolean _xfdashboard_gnome_shell_search_provider_discovery_add_file(XfdashboardGnomeShellSearchProviderDiscovery *self,
+																			GKeyFile *ioProviders,
+																			const gchar *inFilename,
+																			GError **outError)
+{
+	GKeyFile												*providerKeyFile;
+	gchar													*filePath;
+	gchar													*gnomeShellID;
+	gchar													*value;
+	const gchar												**key;
+	GError													*error;
+
+	g_return_val_if_fail(outError==NULL || *outError==NULL, FALSE);
+
+	error=NULL;
+
+	/* Load data file */
+	filePath=g_build_filename(self->path, inFilename, NULL);
+	providerKeyFile=g_key_file_new();
+	if(!g_key_file_load_from_file(providerKeyFile, filePath, G_KEY_FILE_NONE, &error))
+	{
+		g_propagate_error(outError, error);
+
+		g_key_file_free(providerKeyFile);
+		g_free(filePath);
+
+		return(FALSE);
+	}
+
+	/* Check that all keys needed exist before adding search provider */
+	for(key=_xfdashboard_gnome_shell_search_provider_discovery_keys; *key; key++)
+	{
+		if(!g_key_file_has_key(providerKeyFile,
+								XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_DISCOVERY_KEYFILE_GROUP,
+								*key,
+								&error))
+		{
+			if(!error)
+			{
+				g_set_error(&error,
+							G_KEY_FILE_ERROR,
+							G_KEY_FILE_ERROR_KEY_NOT_FOUND,
+							_("Key file does not have key '%s' in group '%s'"),
+							*key,
+							XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_DISCOVERY_KEYFILE_GROUP);
+			}
+			g_propagate_error(outError, error);
+
+			g_key_file_free(providerKeyFile);
+			g_free(filePath);
+
+			return(FALSE);
+		}
+	}
+
+	/* Copy keys to group of search provider. The ID of search provider is
+	 * the file name without file extension.
+	 */
+	gnomeShellID=g_strndup(inFilename, strlen(inFilename)-4);
+	for(key=_xfdashboard_gnome_shell_search_provider_discovery_keys; *key; key++)
+	{
+		value=g_key_file_get_value(providerKeyFile,
+									XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_DISCOVERY_KEYFILE_GROUP,
+									*key,
+									NULL);
+		g_key_file_set_value(ioProviders, gnomeShellID, *key, value);
+		g_free(value);
+	}
+
+	/* Release allocated resources */
+	g_free(gnomeShellID);
+	g_key_file_free(providerKeyFile);
+	g_free(filePath);
+
+	return(TRUE);
+}
+
+/* Scan directory for data files of Gnome-Shell search providers */
+static GKeyFile* _xfdashboard_gnome_shell_search_provider_discovery_scan_directory(XfdashboardGnomeShellSearchProviderDiscovery *self)
+{
+	GKeyFile												*providers;
+	GDir													*directory;
+	const gchar												*filename;
+	GError													*error;
+
+	error=NULL;
+
+	providers=g_key_file_new();
+
+	directory=g_dir_open(self->path, 0, &error);
+	if(!directory)
+	{
+		g_warning(_("Could not scan for gnome-shell search provider at '%s': %s"),
+					self->path,
+					(error && error->message) ? error->message : _("Unknown error"));
+		if(error) g_error_free(error);
+
+		return(providers);
+	}
+
+	while(!g_atomic_int_get(&self->cancelled) &&
+			(filename=g_dir_read_name(directory)))
+	{
+		if(!g_str_has_suffix(filename, ".ini")) continue;
+
+		if(!_xfdashboard_gnome_shell_search_provider_discovery_add_file(self, providers, filename, &error))
+		{
+			g_warning(_("Could not register Gnome-Shell search provider at file '%s': %s"),
+						filename,
+						(error && error->message) ? error->message : _("Unknown error"));
+			if(error)
+			{
+				g_error_free(error);
+				error=NULL;
+			}
+		}
+	}
+
+	g_dir_close(directory);
+
+	return(providers);
+}
+
+/* Store discovered search providers together with directory's modification time */
+static void _xfdashboard_gnome_shell_search_provider_discovery_save_cache(XfdashboardGnomeShellSearchProviderDiscovery *self,
+																			GKeyFile *inProviders,
+																			guint64 inModified)
+{
+	gchar													*cacheDirectory;
+	gchar													*data;
+	gsize													dataLength;
+	GError													*error;
+
+	error=NULL;
+
+	g_key_file_set_string(inProviders,
+							XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_DISCOVERY_CACHE_GROUP,
+							XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_DISCOVERY_CACHE_PATH,
+							self->path);
+	g_key_file_set_uint64(inProviders,
+							XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_DISCOVERY_CACHE_GROUP,
+							XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_DISCOVERY_CACHE_MODIFIED,
+							inModified);
+
+	cacheDirectory=g_path_get_dirname(self->cacheFile);
+	g_mkdir_with_parents(cacheDirectory, 0700);
+
+	data=g_key_file_to_data(inProviders, &dataLength, NULL);
+	if(!g_file_set_contents(self->cacheFile, data, dataLength, &error))
+	{
+		g_warning(_("Could not write cache of Gnome-Shell search providers to '%s': %s"),
+					self->cacheFile,
+					(error && error->message) ? error->message : _("Unknown error"));
+		if(error) g_error_free(error);
+	}
+
+	g_free(data);
+	g_free(cacheDirectory);
+}
+
+/* Discovery has finished so take result and notify callback */
+static gboolean _xfdashboard_gnome_shell_search_provider_discovery_on_scan_done(gpointer inUserData)
+{
+	XfdashboardGnomeShellSearchProviderDiscovery			*self;
+
+	self=(XfdashboardGnomeShellSearchProviderDiscovery*)inUserData;
+
+	g_mutex_lock(&self->lock);
+	self->scanDoneSourceID=0;
+	if(self->providers) g_key_file_free(self->providers);
+	self->providers=self->scanResult;
+	self->scanResult=NULL;
+	g_mutex_unlock(&self->lock);
+
+	if(self->thread)
+	{
+		g_thread_join(self->thread);
+		self->thread=NULL;
+	}
+
+	if(self->callback) (self->callback)(self, self->providers, self->userData);
+
+	return(G_SOURCE_REMOVE);
+}
+
+/* Thread function to discover search providers */
+static gpointer _xfdashboard_gnome_shell_search_provider_discovery_scan_thread(gpointer inUserData)
+{
+	XfdashboardGnomeShellSearchProviderDiscovery			*self;
+	GKeyFile												*providers;
+	guint64													modified;
+
+	self=(XfdashboardGnomeShellSearchProviderDiscovery*)inUserData;
+
+	/* Use cached search providers if directory has not changed since they were
+	 * discovered. Otherwise scan directory and update cache.
+	 */
+	modified=_xfdashboard_gnome_shell_search_provider_discovery_get_modified(self->path);
+
+	providers=NULL;
+	if(modified>0) providers=_xfdashboard_gnome_shell_search_provider_discovery_load_cache(self, modified);
+
+	if(providers)
+	{
+		g_debug("Using cached Gnome-Shell search providers from '%s'", self->cacheFile);
+	}
+		else
+		{
+			g_debug("Scanning directory '%s' for Gnome-Shell search providers", self->path);
+
+			providers=_xfdashboard_gnome_shell_search_provider_discovery_scan_directory(self);
+			if(modified>0 && !g_atomic_int_get(&self->cancelled))
+			{
+				_xfdashboard_gnome_shell_search_provider_discovery_save_cache(self, providers, modified);
+			}
+		}
+
+	/* Only search provider groups are handed out */
+	g_key_file_remove_group(providers, XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_DISCOVERY_CACHE_GROUP, NULL);
+
+	/* Notify main thread */
+	g_mutex_lock(&self->lock);
+	if(!g_atomic_int_get(&self->cancelled))
+	{
+		self->scanResult=providers;
+		self->scanDoneSourceID=g_idle_add(_xfdashboard_gnome_shell_search_provider_discovery_on_scan_done, self);
+	}
+		else g_key_file_free(providers);
+	g_mutex_unlock(&self->lock);
+
+	return(NULL);
+}
+
+
+/* IMPLEMENTATION: Public API */
+
+/* Create discovery for Gnome-Shell search providers at path using cache file */
+XfdashboardGnomeShellSearchProviderDiscovery* xfdashboard_gnome_shell_search_provider_discovery_new(const gchar *inPath,
+																									const gchar *inCacheFile)
+{
+	XfdashboardGnomeShellSearchProviderDiscovery			*self;
+
+	g_return_val_if_fail(inPath && *inPath, NULL);
+	g_return_val_if_fail(inCacheFile && *inCacheFile, NULL);
+
+	self=g_new0(XfdashboardGnomeShellSearchProviderDiscovery, 1);
+	self->path=g_strdup(inPath);
+	self->cacheFile=g_strdup(inCacheFile);
+	g_mutex_init(&self->lock);
+
+	return(self);
+}
+
+/* Free discovery and stop any running scan */
+void xfdashboard_gnome_shell_search_provider_discovery_free(XfdashboardGnomeShellSearchProviderDiscovery *self)
+{
+	g_return_if_fail(self);
+
+	/* Stop any running scan */
+	g_atomic_int_set(&self->cancelled, 1);
+	if(self->thread)
+	{
+		g_thread_join(self->thread);
+		self->thread=NULL;
+	}
+
+	if(self->scanDoneSourceID)
+	{
+		g_source_remove(self->scanDoneSourceID);
+		self->scanDoneSourceID=0;
+	}
+
+	/* Release allocated resources */
+	if(self->scanResult) g_key_file_free(self->scanResult);
+	if(self->providers) g_key_file_free(self->providers);
+	g_free(self->cacheFile);
+	g_free(self->path);
+	g_mutex_clear(&self->lock);
+	g_free(self);
+}
+
+/* Discover search providers in background. The callback is called in main
+ * thread when discovery has finished.
+ */
+void xfdashboard_gnome_shell_search_provider_discovery_scan(XfdashboardGnomeShellSearchProviderDiscovery *self,
+															XfdashboardGnomeShellSearchProviderDiscoveryCallback inCallback,
+															gpointer inUserData)
+{
+	GError													*error;
+
+	g_return_if_fail(self);
+
+	error=NULL;
+
+	if(self->thread) return;
+
+	self->callback=inCallback;
+	self->userData=inUserData;
+
+	self->thread=g_thread_try_new("xfdashboard-gnome-shell-search-provider-discovery",
+									_xfdashboard_gnome_shell_search_provider_discovery_scan_thread,
+									self,
+									&error);
+	if(!self->thread)
+	{
+		g_warning(_("Could not scan for gnome-shell search provider at '%s': %s"),
+					self->path,
+					(error && error->message) ? error->message : _("Unknown error"));
+		if(error) g_error_free(error);
+	}
+}
+
+/* Get search providers discovered or NULL if discovery has not finished yet */
+GKeyFile* xfdashboard_gnome_shell_search_provider_discovery_get_providers(XfdashboardGnomeShellSearchProviderDiscovery *self)
+{
+	g_return_val_if_fail(self, NULL);
+
+	return(self->providers);
+}
+
+/* Get and set discovery used by all search provider instances */
+XfdashboardGnomeShellSearchProviderDiscovery* xfdashboard_gnome_shell_search_provider_discovery_get_default(void)
+{
+	return(_xfdashboard_gnome_shell_search_provider_discovery_default);
+}
+
+void xfdashboard_gnome_shell_search_provider_discovery_set_default(XfdashboardGnomeShellSearchProviderDiscovery *inDiscovery)
+{
+	_xfdashboard_gnome_shell_search_provider_discovery_default=inDiscovery;
+}
@@ -0,0 +1,59 @@
+/*
+ * gnome-shell-search-provider-discovery: Discovers Gnome-Shell search
+ *                                        providers in background and
+ *                                        caches them
+ * 
+ * Copyright 2012-2016 Stephan Haller <nomad@froevel.de>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ * 
+ * 
+ */
+
+#ifndef __XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_DISCOVERY__
+#define __XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_DISCOVERY__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+typedef struct _XfdashboardGnomeShellSearchProviderDiscovery		XfdashboardGnomeShellSearchProviderDiscovery;
+
+/* Called in main thread when discovery has finished. Each group in key file
+ * is named after a Gnome-Shell search provider and contains the keys of its
+ * data file needed to use it.
+ */
+typedef void (*XfdashboardGnomeShellSearchProviderDiscoveryCallback)(XfdashboardGnomeShellSearchProviderDiscovery *inDiscovery,
+																		GKeyFile *inProviders,
+																		gpointer inUserData);
+
+/* Public API */
+XfdashboardGnomeShellSearchProviderDiscovery* xfdashboard_gnome_shell_search_provider_discovery_new(const gchar *inPath,
+																									const gchar *inCacheFile);
+void xfdashboard_gnome_shell_search_provider_discovery_free(XfdashboardGnomeShellSearchProviderDiscovery *self);
+
+void xfdashboard_gnome_shell_search_provider_discovery_scan(XfdashboardGnomeShellSearchProviderDiscovery *self,
+															XfdashboardGnomeShellSearchProviderDiscoveryCallback inCallback,
+															gpointer inUserData);
+
+GKeyFile* xfdashboard_gnome_shell_search_provider_discovery_get_providers(XfdashboardGnomeShellSearchProviderDiscovery *self);
+
+XfdashboardGnomeShellSearchProviderDiscovery* xfdashboard_gnome_shell_search_provider_discovery_get_default(void);
+void xfdashboard_gnome_shell_search_provider_discovery_set_default(XfdashboardGnomeShellSearchProviderDiscovery *inDiscovery);
+
+G_END_DECLS
+
+#endif
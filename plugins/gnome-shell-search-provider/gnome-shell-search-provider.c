@@ -31,6 +31,8 @@
 #include <glib/gi18n-lib.h>
 #include <gio/gio.h>
 
+#include "gnome-shell-search-provider-discovery.h"
+
 
 /* Define this class in GObject system */
 G_DEFINE_DYNAMIC_TYPE(XfdashboardGnomeShellSearchProvider,
@@ -58,21 +60,200 @@ struct _XfdashboardGnomeShellSearchProviderPrivate
 
 	gchar			*providerName;
 	gchar			*providerIcon;
+
+	GDBusProxy		*proxy;
+	gboolean		activationPending;
+	guint			latencyBudget;
+	guint			activationInterval;
 };
 
 /* IMPLEMENTATION: Private variables and methods */
 #define XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_KEYFILE_GROUP		"Shell Search Provider"
+#define XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_DBUS_INTERFACE		"org.gnome.Shell.SearchProvider2"
+
+/* Time in milliseconds a search provider may take to return its result set
+ * before it is skipped for this search. Zero means no limit.
+ */
+#define LATENCY_BUDGET_XFCONF_PROP				"/plugins/"PLUGIN_ID"/latency-budget"
+#define DEFAULT_LATENCY_BUDGET					250
+
+/* Minimum time in milliseconds between starting services of two search providers */
+#define ACTIVATION_INTERVAL_XFCONF_PROP			"/plugins/"PLUGIN_ID"/activation-interval"
+#define DEFAULT_ACTIVATION_INTERVAL				1000
+
+static gint64	_xfdashboard_gnome_shell_search_provider_next_activation=0;
+
+/* A search job waits for the result set of Gnome-Shell search provider which
+ * is requested asynchronously. The pending call holds a reference to the job,
+ * so its reply can be dropped safely if it arrives after the job has ended.
+ */
+typedef struct _XfdashboardGnomeShellSearchProviderJob		XfdashboardGnomeShellSearchProviderJob;
+struct _XfdashboardGnomeShellSearchProviderJob
+{
+	gint									refCount;
+
+	XfdashboardGnomeShellSearchProvider		*provider;
+	XfdashboardSearchResultSet				*resultSet;
+	GCancellable							*cancellable;
+	gint64									budgetEnd;
+	gboolean								finished;
+};
+
+/* Ref and unref search job */
+static XfdashboardGnomeShellSearchProviderJob* _xfdashboard_gnome_shell_search_provider_job_ref(XfdashboardGnomeShellSearchProviderJob *inJob)
+{
+	g_return_val_if_fail(inJob, NULL);
+
+	inJob->refCount++;
+	return(inJob);
+}
+
+static void _xfdashboard_gnome_shell_search_provider_job_unref(XfdashboardGnomeShellSearchProviderJob *inJob)
+{
+	g_return_if_fail(inJob);
+
+	inJob->refCount--;
+	if(inJob->refCount>0) return;
+
+	/* Release allocated resources */
+	if(inJob->cancellable) g_object_unref(inJob->cancellable);
+	if(inJob->resultSet) g_object_unref(inJob->resultSet);
+	if(inJob->provider) g_object_unref(inJob->provider);
+	g_free(inJob);
+}
+
+/* Get proxy for DBUS interface of Gnome-Shell search provider. It is created
+ * once on first use and does not start the service of search provider.
+ */
+static GDBusProxy* _xfdashboard_gnome_shell_search_provider_get_proxy(XfdashboardGnomeShellSearchProvider *self,
+																		GError **outError)
+{
+	XfdashboardGnomeShellSearchProviderPrivate		*priv;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_GNOME_SHELL_SEARCH_PROVIDER(self), NULL);
+	g_return_val_if_fail(outError==NULL || *outError==NULL, NULL);
+
+	priv=self->priv;
+
+	if(!priv->proxy)
+	{
+		priv->proxy=g_dbus_proxy_new_for_bus_sync(G_BUS_TYPE_SESSION,
+													G_DBUS_PROXY_FLAGS_DO_NOT_LOAD_PROPERTIES |
+														G_DBUS_PROXY_FLAGS_DO_NOT_CONNECT_SIGNALS |
+														G_DBUS_PROXY_FLAGS_DO_NOT_AUTO_START,
+													NULL,
+													priv->dbusBusName,
+													priv->dbusObjectPath,
+													XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_DBUS_INTERFACE,
+													NULL,
+													outError);
+	}
+
+	return(priv->proxy);
+}
+
+/* Service of Gnome-Shell search provider was started or failed to start */
+static void _xfdashboard_gnome_shell_search_provider_on_activation_done(GObject *inSource,
+																		GAsyncResult *inResult,
+																		gpointer inUserData)
+{
+	XfdashboardGnomeShellSearchProvider				*self;
+	XfdashboardGnomeShellSearchProviderPrivate		*priv;
+	GVariant										*result;
+	GError											*error;
+
+	g_return_if_fail(XFDASHBOARD_IS_GNOME_SHELL_SEARCH_PROVIDER(inUserData));
+
+	self=XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER(inUserData);
+	priv=self->priv;
+	error=NULL;
+
+	result=g_dbus_connection_call_finish(G_DBUS_CONNECTION(inSource), inResult, &error);
+	if(!result)
+	{
+		/* Show error message */
+		g_warning(_("Could not start service of Gnome-Shell search provider '%s': %s"),
+					priv->gnomeShellID,
+					(error && error->message) ? error->message : _("Unknown error"));
+
+		/* Release allocated resources */
+		if(error) g_error_free(error);
+	}
+		else
+		{
+			g_debug("Started service '%s' of Gnome-Shell search provider '%s'",
+						priv->dbusBusName,
+						priv->gnomeShellID);
+
+			g_variant_unref(result);
+		}
+
+	priv->activationPending=FALSE;
+
+	/* Release reference taken when service was requested to start */
+	g_object_unref(self);
+}
+
+/* Request to start service of Gnome-Shell search provider in background.
+ * Services are started one after another with a minimum interval between
+ * them instead of starting all of them at once on first search. If another
+ * service was started recently the request is dropped and repeated by the
+ * next search.
+ */
+static void _xfdashboard_gnome_shell_search_provider_request_activation(XfdashboardGnomeShellSearchProvider *self,
+																		GDBusProxy *inProxy)
+{
+	XfdashboardGnomeShellSearchProviderPrivate		*priv;
+	gint64											now;
+
+	g_return_if_fail(XFDASHBOARD_IS_GNOME_SHELL_SEARCH_PROVIDER(self));
+	g_return_if_fail(G_IS_DBUS_PROXY(inProxy));
+
+	priv=self->priv;
+
+	/* Do nothing if service is starting already */
+	if(priv->activationPending) return;
+
+	/* Do nothing if another service was started recently */
+	now=g_get_monotonic_time();
+	if(now<_xfdashboard_gnome_shell_search_provider_next_activation)
+	{
+		g_debug("Delaying start of service '%s' of Gnome-Shell search provider '%s' as another service was started recently",
+					priv->dbusBusName,
+					priv->gnomeShellID);
+		return;
+	}
+	_xfdashboard_gnome_shell_search_provider_next_activation=now+(priv->activationInterval*G_TIME_SPAN_MILLISECOND);
+
+	/* Ask DBUS to start service */
+	priv->activationPending=TRUE;
+	g_dbus_connection_call(g_dbus_proxy_get_connection(inProxy),
+							"org.freedesktop.DBus",
+							"/org/freedesktop/DBus",
+							"org.freedesktop.DBus",
+							"StartServiceByName",
+							g_variant_new("(su)", priv->dbusBusName, 0),
+							G_VARIANT_TYPE("(u)"),
+							G_DBUS_CALL_FLAGS_NONE,
+							-1,
+							NULL,
+							_xfdashboard_gnome_shell_search_provider_on_activation_done,
+							g_object_ref(self));
+	g_debug("Requested start of service '%s' of Gnome-Shell search provider '%s'",
+				priv->dbusBusName,
+				priv->gnomeShellID);
+}
 
 
 /* IMPLEMENTATION: XfdashboardSearchProvider */
 
-/* Update information about Gnome-Shell search provider from file */
-static gboolean _xfdashboard_gnome_shell_search_provider_update_from_file(XfdashboardGnomeShellSearchProvider *self,
-																			GError **outError)
+/* Update information about Gnome-Shell search provider from group in key file */
+static gboolean _xfdashboard_gnome_shell_search_provider_update_from_key_file(XfdashboardGnomeShellSearchProvider *self,
+																				GKeyFile *inKeyFile,
+																				const gchar *inGroup,
+																				GError **outError)
 {
 	XfdashboardGnomeShellSearchProviderPrivate		*priv;
-	gchar											*filePath;
-	GKeyFile										*providerKeyFile;
 	XfdashboardApplicationDatabase					*appDB;
 	GAppInfo										*appInfo;
 	gchar											*desktopID;
@@ -84,34 +265,16 @@ static gboolean _xfdashboard_gnome_shell_search_provider_update_from_file(Xfdash
 	GError											*error;
 
 	g_return_val_if_fail(XFDASHBOARD_IS_GNOME_SHELL_SEARCH_PROVIDER(self), FALSE);
+	g_return_val_if_fail(inKeyFile, FALSE);
+	g_return_val_if_fail(inGroup && *inGroup, FALSE);
 	g_return_val_if_fail(outError==NULL || *outError==NULL, FALSE);
 
 	priv=self->priv;
 	error=NULL;
 
-	/* Get path to Gnome-Shell search provider's data file */
-	filePath=g_file_get_path(priv->file);
-
-	/* Get data about search provider */
-	providerKeyFile=g_key_file_new();
-	if(!g_key_file_load_from_file(providerKeyFile,
-									filePath,
-									G_KEY_FILE_NONE,
-									&error))
-	{
-		/* Propagate error */
-		g_propagate_error(outError, error);
-
-		/* Release allocated resources */
-		if(providerKeyFile) g_key_file_free(providerKeyFile);
-		if(filePath) g_free(filePath);
-
-		return(FALSE);
-	}
-
 	/* Get desktop ID from search provider's data file */
-	desktopID=g_key_file_get_string(providerKeyFile,
-									XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_KEYFILE_GROUP,
+	desktopID=g_key_file_get_string(inKeyFile,
+									inGroup,
 									"DesktopId",
 									&error);
 	if(!desktopID)
@@ -120,15 +283,13 @@ static gboolean _xfdashboard_gnome_shell_search_provider_update_from_file(Xfdash
 		g_propagate_error(outError, error);
 
 		/* Release allocated resources */
-		if(providerKeyFile) g_key_file_free(providerKeyFile);
-		if(filePath) g_free(filePath);
 
 		return(FALSE);
 	}
 
 	/* Get bus name from search provider's data file */
-	dbusBusName=g_key_file_get_string(providerKeyFile,
-										XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_KEYFILE_GROUP,
+	dbusBusName=g_key_file_get_string(inKeyFile,
+										inGroup,
 										"BusName",
 										&error);
 	if(!dbusBusName)
@@ -138,15 +299,13 @@ static gboolean _xfdashboard_gnome_shell_search_provider_update_from_file(Xfdash
 
 		/* Release allocated resources */
 		if(desktopID) g_free(desktopID);
-		if(providerKeyFile) g_key_file_free(providerKeyFile);
-		if(filePath) g_free(filePath);
 
 		return(FALSE);
 	}
 
 	/* Get object path from search provider's data file */
-	dbusObjectPath=g_key_file_get_string(providerKeyFile,
-											XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_KEYFILE_GROUP,
+	dbusObjectPath=g_key_file_get_string(inKeyFile,
+											inGroup,
 											"ObjectPath",
 											&error);
 	if(!dbusObjectPath)
@@ -157,15 +316,13 @@ static gboolean _xfdashboard_gnome_shell_search_provider_update_from_file(Xfdash
 		/* Release allocated resources */
 		if(dbusBusName) g_free(dbusBusName);
 		if(desktopID) g_free(desktopID);
-		if(providerKeyFile) g_key_file_free(providerKeyFile);
-		if(filePath) g_free(filePath);
 
 		return(FALSE);
 	}
 
 	/* Get version from search provider's data file */
-	searchProviderVersion=g_key_file_get_integer(providerKeyFile,
-													XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_KEYFILE_GROUP,
+	searchProviderVersion=g_key_file_get_integer(inKeyFile,
+													inGroup,
 													"Version",
 													&error);
 	if(!searchProviderVersion)
@@ -177,8 +334,6 @@ static gboolean _xfdashboard_gnome_shell_search_provider_update_from_file(Xfdash
 		if(dbusObjectPath) g_free(dbusObjectPath);
 		if(dbusBusName) g_free(dbusBusName);
 		if(desktopID) g_free(desktopID);
-		if(providerKeyFile) g_key_file_free(providerKeyFile);
-		if(filePath) g_free(filePath);
 
 		return(FALSE);
 	}
@@ -221,6 +376,13 @@ static gboolean _xfdashboard_gnome_shell_search_provider_update_from_file(Xfdash
 	if(priv->desktopID) g_free(priv->desktopID);
 	priv->desktopID=g_strdup(desktopID);
 
+	if(priv->proxy &&
+		(g_strcmp0(priv->dbusBusName, dbusBusName)!=0 || g_strcmp0(priv->dbusObjectPath, dbusObjectPath)!=0))
+	{
+		g_object_unref(priv->proxy);
+		priv->proxy=NULL;
+	}
+
 	if(priv->dbusBusName) g_free(priv->dbusBusName);
 	priv->dbusBusName=g_strdup(dbusBusName);
 
@@ -245,10 +407,8 @@ static gboolean _xfdashboard_gnome_shell_search_provider_update_from_file(Xfdash
 	if(dbusObjectPath) g_free(dbusObjectPath);
 	if(dbusBusName) g_free(dbusBusName);
 	if(desktopID) g_free(desktopID);
-	if(providerKeyFile) g_key_file_free(providerKeyFile);
-	if(filePath) g_free(filePath);
 
-	/* If we get here we could update from file successfully */
+	/* If we get here we could update from key file successfully */
 	g_debug("Updated search provider '%s' of type %s for Gnome-Shell search provider interface version %d using DBUS name '%s' and object path '%s' displayed as '%s' with icon '%s' from desktop ID '%s'",
 				xfdashboard_search_provider_get_id(XFDASHBOARD_SEARCH_PROVIDER(self)),
 				G_OBJECT_TYPE_NAME(self),
@@ -262,6 +422,41 @@ static gboolean _xfdashboard_gnome_shell_search_provider_update_from_file(Xfdash
 	return(TRUE);
 }
 
+/* Update information about Gnome-Shell search provider from its data file */
+static gboolean _xfdashboard_gnome_shell_search_provider_update_from_file(XfdashboardGnomeShellSearchProvider *self,
+																			GError **outError)
+{
+	XfdashboardGnomeShellSearchProviderPrivate		*priv;
+	gchar											*filePath;
+	GKeyFile										*providerKeyFile;
+	gboolean										success;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_GNOME_SHELL_SEARCH_PROVIDER(self), FALSE);
+	g_return_val_if_fail(outError==NULL || *outError==NULL, FALSE);
+
+	priv=self->priv;
+
+	/* Get path to Gnome-Shell search provider's data file */
+	filePath=g_file_get_path(priv->file);
+
+	/* Get data about search provider */
+	providerKeyFile=g_key_file_new();
+	success=g_key_file_load_from_file(providerKeyFile, filePath, G_KEY_FILE_NONE, outError);
+	if(success)
+	{
+		success=_xfdashboard_gnome_shell_search_provider_update_from_key_file(self,
+																				providerKeyFile,
+																				XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_KEYFILE_GROUP,
+																				outError);
+	}
+
+	/* Release allocated resources */
+	if(providerKeyFile) g_key_file_free(providerKeyFile);
+	if(filePath) g_free(filePath);
+
+	return(success);
+}
+
 /* The data file of Gnome-Shell search provider has changed */
 static void _xfdashboard_gnome_shell_search_provider_on_data_file_changed(XfdashboardGnomeShellSearchProvider *self,
 																			GFile *inFile,
@@ -314,6 +509,10 @@ static void _xfdashboard_gnome_shell_search_provider_initialize(XfdashboardSearc
 {
 	XfdashboardGnomeShellSearchProvider				*self;
 	XfdashboardGnomeShellSearchProviderPrivate		*priv;
+	XfconfChannel									*xfconfChannel;
+	XfdashboardGnomeShellSearchProviderDiscovery	*discovery;
+	GKeyFile										*providers;
+	gboolean										success;
 	GError											*error;
 
 	g_return_if_fail(XFDASHBOARD_IS_GNOME_SHELL_SEARCH_PROVIDER(inProvider));
@@ -386,8 +585,28 @@ static void _xfdashboard_gnome_shell_search_provider_initialize(XfdashboardSearc
 			}
 	}
 
-	/* Get information about Gnome-Shell search provider from file */
-	if(!_xfdashboard_gnome_shell_search_provider_update_from_file(self, &error))
+	/* Get settings for calls to Gnome-Shell search provider */
+	xfconfChannel=xfdashboard_application_get_xfconf_channel(NULL);
+	priv->latencyBudget=xfconf_channel_get_uint(xfconfChannel,
+												LATENCY_BUDGET_XFCONF_PROP,
+												DEFAULT_LATENCY_BUDGET);
+	priv->activationInterval=xfconf_channel_get_uint(xfconfChannel,
+														ACTIVATION_INTERVAL_XFCONF_PROP,
+														DEFAULT_ACTIVATION_INTERVAL);
+
+	/* Get information about Gnome-Shell search provider from discovery which
+	 * has parsed its data file already or from data file itself if it was
+	 * not discovered, e.g. because it was added later.
+	 */
+	discovery=xfdashboard_gnome_shell_search_provider_discovery_get_default();
+	providers=discovery ? xfdashboard_gnome_shell_search_provider_discovery_get_providers(discovery) : NULL;
+	if(providers && g_key_file_has_group(providers, priv->gnomeShellID))
+	{
+		success=_xfdashboard_gnome_shell_search_provider_update_from_key_file(self, providers, priv->gnomeShellID, &error);
+	}
+		else success=_xfdashboard_gnome_shell_search_provider_update_from_file(self, &error);
+
+	if(!success)
 	{
 		/* Show warning message */
 		g_warning(_("Cannot load information about Gnome-Shell search provider '%s': %s"),
@@ -438,37 +657,25 @@ static const gchar* _xfdashboard_gnome_shell_search_provider_get_icon(Xfdashboar
 	return(priv->providerIcon);
 }
 
-/* Get result set for requested search terms */
-static XfdashboardSearchResultSet* _xfdashboard_gnome_shell_search_provider_get_result_set(XfdashboardSearchProvider *inProvider,
-																							const gchar **inSearchTerms,
-																							XfdashboardSearchResultSet *inPreviousResultSet)
+/* Get proxy for DBUS interface of Gnome-Shell search provider if its service
+ * is running. Services of search providers are started lazily when they are
+ * needed for the first time. If the service is not running, request to start
+ * it and return NULL to skip this search provider for this search.
+ */
+static GDBusProxy* _xfdashboard_gnome_shell_search_provider_get_running_proxy(XfdashboardGnomeShellSearchProvider *self)
 {
-	XfdashboardGnomeShellSearchProvider				*self;
 	XfdashboardGnomeShellSearchProviderPrivate		*priv;
 	GError											*error;
-	XfdashboardSearchResultSet						*resultSet;
-	GVariant										*resultItem;
 	GDBusProxy										*proxy;
-	GVariant										*proxyResult;
-	gchar											**proxyResultSet;
-	gchar											**iter;
+	gchar											*nameOwner;
 
-	g_return_val_if_fail(XFDASHBOARD_IS_GNOME_SHELL_SEARCH_PROVIDER(inProvider), NULL);
+	g_return_val_if_fail(XFDASHBOARD_IS_GNOME_SHELL_SEARCH_PROVIDER(self), NULL);
 
-	self=XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER(inProvider);
 	priv=self->priv;
 	error=NULL;
-	resultSet=NULL;
 
-	/* Connect to search provider via DBUS */
-	proxy=g_dbus_proxy_new_for_bus_sync(G_BUS_TYPE_SESSION,
-										G_DBUS_PROXY_FLAGS_NONE,
-										NULL,
-										priv->dbusBusName,
-										priv->dbusObjectPath,
-										"org.gnome.Shell.SearchProvider2",
-										NULL,
-										&error);
+	/* Get proxy to search provider via DBUS */
+	proxy=_xfdashboard_gnome_shell_search_provider_get_proxy(self, &error);
 	if(!proxy)
 	{
 		/* Show error message */
@@ -483,119 +690,359 @@ static XfdashboardSearchResultSet* _xfdashboard_gnome_shell_search_provider_get_
 		return(NULL);
 	}
 
-	/* Call search method at search provider depending on if a initial
-	 * result set is requested or an update for a previous result set.
-	 */
+	/* Check if service of search provider is running */
+	nameOwner=g_dbus_proxy_get_name_owner(proxy);
+	if(!nameOwner)
+	{
+		g_debug("Skipping Gnome-Shell search provider '%s' for this search as its service is not running",
+					priv->gnomeShellID);
+		_xfdashboard_gnome_shell_search_provider_request_activation(self, proxy);
+
+		return(NULL);
+	}
+	g_free(nameOwner);
+
+	/* Return proxy */
+	return(proxy);
+}
+
+/* Build parameters for call of search method at search provider depending on
+ * if a initial result set is requested or an update for a previous result set.
+ * Returns floating reference to parameters and sets name of method to call.
+ */
+static GVariant* _xfdashboard_gnome_shell_search_provider_build_search_call(XfdashboardGnomeShellSearchProvider *self,
+																			const gchar **inSearchTerms,
+																			XfdashboardSearchResultSet *inPreviousResultSet,
+																			const gchar **outMethod)
+{
+	XfdashboardGnomeShellSearchProviderPrivate		*priv;
+	GVariantBuilder									builder;
+	GList											*allPrevResults;
+	GList											*allPrevIter;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_GNOME_SHELL_SEARCH_PROVIDER(self), NULL);
+	g_return_val_if_fail(inSearchTerms, NULL);
+	g_return_val_if_fail(outMethod, NULL);
+
+	priv=self->priv;
+
+	/* Get initial result set if no previous result set is provided */
 	if(!inPreviousResultSet)
 	{
-		/* Call search method at search provider to get initial result set */
-		proxyResult=g_dbus_proxy_call_sync(proxy,
-											"GetInitialResultSet",
-											g_variant_new("(^as)", inSearchTerms),
-											G_DBUS_CALL_FLAGS_NONE,
-											-1,
-											NULL,
-											&error);
-		g_debug("Fetched initial result set at %p for Gnome Shell search provider '%s' of type %s",
-					proxyResult,
+		*outMethod="GetInitialResultSet";
+		return(g_variant_new("(^as)", inSearchTerms));
+	}
+
+	/* Initialize GVariant builder to get a GVariant with an array
+	 * of strings for previous result set.
+	 */
+	g_variant_builder_init(&builder, G_VARIANT_TYPE_STRING_ARRAY);
+
+	/* For each result item in previous result set add a string
+	 * to GVariant builder.
+	 */
+	allPrevResults=xfdashboard_search_result_set_get_all(inPreviousResultSet);
+	for(allPrevIter=allPrevResults; allPrevIter; allPrevIter=g_list_next(allPrevIter))
+	{
+		g_variant_builder_add(&builder, "s", g_variant_get_string((GVariant*)allPrevIter->data, NULL));
+	}
+	g_debug("Built previous result set with %d entries for Gnome Shell search provider '%s' of type %s",
+				g_list_length(allPrevResults),
+				priv->gnomeShellID,
+				G_OBJECT_TYPE_NAME(self));
+	g_list_free_full(allPrevResults, (GDestroyNotify)g_variant_unref);
+
+	/* Get an update for previous result set */
+	*outMethod="GetSubsearchResultSet";
+	return(g_variant_new("(as^as)", &builder, inSearchTerms));
+}
+
+/* Show error of a failed call of search method at search provider but only
+ * a debug message if search provider exceeded its latency budget as this is
+ * expected for slow ones.
+ */
+static void _xfdashboard_gnome_shell_search_provider_print_search_error(XfdashboardGnomeShellSearchProvider *self,
+																		GError *inError)
+{
+	XfdashboardGnomeShellSearchProviderPrivate		*priv;
+
+	g_return_if_fail(XFDASHBOARD_IS_GNOME_SHELL_SEARCH_PROVIDER(self));
+
+	priv=self->priv;
+
+	if(g_error_matches(inError, G_IO_ERROR, G_IO_ERROR_TIMED_OUT))
+	{
+		g_debug("Skipping Gnome-Shell search provider '%s' for this search as it did not respond within %u ms",
 					priv->gnomeShellID,
-					G_OBJECT_TYPE_NAME(self));
+					priv->latencyBudget);
 	}
 		else
 		{
-			GVariantBuilder						builder;
-			GList								*allPrevResults;
-			GList								*allPrevIter;
+			g_warning(_("Could get result set from dbus connection for Gnome-Shell search provider '%s': %s"),
+						priv->gnomeShellID,
+						(inError && inError->message) ? inError->message : _("Unknown error"));
+		}
+}
 
-			/* Initialize GVariant builder to get a GVariant with an array
-			 * of strings for previous result set.
-			 */
-			g_variant_builder_init(&builder, G_VARIANT_TYPE_STRING_ARRAY);
+/* Add result items returned by search method of search provider to result set */
+static void _xfdashboard_gnome_shell_search_provider_add_result_items(XfdashboardGnomeShellSearchProvider *self,
+																		GVariant *inProxyResult,
+																		XfdashboardSearchResultSet *ioResultSet)
+{
+	XfdashboardGnomeShellSearchProviderPrivate		*priv;
+	GVariant										*resultItem;
+	gchar											**proxyResultSet;
+	gchar											**iter;
 
-			/* For each result item in previous result set add a string
-			 * to GVariant builder.
-			 */
-			allPrevResults=xfdashboard_search_result_set_get_all(inPreviousResultSet);
-			for(allPrevIter=allPrevResults; allPrevIter; allPrevIter=g_list_next(allPrevIter))
-			{
-				g_variant_builder_add(&builder, "s", g_variant_get_string((GVariant*)allPrevIter->data, NULL));
-			}
-			g_debug("Built previous result set with %d entries for Gnome Shell search provider '%s' of type %s",
-						g_list_length(allPrevResults),
-						priv->gnomeShellID,
-						G_OBJECT_TYPE_NAME(self));
-			g_list_free_full(allPrevResults, (GDestroyNotify)g_variant_unref);
+	g_return_if_fail(XFDASHBOARD_IS_GNOME_SHELL_SEARCH_PROVIDER(self));
+	g_return_if_fail(inProxyResult);
+	g_return_if_fail(XFDASHBOARD_IS_SEARCH_RESULT_SET(ioResultSet));
 
-			/* Call search method at search provider to get an update
-			 * for previous result set.
-			 */
-			proxyResult=g_dbus_proxy_call_sync(proxy,
-												"GetSubsearchResultSet",
-												g_variant_new("(as^as)", &builder, inSearchTerms),
-												G_DBUS_CALL_FLAGS_NONE,
-												-1,
-												NULL,
-												&error);
-			g_debug("Fetched subset result set at %p for Gnome Shell search provider '%s' of type %s",
-						proxyResult,
-						priv->gnomeShellID,
-						G_OBJECT_TYPE_NAME(self));
+	priv=self->priv;
+
+	/* Retrieve result set for this application from returned result set of
+	 * search provider.
+	 */
+	proxyResultSet=NULL;
+	g_variant_get(inProxyResult, "(^as)", &proxyResultSet);
+	if(!proxyResultSet) return;
+
+	/* For each string in returned result set of search provider create a GVariant
+	 * which gets added with full score to result set for this application.
+	 */
+	for(iter=proxyResultSet; *iter; iter++)
+	{
+		resultItem=g_variant_new_string(*iter);
+		if(resultItem)
+		{
+			xfdashboard_search_result_set_add_item(ioResultSet, g_variant_ref(resultItem));
+			xfdashboard_search_result_set_set_item_score(ioResultSet, resultItem, 1.0f);
+
+			/* Release result item added */
+			g_variant_unref(resultItem);
 		}
+	}
+	g_debug("Got result set with %u entries for Gnome Shell search provider '%s' of type %s",
+				xfdashboard_search_result_set_get_size(ioResultSet),
+				priv->gnomeShellID,
+				G_OBJECT_TYPE_NAME(self));
 
+	/* Release allocated resources */
+	g_strfreev(proxyResultSet);
+}
+
+/* Get result set for requested search terms synchronously. The search view
+ * uses search jobs instead which do not block while waiting for the reply.
+ */
+static XfdashboardSearchResultSet* _xfdashboard_gnome_shell_search_provider_get_result_set(XfdashboardSearchProvider *inProvider,
+																							const gchar **inSearchTerms,
+																							XfdashboardSearchResultSet *inPreviousResultSet)
+{
+	XfdashboardGnomeShellSearchProvider				*self;
+	XfdashboardGnomeShellSearchProviderPrivate		*priv;
+	GError											*error;
+	XfdashboardSearchResultSet						*resultSet;
+	GDBusProxy										*proxy;
+	GVariant										*parameters;
+	const gchar										*method;
+	GVariant										*proxyResult;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_GNOME_SHELL_SEARCH_PROVIDER(inProvider), NULL);
+
+	self=XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER(inProvider);
+	priv=self->priv;
+	error=NULL;
+
+	/* Get proxy to running search provider */
+	proxy=_xfdashboard_gnome_shell_search_provider_get_running_proxy(self);
+	if(!proxy) return(NULL);
+
+	/* Call search method at search provider. It must return its result set
+	 * within latency budget otherwise it is skipped for this search.
+	 */
+	parameters=_xfdashboard_gnome_shell_search_provider_build_search_call(self, inSearchTerms, inPreviousResultSet, &method);
+	proxyResult=g_dbus_proxy_call_sync(proxy,
+										method,
+										parameters,
+										G_DBUS_CALL_FLAGS_NO_AUTO_START,
+										(priv->latencyBudget>0 ? (gint)priv->latencyBudget : -1),
+										NULL,
+										&error);
 	if(!proxyResult)
 	{
 		/* Show error message */
-		g_warning(_("Could get result set from dbus connection for Gnome-Shell search provider '%s': %s"),
-					priv->gnomeShellID,
-					(error && error->message) ? error->message : _("Unknown error"));
+		_xfdashboard_gnome_shell_search_provider_print_search_error(self, error);
 
 		/* Release allocated resources */
 		if(error) g_error_free(error);
-		if(proxy) g_object_unref(proxy);
 
 		/* Return NULL to indicate error */
 		return(NULL);
 	}
 
-	/* Retrieve result set for this application from returned result set of
-	 * search provider.
-	 */
-	proxyResultSet=NULL;
-	g_variant_get(proxyResult, "(^as)", &proxyResultSet);
+	/* Create result set from returned result items */
+	resultSet=xfdashboard_search_result_set_new();
+	_xfdashboard_gnome_shell_search_provider_add_result_items(self, proxyResult, resultSet);
 
-	if(proxyResultSet)
-	{
-		/* Initialize result set */
-		resultSet=xfdashboard_search_result_set_new();
+	/* Release allocated resources */
+	g_variant_unref(proxyResult);
 
-		/* For each string in returned result set of search provider create a GVariant
-		 * which gets added with full score to result set for this application.
-		 */
-		for(iter=proxyResultSet; *iter; iter++)
-		{
-			resultItem=g_variant_new_string(*iter);
-			if(resultItem)
-			{
-				xfdashboard_search_result_set_add_item(resultSet, g_variant_ref(resultItem));
-				xfdashboard_search_result_set_set_item_score(resultSet, resultItem, 1.0f);
+	/* Return result set */
+	return(resultSet);
+}
 
-				/* Release result item added */
-				g_variant_unref(resultItem);
-			}
-		}
-		g_debug("Got result set with %u entries for Gnome Shell search provider '%s' of type %s",
-					xfdashboard_search_result_set_get_size(resultSet),
-					priv->gnomeShellID,
-					G_OBJECT_TYPE_NAME(self));
+/* Search method at search provider returned result set of search job or failed */
+static void _xfdashboard_gnome_shell_search_provider_on_search_done(GObject *inSource,
+																	GAsyncResult *inResult,
+																	gpointer inUserData)
+{
+	XfdashboardGnomeShellSearchProviderJob			*job;
+	GVariant										*proxyResult;
+	GError											*error;
+
+	g_return_if_fail(inUserData);
+
+	job=(XfdashboardGnomeShellSearchProviderJob*)inUserData;
+	error=NULL;
+
+	proxyResult=g_dbus_proxy_call_finish(G_DBUS_PROXY(inSource), inResult, &error);
+
+	/* Drop reply if search job has ended or exceeded its latency budget
+	 * meanwhile. Otherwise add result items to result set of job.
+	 */
+	if(g_cancellable_is_cancelled(job->cancellable))
+	{
+		g_debug("Dropping late reply of Gnome-Shell search provider '%s'",
+					job->provider->priv->gnomeShellID);
 	}
+		else if(!proxyResult)
+		{
+			_xfdashboard_gnome_shell_search_provider_print_search_error(job->provider, error);
+		}
+		else
+		{
+			_xfdashboard_gnome_shell_search_provider_add_result_items(job->provider, proxyResult, job->resultSet);
+		}
+
+	job->finished=TRUE;
 
 	/* Release allocated resources */
-	if(proxyResultSet) g_strfreev(proxyResultSet);
 	if(proxyResult) g_variant_unref(proxyResult);
-	if(proxy) g_object_unref(proxy);
+	if(error) g_error_free(error);
 
-	/* Return result set */
-	return(resultSet);
+	/* Release reference taken when search method was called */
+	_xfdashboard_gnome_shell_search_provider_job_unref(job);
+}
+
+/* Begin search job by calling search method at search provider asynchronously */
+static gpointer _xfdashboard_gnome_shell_search_provider_begin_search_job(XfdashboardSearchProvider *inProvider,
+																			XfdashboardSearchQuery *inQuery,
+																			XfdashboardSearchResultSet *inPreviousResultSet,
+																			XfdashboardSearchResultSet *inResultSet)
+{
+	XfdashboardGnomeShellSearchProvider				*self;
+	XfdashboardGnomeShellSearchProviderPrivate		*priv;
+	XfdashboardGnomeShellSearchProviderJob			*job;
+	GDBusProxy										*proxy;
+	GVariant										*parameters;
+	const gchar										*method;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_GNOME_SHELL_SEARCH_PROVIDER(inProvider), NULL);
+	g_return_val_if_fail(XFDASHBOARD_IS_SEARCH_QUERY(inQuery), NULL);
+	g_return_val_if_fail(XFDASHBOARD_IS_SEARCH_RESULT_SET(inResultSet), NULL);
+
+	self=XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER(inProvider);
+	priv=self->priv;
+
+	/* If no search term is given, there is nothing to search for */
+	if(xfdashboard_search_query_get_terms_count(inQuery)==0) return(NULL);
+
+	/* Get proxy to running search provider */
+	proxy=_xfdashboard_gnome_shell_search_provider_get_running_proxy(self);
+	if(!proxy) return(NULL);
+
+	/* Create job */
+	job=g_new0(XfdashboardGnomeShellSearchProviderJob, 1);
+	job->refCount=1;
+	job->provider=g_object_ref(self);
+	job->resultSet=g_object_ref(inResultSet);
+	job->cancellable=g_cancellable_new();
+	job->budgetEnd=(priv->latencyBudget>0 ? g_get_monotonic_time()+(priv->latencyBudget*G_TIME_SPAN_MILLISECOND) : 0);
+	job->finished=FALSE;
+
+	/* Call search method at search provider without waiting for its reply */
+	parameters=_xfdashboard_gnome_shell_search_provider_build_search_call(self,
+																			xfdashboard_search_query_get_terms(inQuery),
+																			inPreviousResultSet,
+																			&method);
+	g_dbus_proxy_call(proxy,
+						method,
+						parameters,
+						G_DBUS_CALL_FLAGS_NO_AUTO_START,
+						-1,
+						job->cancellable,
+						_xfdashboard_gnome_shell_search_provider_on_search_done,
+						_xfdashboard_gnome_shell_search_provider_job_ref(job));
+	g_debug("Called %s at Gnome Shell search provider '%s' of type %s",
+				method,
+				priv->gnomeShellID,
+				G_OBJECT_TYPE_NAME(self));
+
+	/* Return new job */
+	return(job);
+}
+
+/* Run search job. The reply of search provider is received by main loop
+ * between the time slices of search jobs, so the job only checks if it has
+ * arrived or if latency budget is used up.
+ */
+static gboolean _xfdashboard_gnome_shell_search_provider_run_search_job(XfdashboardSearchProvider *inProvider,
+																		gpointer inJob,
+																		gint64 inDeadline)
+{
+	XfdashboardGnomeShellSearchProviderJob			*job;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_GNOME_SHELL_SEARCH_PROVIDER(inProvider), FALSE);
+	g_return_val_if_fail(inJob, FALSE);
+
+	job=(XfdashboardGnomeShellSearchProviderJob*)inJob;
+
+	/* Job is finished if reply has arrived */
+	if(job->finished) return(FALSE);
+
+	/* Skip search provider for this search if it did not reply within
+	 * latency budget. Its reply will be dropped if it arrives later.
+	 */
+	if(job->budgetEnd>0 && g_get_monotonic_time()>=job->budgetEnd)
+	{
+		g_debug("Skipping Gnome-Shell search provider '%s' for this search as it did not respond within %u ms",
+					job->provider->priv->gnomeShellID,
+					job->provider->priv->latencyBudget);
+
+		g_cancellable_cancel(job->cancellable);
+		job->finished=TRUE;
+		return(FALSE);
+	}
+
+	/* Wait for reply */
+	return(TRUE);
+}
+
+/* End search job and drop reply of search provider if still pending */
+static void _xfdashboard_gnome_shell_search_provider_end_search_job(XfdashboardSearchProvider *inProvider,
+																	gpointer inJob)
+{
+	XfdashboardGnomeShellSearchProviderJob			*job;
+
+	g_return_if_fail(XFDASHBOARD_IS_GNOME_SHELL_SEARCH_PROVIDER(inProvider));
+	g_return_if_fail(inJob);
+
+	job=(XfdashboardGnomeShellSearchProviderJob*)inJob;
+
+	g_cancellable_cancel(job->cancellable);
+	job->finished=TRUE;
+
+	_xfdashboard_gnome_shell_search_provider_job_unref(job);
 }
 
 /* Create actor for a result item of the result set returned from a search request */
@@ -628,14 +1075,7 @@ static ClutterActor* _xfdashboard_gnome_shell_search_provider_create_result_acto
 	error=NULL;
 
 	/* Get meta data of result item */
-	proxy=g_dbus_proxy_new_for_bus_sync(G_BUS_TYPE_SESSION,
-										G_DBUS_PROXY_FLAGS_NONE,
-										NULL,
-										priv->dbusBusName,
-										priv->dbusObjectPath,
-										"org.gnome.Shell.SearchProvider2",
-										NULL,
-										&error);
+	proxy=_xfdashboard_gnome_shell_search_provider_get_proxy(self, &error);
 	if(!proxy)
 	{
 		/* Show error message */
@@ -669,7 +1109,6 @@ static ClutterActor* _xfdashboard_gnome_shell_search_provider_create_result_acto
 
 		/* Release allocated resources */
 		if(error) g_error_free(error);
-		if(proxy) g_object_unref(proxy);
 
 		/* Return NULL to indicate error */
 		return(NULL);
@@ -831,7 +1270,6 @@ static ClutterActor* _xfdashboard_gnome_shell_search_provider_create_result_acto
 	if(name) g_free(name);
 	if(resultIter) g_variant_iter_free(resultIter);
 	if(proxyResult) g_variant_unref(proxyResult);
-	if(proxy) g_object_unref(proxy);
 
 	/* Return created actor */
 	return(actor);
@@ -860,15 +1298,8 @@ static gboolean _xfdashboard_gnome_shell_search_provider_activate_result(Xfdashb
 	/* Get identifier to activate */
 	identifier=g_variant_get_string(inResultItem, NULL);
 
-	/* Call 'ActivateResult' over DBUS at Gnome-Shell search provider */
-	proxy=g_dbus_proxy_new_for_bus_sync(G_BUS_TYPE_SESSION,
-										G_DBUS_PROXY_FLAGS_NONE,
-										NULL,
-										priv->dbusBusName,
-										priv->dbusObjectPath,
-										"org.gnome.Shell.SearchProvider2",
-										NULL,
-										&error);
+	/* Get proxy to search provider via DBUS */
+	proxy=_xfdashboard_gnome_shell_search_provider_get_proxy(self, &error);
 	if(!proxy)
 	{
 		/* Show error message */
@@ -883,16 +1314,24 @@ static gboolean _xfdashboard_gnome_shell_search_provider_activate_result(Xfdashb
 		return(FALSE);
 	}
 
-	proxyResult=g_dbus_proxy_call_sync(proxy,
-										"ActivateResult",
-										g_variant_new("(s^asu)",
-														identifier,
-														inSearchTerms,
-														clutter_get_current_event_time()),
-										G_DBUS_CALL_FLAGS_NONE,
-										-1,
-										NULL,
-										&error);
+	/* Call 'ActivateResult' over DBUS at Gnome-Shell search provider. Call
+	 * it at bus name instead of proxy as the proxy does not start the service
+	 * of search provider if it has exited meanwhile.
+	 */
+	proxyResult=g_dbus_connection_call_sync(g_dbus_proxy_get_connection(proxy),
+											priv->dbusBusName,
+											priv->dbusObjectPath,
+											XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_DBUS_INTERFACE,
+											"ActivateResult",
+											g_variant_new("(s^asu)",
+															identifier,
+															inSearchTerms,
+															clutter_get_current_event_time()),
+											NULL,
+											G_DBUS_CALL_FLAGS_NONE,
+											-1,
+											NULL,
+											&error);
 	if(!proxyResult)
 	{
 		/* Show error message */
@@ -903,7 +1342,6 @@ static gboolean _xfdashboard_gnome_shell_search_provider_activate_result(Xfdashb
 
 		/* Release allocated resources */
 		if(error) g_error_free(error);
-		if(proxy) g_object_unref(proxy);
 
 		/* Return FALSE to indicate error */
 		return(FALSE);
@@ -911,7 +1349,6 @@ static gboolean _xfdashboard_gnome_shell_search_provider_activate_result(Xfdashb
 
 	/* Release allocated resources */
 	if(proxyResult) g_variant_unref(proxyResult);
-	if(proxy) g_object_unref(proxy);
 
 	/* If we get here activating result item was successful, so return TRUE */
 	return(TRUE);
@@ -934,15 +1371,8 @@ static gboolean _xfdashboard_gnome_shell_search_provider_launch_search(Xfdashboa
 	priv=self->priv;
 	error=NULL;
 
-	/* Call 'LaunchSearch' over DBUS at Gnome-Shell search provider */
-	proxy=g_dbus_proxy_new_for_bus_sync(G_BUS_TYPE_SESSION,
-										G_DBUS_PROXY_FLAGS_NONE,
-										NULL,
-										priv->dbusBusName,
-										priv->dbusObjectPath,
-										"org.gnome.Shell.SearchProvider2",
-										NULL,
-										&error);
+	/* Get proxy to search provider via DBUS */
+	proxy=_xfdashboard_gnome_shell_search_provider_get_proxy(self, &error);
 	if(!proxy)
 	{
 		/* Show error message */
@@ -957,15 +1387,23 @@ static gboolean _xfdashboard_gnome_shell_search_provider_launch_search(Xfdashboa
 		return(FALSE);
 	}
 
-	proxyResult=g_dbus_proxy_call_sync(proxy,
-										"LaunchSearch",
-										g_variant_new("(^asu)",
-														inSearchTerms,
-														clutter_get_current_event_time()),
-										G_DBUS_CALL_FLAGS_NONE,
-										-1,
-										NULL,
-										&error);
+	/* Call 'LaunchSearch' over DBUS at Gnome-Shell search provider. Call
+	 * it at bus name instead of proxy as the proxy does not start the service
+	 * of search provider if it has exited meanwhile.
+	 */
+	proxyResult=g_dbus_connection_call_sync(g_dbus_proxy_get_connection(proxy),
+											priv->dbusBusName,
+											priv->dbusObjectPath,
+											XFDASHBOARD_GNOME_SHELL_SEARCH_PROVIDER_DBUS_INTERFACE,
+											"LaunchSearch",
+											g_variant_new("(^asu)",
+															inSearchTerms,
+															clutter_get_current_event_time()),
+											NULL,
+											G_DBUS_CALL_FLAGS_NONE,
+											-1,
+											NULL,
+											&error);
 	if(!proxyResult)
 	{
 		/* Show error message */
@@ -975,7 +1413,6 @@ static gboolean _xfdashboard_gnome_shell_search_provider_launch_search(Xfdashboa
 
 		/* Release allocated resources */
 		if(error) g_error_free(error);
-		if(proxy) g_object_unref(proxy);
 
 		/* Return FALSE to indicate error */
 		return(FALSE);
@@ -983,7 +1420,6 @@ static gboolean _xfdashboard_gnome_shell_search_provider_launch_search(Xfdashboa
 
 	/* Release allocated resources */
 	if(proxyResult) g_variant_unref(proxyResult);
-	if(proxy) g_object_unref(proxy);
 
 	/* If we get here launching search was successful, so return TRUE */
 	return(TRUE);
@@ -998,6 +1434,12 @@ static void _xfdashboard_gnome_shell_search_provider_dispose(GObject *inObject)
 	XfdashboardGnomeShellSearchProviderPrivate	*priv=self->priv;
 
 	/* Release allocated resources */
+	if(priv->proxy)
+	{
+		g_object_unref(priv->proxy);
+		priv->proxy=NULL;
+	}
+
 	if(priv->gnomeShellID)
 	{
 		g_free(priv->gnomeShellID);
@@ -1066,6 +1508,9 @@ void xfdashboard_gnome_shell_search_provider_class_init(XfdashboardGnomeShellSea
 	providerClass->get_icon=_xfdashboard_gnome_shell_search_provider_get_icon;
 	providerClass->get_name=_xfdashboard_gnome_shell_search_provider_get_name;
 	providerClass->get_result_set=_xfdashboard_gnome_shell_search_provider_get_result_set;
+	providerClass->begin_search_job=_xfdashboard_gnome_shell_search_provider_begin_search_job;
+	providerClass->run_search_job=_xfdashboard_gnome_shell_search_provider_run_search_job;
+	providerClass->end_search_job=_xfdashboard_gnome_shell_search_provider_end_search_job;
 	providerClass->create_result_actor=_xfdashboard_gnome_shell_search_provider_create_result_actor;
 	providerClass->activate_result=_xfdashboard_gnome_shell_search_provider_activate_result;
 	providerClass->launch_search=_xfdashboard_gnome_shell_search_provider_launch_search;
@@ -1097,4 +1542,8 @@ void xfdashboard_gnome_shell_search_provider_init(XfdashboardGnomeShellSearchPro
 	priv->dbusObjectPath=NULL;
 	priv->providerName=NULL;
 	priv->providerIcon=NULL;
+	priv->proxy=NULL;
+	priv->activationPending=FALSE;
+	priv->latencyBudget=DEFAULT_LATENCY_BUDGET;
+	priv->activationInterval=DEFAULT_ACTIVATION_INTERVAL;
 }
@@ -29,6 +29,7 @@
 #include <libxfce4util/libxfce4util.h>
 
 #include "gnome-shell-search-provider.h"
+#include "gnome-shell-search-provider-discovery.h"
 
 
 /* IMPLEMENTATION: Private variables and methods */
@@ -36,8 +37,9 @@ typedef struct _XfdashboardGnomeShellSearchProviderPluginPrivate	XfdashboardGnom
 struct _XfdashboardGnomeShellSearchProviderPluginPrivate
 {
 	/* Private structure */
-	GList			*providers;
-	GFileMonitor	*fileMonitor;
+	GList											*providers;
+	GFileMonitor									*fileMonitor;
+	XfdashboardGnomeShellSearchProviderDiscovery	*discovery;
 };
 
 
@@ -187,134 +189,56 @@ static void _xfdashboard_gnome_shell_search_provider_plugin_on_file_monitor_chan
 	if(searchManager) g_object_unref(searchManager);
 }
 
-/* Plugin enable function */
-static void plugin_enable(XfdashboardPlugin *self, gpointer inUserData)
+/* Discovery of Gnome-Shell search providers has finished */
+static void _xfdashboard_gnome_shell_search_provider_plugin_on_discovery_done(XfdashboardGnomeShellSearchProviderDiscovery *inDiscovery,
+																				GKeyFile *inProviders,
+																				gpointer inUserData)
 {
 	XfdashboardGnomeShellSearchProviderPluginPrivate	*priv;
 	XfdashboardSearchManager							*searchManager;
 	GFile												*gnomeShellSearchProvidersPath;
-	GFileEnumerator										*enumerator;
-	GFileInfo											*info;
+	gchar												**gnomeShellIDs;
+	gchar												**iter;
+	gchar												*providerName;
+	gboolean											success;
 	GError												*error;
-	gchar												*pluginID;
 
 	g_return_if_fail(inUserData);
 
 	priv=(XfdashboardGnomeShellSearchProviderPluginPrivate*)inUserData;
 	error=NULL;
 
-	/* Get plugin's ID */
-	g_object_get(G_OBJECT(self), "id", &pluginID, NULL);
-	g_debug("Enabling plugin '%s'", pluginID);
-
-	/* Get path where Gnome-Shell search providers are stored at */
-	gnomeShellSearchProvidersPath=g_file_new_for_path(GNOME_SHELL_PROVIDERS_PATH);
-	g_debug("Scanning directory '%s' for Gnome-Shell search providers",
-				GNOME_SHELL_PROVIDERS_PATH);
-
 	/* Get search manager where to register search providers at */
 	searchManager=xfdashboard_search_manager_get_default();
 
-	/* Create enumerator for search providers path to iterate through path and
-	 * register search providers found.
-	 */
-	enumerator=g_file_enumerate_children(gnomeShellSearchProvidersPath,
-											G_FILE_ATTRIBUTE_STANDARD_TYPE "," G_FILE_ATTRIBUTE_STANDARD_NAME,
-											G_FILE_QUERY_INFO_NONE,
-											NULL,
-											&error);
-	if(!enumerator)
+	/* Register a search provider for each Gnome-Shell search provider discovered */
+	gnomeShellIDs=g_key_file_get_groups(inProviders, NULL);
+	for(iter=gnomeShellIDs; iter && *iter; iter++)
 	{
-		/* Show error message */
-		g_warning(_("Could not scan for gnome-shell search provider at '%s': %s"),
-					GNOME_SHELL_PROVIDERS_PATH,
-					(error && error->message) ? error->message : _("Unknown error"));
-
-		/* Release allocated resources */
-		if(error) g_error_free(error);
-		if(pluginID) g_free(pluginID);
-		if(searchManager) g_object_unref(searchManager);
-		if(gnomeShellSearchProvidersPath) g_object_unref(gnomeShellSearchProvidersPath);
-
-		return;
-	}
-
-
-	/* Iterate through files in search providers path and for each
-	 * ".ini" file found register a search provider
-	 */
-	while((info=g_file_enumerator_next_file(enumerator, NULL, &error)))
-	{
-		/* If current iterated file ends with ".ini" then assume it is a Gnome-Shell
-		 * search provider and register it.
+		/* Build unique provider name for Gnome-Shell search provider
+		 * using this plugin.
 		 */
-		if(g_file_info_get_file_type(info)==G_FILE_TYPE_REGULAR &&
-			g_str_has_suffix(g_file_info_get_name(info), ".ini"))
-		{
-			const gchar			*infoFilename;
-			GFile				*infoFile;
-			GError				*infoError;
-			gchar				*providerName;
-			gboolean			success;
-
-			infoError=NULL;
-
-			/* Get file for current one from enumerator */
-			infoFilename=g_file_info_get_name(info);
-			infoFile=g_file_get_child(g_file_enumerator_get_container(enumerator), infoFilename);
+		providerName=g_strdup_printf("%s.%s", PLUGIN_ID, *iter);
 
-			/* Get provider name for file and register Gnome-Shell search provider */
-			providerName=_xfdashboard_gnome_shell_search_provider_plugin_get_provider_name_from_file(infoFile, &infoError);
-			if(providerName)
+		/* Register search provider */
+		success=xfdashboard_search_manager_register(searchManager, providerName, XFDASHBOARD_TYPE_GNOME_SHELL_SEARCH_PROVIDER);
+		if(success)
+		{
+			priv->providers=g_list_prepend(priv->providers, g_strdup(providerName));
+			g_debug("Successfully registered Gnome-Shell search provider '%s' with ID '%s'", *iter, providerName);
+		}
+			else
 			{
-				/* Register search provider */
-				success=xfdashboard_search_manager_register(searchManager, providerName, XFDASHBOARD_TYPE_GNOME_SHELL_SEARCH_PROVIDER);
-				if(success)
-				{
-					priv->providers=g_list_prepend(priv->providers, g_strdup(providerName));
-					g_debug("Successfully registered Gnome-Shell search provider at file '%s' with ID '%s'", infoFilename, providerName);
-				}
-					else
-					{
-						g_debug("Failed to register Gnome-Shell search provider at file '%s' with ID '%s'", infoFilename, providerName);
-					}
+				g_debug("Failed to register Gnome-Shell search provider '%s' with ID '%s'", *iter, providerName);
 			}
-				else
-				{
-					/* Show warning */
-					g_warning(_("Could not register Gnome-Shell search provider at file '%s': %s"),
-								infoFilename,
-								(infoError && infoError->message) ? infoError->message : _("Unknown error"));
-				}
-
-			/* Release allocated resources */
-			if(infoError) g_error_free(infoError);
-			if(infoFile) g_object_unref(infoFile);
-			if(providerName) g_free(providerName);
-		}
 
 		/* Release allocated resources */
-		g_object_unref(info);
-	}
-
-	if(error)
-	{
-		/* Show error message */
-		g_warning(_("Could not scan for gnome-shell search provider at '%s': %s"),
-					GNOME_SHELL_PROVIDERS_PATH,
-					(error && error->message) ? error->message : _("Unknown error"));
-
-		/* Release allocated resources */
-		if(error) g_error_free(error);
-		if(pluginID) g_free(pluginID);
-		if(enumerator) g_object_unref(enumerator);
-		if(searchManager) g_object_unref(searchManager);
-		if(gnomeShellSearchProvidersPath) g_object_unref(gnomeShellSearchProvidersPath);
-
-		return;
+		g_free(providerName);
 	}
 
 	/* Create monitor to get notified about new, changed and removed search providers */
+	gnomeShellSearchProvidersPath=g_file_new_for_path(GNOME_SHELL_PROVIDERS_PATH);
+
 	priv->fileMonitor=g_file_monitor_directory(gnomeShellSearchProvidersPath, G_FILE_MONITOR_NONE, NULL, &error);
 	if(priv->fileMonitor)
 	{
@@ -344,16 +268,50 @@ static void plugin_enable(XfdashboardPlugin *self, gpointer inUserData)
 		}
 
 	/* Release allocated resources */
-	g_debug("Enabled plugin '%s' with %d search providers",
-				pluginID,
+	g_debug("Registered %d Gnome-Shell search providers",
 				g_list_length(priv->providers));
 
-	if(pluginID) g_free(pluginID);
-	if(enumerator) g_object_unref(enumerator);
+	if(gnomeShellIDs) g_strfreev(gnomeShellIDs);
 	if(searchManager) g_object_unref(searchManager);
 	if(gnomeShellSearchProvidersPath) g_object_unref(gnomeShellSearchProvidersPath);
 }
 
+/* Plugin enable function */
+static void plugin_enable(XfdashboardPlugin *self, gpointer inUserData)
+{
+	XfdashboardGnomeShellSearchProviderPluginPrivate	*priv;
+	gchar												*pluginID;
+	gchar												*cacheFile;
+
+	g_return_if_fail(inUserData);
+
+	priv=(XfdashboardGnomeShellSearchProviderPluginPrivate*)inUserData;
+
+	/* Get plugin's ID */
+	g_object_get(G_OBJECT(self), "id", &pluginID, NULL);
+	g_debug("Enabling plugin '%s'", pluginID);
+
+	/* Discover Gnome-Shell search providers in background and register them
+	 * when done. The search providers found are cached in user's cache
+	 * directory and only discovered again if the directory where they are
+	 * stored at has changed.
+	 */
+	cacheFile=g_build_filename(g_get_user_cache_dir(), "xfdashboard", "gnome-shell-search-providers", NULL);
+	priv->discovery=xfdashboard_gnome_shell_search_provider_discovery_new(GNOME_SHELL_PROVIDERS_PATH, cacheFile);
+	xfdashboard_gnome_shell_search_provider_discovery_set_default(priv->discovery);
+	xfdashboard_gnome_shell_search_provider_discovery_scan(priv->discovery,
+															_xfdashboard_gnome_shell_search_provider_plugin_on_discovery_done,
+															priv);
+
+	/* Release allocated resources */
+	g_debug("Enabled plugin '%s' and started discovery of search providers at '%s'",
+				pluginID,
+				GNOME_SHELL_PROVIDERS_PATH);
+
+	if(cacheFile) g_free(cacheFile);
+	if(pluginID) g_free(pluginID);
+}
+
 /* Plugin disable function */
 static void plugin_disable(XfdashboardPlugin *self, gpointer inUserData)
 {
@@ -417,6 +375,14 @@ static void plugin_disable(XfdashboardPlugin *self, gpointer inUserData)
 		g_list_free_full(priv->providers, g_free);
 		priv->providers=NULL;
 	}
+
+	/* Stop any running discovery of search providers */
+	if(priv->discovery)
+	{
+		xfdashboard_gnome_shell_search_provider_discovery_set_default(NULL);
+		xfdashboard_gnome_shell_search_provider_discovery_free(priv->discovery);
+		priv->discovery=NULL;
+	}
 }
 
 /* Plugin initialization function */
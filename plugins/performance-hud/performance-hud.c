@@ -0,0 +1,565 @@
+/*
+ * performance-hud: Shows a heads-up display with frame timings and
+ *                  library counters on stage
+ * 
+ * Copyright 2012-2016 Stephan Haller <nomad@froevel.de>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ * 
+ * 
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "performance-hud.h"
+
+#include <libxfdashboard/libxfdashboard.h>
+#include <glib/gi18n-lib.h>
+#include <gtk/gtk.h>
+
+
+/* Define this class in GObject system */
+G_DEFINE_DYNAMIC_TYPE(XfdashboardPerformanceHud,
+						xfdashboard_performance_hud,
+						G_TYPE_OBJECT)
+
+/* Define this class in this plugin */
+XFDASHBOARD_DEFINE_PLUGIN_TYPE(xfdashboard_performance_hud);
+
+/* Private structure - access only by public API if needed */
+#define XFDASHBOARD_PERFORMANCE_HUD_GET_PRIVATE(obj)         \
+	(G_TYPE_INSTANCE_GET_PRIVATE((obj), XFDASHBOARD_TYPE_PERFORMANCE_HUD, XfdashboardPerformanceHudPrivate))
+
+struct _XfdashboardPerformanceHudPrivate
+{
+	/* Instance related */
+	XfdashboardStage					*stage;
+	guint								stageDestroySignalID;
+	guint								stagePaintSignalID;
+	guint								stagePaintAfterSignalID;
+	guint								stagePickSignalID;
+	guint								stagePickAfterSignalID;
+	guint								stageActorAddedSignalID;
+
+	ClutterActor						*overlay;
+	gboolean							instrumentationEnabled;
+
+	guint								prePaintID;
+	guint								postPaintID;
+	guint								updateID;
+
+	/* Timestamps of current frame */
+	gint64								frameStartTime;
+	gint64								paintStartTime;
+	gint64								paintEndTime;
+	gint64								pickStartTime;
+
+	/* Timings accumulated since last update of display */
+	gint64								intervalStartTime;
+	guint								frames;
+	gint64								frameTime;
+	gint64								frameTimeMax;
+	gint64								layoutTime;
+	gint64								paintTime;
+	guint								picks;
+	gint64								pickTime;
+	gint64								restyles;
+};
+
+
+/* IMPLEMENTATION: Private variables and methods */
+#define XFDASHBOARD_PERFORMANCE_HUD_UPDATE_INTERVAL		500
+#define XFDASHBOARD_PERFORMANCE_HUD_FONT				"Monospace 9"
+#define XFDASHBOARD_PERFORMANCE_HUD_MARGIN				8.0f
+
+/* Convert microseconds to milliseconds and average them over number of samples */
+static gdouble _xfdashboard_performance_hud_average_ms(gint64 inTime, guint inSamples)
+{
+	if(inSamples==0) return(0.0);
+	return(((gdouble)inTime/1000.0)/(gdouble)inSamples);
+}
+
+/* Update text of heads-up display with timings and counters collected
+ * since last update.
+ */
+static gboolean _xfdashboard_performance_hud_on_update_timeout(gpointer inUserData)
+{
+	XfdashboardPerformanceHud			*self;
+	XfdashboardPerformanceHudPrivate	*priv;
+	gint64								currentTime;
+	gdouble								elapsed;
+	gint64								restyles;
+	gint64								cacheHits;
+	gint64								cacheLookups;
+	gint64								searches;
+	gint64								searchTime;
+	gchar								*text;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_PERFORMANCE_HUD(inUserData), G_SOURCE_REMOVE);
+
+	self=XFDASHBOARD_PERFORMANCE_HUD(inUserData);
+	priv=self->priv;
+
+	/* Do nothing if overlay was destroyed together with stage */
+	if(!priv->overlay) return(G_SOURCE_CONTINUE);
+
+	/* Get time elapsed since last update in seconds */
+	currentTime=g_get_monotonic_time();
+	elapsed=(gdouble)(currentTime-priv->intervalStartTime)/G_USEC_PER_SEC;
+	if(elapsed<=0.0) elapsed=1.0;
+
+	/* Get counters from library. Restyles are reported per second so only
+	 * the difference to last update is needed. All other counters are
+	 * reported as accumulated since plugin was enabled.
+	 */
+	restyles=xfdashboard_instrumentation_get(XFDASHBOARD_INSTRUMENTATION_COUNTER_RESTYLES);
+	cacheHits=xfdashboard_instrumentation_get(XFDASHBOARD_INSTRUMENTATION_COUNTER_IMAGE_CACHE_HITS);
+	cacheLookups=cacheHits+xfdashboard_instrumentation_get(XFDASHBOARD_INSTRUMENTATION_COUNTER_IMAGE_CACHE_MISSES);
+	searches=xfdashboard_instrumentation_get(XFDASHBOARD_INSTRUMENTATION_COUNTER_SEARCHES);
+	searchTime=xfdashboard_instrumentation_get(XFDASHBOARD_INSTRUMENTATION_COUNTER_SEARCH_TIME);
+
+	/* Build text and set it only if it changed as setting text queues a
+	 * relayout and redraw of stage which would influence the timings shown.
+	 */
+	text=g_strdup_printf(_("Frames: %.1f fps\n"
+							"Frame: %.2f ms avg, %.2f ms max\n"
+							"Layout: %.2f ms  Paint: %.2f ms\n"
+							"Pick: %.2f ms avg, %u picks\n"
+							"Restyles: %.1f/s\n"
+							"Window textures: %" G_GINT64_FORMAT "\n"
+							"Image cache: %.1f%% hits of %" G_GINT64_FORMAT " lookups\n"
+							"Search: %.2f ms avg of %" G_GINT64_FORMAT " searches"),
+							(gdouble)priv->frames/elapsed,
+							_xfdashboard_performance_hud_average_ms(priv->frameTime, priv->frames),
+							_xfdashboard_performance_hud_average_ms(priv->frameTimeMax, 1),
+							_xfdashboard_performance_hud_average_ms(priv->layoutTime, priv->frames),
+							_xfdashboard_performance_hud_average_ms(priv->paintTime, priv->frames),
+							_xfdashboard_performance_hud_average_ms(priv->pickTime, priv->picks),
+							priv->picks,
+							(gdouble)(restyles-priv->restyles)/elapsed,
+							xfdashboard_instrumentation_get(XFDASHBOARD_INSTRUMENTATION_COUNTER_WINDOW_CONTENTS),
+							cacheLookups>0 ? ((gdouble)cacheHits*100.0)/(gdouble)cacheLookups : 0.0,
+							cacheLookups,
+							_xfdashboard_performance_hud_average_ms(searchTime, (guint)searches),
+							searches);
+	if(g_strcmp0(clutter_text_get_text(CLUTTER_TEXT(priv->overlay)), text)!=0)
+	{
+		clutter_text_set_text(CLUTTER_TEXT(priv->overlay), text);
+	}
+	g_free(text);
+
+	/* Start new interval */
+	priv->intervalStartTime=currentTime;
+	priv->frames=0;
+	priv->frameTime=0;
+	priv->frameTimeMax=0;
+	priv->layoutTime=0;
+	priv->paintTime=0;
+	priv->picks=0;
+	priv->pickTime=0;
+	priv->restyles=restyles;
+
+	return(G_SOURCE_CONTINUE);
+}
+
+/* A new frame is going to be processed by master clock */
+static gboolean _xfdashboard_performance_hud_on_pre_paint(gpointer inUserData)
+{
+	XfdashboardPerformanceHudPrivate	*priv;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_PERFORMANCE_HUD(inUserData), FALSE);
+
+	priv=XFDASHBOARD_PERFORMANCE_HUD(inUserData)->priv;
+
+	/* Remember start of frame and forget about paint of previous one */
+	priv->frameStartTime=g_get_monotonic_time();
+	priv->paintStartTime=0;
+	priv->paintEndTime=0;
+
+	return(TRUE);
+}
+
+/* Frame was processed by master clock */
+static gboolean _xfdashboard_performance_hud_on_post_paint(gpointer inUserData)
+{
+	XfdashboardPerformanceHudPrivate	*priv;
+	gint64								frameTime;
+
+	g_return_val_if_fail(XFDASHBOARD_IS_PERFORMANCE_HUD(inUserData), FALSE);
+
+	priv=XFDASHBOARD_PERFORMANCE_HUD(inUserData)->priv;
+
+	/* Only count frames which were painted as master clock may also run
+	 * to advance timelines without any stage to redraw.
+	 */
+	if(priv->frameStartTime>0 && priv->paintStartTime>0 && priv->paintEndTime>0)
+	{
+		frameTime=g_get_monotonic_time()-priv->frameStartTime;
+
+		priv->frames++;
+		priv->frameTime+=frameTime;
+		if(frameTime>priv->frameTimeMax) priv->frameTimeMax=frameTime;
+
+		/* Everything done between start of frame and begin of painting
+		 * is mostly relayouting of stage.
+		 */
+		priv->layoutTime+=priv->paintStartTime-priv->frameStartTime;
+		priv->paintTime+=priv->paintEndTime-priv->paintStartTime;
+	}
+
+	priv->frameStartTime=0;
+
+	return(TRUE);
+}
+
+/* Stage is going to be painted */
+static void _xfdashboard_performance_hud_on_stage_paint(XfdashboardPerformanceHud *self,
+														gpointer inUserData)
+{
+	g_return_if_fail(XFDASHBOARD_IS_PERFORMANCE_HUD(self));
+
+	self->priv->paintStartTime=g_get_monotonic_time();
+}
+
+/* Stage was painted */
+static void _xfdashboard_performance_hud_on_stage_paint_after(XfdashboardPerformanceHud *self,
+																gpointer inUserData)
+{
+	g_return_if_fail(XFDASHBOARD_IS_PERFORMANCE_HUD(self));
+
+	self->priv->paintEndTime=g_get_monotonic_time();
+}
+
+/* Stage is going to be picked */
+static void _xfdashboard_performance_hud_on_stage_pick(XfdashboardPerformanceHud *self,
+														const ClutterColor *inColor,
+														gpointer inUserData)
+{
+	g_return_if_fail(XFDASHBOARD_IS_PERFORMANCE_HUD(self));
+
+	self->priv->pickStartTime=g_get_monotonic_time();
+}
+
+/* Stage was picked */
+static void _xfdashboard_performance_hud_on_stage_pick_after(XfdashboardPerformanceHud *self,
+																const ClutterColor *inColor,
+																gpointer inUserData)
+{
+	XfdashboardPerformanceHudPrivate	*priv;
+
+	g_return_if_fail(XFDASHBOARD_IS_PERFORMANCE_HUD(self));
+
+	priv=self->priv;
+
+	if(priv->pickStartTime>0)
+	{
+		priv->picks++;
+		priv->pickTime+=g_get_monotonic_time()-priv->pickStartTime;
+		priv->pickStartTime=0;
+	}
+}
+
+/* An actor was added to stage so keep overlay above it */
+static void _xfdashboard_performance_hud_on_stage_actor_added(XfdashboardPerformanceHud *self,
+																ClutterActor *inActor,
+																gpointer inUserData)
+{
+	XfdashboardPerformanceHudPrivate	*priv;
+
+	g_return_if_fail(XFDASHBOARD_IS_PERFORMANCE_HUD(self));
+	g_return_if_fail(CLUTTER_IS_ACTOR(inActor));
+
+	priv=self->priv;
+
+	if(priv->overlay && inActor!=priv->overlay)
+	{
+		clutter_actor_set_child_above_sibling(CLUTTER_ACTOR(priv->stage), priv->overlay, NULL);
+	}
+}
+
+/* Disconnect signals from stage and release overlay */
+static void _xfdashboard_performance_hud_release_stage(XfdashboardPerformanceHud *self)
+{
+	XfdashboardPerformanceHudPrivate	*priv;
+
+	g_return_if_fail(XFDASHBOARD_IS_PERFORMANCE_HUD(self));
+
+	priv=self->priv;
+
+	if(!priv->stage) return;
+
+	/* Disconnect signals */
+	if(priv->stageDestroySignalID)
+	{
+		g_signal_handler_disconnect(priv->stage, priv->stageDestroySignalID);
+		priv->stageDestroySignalID=0;
+	}
+
+	if(priv->stagePaintSignalID)
+	{
+		g_signal_handler_disconnect(priv->stage, priv->stagePaintSignalID);
+		priv->stagePaintSignalID=0;
+	}
+
+	if(priv->stagePaintAfterSignalID)
+	{
+		g_signal_handler_disconnect(priv->stage, priv->stagePaintAfterSignalID);
+		priv->stagePaintAfterSignalID=0;
+	}
+
+	if(priv->stagePickSignalID)
+	{
+		g_signal_handler_disconnect(priv->stage, priv->stagePickSignalID);
+		priv->stagePickSignalID=0;
+	}
+
+	if(priv->stagePickAfterSignalID)
+	{
+		g_signal_handler_disconnect(priv->stage, priv->stagePickAfterSignalID);
+		priv->stagePickAfterSignalID=0;
+	}
+
+	if(priv->stageActorAddedSignalID)
+	{
+		g_signal_handler_disconnect(priv->stage, priv->stageActorAddedSignalID);
+		priv->stageActorAddedSignalID=0;
+	}
+
+	/* Destroy overlay */
+	if(priv->overlay)
+	{
+		clutter_actor_destroy(priv->overlay);
+		priv->overlay=NULL;
+	}
+
+	/* Release stage */
+	priv->stage=NULL;
+}
+
+/* Stage is going to be destroyed */
+static void _xfdashboard_performance_hud_on_stage_destroyed(XfdashboardPerformanceHud *self,
+															gpointer inUserData)
+{
+	XfdashboardStage					*stage;
+
+	g_return_if_fail(XFDASHBOARD_IS_PERFORMANCE_HUD(self));
+	g_return_if_fail(XFDASHBOARD_IS_STAGE(inUserData));
+
+	stage=XFDASHBOARD_STAGE(inUserData);
+
+	/* Release stage but only if it the stage we are handling right now
+	 * (this should always be the case!)
+	 */
+	if(self->priv->stage==stage) _xfdashboard_performance_hud_release_stage(self);
+}
+
+/* IMPLEMENTATION: GObject */
+
+/* Dispose this object */
+static void _xfdashboard_performance_hud_dispose(GObject *inObject)
+{
+	XfdashboardPerformanceHud			*self=XFDASHBOARD_PERFORMANCE_HUD(inObject);
+	XfdashboardPerformanceHudPrivate	*priv=self->priv;
+
+	/* Release allocated resources */
+	if(priv->updateID)
+	{
+		g_source_remove(priv->updateID);
+		priv->updateID=0;
+	}
+
+	if(priv->prePaintID)
+	{
+		clutter_threads_remove_repaint_func(priv->prePaintID);
+		priv->prePaintID=0;
+	}
+
+	if(priv->postPaintID)
+	{
+		clutter_threads_remove_repaint_func(priv->postPaintID);
+		priv->postPaintID=0;
+	}
+
+	_xfdashboard_performance_hud_release_stage(self);
+
+	if(priv->instrumentationEnabled)
+	{
+		xfdashboard_instrumentation_disable();
+		priv->instrumentationEnabled=FALSE;
+	}
+
+	/* Call parent's class dispose method */
+	G_OBJECT_CLASS(xfdashboard_performance_hud_parent_class)->dispose(inObject);
+}
+
+/* Class initialization
+ * Override functions in parent classes and define properties
+ * and signals
+ */
+void xfdashboard_performance_hud_class_init(XfdashboardPerformanceHudClass *klass)
+{
+	GObjectClass			*gobjectClass=G_OBJECT_CLASS(klass);
+
+	/* Override functions */
+	gobjectClass->dispose=_xfdashboard_performance_hud_dispose;
+
+	/* Set up private structure */
+	g_type_class_add_private(klass, sizeof(XfdashboardPerformanceHudPrivate));
+}
+
+/* Class finalization */
+void xfdashboard_performance_hud_class_finalize(XfdashboardPerformanceHudClass *klass)
+{
+}
+
+/* Object initialization
+ * Create private structure and set up default values
+ */
+void xfdashboard_performance_hud_init(XfdashboardPerformanceHud *self)
+{
+	XfdashboardPerformanceHudPrivate	*priv;
+	ClutterColor						textColor;
+	ClutterColor						backgroundColor;
+
+	self->priv=priv=XFDASHBOARD_PERFORMANCE_HUD_GET_PRIVATE(self);
+
+	/* Set up default values */
+	priv->stage=xfdashboard_application_get_stage(NULL);
+	priv->stageDestroySignalID=0;
+	priv->stagePaintSignalID=0;
+	priv->stagePaintAfterSignalID=0;
+	priv->stagePickSignalID=0;
+	priv->stagePickAfterSignalID=0;
+	priv->stageActorAddedSignalID=0;
+	priv->overlay=NULL;
+	priv->instrumentationEnabled=FALSE;
+	priv->prePaintID=0;
+	priv->postPaintID=0;
+	priv->updateID=0;
+	priv->frameStartTime=0;
+	priv->paintStartTime=0;
+	priv->paintEndTime=0;
+	priv->pickStartTime=0;
+	priv->intervalStartTime=g_get_monotonic_time();
+	priv->frames=0;
+	priv->frameTime=0;
+	priv->frameTimeMax=0;
+	priv->layoutTime=0;
+	priv->paintTime=0;
+	priv->picks=0;
+	priv->pickTime=0;
+	priv->restyles=0;
+
+	if(!priv->stage)
+	{
+		g_warning(_("Could not set up performance HUD because no stage is available"));
+		return;
+	}
+
+	/* Start collecting counters in library */
+	xfdashboard_instrumentation_enable();
+	priv->instrumentationEnabled=TRUE;
+	priv->restyles=xfdashboard_instrumentation_get(XFDASHBOARD_INSTRUMENTATION_COUNTER_RESTYLES);
+
+	/* Create overlay showing timings and counters on top of all other actors */
+	clutter_color_init(&textColor, 0xff, 0xff, 0xff, 0xff);
+	clutter_color_init(&backgroundColor, 0x00, 0x00, 0x00, 0xc0);
+
+	priv->overlay=clutter_text_new();
+	clutter_text_set_font_name(CLUTTER_TEXT(priv->overlay), XFDASHBOARD_PERFORMANCE_HUD_FONT);
+	clutter_text_set_color(CLUTTER_TEXT(priv->overlay), &textColor);
+	clutter_actor_set_background_color(priv->overlay, &backgroundColor);
+	clutter_actor_set_position(priv->overlay, XFDASHBOARD_PERFORMANCE_HUD_MARGIN, XFDASHBOARD_PERFORMANCE_HUD_MARGIN);
+	clutter_actor_set_reactive(priv->overlay, FALSE);
+	clutter_actor_add_child(CLUTTER_ACTOR(priv->stage), priv->overlay);
+	clutter_actor_set_child_above_sibling(CLUTTER_ACTOR(priv->stage), priv->overlay, NULL);
+
+	/* Clutter does not provide timings of the single phases of a frame so
+	 * measure them at the boundaries we can hook into: the master clock's
+	 * repaint functions enclose a frame and the stage's paint and pick
+	 * signals enclose painting and picking.
+	 */
+	priv->prePaintID=clutter_threads_add_repaint_func_full(CLUTTER_REPAINT_FLAGS_PRE_PAINT,
+															_xfdashboard_performance_hud_on_pre_paint,
+															self,
+															NULL);
+	priv->postPaintID=clutter_threads_add_repaint_func_full(CLUTTER_REPAINT_FLAGS_POST_PAINT,
+															_xfdashboard_performance_hud_on_post_paint,
+															self,
+															NULL);
+
+	priv->stagePaintSignalID=
+		g_signal_connect_swapped(priv->stage,
+									"paint",
+									G_CALLBACK(_xfdashboard_performance_hud_on_stage_paint),
+									self);
+	priv->stagePaintAfterSignalID=
+		g_signal_connect_data(priv->stage,
+								"paint",
+								G_CALLBACK(_xfdashboard_performance_hud_on_stage_paint_after),
+								self,
+								NULL,
+								G_CONNECT_SWAPPED | G_CONNECT_AFTER);
+
+	priv->stagePickSignalID=
+		g_signal_connect_swapped(priv->stage,
+									"pick",
+									G_CALLBACK(_xfdashboard_performance_hud_on_stage_pick),
+									self);
+	priv->stagePickAfterSignalID=
+		g_signal_connect_data(priv->stage,
+								"pick",
+								G_CALLBACK(_xfdashboard_performance_hud_on_stage_pick_after),
+								self,
+								NULL,
+								G_CONNECT_SWAPPED | G_CONNECT_AFTER);
+
+	/* Keep overlay above all actors added to stage later */
+	priv->stageActorAddedSignalID=
+		g_signal_connect_swapped(priv->stage,
+									"actor-added",
+									G_CALLBACK(_xfdashboard_performance_hud_on_stage_actor_added),
+									self);
+
+	/* Connect signal to get notified when stage is getting destoyed */
+	priv->stageDestroySignalID=
+		g_signal_connect_swapped(priv->stage,
+									"destroy",
+									G_CALLBACK(_xfdashboard_performance_hud_on_stage_destroyed),
+									self);
+
+	/* Update display periodically */
+	priv->updateID=g_timeout_add(XFDASHBOARD_PERFORMANCE_HUD_UPDATE_INTERVAL,
+									_xfdashboard_performance_hud_on_update_timeout,
+									self);
+	_xfdashboard_performance_hud_on_update_timeout(self);
+}
+
+
+/* IMPLEMENTATION: Public API */
+
+/* Create new instance */
+XfdashboardPerformanceHud* xfdashboard_performance_hud_new(void)
+{
+	GObject		*performanceHud;
+
+	performanceHud=g_object_new(XFDASHBOARD_TYPE_PERFORMANCE_HUD, NULL);
+	if(!performanceHud) return(NULL);
+
+	return(XFDASHBOARD_PERFORMANCE_HUD(performanceHud));
+}
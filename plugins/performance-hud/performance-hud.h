@@ -0,0 +1,68 @@
+/*
+ * performance-hud: Shows a heads-up display with frame timings and
+ *                  library counters on stage
+ * 
+ * Copyright 2012-2016 Stephan Haller <nomad@froevel.de>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ * 
+ * 
+ */
+
+#ifndef __XFDASHBOARD_PERFORMANCE_HUD__
+#define __XFDASHBOARD_PERFORMANCE_HUD__
+
+#include <libxfdashboard/libxfdashboard.h>
+
+G_BEGIN_DECLS
+
+#define XFDASHBOARD_TYPE_PERFORMANCE_HUD				(xfdashboard_performance_hud_get_type())
+#define XFDASHBOARD_PERFORMANCE_HUD(obj)				(G_TYPE_CHECK_INSTANCE_CAST((obj), XFDASHBOARD_TYPE_PERFORMANCE_HUD, XfdashboardPerformanceHud))
+#define XFDASHBOARD_IS_PERFORMANCE_HUD(obj)				(G_TYPE_CHECK_INSTANCE_TYPE((obj), XFDASHBOARD_TYPE_PERFORMANCE_HUD))
+#define XFDASHBOARD_PERFORMANCE_HUD_CLASS(klass)		(G_TYPE_CHECK_CLASS_CAST((klass), XFDASHBOARD_TYPE_PERFORMANCE_HUD, XfdashboardPerformanceHudClass))
+#define XFDASHBOARD_IS_PERFORMANCE_HUD_CLASS(klass)		(G_TYPE_CHECK_CLASS_TYPE((klass), XFDASHBOARD_TYPE_PERFORMANCE_HUD))
+#define XFDASHBOARD_PERFORMANCE_HUD_GET_CLASS(obj)		(G_TYPE_INSTANCE_GET_CLASS((obj), XFDASHBOARD_TYPE_PERFORMANCE_HUD, XfdashboardPerformanceHudClass))
+
+typedef struct _XfdashboardPerformanceHud				XfdashboardPerformanceHud; 
+typedef struct _XfdashboardPerformanceHudPrivate		XfdashboardPerformanceHudPrivate;
+typedef struct _XfdashboardPerformanceHudClass			XfdashboardPerformanceHudClass;
+
+struct _XfdashboardPerformanceHud
+{
+	/* Parent instance */
+	GObject								parent_instance;
+
+	/* Private structure */
+	XfdashboardPerformanceHudPrivate	*priv;
+};
+
+struct _XfdashboardPerformanceHudClass
+{
+	/*< private >*/
+	/* Parent class */
+	GObjectClass						parent_class;
+};
+
+/* Public API */
+GType xfdashboard_performance_hud_get_type(void) G_GNUC_CONST;
+
+XFDASHBOARD_DECLARE_PLUGIN_TYPE(xfdashboard_performance_hud);
+
+XfdashboardPerformanceHud* xfdashboard_performance_hud_new(void);
+
+G_END_DECLS
+
+#endif
@@ -0,0 +1,573 @@
+/*
+ * benchmark-desktop-entry: Measure parsing of desktop files by the
+ *                          locale-filtered parser of desktop app infos
+ *                          against loading them into key files and the
+ *                          memory used by the parsed desktop entries
+ * 
+ * Copyright 2012-2016 Stephan Haller <nomad@froevel.de>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ * 
+ * 
+ */
+
+#include "config.h"
+
+#include <glib.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#ifdef HAVE_MALLOC_H
+#include <malloc.h>
+#endif
+
+#include <libxfdashboard/desktop-entry.h>
+
+
+/* IMPLEMENTATION: Private variables and methods */
+#define BENCHMARK_DEFAULT_DIRECTORY		"/usr/share/applications"
+#define BENCHMARK_DEFAULT_ROUNDS		20
+#define BENCHMARK_DESKTOP_GROUP			"Desktop Entry"
+
+/* Options */
+static gint			_benchmark_rounds=BENCHMARK_DEFAULT_ROUNDS;
+static gchar		**_benchmark_directories=NULL;
+
+static GOptionEntry	_benchmark_options[]=
+{
+	{ "rounds", 'r', 0, G_OPTION_ARG_INT, &_benchmark_rounds, "Number of times all desktop files are parsed", "N" },
+	{ G_OPTION_REMAINING, 0, 0, G_OPTION_ARG_FILENAME_ARRAY, &_benchmark_directories, NULL, "[DIRECTORY...]" },
+	{ NULL }
+};
+
+/* Content of a desktop file read before parsing, so reading from disk is
+ * not measured.
+ */
+typedef struct _BenchmarkDesktopFile		BenchmarkDesktopFile;
+struct _BenchmarkDesktopFile
+{
+	gchar				*filename;
+	gchar				*contents;
+	gsize				length;
+};
+
+/* Values of desktop entry as desktop app infos stored them before they were
+ * packed into one memory block, i.e. each string allocated separately.
+ */
+typedef struct _BenchmarkSeparateEntry		BenchmarkSeparateEntry;
+struct _BenchmarkSeparateEntry
+{
+	gchar				*name;
+	gchar				*comment;
+	gchar				*command;
+	gchar				*binaryExecutable;
+	gchar				*iconName;
+	gchar				*path;
+	guint				requiresTerminal : 1;
+	guint				supportsStartupNotification : 1;
+	guint				isHidden : 1;
+	guint				noDisplay : 1;
+	guint				showInEnvironment : 1;
+};
+
+/* Memory used by process at a point of time */
+typedef struct _BenchmarkMemory				BenchmarkMemory;
+struct _BenchmarkMemory
+{
+	gsize				heap;
+	gsize				resident;
+};
+
+/* Read all desktop files of a directory and its sub-directories */
+static void _benchmark_read_directory(const gchar *inDirectory, GArray *ioFiles, gsize *ioBytes)
+{
+	GDir					*directory;
+	const gchar				*name;
+
+	directory=g_dir_open(inDirectory, 0, NULL);
+	if(!directory)
+	{
+		g_printerr("Could not open directory '%s'\n", inDirectory);
+		return;
+	}
+
+	while((name=g_dir_read_name(directory)))
+	{
+		BenchmarkDesktopFile	file;
+
+		file.filename=g_build_filename(inDirectory, name, NULL);
+
+		if(g_file_test(file.filename, G_FILE_TEST_IS_DIR))
+		{
+			_benchmark_read_directory(file.filename, ioFiles, ioBytes);
+			g_free(file.filename);
+			continue;
+		}
+
+		if(!g_str_has_suffix(name, ".desktop") ||
+			!g_file_get_contents(file.filename, &file.contents, &file.length, NULL))
+		{
+			g_free(file.filename);
+			continue;
+		}
+
+		*ioBytes+=file.length;
+		g_array_append_val(ioFiles, file);
+	}
+
+	g_dir_close(directory);
+}
+
+/* Parse desktop file like menu items of garcon did before: load all keys and
+ * all their translations into a key file and get the values of menu item from
+ * it. Returns TRUE if desktop file is valid.
+ */
+static gboolean _benchmark_parse_key_file(const BenchmarkDesktopFile *inFile, gchar **outName, gchar **outCommand)
+{
+	GKeyFile			*keyFile;
+	gchar				*name;
+	gchar				*genericName;
+	gchar				*comment;
+	gchar				*command;
+	gchar				*tryExec;
+	gchar				*iconName;
+	gchar				*path;
+	gchar				**keywords;
+	gchar				**categories;
+	gchar				**onlyShowIn;
+	gchar				**notShowIn;
+	gboolean			requiresTerminal;
+	gboolean			supportsStartupNotification;
+	gboolean			isHidden;
+	gboolean			noDisplay;
+
+	keyFile=g_key_file_new();
+	if(!g_key_file_load_from_data(keyFile, inFile->contents, inFile->length, G_KEY_FILE_NONE, NULL))
+	{
+		g_key_file_free(keyFile);
+		return(FALSE);
+	}
+
+	name=g_key_file_get_locale_string(keyFile, BENCHMARK_DESKTOP_GROUP, "Name", NULL, NULL);
+	genericName=g_key_file_get_locale_string(keyFile, BENCHMARK_DESKTOP_GROUP, "GenericName", NULL, NULL);
+	comment=g_key_file_get_locale_string(keyFile, BENCHMARK_DESKTOP_GROUP, "Comment", NULL, NULL);
+	keywords=g_key_file_get_locale_string_list(keyFile, BENCHMARK_DESKTOP_GROUP, "Keywords", NULL, NULL, NULL);
+	command=g_key_file_get_string(keyFile, BENCHMARK_DESKTOP_GROUP, "Exec", NULL);
+	tryExec=g_key_file_get_string(keyFile, BENCHMARK_DESKTOP_GROUP, "TryExec", NULL);
+	iconName=g_key_file_get_string(keyFile, BENCHMARK_DESKTOP_GROUP, "Icon", NULL);
+	path=g_key_file_get_string(keyFile, BENCHMARK_DESKTOP_GROUP, "Path", NULL);
+	categories=g_key_file_get_string_list(keyFile, BENCHMARK_DESKTOP_GROUP, "Categories", NULL, NULL);
+	onlyShowIn=g_key_file_get_string_list(keyFile, BENCHMARK_DESKTOP_GROUP, "OnlyShowIn", NULL, NULL);
+	notShowIn=g_key_file_get_string_list(keyFile, BENCHMARK_DESKTOP_GROUP, "NotShowIn", NULL, NULL);
+	requiresTerminal=g_key_file_get_boolean(keyFile, BENCHMARK_DESKTOP_GROUP, "Terminal", NULL);
+	supportsStartupNotification=g_key_file_get_boolean(keyFile, BENCHMARK_DESKTOP_GROUP, "StartupNotify", NULL);
+	isHidden=g_key_file_get_boolean(keyFile, BENCHMARK_DESKTOP_GROUP, "Hidden", NULL);
+	noDisplay=g_key_file_get_boolean(keyFile, BENCHMARK_DESKTOP_GROUP, "NoDisplay", NULL);
+
+	(void)requiresTerminal;
+	(void)supportsStartupNotification;
+	(void)isHidden;
+	(void)noDisplay;
+
+	g_free(genericName);
+	g_free(comment);
+	g_free(tryExec);
+	g_free(iconName);
+	g_free(path);
+	g_strfreev(keywords);
+	g_strfreev(categories);
+	g_strfreev(onlyShowIn);
+	g_strfreev(notShowIn);
+	g_key_file_free(keyFile);
+
+	if(!name || !command)
+	{
+		g_free(name);
+		g_free(command);
+		return(FALSE);
+	}
+
+	if(outName) *outName=name;
+		else g_free(name);
+
+	if(outCommand) *outCommand=command;
+		else g_free(command);
+
+	return(TRUE);
+}
+
+/* Count categories of all desktop files and the number of distinct ones */
+static void _benchmark_count_categories(GArray *inFiles, guint *outCategories, guint *outDistinct)
+{
+	GHashTable			*distinct;
+	GKeyFile			*keyFile;
+	gchar				**categories;
+	gchar				**iter;
+	guint				i;
+
+	*outCategories=0;
+	distinct=g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+	for(i=0; i<inFiles->len; i++)
+	{
+		const BenchmarkDesktopFile	*file;
+
+		file=&g_array_index(inFiles, BenchmarkDesktopFile, i);
+
+		keyFile=g_key_file_new();
+		if(g_key_file_load_from_data(keyFile, file->contents, file->length, G_KEY_FILE_NONE, NULL))
+		{
+			categories=g_key_file_get_string_list(keyFile, BENCHMARK_DESKTOP_GROUP, "Categories", NULL, NULL);
+			for(iter=categories; iter && *iter; iter++)
+			{
+				(*outCategories)++;
+				if(!g_hash_table_contains(distinct, *iter)) g_hash_table_add(distinct, g_strdup(*iter));
+			}
+			g_strfreev(categories);
+		}
+		g_key_file_free(keyFile);
+	}
+
+	*outDistinct=g_hash_table_size(distinct);
+	g_hash_table_destroy(distinct);
+}
+
+/* Get size of memory block of a desktop entry */
+static gsize _benchmark_get_entry_size(const XfdashboardDesktopEntry *inEntry)
+{
+	gsize				size;
+
+	size=sizeof(XfdashboardDesktopEntry);
+	size+=strlen(inEntry->name)+1;
+	if(inEntry->comment) size+=strlen(inEntry->comment)+1;
+	size+=strlen(inEntry->command)+1;
+	size+=strlen(inEntry->binaryExecutable)+1;
+	if(inEntry->iconName) size+=strlen(inEntry->iconName)+1;
+	if(inEntry->path) size+=strlen(inEntry->path)+1;
+
+	return(size);
+}
+
+/* Get memory used by process. Heap memory in use including the overhead of
+ * each allocation is only known if mallinfo2() is available. Resident memory
+ * is only known on systems providing /proc/self/statm. Free memory is given
+ * back to system before if possible, so resident memory grows by the memory
+ * allocated afterwards and not only by reusing freed memory.
+ */
+static void _benchmark_get_memory(BenchmarkMemory *outMemory)
+{
+	gchar				*statm;
+	gchar				**values;
+
+	outMemory->heap=0;
+	outMemory->resident=0;
+
+#ifdef HAVE_MALLOC_TRIM
+	malloc_trim(0);
+#endif
+
+#ifdef HAVE_MALLINFO2
+	outMemory->heap=mallinfo2().uordblks;
+#endif
+
+	if(g_file_get_contents("/proc/self/statm", &statm, NULL, NULL))
+	{
+		values=g_strsplit(statm, " ", -1);
+		if(values[0] && values[1]) outMemory->resident=g_ascii_strtoull(values[1], NULL, 10)*sysconf(_SC_PAGESIZE);
+		g_strfreev(values);
+		g_free(statm);
+	}
+}
+
+/* Print memory used by a representation of desktop entries */
+static void _benchmark_print_memory(const gchar *inName,
+									gsize inRequested,
+									const BenchmarkMemory *inBefore,
+									const BenchmarkMemory *inAfter,
+									guint inEntries)
+{
+	g_print("  %-28s %8.1f bytes/entry requested", inName, (gdouble)inRequested/(gdouble)inEntries);
+
+	if(inAfter->heap>0) g_print(" %8.1f bytes/entry heap", (gdouble)(gssize)(inAfter->heap-inBefore->heap)/(gdouble)inEntries);
+		else g_print("    heap n/a");
+
+	if(inAfter->resident>0) g_print(" %8.1f bytes/entry resident", (gdouble)(gssize)(inAfter->resident-inBefore->resident)/(gdouble)inEntries);
+		else g_print("    resident n/a");
+
+	g_print("\n");
+}
+
+/* Print result of a benchmark */
+static void _benchmark_print_result(const gchar *inName, gint64 inTime, guint inFiles, gsize inBytes)
+{
+	gdouble				perFile;
+
+	perFile=(gdouble)inTime/(gdouble)inFiles;
+	g_print("  %-28s %10.2f us/file %8.2f MB/s\n",
+				inName,
+				perFile,
+				(gdouble)inBytes/(gdouble)inTime);
+}
+
+
+/* IMPLEMENTATION: Main */
+
+int main(int argc, char **argv)
+{
+	GOptionContext			*context;
+	GError					*error;
+	GArray					*files;
+	gsize					bytes;
+	const gchar				*environment;
+	const gchar				*defaultDirectories[]={ BENCHMARK_DEFAULT_DIRECTORY, NULL };
+	const gchar * const		*directories;
+	gint64					startTime;
+	gint64					timeKeyFile;
+	gint64					timeEntry;
+	guint					validKeyFile;
+	guint					validEntry;
+	guint					mismatches;
+	gboolean				success;
+	XfdashboardDesktopEntry	**entries;
+	BenchmarkSeparateEntry	*separateEntries;
+	gchar					*arena;
+	guint					entriesCount;
+	gsize					requested;
+	gsize					arenaSize;
+	BenchmarkMemory			before;
+	BenchmarkMemory			after;
+	guint					categories;
+	guint					distinctCategories;
+	guint					i;
+	gint					round;
+
+	/* Parse command-line options */
+	error=NULL;
+	context=g_option_context_new(NULL);
+	g_option_context_set_summary(context,
+									"Measures time to parse the desktop files of the given directories, "
+									"by default " BENCHMARK_DEFAULT_DIRECTORY ", by loading them into key files "
+									"like menu items do and by the locale-filtered parser of desktop app infos. "
+									"Files are read before, so reading them from disk is not measured. "
+									"Then measures the memory used by the parsed desktop entries.");
+	g_option_context_add_main_entries(context, _benchmark_options, NULL);
+	if(!g_option_context_parse(context, &argc, &argv, &error))
+	{
+		g_printerr("%s\n", error->message);
+		g_error_free(error);
+		g_option_context_free(context);
+		return(EXIT_FAILURE);
+	}
+	g_option_context_free(context);
+
+	if(_benchmark_rounds<=0)
+	{
+		g_printerr("Number of rounds must be positive\n");
+		return(EXIT_FAILURE);
+	}
+
+	/* Read all desktop files */
+	directories=_benchmark_directories ? (const gchar * const*)_benchmark_directories : defaultDirectories;
+
+	files=g_array_new(FALSE, FALSE, sizeof(BenchmarkDesktopFile));
+	bytes=0;
+	for(i=0; directories[i]; i++) _benchmark_read_directory(directories[i], files, &bytes);
+
+	if(files->len==0)
+	{
+		g_printerr("No desktop files found\n");
+		g_array_free(files, TRUE);
+		g_strfreev(_benchmark_directories);
+		return(EXIT_FAILURE);
+	}
+
+	environment=g_getenv("XDG_CURRENT_DESKTOP");
+	g_print("Parsing %u desktop files (%" G_GSIZE_FORMAT " bytes) %d times for locale '%s' and environment '%s'\n\n",
+				files->len,
+				bytes,
+				_benchmark_rounds,
+				g_get_language_names()[0],
+				environment ? environment : "");
+
+	/* Parse all desktop files with both parsers */
+	validKeyFile=validEntry=0;
+
+	startTime=g_get_monotonic_time();
+	for(round=0; round<_benchmark_rounds; round++)
+	{
+		validKeyFile=0;
+		for(i=0; i<files->len; i++)
+		{
+			if(_benchmark_parse_key_file(&g_array_index(files, BenchmarkDesktopFile, i), NULL, NULL)) validKeyFile++;
+		}
+	}
+	timeKeyFile=g_get_monotonic_time()-startTime;
+
+	startTime=g_get_monotonic_time();
+	for(round=0; round<_benchmark_rounds; round++)
+	{
+		validEntry=0;
+		for(i=0; i<files->len; i++)
+		{
+			const BenchmarkDesktopFile	*file;
+			XfdashboardDesktopEntry		*entry;
+
+			file=&g_array_index(files, BenchmarkDesktopFile, i);
+			entry=_xfdashboard_desktop_entry_new_from_data(file->contents, file->length, environment, NULL);
+			if(entry)
+			{
+				validEntry++;
+				_xfdashboard_desktop_entry_free(entry);
+			}
+		}
+	}
+	timeEntry=g_get_monotonic_time()-startTime;
+
+	g_print("Parse time:\n");
+	_benchmark_print_result("key file", timeKeyFile, files->len*_benchmark_rounds, bytes*_benchmark_rounds);
+	_benchmark_print_result("locale-filtered parser", timeEntry, files->len*_benchmark_rounds, bytes*_benchmark_rounds);
+
+	/* Both parsers must get the same name and command of each desktop file */
+	mismatches=0;
+	for(i=0; i<files->len; i++)
+	{
+		const BenchmarkDesktopFile	*file;
+		XfdashboardDesktopEntry		*entry;
+		gchar						*name;
+		gchar						*command;
+		gboolean					valid;
+
+		file=&g_array_index(files, BenchmarkDesktopFile, i);
+		valid=_benchmark_parse_key_file(file, &name, &command);
+		entry=_xfdashboard_desktop_entry_new_from_data(file->contents, file->length, environment, NULL);
+
+		if(valid && entry)
+		{
+			if(g_strcmp0(name, entry->name) || g_strcmp0(command, entry->command))
+			{
+				g_printerr("Values differ for desktop file '%s'\n", file->filename);
+				mismatches++;
+			}
+		}
+
+		if(valid)
+		{
+			g_free(name);
+			g_free(command);
+		}
+		if(entry) _xfdashboard_desktop_entry_free(entry);
+	}
+
+	g_print("\nValid desktop files: %u by key file, %u by locale-filtered parser, %u with different values\n",
+				validKeyFile,
+				validEntry,
+				mismatches);
+
+	success=(mismatches==0);
+
+	/* Measure memory of all valid desktop entries when stored as one block
+	 * per entry like desktop app infos do, with separately allocated strings
+	 * like before and with all entries stored in one arena. Each
+	 * representation is measured from the state before it was created.
+	 */
+	entries=g_new0(XfdashboardDesktopEntry*, files->len);
+	entriesCount=0;
+	requested=0;
+
+	_benchmark_get_memory(&before);
+	for(i=0; i<files->len; i++)
+	{
+		const BenchmarkDesktopFile	*file;
+
+		file=&g_array_index(files, BenchmarkDesktopFile, i);
+		entries[entriesCount]=_xfdashboard_desktop_entry_new_from_data(file->contents, file->length, environment, NULL);
+		if(entries[entriesCount])
+		{
+			requested+=_benchmark_get_entry_size(entries[entriesCount]);
+			entriesCount++;
+		}
+	}
+	_benchmark_get_memory(&after);
+
+	g_print("\nMemory of %u desktop entries:\n", entriesCount);
+	_benchmark_print_memory("one block per entry", requested, &before, &after, entriesCount);
+
+	requested=entriesCount*sizeof(BenchmarkSeparateEntry);
+
+	_benchmark_get_memory(&before);
+	separateEntries=g_new0(BenchmarkSeparateEntry, entriesCount);
+	for(i=0; i<entriesCount; i++)
+	{
+		separateEntries[i].name=g_strdup(entries[i]->name);
+		separateEntries[i].comment=g_strdup(entries[i]->comment);
+		separateEntries[i].command=g_strdup(entries[i]->command);
+		separateEntries[i].binaryExecutable=g_strdup(entries[i]->binaryExecutable);
+		separateEntries[i].iconName=g_strdup(entries[i]->iconName);
+		separateEntries[i].path=g_strdup(entries[i]->path);
+		requested+=_benchmark_get_entry_size(entries[i])-sizeof(XfdashboardDesktopEntry);
+	}
+	_benchmark_get_memory(&after);
+
+	_benchmark_print_memory("separate strings", requested, &before, &after, entriesCount);
+
+	for(i=0; i<entriesCount; i++)
+	{
+		g_free(separateEntries[i].name);
+		g_free(separateEntries[i].comment);
+		g_free(separateEntries[i].command);
+		g_free(separateEntries[i].binaryExecutable);
+		g_free(separateEntries[i].iconName);
+		g_free(separateEntries[i].path);
+	}
+	g_free(separateEntries);
+
+	arenaSize=0;
+	for(i=0; i<entriesCount; i++)
+	{
+		arenaSize+=(_benchmark_get_entry_size(entries[i])+sizeof(gpointer)-1) & ~(sizeof(gpointer)-1);
+	}
+
+	_benchmark_get_memory(&before);
+	arena=g_malloc(arenaSize);
+	memset(arena, 0, arenaSize);
+	_benchmark_get_memory(&after);
+
+	_benchmark_print_memory("one arena for all entries", arenaSize, &before, &after, entriesCount);
+	g_free(arena);
+
+	for(i=0; i<entriesCount; i++) _xfdashboard_desktop_entry_free(entries[i]);
+	g_free(entries);
+
+	/* Categories are not stored by desktop app infos. Show what storing
+	 * them as a bitset over all distinct categories would cost.
+	 */
+	_benchmark_count_categories(files, &categories, &distinctCategories);
+	g_print("\nCategories: %u distinct, %.1f per entry, bitset would add %u bytes/entry\n",
+				distinctCategories,
+				(gdouble)categories/(gdouble)files->len,
+				((distinctCategories+31)/32)*4);
+
+	/* Release allocated resources */
+	for(i=0; i<files->len; i++)
+	{
+		g_free(g_array_index(files, BenchmarkDesktopFile, i).filename);
+		g_free(g_array_index(files, BenchmarkDesktopFile, i).contents);
+	}
+	g_array_free(files, TRUE);
+	g_strfreev(_benchmark_directories);
+
+	return(success ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -0,0 +1,597 @@
+/*
+ * benchmark-search-match: Measure matching of search terms against
+ *                         search index of applications exactly and
+ *                         approximately
+ * 
+ * Copyright 2012-2016 Stephan Haller <nomad@froevel.de>
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ * 
+ * 
+ */
+
+#include "config.h"
+
+#include <glib.h>
+#include <string.h>
+#include <stdlib.h>
+
+#include <libxfdashboard/search-match.h>
+
+
+/* IMPLEMENTATION: Private variables and methods */
+#define BENCHMARK_DEFAULT_APPLICATIONS		2000
+#define BENCHMARK_DEFAULT_ROUNDS			200
+#define BENCHMARK_RANDOM_SEED				20160101
+#define BENCHMARK_DEFAULT_BUDGET			16
+#define BENCHMARK_MAX_TERMS					8
+
+/* Options */
+static gint			_benchmark_applications=BENCHMARK_DEFAULT_APPLICATIONS;
+static gint			_benchmark_rounds=BENCHMARK_DEFAULT_ROUNDS;
+static gint			_benchmark_budget=BENCHMARK_DEFAULT_BUDGET;
+
+static GOptionEntry	_benchmark_options[]=
+{
+	{ "applications", 'a', 0, G_OPTION_ARG_INT, &_benchmark_applications, "Number of generated applications", "N" },
+	{ "rounds", 'r', 0, G_OPTION_ARG_INT, &_benchmark_rounds, "Number of times each search is repeated", "N" },
+	{ "budget", 'b', 0, G_OPTION_ARG_INT, &_benchmark_budget, "Time in milliseconds a search for a typed key may take", "MS" },
+	{ NULL }
+};
+
+/* Words generated applications are made of */
+static const gchar	*_benchmark_words[]=
+{
+	"Firefox", "Web", "Browser", "Terminal", "Emulator", "Files", "Manager",
+	"Text", "Editor", "Image", "Viewer", "Mail", "Client", "Music", "Player",
+	"Video", "Settings", "System", "Monitor", "Calculator", "Archive", "Office",
+	"Document", "Writer", "Spreadsheet", "Presentation", "Screenshot", "Camera",
+	"Photo", "Network", "Bluetooth", "Printer", "Disk", "Usage", "Analyzer",
+	"Task", "Clock", "Calendar", "Contacts", "Notes", "Maps", "Weather", "Chat",
+	"Chess", "Mines", "Sudoku", "Font", "Colour", "Picker", "Sound", "Volume",
+	"Keyboard", "Mouse", "Display", "Power", "Backup", "Software", "Update",
+	"Package", "Remote", "Desktop", "Accessibility", "Éditeur", "Größe",
+	NULL
+};
+
+/* Search terms as typed key by key */
+static const gchar	*_benchmark_searches[]=
+{
+	"f", "fi", "fir", "fire", "firef", "firefo", "firefox",
+	"t", "te", "ter", "term", "termi", "termin", "termina", "terminal",
+	"ed", "edi", "edit", "edito", "editor",
+	"colour picker",
+	"zzz",
+	NULL
+};
+
+/* Search terms with typing errors as typed key by key */
+static const gchar	*_benchmark_fuzzy_searches[]=
+{
+	"fir", "firf", "firfo", "firfox",
+	"ter", "term", "termn", "termni", "termnia", "termnial",
+	"cal", "calc", "calcu", "calcua", "calcual", "calcualt", "calcualto", "calcualtor",
+	"edtor",
+	"colur pikcer",
+	NULL
+};
+
+/* Generated application as the previous matching path saw it: separately
+ * allocated strings which were lower-cased at each match.
+ */
+typedef struct _BenchmarkApplication		BenchmarkApplication;
+struct _BenchmarkApplication
+{
+	gchar				*title;
+	gchar				*description;
+	gchar				*command;
+};
+
+/* Entry of packed search index like the one of applications search provider */
+typedef struct _BenchmarkIndexEntry			BenchmarkIndexEntry;
+struct _BenchmarkIndexEntry
+{
+	gsize				titleOffset;
+	gsize				titleLength;
+	gsize				descriptionOffset;
+	gsize				descriptionLength;
+	gsize				commandOffset;
+	gsize				commandLength;
+};
+
+/* Function to find needle in haystack */
+typedef const gchar* (*BenchmarkFindFunc)(const gchar *inHaystack,
+											gsize inHaystackLength,
+											const gchar *inNeedle,
+											gsize inNeedleLength);
+
+/* Create a string of random words */
+static gchar* _benchmark_create_words(GRand *inRandom, gint inMinimum, gint inMaximum, const gchar *inSeparator)
+{
+	GString				*string;
+	gint				count;
+	gint				i;
+
+	string=g_string_new(NULL);
+	count=g_rand_int_range(inRandom, inMinimum, inMaximum+1);
+	for(i=0; i<count; i++)
+	{
+		if(i>0) g_string_append(string, inSeparator);
+		g_string_append(string, _benchmark_words[g_rand_int_range(inRandom, 0, G_N_ELEMENTS(_benchmark_words)-1)]);
+	}
+
+	return(g_string_free(string, FALSE));
+}
+
+/* Generate applications */
+static BenchmarkApplication* _benchmark_create_applications(gint inCount)
+{
+	BenchmarkApplication	*applications;
+	GRand					*random;
+	gchar					*name;
+	gint					i;
+
+	random=g_rand_new_with_seed(BENCHMARK_RANDOM_SEED);
+
+	applications=g_new0(BenchmarkApplication, inCount);
+	for(i=0; i<inCount; i++)
+	{
+		applications[i].title=_benchmark_create_words(random, 1, 3, " ");
+		applications[i].description=_benchmark_create_words(random, 4, 10, " ");
+
+		name=_benchmark_create_words(random, 1, 2, "-");
+		applications[i].command=g_ascii_strdown(name, -1);
+		g_free(name);
+	}
+
+	g_rand_free(random);
+
+	return(applications);
+}
+
+/* Add lower-case string to packed string buffer */
+static void _benchmark_add_index_string(GString *ioStrings, const gchar *inString, gsize *outOffset, gsize *outLength)
+{
+	gchar				*lowerString;
+
+	lowerString=g_utf8_strdown(inString, -1);
+
+	*outOffset=ioStrings->len;
+	*outLength=strlen(lowerString);
+	g_string_append_len(ioStrings, lowerString, *outLength+1);
+
+	g_free(lowerString);
+}
+
+/* Create packed search index of applications */
+static BenchmarkIndexEntry* _benchmark_create_index(BenchmarkApplication *inApplications, gint inCount, gchar **outStrings)
+{
+	BenchmarkIndexEntry		*index;
+	GString					*strings;
+	gint					i;
+
+	strings=g_string_new(NULL);
+	index=g_new0(BenchmarkIndexEntry, inCount);
+	for(i=0; i<inCount; i++)
+	{
+		_benchmark_add_index_string(strings, inApplications[i].title, &index[i].titleOffset, &index[i].titleLength);
+		_benchmark_add_index_string(strings, inApplications[i].description, &index[i].descriptionOffset, &index[i].descriptionLength);
+
+		/* Command is not lower-cased */
+		index[i].commandOffset=strings->len;
+		index[i].commandLength=strlen(inApplications[i].command);
+		g_string_append_len(strings, inApplications[i].command, index[i].commandLength+1);
+	}
+
+	*outStrings=g_string_free(strings, FALSE);
+	return(index);
+}
+
+/* Match applications with previous matching path: lower-case title and
+ * description of each application at each search and find search terms with
+ * g_strstr_len(). Returns number of matching applications.
+ */
+static guint _benchmark_match_previous(BenchmarkApplication *inApplications, gint inCount, gchar **inTerms)
+{
+	guint				matches;
+	gint				i;
+	gint				j;
+
+	matches=0;
+	for(i=0; i<inCount; i++)
+	{
+		gchar			*title;
+		gchar			*description;
+		const gchar		*commandPos;
+		gboolean		allTermsMatch;
+
+		title=g_utf8_strdown(inApplications[i].title, -1);
+		description=g_utf8_strdown(inApplications[i].description, -1);
+
+		allTermsMatch=TRUE;
+		for(j=0; inTerms[j] && allTermsMatch; j++)
+		{
+			if(g_strstr_len(title, -1, inTerms[j])) continue;
+			if(g_strstr_len(description, -1, inTerms[j])) continue;
+
+			commandPos=g_strstr_len(inApplications[i].command, -1, inTerms[j]);
+			if(commandPos &&
+				(commandPos==inApplications[i].command || *(commandPos-1)==G_DIR_SEPARATOR))
+			{
+				continue;
+			}
+
+			allTermsMatch=FALSE;
+		}
+
+		if(allTermsMatch) matches++;
+
+		g_free(title);
+		g_free(description);
+	}
+
+	return(matches);
+}
+
+/* Match applications against packed search index in one pass with function
+ * to find search terms. Returns number of matching applications.
+ */
+static guint _benchmark_match_index(BenchmarkIndexEntry *inIndex,
+									gint inCount,
+									const gchar *inStrings,
+									gchar **inTerms,
+									BenchmarkFindFunc inFind)
+{
+	guint				matches;
+	gint				i;
+	gint				j;
+	gsize				termsLength[BENCHMARK_MAX_TERMS];
+	gint				termsCount;
+
+	termsCount=0;
+	while(inTerms[termsCount] && termsCount<(gint)G_N_ELEMENTS(termsLength))
+	{
+		termsLength[termsCount]=strlen(inTerms[termsCount]);
+		termsCount++;
+	}
+
+	matches=0;
+	for(i=0; i<inCount; i++)
+	{
+		const BenchmarkIndexEntry	*entry;
+		const gchar					*command;
+		const gchar					*commandPos;
+		gboolean					allTermsMatch;
+
+		entry=&inIndex[i];
+		command=inStrings+entry->commandOffset;
+
+		allTermsMatch=TRUE;
+		for(j=0; j<termsCount && allTermsMatch; j++)
+		{
+			if((inFind)(inStrings+entry->titleOffset, entry->titleLength, inTerms[j], termsLength[j])) continue;
+			if((inFind)(inStrings+entry->descriptionOffset, entry->descriptionLength, inTerms[j], termsLength[j])) continue;
+
+			commandPos=(inFind)(command, entry->commandLength, inTerms[j], termsLength[j]);
+			if(commandPos &&
+				(commandPos==command || *(commandPos-1)==G_DIR_SEPARATOR))
+			{
+				continue;
+			}
+
+			allTermsMatch=FALSE;
+		}
+
+		if(allTermsMatch) matches++;
+	}
+
+	return(matches);
+}
+
+/* Match applications against packed search index like applications search
+ * provider does: a search term not found exactly in title or command is
+ * matched approximately with at most the given number of errors which is
+ * limited to a third of the length of search term. Returns number of
+ * matching applications.
+ */
+static guint _benchmark_match_fuzzy(BenchmarkIndexEntry *inIndex,
+									gint inCount,
+									const gchar *inStrings,
+									gchar **inTerms,
+									guint inMaxErrors)
+{
+	guint64				*masks;
+	gsize				termsLength[BENCHMARK_MAX_TERMS];
+	guint				termsErrors[BENCHMARK_MAX_TERMS];
+	gint				termsCount;
+	guint				matches;
+	gint				i;
+	gint				j;
+
+	/* Set up terms once per search like search query does */
+	masks=g_new(guint64, BENCHMARK_MAX_TERMS*XFDASHBOARD_SEARCH_MATCH_FUZZY_MASK_SIZE);
+
+	termsCount=0;
+	while(inTerms[termsCount] && termsCount<BENCHMARK_MAX_TERMS)
+	{
+		termsLength[termsCount]=strlen(inTerms[termsCount]);
+		termsErrors[termsCount]=MIN(inMaxErrors, termsLength[termsCount]/3);
+		_xfdashboard_search_match_fuzzy_build_mask(inTerms[termsCount],
+													termsLength[termsCount],
+													masks+(termsCount*XFDASHBOARD_SEARCH_MATCH_FUZZY_MASK_SIZE));
+		termsCount++;
+	}
+
+	matches=0;
+	for(i=0; i<inCount; i++)
+	{
+		const BenchmarkIndexEntry	*entry;
+		const gchar					*title;
+		const gchar					*command;
+		const gchar					*commandPos;
+		const guint64				*mask;
+		gboolean					allTermsMatch;
+
+		entry=&inIndex[i];
+		title=inStrings+entry->titleOffset;
+		command=inStrings+entry->commandOffset;
+
+		allTermsMatch=TRUE;
+		for(j=0; j<termsCount && allTermsMatch; j++)
+		{
+			mask=masks+(j*XFDASHBOARD_SEARCH_MATCH_FUZZY_MASK_SIZE);
+
+			if(_xfdashboard_search_match_find(title, entry->titleLength, inTerms[j], termsLength[j])) continue;
+			if(termsErrors[j]>0 &&
+				_xfdashboard_search_match_fuzzy_find(title, entry->titleLength, mask, termsLength[j], termsErrors[j])>0)
+			{
+				continue;
+			}
+
+			if(_xfdashboard_search_match_find(inStrings+entry->descriptionOffset, entry->descriptionLength, inTerms[j], termsLength[j])) continue;
+
+			commandPos=_xfdashboard_search_match_find(command, entry->commandLength, inTerms[j], termsLength[j]);
+			if(commandPos &&
+				(commandPos==command || *(commandPos-1)==G_DIR_SEPARATOR))
+			{
+				continue;
+			}
+
+			if(termsErrors[j]>0 &&
+				_xfdashboard_search_match_fuzzy_find(command, entry->commandLength, mask, termsLength[j], termsErrors[j])>0)
+			{
+				continue;
+			}
+
+			allTermsMatch=FALSE;
+		}
+
+		if(allTermsMatch) matches++;
+	}
+
+	g_free(masks);
+
+	return(matches);
+}
+
+/* Print result of a benchmark */
+static void _benchmark_print_result(const gchar *inName, gint64 inTime, guint inSearches, guint inMatches)
+{
+	gdouble				perSearch;
+
+	perSearch=(gdouble)inTime/(gdouble)inSearches;
+	g_print("  %-28s %10.2f us/search %8.2f ns/application",
+				inName,
+				perSearch,
+				(perSearch*1000.0)/(gdouble)_benchmark_applications);
+	if(inMatches>0) g_print(" %8u matches", inMatches);
+	g_print("\n");
+}
+
+
+/* IMPLEMENTATION: Main */
+
+int main(int argc, char **argv)
+{
+	GOptionContext			*context;
+	GError					*error;
+	BenchmarkApplication	*applications;
+	BenchmarkIndexEntry		*index;
+	gchar					*strings;
+	gint64					timePrevious;
+	gint64					timeScalar;
+	gint64					timeVector;
+	gint64					totalPrevious;
+	gint64					totalScalar;
+	gint64					totalVector;
+	guint					matchesPrevious;
+	guint					matchesScalar;
+	guint					matchesVector;
+	guint					searches;
+	gint64					startTime;
+	gboolean				success;
+	gint					i;
+	gint					round;
+	guint					errors;
+	guint					matchesFuzzy;
+	gint64					timeFuzzy;
+	gint64					slowestFuzzy[XFDASHBOARD_SEARCH_MATCH_FUZZY_MAX_ERRORS+1];
+	const gchar				*slowestFuzzySearch[XFDASHBOARD_SEARCH_MATCH_FUZZY_MAX_ERRORS+1];
+
+	/* Parse command-line options */
+	error=NULL;
+	context=g_option_context_new(NULL);
+	g_option_context_set_summary(context,
+									"Measures time to match typed search terms against generated applications "
+									"with the previous matching path, the packed search index with scalar "
+									"substring search and the packed search index with vectorized substring search. "
+									"Then measures the cost of approximate matching for each allowed number of errors "
+									"on searches with typing errors.");
+	g_option_context_add_main_entries(context, _benchmark_options, NULL);
+	if(!g_option_context_parse(context, &argc, &argv, &error))
+	{
+		g_printerr("%s\n", error->message);
+		g_error_free(error);
+		g_option_context_free(context);
+		return(EXIT_FAILURE);
+	}
+	g_option_context_free(context);
+
+	if(_benchmark_applications<=0 || _benchmark_rounds<=0 || _benchmark_budget<=0)
+	{
+		g_printerr("Number of applications, rounds and budget must be positive\n");
+		return(EXIT_FAILURE);
+	}
+
+	/* Generate applications and their packed search index */
+	searches=0;
+	applications=_benchmark_create_applications(_benchmark_applications);
+	index=_benchmark_create_index(applications, _benchmark_applications, &strings);
+
+#if defined(__AVX2__)
+	g_print("Vectorized substring search uses AVX2\n");
+#elif defined(__SSE2__)
+	g_print("Vectorized substring search uses SSE2\n");
+#else
+	g_print("No vector instructions available, vectorized substring search is scalar\n");
+#endif
+	g_print("Matching %d applications, each search repeated %d times\n\n", _benchmark_applications, _benchmark_rounds);
+
+	/* Run each search key by key with all matching paths. Each search scans
+	 * all applications once like a search at applications search provider
+	 * does for each key typed.
+	 */
+	success=TRUE;
+	totalPrevious=totalScalar=totalVector=0;
+	for(i=0; _benchmark_searches[i]; i++)
+	{
+		gchar				**terms;
+
+		terms=g_strsplit(_benchmark_searches[i], " ", -1);
+		matchesPrevious=matchesScalar=matchesVector=0;
+
+		startTime=g_get_monotonic_time();
+		for(round=0; round<_benchmark_rounds; round++) matchesPrevious=_benchmark_match_previous(applications, _benchmark_applications, terms);
+		timePrevious=g_get_monotonic_time()-startTime;
+
+		startTime=g_get_monotonic_time();
+		for(round=0; round<_benchmark_rounds; round++) matchesScalar=_benchmark_match_index(index, _benchmark_applications, strings, terms, _xfdashboard_search_match_find_scalar);
+		timeScalar=g_get_monotonic_time()-startTime;
+
+		startTime=g_get_monotonic_time();
+		for(round=0; round<_benchmark_rounds; round++) matchesVector=_benchmark_match_index(index, _benchmark_applications, strings, terms, _xfdashboard_search_match_find);
+		timeVector=g_get_monotonic_time()-startTime;
+
+		g_print("Search '%s':\n", _benchmark_searches[i]);
+		_benchmark_print_result("previous path", timePrevious, _benchmark_rounds, matchesPrevious);
+		_benchmark_print_result("packed index, scalar", timeScalar, _benchmark_rounds, matchesScalar);
+		_benchmark_print_result("packed index, vectorized", timeVector, _benchmark_rounds, matchesVector);
+
+		/* All matching paths must find the same applications */
+		if(matchesScalar!=matchesPrevious || matchesVector!=matchesPrevious)
+		{
+			g_printerr("Number of matches differ for search '%s'\n", _benchmark_searches[i]);
+			success=FALSE;
+		}
+
+		totalPrevious+=timePrevious;
+		totalScalar+=timeScalar;
+		totalVector+=timeVector;
+		searches+=_benchmark_rounds;
+
+		g_strfreev(terms);
+	}
+
+	g_print("\nAll searches:\n");
+	_benchmark_print_result("previous path", totalPrevious, searches, 0);
+	_benchmark_print_result("packed index, scalar", totalScalar, searches, 0);
+	_benchmark_print_result("packed index, vectorized", totalVector, searches, 0);
+
+	/* Run searches with typing errors key by key for each number of errors
+	 * allowed and remember slowest search. Allowing no error must find the
+	 * same applications as exact matching.
+	 */
+	g_print("\nApproximate matching, budget of %d ms per typed key:\n", _benchmark_budget);
+	for(errors=0; errors<=XFDASHBOARD_SEARCH_MATCH_FUZZY_MAX_ERRORS; errors++)
+	{
+		slowestFuzzy[errors]=0;
+		slowestFuzzySearch[errors]=NULL;
+	}
+
+	for(i=0; _benchmark_fuzzy_searches[i]; i++)
+	{
+		gchar				**terms;
+
+		terms=g_strsplit(_benchmark_fuzzy_searches[i], " ", -1);
+
+		g_print("Search '%s':\n", _benchmark_fuzzy_searches[i]);
+		for(errors=0; errors<=XFDASHBOARD_SEARCH_MATCH_FUZZY_MAX_ERRORS; errors++)
+		{
+			gchar			*name;
+
+			matchesFuzzy=0;
+			startTime=g_get_monotonic_time();
+			for(round=0; round<_benchmark_rounds; round++) matchesFuzzy=_benchmark_match_fuzzy(index, _benchmark_applications, strings, terms, errors);
+			timeFuzzy=g_get_monotonic_time()-startTime;
+
+			name=g_strdup_printf("fuzzy-max-errors=%u", errors);
+			_benchmark_print_result(name, timeFuzzy, _benchmark_rounds, matchesFuzzy);
+			g_free(name);
+
+			if(errors==0 &&
+				matchesFuzzy!=_benchmark_match_index(index, _benchmark_applications, strings, terms, _xfdashboard_search_match_find))
+			{
+				g_printerr("Number of matches differ for search '%s' without errors\n", _benchmark_fuzzy_searches[i]);
+				success=FALSE;
+			}
+
+			if(timeFuzzy/_benchmark_rounds>slowestFuzzy[errors])
+			{
+				slowestFuzzy[errors]=timeFuzzy/_benchmark_rounds;
+				slowestFuzzySearch[errors]=_benchmark_fuzzy_searches[i];
+			}
+		}
+
+		g_strfreev(terms);
+	}
+
+	g_print("\nSlowest typed key:\n");
+	for(errors=0; errors<=XFDASHBOARD_SEARCH_MATCH_FUZZY_MAX_ERRORS; errors++)
+	{
+		gchar				*name;
+
+		name=g_strdup_printf("fuzzy-max-errors=%u", errors);
+		g_print("  %-28s %10.2f ms for '%s'%s\n",
+					name,
+					(gdouble)slowestFuzzy[errors]/1000.0,
+					slowestFuzzySearch[errors],
+					slowestFuzzy[errors]>_benchmark_budget*1000 ? ", exceeds budget" : "");
+		g_free(name);
+	}
+
+	/* Release allocated resources */
+	for(i=0; i<_benchmark_applications; i++)
+	{
+		g_free(applications[i].title);
+		g_free(applications[i].description);
+		g_free(applications[i].command);
+	}
+	g_free(applications);
+	g_free(index);
+	g_free(strings);
+
+	return(success ? EXIT_SUCCESS : EXIT_FAILURE);
+}
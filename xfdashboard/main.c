@@ -181,22 +181,11 @@ static gboolean _restart(XfdashboardApplication *inApplication)
 	return(restartData.appHasQuitted);
 }
 
-/* Main entry point */
-int main(int argc, char **argv)
+/* Initialize GTK+ and Clutter. This opens the display and creates a GL context
+ * so it is only done if this instance will become the primary instance.
+ */
+static gboolean _initialize_toolkits(int *ioArgc, char ***ioArgv)
 {
-	XfdashboardApplication		*app=NULL;
-	gint						status;
-
-#ifdef ENABLE_NLS
-	/* Set up localization */
-	xfce_textdomain(GETTEXT_PACKAGE, PACKAGE_LOCALE_DIR, "UTF-8");
-#endif
-
-#if !GLIB_CHECK_VERSION(2, 36, 0)
-	/* Initialize GObject type system */
-	g_type_init();
-#endif
-
 #if CLUTTER_CHECK_VERSION(1, 16, 0)
 	/* Enforce X11 backend in Clutter. This function must be called before any
 	 * other Clutter API function.
@@ -208,17 +197,37 @@ int main(int argc, char **argv)
 	clutter_x11_set_use_argb_visual(TRUE);
 
 	/* Initialize GTK+ and Clutter */
-	gtk_init(&argc, &argv);
-	if(!clutter_init(&argc, &argv))
+	gtk_init(ioArgc, ioArgv);
+	if(!clutter_init(ioArgc, ioArgv))
 	{
 		g_error(_("Initializing clutter failed!"));
-		return(1);
+		return(FALSE);
 	}
 
 	/* Notify that application has started and main loop will be entered */
 	gdk_notify_startup_complete();
 
-	/* Start application as primary or remote instace */
+	return(TRUE);
+}
+
+/* Main entry point */
+int main(int argc, char **argv)
+{
+	XfdashboardApplication		*app=NULL;
+	gboolean					toolkitsInitialized;
+	gint						status;
+
+#ifdef ENABLE_NLS
+	/* Set up localization */
+	xfce_textdomain(GETTEXT_PACKAGE, PACKAGE_LOCALE_DIR, "UTF-8");
+#endif
+
+#if !GLIB_CHECK_VERSION(2, 36, 0)
+	/* Initialize GObject type system */
+	g_type_init();
+#endif
+
+	/* Create application instance */
 	app=xfdashboard_application_get_default();
 	if(!app)
 	{
@@ -226,6 +235,22 @@ int main(int argc, char **argv)
 		return(XFDASHBOARD_APPLICATION_ERROR_FAILED);
 	}
 
+	/* Register application at session bus before initializing any toolkit to
+	 * find out if a primary instance is running already. In this case this
+	 * instance is a remote one which only sends its command-line to the primary
+	 * instance and does not need GTK+ and Clutter. If registration fails
+	 * initialize toolkits anyway and let g_application_run() handle the error.
+	 */
+	toolkitsInitialized=FALSE;
+	if(!g_application_register(G_APPLICATION(app), NULL, NULL) ||
+		!g_application_get_is_remote(G_APPLICATION(app)))
+	{
+		if(!_initialize_toolkits(&argc, &argv)) return(1);
+		toolkitsInitialized=TRUE;
+	}
+		else g_debug("Primary instance is running so send command-line without initializing toolkits");
+
+	/* Start application as primary or remote instace */
 	status=g_application_run(G_APPLICATION(app), argc, argv);
 	if(status==XFDASHBOARD_APPLICATION_ERROR_RESTART &&
 		g_application_get_is_remote(G_APPLICATION(app)))
@@ -239,6 +264,15 @@ int main(int argc, char **argv)
 			g_object_unref(app);
 			app=NULL;
 
+			/* This instance will become the new primary instance so toolkits
+			 * are needed now.
+			 */
+			if(!toolkitsInitialized)
+			{
+				if(!_initialize_toolkits(&argc, &argv)) return(1);
+				toolkitsInitialized=TRUE;
+			}
+
 			/* Create new application instance which should become
 			 * the new primary instance.
 			 */